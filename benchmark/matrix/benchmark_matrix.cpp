@@ -0,0 +1,478 @@
+//----------------------------------------------------------------------------
+/// @file benchmark_matrix.cpp
+/// @brief Benchmark of all the sort methods, on every distribution of the
+///        data, size of the elements and number of threads, with the
+///        results in JSON or CSV
+///
+/// @author Distributed under the Boost Software License, Version 1.0.\n
+///         ( See accompanying file LICENSE_1_0.txt or copy at
+///           http://www.boost.org/LICENSE_1_0.txt )
+///
+/// @version 0.1
+///
+/// @remarks The elements are int_array<N>, sorted by their first number
+///          (L_comp), so the radix sorts use the same key as the others,
+///          and the float sorts a key in the same order (L_float_shift).
+///          The data are generated in memory from a seed, and each sort is
+///          run some times after some warm-up runs, reporting the median,
+///          the 95th percentile and the minimum of the times
+//-----------------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/sort/common/time_measure.hpp>
+#include <boost/sort/common/int_array.hpp>
+
+#include <boost/sort/sort.hpp>
+
+using namespace std;
+namespace bsort = boost::sort;
+namespace bsc = boost::sort::common;
+namespace bss = boost::sort::spreadsort;
+
+using bsc::time_point;
+using bsc::now;
+using bsc::subtract_time;
+using bsc::int_array;
+using bsc::L_comp;
+
+//---------------------------------------------------------------------------
+//                 C O N F I G U R A T I O N
+//---------------------------------------------------------------------------
+struct config_t
+{
+    uint64_t size = 1000000;      // elements of int_array<1>
+    uint32_t reps = 5;            // timed runs of each sort
+    uint32_t warmup = 1;          // runs before the timed ones
+    uint64_t seed = 1;
+    bool csv = false;
+    string output;                // empty means the standard output
+    vector<uint32_t> elements = {1, 4, 16};
+    vector<uint32_t> threads;
+    vector<string> algorithms;    // empty means all
+    vector<string> distributions; // empty means all
+};
+
+//---------------------------------------------------------------------------
+//                       R E S U L T S
+//---------------------------------------------------------------------------
+struct result_t
+{
+    string algorithm, distribution;
+    uint32_t element_bytes, threads;
+    uint64_t nelem;
+    double median, p95, min;
+    bool sorted;
+};
+
+template <class IA>
+struct L_rightshift
+{
+    inline uint64_t operator()(const IA &A1, unsigned offset) const
+    {
+        return A1.M[0] >> offset;
+    };
+};
+
+// Key of the float sorts: the signed integer whose bits, read as a double,
+// are in the same order as the first number
+template <class IA>
+struct L_float_shift
+{
+    inline int64_t operator()(const IA &A1, unsigned) const
+    {
+        const uint64_t sign = uint64_t(1) << 63;
+        return int64_t((A1.M[0] & sign) ? A1.M[0] ^ sign : ~A1.M[0]);
+    };
+};
+
+//---------------------------------------------------------------------------
+//                      A L G O R I T H M S
+//---------------------------------------------------------------------------
+// Each sort receives the data and the number of threads, which the
+// sequential sorts ignore
+template <class IA>
+struct algorithm_t
+{
+    string name;
+    bool parallel;
+    function<void(vector<IA> &, uint32_t)> sort;
+};
+
+template <class IA>
+vector<algorithm_t<IA> > algorithm_list()
+{
+    L_comp<IA> comp;
+    L_rightshift<IA> shift;
+    L_float_shift<IA> float_shift;
+    vector<algorithm_t<IA> > V;
+
+    V.push_back({"std::sort", false, [=](vector<IA> &A, uint32_t)
+                 { std::sort(A.begin(), A.end(), comp); }});
+    V.push_back({"std::stable_sort", false, [=](vector<IA> &A, uint32_t)
+                 { std::stable_sort(A.begin(), A.end(), comp); }});
+    V.push_back({"pdqsort", false, [=](vector<IA> &A, uint32_t)
+                 { bsort::pdqsort(A.begin(), A.end(), comp); }});
+    V.push_back({"spinsort", false, [=](vector<IA> &A, uint32_t)
+                 { bsort::spinsort(A.begin(), A.end(), comp); }});
+    V.push_back({"flat_stable_sort", false, [=](vector<IA> &A, uint32_t)
+                 { bsort::flat_stable_sort(A.begin(), A.end(), comp); }});
+    V.push_back({"integer_sort", false, [=](vector<IA> &A, uint32_t)
+                 { bss::integer_sort(A.begin(), A.end(), shift, comp); }});
+    V.push_back({"stable_integer_sort", false, [=](vector<IA> &A, uint32_t)
+                 { bss::stable_integer_sort(A.begin(), A.end(), shift); }});
+    V.push_back({"integer_sort_lsd", false, [=](vector<IA> &A, uint32_t)
+                 { bss::integer_sort_lsd(A.begin(), A.end(), shift); }});
+    V.push_back({"integer_tag_sort", false, [=](vector<IA> &A, uint32_t)
+                 { bss::integer_tag_sort(A.begin(), A.end(), shift); }});
+    V.push_back({"block_indirect_sort", true, [=](vector<IA> &A, uint32_t nt)
+                 { bsort::block_indirect_sort(A.begin(), A.end(), comp, nt); }});
+    V.push_back({"sample_sort", true, [=](vector<IA> &A, uint32_t nt)
+                 { bsort::sample_sort(A.begin(), A.end(), comp, nt); }});
+    V.push_back({"parallel_stable_sort", true, [=](vector<IA> &A, uint32_t nt)
+                 { bsort::parallel_stable_sort(A.begin(), A.end(), comp, nt); }});
+    V.push_back({"parallel_integer_sort", true,
+                 [=](vector<IA> &A, uint32_t nt)
+                 { bss::parallel_integer_sort(A.begin(), A.end(), shift, comp,
+                                              nt); }});
+    V.push_back({"parallel_stable_integer_sort", true,
+                 [=](vector<IA> &A, uint32_t nt)
+                 { bss::parallel_stable_integer_sort(A.begin(), A.end(),
+                                                     shift, nt); }});
+    V.push_back({"parallel_integer_tag_sort", true,
+                 [=](vector<IA> &A, uint32_t nt)
+                 { bss::parallel_integer_tag_sort(A.begin(), A.end(), shift,
+                                                  nt); }});
+    V.push_back({"parallel_stable_float_sort", true,
+                 [=](vector<IA> &A, uint32_t nt)
+                 { bss::parallel_stable_float_sort(A.begin(), A.end(),
+                                                   float_shift, nt); }});
+    return V;
+};
+
+//---------------------------------------------------------------------------
+//                   D I S T R I B U T I O N S
+//---------------------------------------------------------------------------
+static const char *distribution_names[] =
+{ "random", "sorted", "reverse", "sorted_end", "sorted_middle",
+  "duplicates", "zipf" };
+//
+//---------------------------------------------------------------------------
+//  function : generate_keys
+/// @brief fill the keys of the elements with a distribution
+///        - random : all the keys random
+///        - sorted : the keys sorted
+///        - reverse : the keys sorted in the reverse order
+///        - sorted_end : sorted, with the last 1% of the keys random
+///        - sorted_middle : sorted, with 1% of random keys spread in
+///                          the middle
+///        - duplicates : random keys of 100 different values
+///        - zipf : keys with a Zipf distribution of exponent 1 over 4096
+///                 values, in random order
+//
+/// @param A : vector with the elements, with their numbers random
+/// @param dist : name of the distribution
+/// @param gen : random generator
+//---------------------------------------------------------------------------
+template <class IA>
+void generate_keys(vector<IA> &A, const string &dist, mt19937_64 &gen)
+{
+    L_comp<IA> comp;
+    const size_t N = A.size();
+    if (dist == "random") return;
+
+    if (dist == "sorted" or dist == "reverse")
+    {
+        std::sort(A.begin(), A.end(), comp);
+        if (dist == "reverse") std::reverse(A.begin(), A.end());
+    }
+    else if (dist == "sorted_end")
+    {
+        std::sort(A.begin(), A.end() - N / 100, comp);
+    }
+    else if (dist == "sorted_middle")
+    {
+        // sorted, and then the keys of 1% of the positions replaced
+        std::sort(A.begin(), A.end(), comp);
+        const size_t step = (N / 100 == 0) ? N : 100;
+        for (size_t i = step / 2; i < N; i += step) A[i].M[0] = gen();
+    }
+    else if (dist == "duplicates")
+    {
+        for (size_t i = 0; i < N; ++i) A[i].M[0] %= 100;
+    }
+    else if (dist == "zipf")
+    {
+        const size_t nvalues = 4096;
+        vector<double> weight(nvalues);
+        vector<uint64_t> value(nvalues);
+        for (size_t i = 0; i < nvalues; ++i)
+        {
+            weight[i] = 1.0 / double(i + 1);
+            value[i] = gen();
+        };
+        discrete_distribution<size_t> zipf(weight.begin(), weight.end());
+        for (size_t i = 0; i < N; ++i) A[i].M[0] = value[zipf(gen)];
+    };
+};
+
+//---------------------------------------------------------------------------
+//                        M E A S U R E
+//---------------------------------------------------------------------------
+// value of the position p (0..1) of the sorted times, by nearest rank
+double percentile(const vector<double> &times, double p)
+{
+    size_t rank = size_t(std::ceil(p * double(times.size())));
+    if (rank == 0) rank = 1;
+    return times[rank - 1];
+};
+//
+//---------------------------------------------------------------------------
+//  function : measure
+/// @brief sort copies of the data warmup + reps times, timing the last reps
+/// @param B : data to sort
+/// @param alg : algorithm
+/// @param nthread : number of threads
+/// @param cfg : configuration
+/// @param R : result, filled with the times in seconds
+//---------------------------------------------------------------------------
+template <class IA>
+void measure(const vector<IA> &B, const algorithm_t<IA> &alg,
+             uint32_t nthread, const config_t &cfg, result_t &R)
+{
+    L_comp<IA> comp;
+    vector<double> times;
+    vector<IA> A;
+    R.sorted = true;
+    for (uint32_t k = 0; k < cfg.warmup + cfg.reps; ++k)
+    {
+        A = B;
+        time_point start = now();
+        alg.sort(A, nthread);
+        time_point finish = now();
+        if (k == 0) R.sorted = std::is_sorted(A.begin(), A.end(), comp);
+        if (k >= cfg.warmup) times.push_back(subtract_time(finish, start));
+    };
+    std::sort(times.begin(), times.end());
+    R.median = percentile(times, 0.5);
+    R.p95 = percentile(times, 0.95);
+    R.min = times.front();
+};
+
+bool selected(const vector<string> &names, const string &name)
+{
+    return names.empty() or
+           std::find(names.begin(), names.end(), name) != names.end();
+};
+//
+//---------------------------------------------------------------------------
+//  function : run_elements
+/// @brief run all the selected algorithms and distributions with elements
+///        of type IA. The number of elements is divided by the size of IA,
+///        so all the sorts move the same memory
+//---------------------------------------------------------------------------
+template <class IA>
+void run_elements(const config_t &cfg, vector<result_t> &results)
+{
+    const uint64_t nelem = cfg.size * sizeof(int_array<1>) / sizeof(IA);
+    vector<algorithm_t<IA> > algorithms = algorithm_list<IA>();
+
+    for (const char *dist : distribution_names)
+    {
+        if (not selected(cfg.distributions, dist)) continue;
+        mt19937_64 gen(cfg.seed);
+        vector<IA> B;
+        B.reserve(nelem);
+        for (uint64_t i = 0; i < nelem; ++i) B.push_back(IA::generate(gen));
+        generate_keys(B, dist, gen);
+
+        for (const algorithm_t<IA> &alg : algorithms)
+        {
+            if (not selected(cfg.algorithms, alg.name)) continue;
+            vector<uint32_t> threads = cfg.threads;
+            if (not alg.parallel) threads.assign(1, 1);
+            for (uint32_t nthread : threads)
+            {
+                result_t R;
+                R.algorithm = alg.name;
+                R.distribution = dist;
+                R.element_bytes = uint32_t(sizeof(IA));
+                R.threads = nthread;
+                R.nelem = nelem;
+                measure(B, alg, nthread, cfg, R);
+                cerr << R.algorithm << " " << R.distribution << " "
+                     << R.element_bytes << "B " << R.threads << "T : "
+                     << R.median << " s" << (R.sorted ? "" : " NOT SORTED")
+                     << endl;
+                results.push_back(R);
+            };
+        };
+    };
+};
+
+// the sizes of int_array measured, in numbers of 64 bits
+void run_all(const config_t &cfg, vector<result_t> &results)
+{
+    for (uint32_t n : cfg.elements)
+    {
+        switch (n)
+        {
+        case 1: run_elements<int_array<1> >(cfg, results); break;
+        case 2: run_elements<int_array<2> >(cfg, results); break;
+        case 4: run_elements<int_array<4> >(cfg, results); break;
+        case 8: run_elements<int_array<8> >(cfg, results); break;
+        case 16: run_elements<int_array<16> >(cfg, results); break;
+        case 32: run_elements<int_array<32> >(cfg, results); break;
+        case 64: run_elements<int_array<64> >(cfg, results); break;
+        default:
+            cerr << "int_array<" << n << "> not available, skipped\n";
+        };
+    };
+};
+
+//---------------------------------------------------------------------------
+//                          O U T P U T
+//---------------------------------------------------------------------------
+void write_csv(ostream &out, const vector<result_t> &results)
+{
+    out << "algorithm,distribution,element_bytes,threads,elements,"
+           "median_s,p95_s,min_s,sorted\n";
+    for (const result_t &R : results)
+    {
+        out << R.algorithm << "," << R.distribution << "," << R.element_bytes
+            << "," << R.threads << "," << R.nelem << "," << R.median << ","
+            << R.p95 << "," << R.min << "," << (R.sorted ? "true" : "false")
+            << "\n";
+    };
+};
+
+void write_json(ostream &out, const config_t &cfg,
+                const vector<result_t> &results)
+{
+    out << "{\n  \"size\": " << cfg.size << ",\n  \"reps\": " << cfg.reps
+        << ",\n  \"warmup\": " << cfg.warmup << ",\n  \"seed\": " << cfg.seed
+        << ",\n  \"hardware_threads\": " << thread::hardware_concurrency()
+        << ",\n  \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const result_t &R = results[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"algorithm\": \""
+            << R.algorithm << "\", \"distribution\": \"" << R.distribution
+            << "\", \"element_bytes\": " << R.element_bytes
+            << ", \"threads\": " << R.threads << ", \"elements\": " << R.nelem
+            << ", \"median_s\": " << R.median << ", \"p95_s\": " << R.p95
+            << ", \"min_s\": " << R.min << ", \"sorted\": "
+            << (R.sorted ? "true" : "false") << "}";
+    };
+    out << "\n  ]\n}\n";
+};
+
+//---------------------------------------------------------------------------
+//                     C O M M A N D   L I N E
+//---------------------------------------------------------------------------
+vector<string> split(const string &text)
+{
+    vector<string> V;
+    stringstream ss(text);
+    string item;
+    while (getline(ss, item, ','))
+        if (not item.empty()) V.push_back(item);
+    return V;
+};
+
+vector<uint32_t> split_numbers(const string &text)
+{
+    vector<uint32_t> V;
+    for (const string &item : split(text))
+    {
+        if (item == "hw")
+            V.push_back(std::max(1u, thread::hardware_concurrency()));
+        else
+            V.push_back(uint32_t(strtoul(item.c_str(), nullptr, 10)));
+    };
+    return V;
+};
+
+void usage(const char *name)
+{
+    cerr << "usage: " << name << " [options]\n"
+         << "  --size N            elements of 8 bytes (default 1000000);\n"
+         << "                      larger elements use N * 8 / bytes\n"
+         << "  --reps N            timed runs of each sort (default 5)\n"
+         << "  --warmup N          runs before the timed ones (default 1)\n"
+         << "  --elements 1,4,16   int_array sizes, of 1 2 4 8 16 32 64\n"
+         << "  --threads 1,2,hw    threads of the parallel sorts\n"
+         << "                      (default 1,hw)\n"
+         << "  --algorithms a,b    only these sorts\n"
+         << "  --distributions a,b only these of random, sorted, reverse,\n"
+         << "                      sorted_end, sorted_middle, duplicates, "
+            "zipf\n"
+         << "  --seed N            seed of the data (default 1)\n"
+         << "  --format json|csv   output format (default json)\n"
+         << "  --output FILE       write the results to FILE\n";
+};
+
+int main(int argc, char *argv[])
+{
+    config_t cfg;
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        if (i + 1 == argc)
+        {
+            usage(argv[0]);
+            return 1;
+        };
+        string value = argv[++i];
+        if (arg == "--size") cfg.size = strtoull(value.c_str(), nullptr, 10);
+        else if (arg == "--reps") cfg.reps = uint32_t(atoi(value.c_str()));
+        else if (arg == "--warmup") cfg.warmup = uint32_t(atoi(value.c_str()));
+        else if (arg == "--elements") cfg.elements = split_numbers(value);
+        else if (arg == "--threads") cfg.threads = split_numbers(value);
+        else if (arg == "--algorithms") cfg.algorithms = split(value);
+        else if (arg == "--distributions") cfg.distributions = split(value);
+        else if (arg == "--seed") cfg.seed = strtoull(value.c_str(), nullptr, 10);
+        else if (arg == "--format") cfg.csv = (value == "csv");
+        else if (arg == "--output") cfg.output = value;
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        };
+    };
+    if (cfg.threads.empty()) cfg.threads = split_numbers("1,hw");
+    std::sort(cfg.threads.begin(), cfg.threads.end());
+    cfg.threads.erase(std::unique(cfg.threads.begin(), cfg.threads.end()),
+                      cfg.threads.end());
+    if (cfg.reps == 0 or cfg.size == 0)
+    {
+        usage(argv[0]);
+        return 1;
+    };
+
+    vector<result_t> results;
+    run_all(cfg, results);
+
+    ofstream file;
+    if (not cfg.output.empty()) file.open(cfg.output.c_str());
+    ostream &out = cfg.output.empty() ? cout : file;
+    out.precision(6);
+    if (cfg.csv)
+        write_csv(out, results);
+    else
+        write_json(out, cfg, results);
+
+    for (const result_t &R : results)
+        if (not R.sorted) return 2;
+    return 0;
+};
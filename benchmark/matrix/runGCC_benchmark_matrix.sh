@@ -0,0 +1,23 @@
+clear
+echo "=================================================================="
+echo "==              B E N C H M A R K   M A T R I X                 =="
+echo "==                                                              =="
+echo "==                 G C C      C O M P I L E R                   =="
+echo "=================================================================="
+echo "."
+echo "C O M P I L I N G . . . . . . . . . . ."
+
+g++ ./benchmark_matrix.cpp -std=c++11 -march=native -w -fexceptions -O3 -I../../include -pthread -s  -o benchmark_matrix -lpthread
+echo "."
+echo "R U N N I N G . . . . . . . . . . ."
+echo "( The time needed is around 60 minutes depending of your machine )"
+echo "."
+date
+./benchmark_matrix --size 10000000 --elements 1,4,16,64 --output benchmark_matrix.json "$@"
+date
+echo "."
+rm benchmark_matrix
+echo "."
+echo "The results are in benchmark_matrix.json"
+echo "E N D"
+echo "."
@@ -0,0 +1,29 @@
+// spreadsort calibration example
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/sort for library home page.
+
+#include <boost/sort/spreadsort/calibrate.hpp>
+#include <stdio.h>
+#include <stdlib.h>
+using namespace boost::sort::spreadsort;
+
+//Pass in the name of the profile, and optionally the sample size.
+//The profile is measured and written the first time, and read afterwards;
+//set BOOST_SORT_TUNING_PROFILE to its name to use it in other programs.
+int main(int argc, const char ** argv) {
+  const char * profile = argc > 1 ? argv[1] : "spreadsort.profile";
+  size_t sampleSize = argc > 2 ? size_t(atol(argv[2])) : size_t(1) << 20;
+  tuning values = calibrate(profile, sampleSize);
+  printf("%s\n", profile);
+  printf("max_splits %u\n", values.max_splits);
+  printf("int_log_mean_bin_size %u\n", values.int_log_mean_bin_size);
+  printf("int_log_min_split_count %u\n", values.int_log_min_split_count);
+  printf("float_log_mean_bin_size %u\n", values.float_log_mean_bin_size);
+  printf("float_log_min_split_count %u\n", values.float_log_min_split_count);
+  printf("min_sort_size %u\n", values.min_sort_size);
+  return 0;
+}
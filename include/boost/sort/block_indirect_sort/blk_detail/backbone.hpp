@@ -18,10 +18,13 @@
 #include <boost/sort/pdqsort/pdqsort.hpp>
 #include <boost/sort/common/util/atomic.hpp>
 #include <boost/sort/common/util/algorithm.hpp>
-#include <boost/sort/common/stack_cnc.hpp>
+#include <boost/sort/common/scheduler_ws.hpp>
+#include <boost/sort/common/inplace_function.hpp>
 #include <future>
 #include <iostream>
 #include <iterator>
+#include <memory>
+#include <vector>
 
 #include <boost/sort/block_indirect_sort/blk_detail/block.hpp>
 
@@ -37,16 +40,18 @@ namespace blk_detail
 //---------------------------------------------------------------------------
 namespace bsc = boost::sort::common;
 namespace bscu = bsc::util;
-using bsc::stack_cnc;
+using bsc::scheduler_ws;
+using bsc::inplace_function;
 using bsc::range;
 
 ///---------------------------------------------------------------------------
 /// @struct backbone
 /// @brief This contains all the information shared betwen the classes of the
 ///        block indirect sort algorithm
-
+/// @remarks The index, the works and the internal vectors of the other
+///          classes are obtained from Allocator
 //----------------------------------------------------------------------------
-template < uint32_t Block_size, class Iter_t, class Compare >
+template < uint32_t Block_size, class Iter_t, class Compare, class Allocator >
 struct backbone
 {
     //-------------------------------------------------------------------------
@@ -57,17 +62,34 @@ struct backbone
     typedef range< size_t >                                     range_pos;
     typedef range< Iter_t >                                     range_it;
     typedef range< value_t * >                                  range_buf;
-    typedef std::function< void(void) >                         function_t;
     typedef block< Block_size, Iter_t >                         block_t;
 
+    // The works are lambdas with the this pointer, up to two iterators and a
+    // few positions and references
+    static constexpr const size_t work_size =
+                    6 * sizeof (void *) + 2 * sizeof (Iter_t);
+    typedef inplace_function< work_size >                       function_t;
+
+    typedef std::allocator_traits< Allocator >                  traits_t;
+    typedef typename traits_t::template rebind_alloc< function_t >
+                                                                function_alloc_t;
+    typedef typename traits_t::template rebind_alloc< block_pos >
+                                                                blkpos_alloc_t;
+    typedef typename traits_t::template rebind_alloc< size_t >  size_alloc_t;
+    typedef std::vector< block_pos, blkpos_alloc_t >            vblkpos_t;
+    typedef std::vector< size_t, size_alloc_t >                 vsize_t;
+
     //------------------------------------------------------------------------
     //                V A R I A B L E S
     //------------------------------------------------------------------------
     // range with all the element to sort
     range< Iter_t > global_range;
 
+    // allocator of the internal data structures
+    Allocator alloc;
+
     // index vector of block_pos elements
-    std::vector< block_pos > index;
+    vblkpos_t index;
 
     // Number of elements to sort
     size_t nelem;
@@ -87,8 +109,9 @@ struct backbone
     // thread local varible. It is a pointer to the buffer
     static thread_local value_t *buf;
 
-    // concurrent stack where store the function_t elements
-    stack_cnc< function_t > works;
+    // work stealing scheduler where store the function_t elements, with a
+    // deque for each thread
+    scheduler_ws< function_t, function_alloc_t > works;
 
     // global indicator of error
     bool error;
@@ -96,7 +119,8 @@ struct backbone
     //------------------------------------------------------------------------
     //                F U N C T I O N S
     //------------------------------------------------------------------------
-    backbone (Iter_t first, Iter_t last, Compare comp);
+    backbone (Iter_t first, Iter_t last, Compare comp,
+              const Allocator &alloc1);
 
     //------------------------------------------------------------------------
     //  function : get_block
@@ -133,7 +157,8 @@ struct backbone
     //-------------------------------------------------------------------------
     //  function : exec
     /// @brief Initialize the thread local buffer with the ptr_buf pointer,
-    ///        and begin with the execution of the functions stored in works
+    ///        attach the thread as worker of works, and begin with the
+    ///        execution of the functions stored in works
     //
     /// @param ptr_buf : Pointer to the memory assigned to the thread_local
     ///                  buffer
@@ -143,6 +168,8 @@ struct backbone
     void exec (value_t *ptr_buf, atomic_t &counter)
     {
         buf = ptr_buf;
+        typename scheduler_ws< function_t, function_alloc_t >::worker
+            wk (works);
         exec (counter);
     };
 
@@ -161,9 +188,9 @@ struct backbone
 //############################################################################
 //
 // initialization of the thread_local pointer to the auxiliary buffer
-template < uint32_t Block_size, class Iter_t, class Compare >
+template < uint32_t Block_size, class Iter_t, class Compare, class Allocator >
 thread_local typename std::iterator_traits< Iter_t >
-::value_type *backbone< Block_size, Iter_t, Compare >::buf = nullptr;
+::value_type *backbone< Block_size, Iter_t, Compare, Allocator >::buf = nullptr;
 
 //------------------------------------------------------------------------
 //  function : backbone
@@ -173,11 +200,13 @@ thread_local typename std::iterator_traits< Iter_t >
 /// @param last : iterator after the last element to the range to sort
 /// @param comp : object for to compare two elements pointed by Iter_t
 ///               iterators
+/// @param alloc1 : allocator of the internal data structures
 //------------------------------------------------------------------------
-template < uint32_t Block_size, class Iter_t, class Compare >
-backbone< Block_size, Iter_t, Compare >
-::backbone (Iter_t first, Iter_t last, Compare comp)
-: global_range (first, last), cmp (comp), error (false)
+template < uint32_t Block_size, class Iter_t, class Compare, class Allocator >
+backbone< Block_size, Iter_t, Compare, Allocator >
+::backbone (Iter_t first, Iter_t last, Compare comp, const Allocator &alloc1)
+: global_range (first, last), alloc (alloc1), index (blkpos_alloc_t (alloc1)),
+  cmp (comp), works (0, function_alloc_t (alloc1)), error (false)
 {
     assert ((last - first) >= 0);
     if (first == last) return; // nothing to do
@@ -200,8 +229,9 @@ backbone< Block_size, Iter_t, Compare >
 //
 /// @param counter : atomic counter. When 0 exits the function
 //-------------------------------------------------------------------------
-template < uint32_t Block_size, class Iter_t, class Compare >
-void backbone< Block_size, Iter_t, Compare >::exec (atomic_t &counter)
+template < uint32_t Block_size, class Iter_t, class Compare, class Allocator >
+void backbone< Block_size, Iter_t, Compare, Allocator >
+::exec (atomic_t &counter)
 {
     function_t func_exec;
     while (bscu::atomic_read (counter) != 0)
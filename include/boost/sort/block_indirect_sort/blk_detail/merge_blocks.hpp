@@ -41,7 +41,8 @@ using bsc::merge_uncontiguous;
 /// @brief This class merge the blocks. The blocks to merge are defined by two
 ///        ranges of positions in the index of the backbone
 //----------------------------------------------------------------------------
-template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare>
+template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare,
+         class Allocator>
 struct merge_blocks
 {
     //-----------------------------------------------------------------------
@@ -52,8 +53,8 @@ struct merge_blocks
     typedef range<size_t> range_pos;
     typedef range<Iter_t> range_it;
     typedef range<value_t *> range_buf;
-    typedef std::function<void(void)> function_t;
-    typedef backbone<Block_size, Iter_t, Compare> backbone_t;
+    typedef backbone<Block_size, Iter_t, Compare, Allocator> backbone_t;
+    typedef typename backbone_t::vblkpos_t vblkpos_t;
     typedef compare_block_pos<Block_size, Iter_t, Compare> compare_block_pos_t;
 
     //------------------------------------------------------------------------
@@ -69,8 +70,7 @@ struct merge_blocks
     merge_blocks(backbone_t &bkb, size_t pos_index1, size_t pos_index2,
                     size_t pos_index3);
 
-    void tail_process(std::vector<block_pos> &vblkpos1,
-                    std::vector<block_pos> &vblkpos2);
+    void tail_process(vblkpos_t &vblkpos1, vblkpos_t &vblkpos2);
 
     void cut_range(range_pos rng);
 
@@ -95,7 +95,7 @@ struct merge_blocks
                     bool &error)
     {
         bscu::atomic_add(counter, 1);
-        function_t f1 = [this, rng_input, &counter, &error]( ) -> void
+        bk.works.emplace_back([this, rng_input, &counter, &error]( ) -> void
         {
             if (not error)
             {
@@ -109,8 +109,7 @@ struct merge_blocks
                 };
             }
             bscu::atomic_sub (counter, 1);
-        };
-        bk.works.emplace_back(f1);
+        });
     }
     ;
     //
@@ -130,7 +129,7 @@ struct merge_blocks
                     bool &error)
     {
         bscu::atomic_add(counter, 1);
-        function_t f1 = [this, rng_input, &counter, &error]( ) -> void
+        bk.works.emplace_back([this, rng_input, &counter, &error]( ) -> void
         {
             if (not error)
             {
@@ -144,8 +143,7 @@ struct merge_blocks
                 };
             }
             bscu::atomic_sub (counter, 1);
-        };
-        bk.works.emplace_back(f1);
+        });
     }
 
 
@@ -174,8 +172,9 @@ struct merge_blocks
 ///                     of the second range in the index
 /// @param pos_index3 : last position of the second range in the index
 //-------------------------------------------------------------------------
-template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare>
-merge_blocks<Block_size, Group_size, Iter_t, Compare>
+template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare,
+         class Allocator>
+merge_blocks<Block_size, Group_size, Iter_t, Compare, Allocator>
 ::merge_blocks( backbone_t &bkb, size_t pos_index1, size_t pos_index2,
                 size_t pos_index3) : bk(bkb)
 {
@@ -186,7 +185,8 @@ merge_blocks<Block_size, Group_size, Iter_t, Compare>
     //-----------------------------------------------------------------------
     // Merging of the two intervals
     //-----------------------------------------------------------------------
-    std::vector<block_pos> vpos1, vpos2;
+    vblkpos_t vpos1(bk.index.get_allocator());
+    vblkpos_t vpos2(bk.index.get_allocator());
     vpos1.reserve(nblock1 + 1);
     vpos2.reserve(nblock2 + 1);
 
@@ -229,10 +229,10 @@ merge_blocks<Block_size, Group_size, Iter_t, Compare>
 /// @param vblkpos1 : first vector of block_pos elements to merge
 /// @param vblkpos2 : second vector of block_pos elements to merge
 //-------------------------------------------------------------------------
-template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare>
-void merge_blocks<Block_size, Group_size, Iter_t, Compare>
-::tail_process( std::vector<block_pos> &vblkpos1,
-                std::vector<block_pos> &vblkpos2 )
+template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare,
+         class Allocator>
+void merge_blocks<Block_size, Group_size, Iter_t, Compare, Allocator>
+::tail_process(vblkpos_t &vblkpos1, vblkpos_t &vblkpos2)
 {
     if (vblkpos1.size() == 0 or vblkpos2.size() == 0) return;
 
@@ -268,8 +268,9 @@ void merge_blocks<Block_size, Group_size, Iter_t, Compare>
 //
 /// @param rng_input : range to divide
 //-------------------------------------------------------------------------
-template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare>
-void merge_blocks<Block_size, Group_size, Iter_t, Compare>
+template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare,
+         class Allocator>
+void merge_blocks<Block_size, Group_size, Iter_t, Compare, Allocator>
 ::cut_range(range_pos rng_input)
 {
     if (rng_input.size() < Group_size)
@@ -318,8 +319,9 @@ void merge_blocks<Block_size, Group_size, Iter_t, Compare>
 //
 /// @param rng_input : range of positions of the blocks to merge
 //-------------------------------------------------------------------------
-template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare>
-void merge_blocks<Block_size, Group_size, Iter_t, Compare>
+template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare,
+         class Allocator>
+void merge_blocks<Block_size, Group_size, Iter_t, Compare, Allocator>
 ::merge_range_pos(range_pos rng_input)
 {
     if (rng_input.size() < 2) return;
@@ -352,8 +354,9 @@ void merge_blocks<Block_size, Group_size, Iter_t, Compare>
 /// @param rpos range_input : range of the position in the index, where must
 ///                           extract the ranges to merge
 //-------------------------------------------------------------------------
-template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare>
-void merge_blocks<Block_size, Group_size, Iter_t, Compare>
+template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare,
+         class Allocator>
+void merge_blocks<Block_size, Group_size, Iter_t, Compare, Allocator>
 ::extract_ranges(range_pos range_input)
 {
     if (range_input.size() < 2) return;
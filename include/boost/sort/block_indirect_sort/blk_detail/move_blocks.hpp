@@ -36,20 +36,23 @@ namespace bsc = boost::sort::common;
 /// @brief This class move the blocks, trnasforming a logical sort by an index,
 ///        in physical sort
 //----------------------------------------------------------------------------
-template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare>
+template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare,
+         class Allocator>
 struct move_blocks
 {
     //-------------------------------------------------------------------------
     //                  D E F I N I T I O N S
     //-------------------------------------------------------------------------
-    typedef move_blocks<Block_size, Group_size, Iter_t, Compare> this_type;
+    typedef move_blocks<Block_size, Group_size, Iter_t, Compare, Allocator>
+                    this_type;
     typedef typename std::iterator_traits<Iter_t>::value_type value_t;
     typedef std::atomic<uint32_t> atomic_t;
     typedef bsc::range<size_t> range_pos;
     typedef bsc::range<Iter_t> range_it;
     typedef bsc::range<value_t *> range_buf;
-    typedef std::function<void(void)> function_t;
-    typedef backbone<Block_size, Iter_t, Compare> backbone_t;
+    typedef bsc::range<const size_t *> range_seq;
+    typedef backbone<Block_size, Iter_t, Compare, Allocator> backbone_t;
+    typedef typename backbone_t::vsize_t vsize_t;
 
     //------------------------------------------------------------------------
     //                V A R I A B L E S
@@ -63,27 +66,28 @@ struct move_blocks
     //------------------------------------------------------------------------
     move_blocks(backbone_t &bkb);
 
-    void move_sequence(const std::vector<size_t> &init_sequence);
+    void move_sequence(range_seq init_sequence);
 
-    void move_long_sequence(const std::vector<size_t> &init_sequence);
+    void move_long_sequence(range_seq init_sequence);
     //
     //------------------------------------------------------------------------
     //  function : function_move_sequence
     /// @brief create a function_t with a call to move_sequence, and insert
     ///        in the stack of the backbone
     ///
-    /// @param sequence :sequence of positions for to move the blocks
+    /// @param sequence :sequence of positions for to move the blocks. It
+    ///                  must exist until the end of the function_t
     /// @param counter : atomic variable which is decremented when finish
     ///                  the function. This variable is used for to know
     ///                  when are finished all the function_t created
     ///                  inside an object
     /// @param error : global indicator of error.
     //------------------------------------------------------------------------
-    void function_move_sequence(std::vector<size_t> &sequence,
-                                atomic_t &counter, bool &error)
+    void function_move_sequence(range_seq sequence, atomic_t &counter,
+                                bool &error)
     {
         bscu::atomic_add(counter, 1);
-        function_t f1 = [this, sequence, &counter, &error]( ) -> void
+        bk.works.emplace_back([this, sequence, &counter, &error]( ) -> void
         {
             if (not error)
             {
@@ -97,8 +101,7 @@ struct move_blocks
                 };
             }
             bscu::atomic_sub (counter, 1);
-        };
-        bk.works.emplace_back(f1);
+        });
     }
 
     //
@@ -107,18 +110,19 @@ struct move_blocks
     /// @brief create a function_t with a call to move_long_sequence, and
     ///        insert in the stack of the backbone
     //
-    /// @param sequence :sequence of positions for to move the blocks
+    /// @param sequence :sequence of positions for to move the blocks. It
+    ///                  must exist until the end of the function_t
     /// @param counter : atomic variable which is decremented when finish
     ///                  the function. This variable is used for to know
     ///                  when are finished all the function_t created
     ///                  inside an object
     /// @param error : global indicator of error.
     //------------------------------------------------------------------------
-    void function_move_long_sequence(std::vector<size_t> &sequence,
-                                     atomic_t &counter, bool &error)
+    void function_move_long_sequence(range_seq sequence, atomic_t &counter,
+                                     bool &error)
     {
         bscu::atomic_add(counter, 1);
-        function_t f1 = [this, sequence, &counter, &error]( ) -> void
+        bk.works.emplace_back([this, sequence, &counter, &error]( ) -> void
         {
             if (not error)
             {
@@ -132,8 +136,7 @@ struct move_blocks
                 };
             }
             bscu::atomic_sub (counter, 1);
-        };
-        bk.works.emplace_back(f1);
+        });
     }
     ;
 //---------------------------------------------------------------------------
@@ -155,13 +158,15 @@ struct move_blocks
 //
 /// @param bkb : backbone with the index and the blocks
 //-------------------------------------------------------------------------
-template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare>
-move_blocks<Block_size, Group_size, Iter_t, Compare>
+template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare,
+         class Allocator>
+move_blocks<Block_size, Group_size, Iter_t, Compare, Allocator>
 ::move_blocks(backbone_t &bkb) : bk(bkb)
 {
-    std::vector<std::vector<size_t> > vsequence;
-    vsequence.reserve(bk.index.size() >> 1);
-    std::vector<size_t> sequence;
+    // The sequences are stored one after other. Each position of the index
+    // is in only one sequence, and the vector is never reallocated
+    vsize_t vsequence(typename vsize_t::allocator_type(bk.alloc));
+    vsequence.reserve(bk.index.size());
     atomic_t counter(0);
 
     size_t pos_index_ini = 0, pos_index_src = 0, pos_index_dest = 0;
@@ -175,29 +180,30 @@ move_blocks<Block_size, Group_size, Iter_t, Compare>
 
         if (pos_index_ini == bk.index.size()) break;
 
-        sequence.clear();
+        size_t pos_seq = vsequence.size();
         pos_index_src = pos_index_dest = pos_index_ini;
-        sequence.push_back(pos_index_ini);
+        vsequence.push_back(pos_index_ini);
 
         while (bk.index[pos_index_dest].pos() != pos_index_ini)
         {
             pos_index_src = bk.index[pos_index_dest].pos();
-            sequence.push_back(pos_index_src);
+            vsequence.push_back(pos_index_src);
 
             bk.index[pos_index_dest].set_pos(pos_index_dest);
             pos_index_dest = pos_index_src;
         };
 
         bk.index[pos_index_dest].set_pos(pos_index_dest);
-        vsequence.push_back(sequence);
+        range_seq sequence(vsequence.data() + pos_seq,
+                           vsequence.data() + vsequence.size());
 
         if (sequence.size() < Group_size)
         {
-            function_move_sequence(vsequence.back(), counter, bk.error);
+            function_move_sequence(sequence, counter, bk.error);
         }
         else
         {
-            function_move_long_sequence(vsequence.back(), counter, bk.error);
+            function_move_long_sequence(sequence, counter, bk.error);
         };
     };
     bk.exec(counter);
@@ -208,22 +214,23 @@ move_blocks<Block_size, Group_size, Iter_t, Compare>
 //  function : move_sequence
 /// @brief move the blocks, following the positions of the init_sequence
 //
-/// @param init_sequence : vector with the positions from and where move the
+/// @param init_sequence : range with the positions from and where move the
 ///                        blocks
 //-------------------------------------------------------------------------
-template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare>
-void move_blocks<Block_size, Group_size, Iter_t, Compare>
-::move_sequence(const std::vector<size_t> &init_sequence)
+template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare,
+         class Allocator>
+void move_blocks<Block_size, Group_size, Iter_t, Compare, Allocator>
+::move_sequence(range_seq init_sequence)
 {
     range_buf rbuf = bk.get_range_buf();
-    size_t pos_range2 = init_sequence[0];
+    size_t pos_range2 = init_sequence.first[0];
 
     range_it range2 = bk.get_range(pos_range2);
     move_forward(rbuf, range2);
 
     for (size_t i = 1; i < init_sequence.size(); ++i)
     {
-        pos_range2 = init_sequence[i];
+        pos_range2 = init_sequence.first[i];
         range_it range1(range2);
         range2 = bk.get_range(pos_range2);
         move_forward(range1, range2);
@@ -238,12 +245,13 @@ void move_blocks<Block_size, Group_size, Iter_t, Compare>
 ///        sequences, creating function_t elements, for to be inserted in the
 ///        concurrent stack
 //
-/// @param init_sequence : vector with the positions from and where move the
+/// @param init_sequence : range with the positions from and where move the
 ///                        blocks
 //-------------------------------------------------------------------------
-template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare>
-void move_blocks<Block_size, Group_size, Iter_t, Compare>
-::move_long_sequence(const std::vector<size_t> &init_sequence)
+template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare,
+         class Allocator>
+void move_blocks<Block_size, Group_size, Iter_t, Compare, Allocator>
+::move_long_sequence(range_seq init_sequence)
 {
     if (init_sequence.size() < Group_size) return move_sequence(init_sequence);
 
@@ -251,27 +259,25 @@ void move_blocks<Block_size, Group_size, Iter_t, Compare>
     size_t size_part = init_sequence.size() / npart;
     atomic_t son_counter(0);
 
-    std::vector<size_t> sequence;
-    sequence.reserve(size_part);
-
-    std::vector<size_t> index_seq;
+    vsize_t index_seq(typename vsize_t::allocator_type(bk.alloc));
     index_seq.reserve(npart);
 
-    auto it_pos = init_sequence.begin();
+    const size_t *it_pos = init_sequence.first;
     for (size_t i = 0; i < (npart - 1); ++i, it_pos += size_part)
     {
-        sequence.assign(it_pos, it_pos + size_part);
         index_seq.emplace_back(*(it_pos + size_part - 1));
-        function_move_sequence(sequence, son_counter, bk.error);
+        function_move_sequence(range_seq(it_pos, it_pos + size_part),
+                               son_counter, bk.error);
     };
 
-    sequence.assign(it_pos, init_sequence.end());
-    index_seq.emplace_back(init_sequence.back());
-    function_move_sequence(sequence, son_counter, bk.error);
+    index_seq.emplace_back(*init_sequence.back());
+    function_move_sequence(range_seq(it_pos, init_sequence.last),
+                           son_counter, bk.error);
 
     bk.exec(son_counter);
     if (bk.error) return;
-    move_long_sequence(index_seq);
+    move_long_sequence(range_seq(index_seq.data(),
+                                 index_seq.data() + index_seq.size()));
 }
 
 //
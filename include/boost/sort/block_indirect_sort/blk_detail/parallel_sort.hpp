@@ -40,7 +40,7 @@ using boost::sort::pdqsort;
 ///        splitting the data until the number of elements is smaller than a
 ///        predefined value (max_per_thread)
 //----------------------------------------------------------------------------
-template<uint32_t Block_size, class Iter_t, class Compare>
+template<uint32_t Block_size, class Iter_t, class Compare, class Allocator>
 struct parallel_sort
 {
     //-------------------------------------------------------------------------
@@ -48,8 +48,7 @@ struct parallel_sort
     //-------------------------------------------------------------------------
     typedef typename std::iterator_traits<Iter_t>::value_type value_t;
     typedef std::atomic<uint32_t> atomic_t;
-    typedef std::function<void(void)> function_t;
-    typedef backbone<Block_size, Iter_t, Compare> backbone_t;
+    typedef backbone<Block_size, Iter_t, Compare, Allocator> backbone_t;
 
     //------------------------------------------------------------------------
     //                V A R I A B L E S
@@ -91,7 +90,7 @@ struct parallel_sort
                               atomic_t &counter, bool &error)
     {
         bscu::atomic_add(counter, 1);
-        function_t f1 = [this, first, last, level, &counter, &error]( )
+        bk.works.emplace_back([this, first, last, level, &counter, &error]( )
         {
             if (not error)
             {
@@ -105,8 +104,7 @@ struct parallel_sort
                 };
             };
             bscu::atomic_sub (counter, 1);
-        };
-        bk.works.emplace_back(f1);
+        });
     };
 
 //--------------------------------------------------------------------------
@@ -128,8 +126,8 @@ struct parallel_sort
 /// @param [in] first : iterator to the first element to sort
 /// @param [in] last : iterator to the next element after the last
 //------------------------------------------------------------------------
-template<uint32_t Block_size, class Iter_t, class Compare>
-parallel_sort<Block_size, Iter_t, Compare>
+template<uint32_t Block_size, class Iter_t, class Compare, class Allocator>
+parallel_sort<Block_size, Iter_t, Compare, Allocator>
 ::parallel_sort(backbone_t &bkbn, Iter_t first, Iter_t last)
  : bk(bkbn), counter(0)
 {
@@ -183,8 +181,8 @@ parallel_sort<Block_size, Iter_t, Compare>
 /// @param last : iterator to the next element after the last
 /// @param level : level of depth before call to pdqsort
 //------------------------------------------------------------------------
-template<uint32_t Block_size, class Iter_t, class Compare>
-void parallel_sort<Block_size, Iter_t, Compare>
+template<uint32_t Block_size, class Iter_t, class Compare, class Allocator>
+void parallel_sort<Block_size, Iter_t, Compare, Allocator>
 ::divide_sort(Iter_t first, Iter_t last, uint32_t level)
 {
     //------------------- check if sort -----------------------------------
@@ -20,8 +20,11 @@
 #include <boost/sort/pdqsort/pdqsort.hpp>
 #include <boost/sort/common/util/traits.hpp>
 #include <boost/sort/common/util/algorithm.hpp>
+#include <boost/sort/common/thread_pool.hpp>
+#include <boost/sort/common/numa.hpp>
 #include <future>
 #include <iterator>
+#include <memory>
 
 // This value is the minimal number of threads for to use the
 // block_indirect_sort algorithm
@@ -44,6 +47,9 @@ using bscu::value_iter;
 using bsc::range;
 using bsc::destroy;
 using bsc::initialize;
+using bsc::numa_bind;
+using bsc::numa_machine;
+using bsc::numa_first_touch;
 using bscu::nbits64;
 using bs::pdqsort;
 using bscu::enable_if_string;
@@ -62,9 +68,14 @@ using bscu::tmsb;
 ///        bis/parallel_sort.hpp : make the parallel sort of each part in the
 ///                                initial division of the data
 ///
+/// @remarks The internal data structures are obtained from Allocator. With
+///          the memory for the buffers of the threads received as parameter,
+///          and an Allocator which reuses its memory, the sort doesn't use
+///          the heap
 //----------------------------------------------------------------------------
 template<uint32_t Block_size, uint32_t Group_size, class Iter_t,
-                class Compare = compare_iter<Iter_t> >
+                class Compare = compare_iter<Iter_t>,
+                class Allocator = std::allocator<value_iter<Iter_t> > >
 struct block_indirect_sort
 {
     //------------------------------------------------------------------------
@@ -75,16 +86,18 @@ struct block_indirect_sort
     typedef range<size_t> range_pos;
     typedef range<Iter_t> range_it;
     typedef range<value_t *> range_buf;
-    typedef std::function<void(void)> function_t;
 
     // classes used in the internal operations of the algorithm
     typedef block_pos block_pos_t;
     typedef block<Block_size, Iter_t> block_t;
-    typedef backbone<Block_size, Iter_t, Compare> backbone_t;
-    typedef parallel_sort<Block_size, Iter_t, Compare> parallel_sort_t;
-
-    typedef merge_blocks<Block_size, Group_size, Iter_t, Compare> merge_blocks_t;
-    typedef move_blocks<Block_size, Group_size, Iter_t, Compare> move_blocks_t;
+    typedef backbone<Block_size, Iter_t, Compare, Allocator> backbone_t;
+    typedef parallel_sort<Block_size, Iter_t, Compare, Allocator>
+                    parallel_sort_t;
+
+    typedef merge_blocks<Block_size, Group_size, Iter_t, Compare, Allocator>
+                    merge_blocks_t;
+    typedef move_blocks<Block_size, Group_size, Iter_t, Compare, Allocator>
+                    move_blocks_t;
     typedef compare_block_pos<Block_size, Iter_t, Compare> compare_block_pos_t;
     //
     //------------------------------------------------------------------------
@@ -100,16 +113,28 @@ struct block_indirect_sort
     value_t *ptr;
     // indicate if the memory pointed by ptr is initialized
     bool construct;
+    // indicate if the memory pointed by ptr had been obtained inside the
+    // algorithm, or had been received as a parameter
+    bool owner;
     // range from extract the buffers for the threads
     range_buf rglobal_buf;
     // number of threads to use
     uint32_t nthread;
+    // pool with the threads which help to the calling thread
+    thread_pool &pool;
     //
     //------------------------------------------------------------------------
     //                F U N C T I O N S
     //------------------------------------------------------------------------
 
-    block_indirect_sort(Iter_t first, Iter_t last, Compare cmp, uint32_t nthr);
+    block_indirect_sort(Iter_t first, Iter_t last, Compare cmp, uint32_t nthr,
+                        range_buf rbuf, thread_pool &pl = default_thread_pool(),
+                        const Allocator &alloc = Allocator());
+
+    block_indirect_sort(Iter_t first, Iter_t last, Compare cmp, uint32_t nthr,
+                        thread_pool &pl = default_thread_pool()) :
+                        block_indirect_sort(first, last, cmp, nthr,
+                        range_buf(nullptr, nullptr), pl) { }
 
     block_indirect_sort(Iter_t first, Iter_t last) :
                         block_indirect_sort(first, last, Compare(),
@@ -141,7 +166,7 @@ struct block_indirect_sort
                 destroy(rglobal_buf);
                 construct = false;
             };
-            std::return_temporary_buffer(ptr);
+            if (owner) std::return_temporary_buffer(ptr);
             ptr = nullptr;
         };
     }
@@ -156,6 +181,8 @@ struct block_indirect_sort
         destroy_all();
     }
 
+    static size_t required_buffer_size(size_t nelem, uint32_t nthr);
+
     void split_range(size_t pos_index1, size_t pos_index2,
                     uint32_t level_thread);
 
@@ -182,12 +209,19 @@ struct block_indirect_sort
 ///               iterators
 /// @param nthr : Number of threads to use in the process.When this value
 ///               is lower than 2, the sorting is done with 1 thread
+/// @param rbuf : uninitialized memory for the buffers of the threads. If
+///               it is smaller than required_buffer_size (nelem, nthr), the
+///               memory is obtained inside the class
+/// @param pl : pool where run the threads, except the calling thread
+/// @param alloc : allocator of the internal data structures
 //-------------------------------------------------------------------------
-template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare>
-block_indirect_sort<Block_size, Group_size, Iter_t, Compare>
-::block_indirect_sort(Iter_t first, Iter_t last, Compare cmp, uint32_t nthr)
-: bk(first, last, cmp), counter(0), ptr(nullptr), construct(false),
-  nthread(nthr)
+template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare,
+         class Allocator>
+block_indirect_sort<Block_size, Group_size, Iter_t, Compare, Allocator>
+::block_indirect_sort(Iter_t first, Iter_t last, Compare cmp, uint32_t nthr,
+                      range_buf rbuf, thread_pool &pl, const Allocator &alloc)
+: bk(first, last, cmp, alloc), counter(0), ptr(nullptr), construct(false),
+  owner(false), nthread(nthr), pool(pl)
 {
     try
     {
@@ -218,65 +252,70 @@ block_indirect_sort<Block_size, Group_size, Iter_t, Compare>
         };
 
         //---------------- check if only single thread -----------------------
-        size_t nthreadmax = nelem / (Block_size * Group_size) + 1;
-        if (nthread > nthreadmax) nthread = (uint32_t) nthreadmax;
-
-        uint32_t nbits_size = (nbits64(sizeof(value_t)) >> 1);
-        if (nbits_size > 5) nbits_size = 5;
-        size_t max_per_thread = 1 << (18 - nbits_size);
-
-        if (nelem < (max_per_thread) or nthread < 2)
+        size_t nbuf = required_buffer_size(nelem, nthread);
+        if (nbuf == 0)
         {
             //intro_sort (first, last, bk.cmp);
             pdqsort(first, last, bk.cmp);
             return;
         };
+        nthread = (uint32_t) (nbuf / Block_size);
 
         //----------- creation of the temporary buffer --------------------
-        ptr = std::get_temporary_buffer<value_t>(Block_size * nthread).first;
-        if (ptr == nullptr)
+        if (rbuf.size() >= nbuf)
+        {
+            ptr = rbuf.first;
+        }
+        else
         {
-            bk.error = true;
-            throw std::bad_alloc();
+            ptr = std::get_temporary_buffer<value_t>(nbuf).first;
+            if (ptr == nullptr)
+            {
+                bk.error = true;
+                throw std::bad_alloc();
+            };
+            owner = true;
+        };
+
+        // In NUMA mode, the buffer of each thread is placed in its node
+        // before the initialization
+        if (numa_machine().nnodes() > 1)
+        {
+            pool.run(nthread, [&](uint32_t i)
+            {
+                numa_bind nb(numa_machine().node_of(i, nthread));
+                numa_first_touch(ptr + (i * Block_size),
+                                 ptr + ((i + 1) * Block_size));
+            });
         };
 
         rglobal_buf = range_buf(ptr, ptr + (Block_size * nthread));
         initialize(rglobal_buf, *first);
         construct = true;
 
-        // creation of the buffers for the threads
-        std::vector<value_t *> vbuf(nthread);
-        for (uint32_t i = 0; i < nthread; ++i)
-        {
-            vbuf[i] = ptr + (i * Block_size);
-        };
+        // One deque of works for each thread
+        bk.works.set_nthread(nthread);
 
         // Insert the first work in the stack
         bscu::atomic_write(counter, 1);
-        function_t f1 = [&]( )
+        bk.works.emplace_back([this]( )
         {
             start_function ( );
             bscu::atomic_sub (counter, 1);
-        };
-        bk.works.emplace_back(f1);
+        });
 
         //---------------------------------------------------------------------
         //                    PROCESS
         //---------------------------------------------------------------------
-        std::vector<std::future<void> > vfuture(nthread);
-
-        // The function launched with the futures is "execute the functions of
-        // the stack until this->counter is zero
-        // vbuf[i] is the memory from the main thread for to configure the
-        // thread local buffer
-        for (uint32_t i = 0; i < nthread; ++i)
+        // Each thread, the calling thread included, "execute the functions
+        // of the stack until this->counter is zero"
+        // ptr + (i * Block_size) is the memory from the main thread for to
+        // configure the thread local buffer
+        pool.run(nthread, [&](uint32_t i)
         {
-            auto f1 = [=, &vbuf]( )
-            {   bk.exec (vbuf[i], this->counter);};
-            vfuture[i] = std::async(std::launch::async, f1);
-        };
-        for (uint32_t i = 0; i < nthread; ++i)
-            vfuture[i].get();
+            numa_bind nb(numa_machine().node_of(i, nthread));
+            bk.exec (ptr + (i * Block_size), this->counter);
+        });
         if (bk.error) throw std::bad_alloc();
     }
     catch (std::bad_alloc &)
@@ -287,6 +326,31 @@ block_indirect_sort<Block_size, Group_size, Iter_t, Compare>
 };
 //
 //-----------------------------------------------------------------------------
+//  function : required_buffer_size
+/// @brief number of elements of the memory used for the buffers of the
+///        threads, sorting nelem elements with nthr threads
+/// @param nelem : number of elements to sort
+/// @param nthr : Number of threads to use in the process
+/// @return number of elements of the buffer. When 0, the elements are sorted
+///         with 1 thread, without buffer
+//-----------------------------------------------------------------------------
+template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare,
+         class Allocator>
+size_t block_indirect_sort<Block_size, Group_size, Iter_t, Compare, Allocator>
+::required_buffer_size(size_t nelem, uint32_t nthr)
+{
+    size_t nthreadmax = nelem / (Block_size * Group_size) + 1;
+    if (nthr > nthreadmax) nthr = (uint32_t) nthreadmax;
+
+    uint32_t nbits_size = (nbits64(sizeof(value_t)) >> 1);
+    if (nbits_size > 5) nbits_size = 5;
+    size_t max_per_thread = 1 << (18 - nbits_size);
+
+    if (nelem < (max_per_thread) or nthr < 2) return 0;
+    return Block_size * size_t(nthr);
+};
+//
+//-----------------------------------------------------------------------------
 //  function : split_rage
 /// @brief this function splits a range of positions in the index, and
 ///        depending of the size, sort directly or make to a recursive call
@@ -295,8 +359,9 @@ block_indirect_sort<Block_size, Group_size, Iter_t, Compare>
 /// @param pos_index2 : position after the last in the index
 /// @param level_thread : depth of the call. When 0 sort the blocks
 //-----------------------------------------------------------------------------
-template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare>
-void block_indirect_sort<Block_size, Group_size, Iter_t, Compare>
+template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare,
+         class Allocator>
+void block_indirect_sort<Block_size, Group_size, Iter_t, Compare, Allocator>
 ::split_range(size_t pos_index1, size_t pos_index2, uint32_t level_thread)
 {
     size_t nblock = pos_index2 - pos_index1;
@@ -322,24 +387,22 @@ void block_indirect_sort<Block_size, Group_size, Iter_t, Compare>
     //-------------------------------------------------------------------------
     if (level_thread != 0)
     {
-        auto f1 = [=, &son_counter]( )
+        bk.works.emplace_back([=, &son_counter]( )
         {
             split_range (pos_index_mid, pos_index2, level_thread - 1);
             bscu::atomic_sub (son_counter, 1);
-        };
-        bk.works.emplace_back(f1);
+        });
         if (bk.error) return;
         split_range(pos_index1, pos_index_mid, level_thread - 1);
     }
     else
     {
         Iter_t mid = first + ((nblock >> 1) * Block_size);
-        auto f1 = [=, &son_counter]( )
+        bk.works.emplace_back([=, &son_counter]( )
         {
             parallel_sort_t (bk, mid, last);
             bscu::atomic_sub (son_counter, 1);
-        };
-        bk.works.emplace_back(f1);
+        });
         if (bk.error) return;
         parallel_sort_t(bk, first, mid);
     };
@@ -354,8 +417,9 @@ void block_indirect_sort<Block_size, Group_size, Iter_t, Compare>
 /// @brief this function init the process. When the number of threads is lower
 ///        than a predefined value, sort the elements with a parallel pdqsort.
 //-----------------------------------------------------------------------------
-template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare>
-void block_indirect_sort<Block_size, Group_size, Iter_t, Compare>
+template<uint32_t Block_size, uint32_t Group_size, class Iter_t, class Compare,
+         class Allocator>
+void block_indirect_sort<Block_size, Group_size, Iter_t, Compare, Allocator>
 ::start_function(void)
 {
     if (nthread < BOOST_NTHREAD_BORDER)
@@ -378,11 +442,24 @@ void block_indirect_sort<Block_size, Group_size, Iter_t, Compare>
 ///
 //----------------------------------------------------------------------------
 template <class Iter_t, class Compare,
+         class Allocator = std::allocator<value_iter<Iter_t> >,
          enable_if_string<value_iter<Iter_t>> * = nullptr>
 inline void block_indirect_sort_call(Iter_t first, Iter_t last, Compare cmp,
-                uint32_t nthr)
+                uint32_t nthr,
+                range<value_iter<Iter_t> *> rbuf =
+                    range<value_iter<Iter_t> *>(nullptr, nullptr),
+                thread_pool &pool = default_thread_pool(),
+                const Allocator &alloc = Allocator())
+{
+    block_indirect_sort<128, 128, Iter_t, Compare, Allocator>(first, last,
+                                                  cmp, nthr, rbuf, pool, alloc);
+};
+
+template <class Iter_t, enable_if_string<value_iter<Iter_t>> * = nullptr>
+inline size_t block_indirect_buffer_size_call(size_t nelem, uint32_t nthr)
 {
-    block_indirect_sort<128, 128, Iter_t, Compare>(first, last, cmp, nthr);
+    return block_indirect_sort<128, 128, Iter_t, compare_iter<Iter_t> >
+        ::required_buffer_size(nelem, nthr);
 };
 
 template<size_t Size>
@@ -402,12 +479,27 @@ struct block_size
 ///
 //----------------------------------------------------------------------------
 template <class Iter_t, class Compare,
+          class Allocator = std::allocator<value_iter<Iter_t> >,
           enable_if_not_string<value_iter<Iter_t>> * = nullptr>
 inline void block_indirect_sort_call (Iter_t first, Iter_t last, Compare cmp,
-                                      uint32_t nthr)
+                                      uint32_t nthr,
+                                      range<value_iter<Iter_t> *> rbuf =
+                                        range<value_iter<Iter_t> *>(nullptr,
+                                                                    nullptr),
+                                      thread_pool &pool = default_thread_pool(),
+                                      const Allocator &alloc = Allocator())
 {
     block_indirect_sort<block_size<sizeof (value_iter<Iter_t> )>::data, 64,
-                        Iter_t, Compare> (first, last, cmp, nthr);
+                        Iter_t, Compare, Allocator> (first, last, cmp, nthr,
+                                                     rbuf, pool, alloc);
+};
+
+template <class Iter_t, enable_if_not_string<value_iter<Iter_t>> * = nullptr>
+inline size_t block_indirect_buffer_size_call (size_t nelem, uint32_t nthr)
+{
+    return block_indirect_sort<block_size<sizeof (value_iter<Iter_t> )>::data,
+                               64, Iter_t, compare_iter<Iter_t> >
+        ::required_buffer_size(nelem, nthr);
 };
 
 //
@@ -495,6 +587,130 @@ void block_indirect_sort (Iter_t first, Iter_t last, Compare comp,
     blk_detail::block_indirect_sort_call(first, last, comp, nthread);
 }
 //
+//-----------------------------------------------------------------------------
+//  function : block_indirect_sort
+/// @brief invocation of block_indirtect_sort with 5 parameters. The fifth is
+///        the thread pool where run the threads, instead of the default pool
+///
+/// @param first : iterator to the first element of the range to sort
+/// @param last : iterator after the last element to the range to sort
+/// @param comp : object for to compare two elements pointed by Iter_t
+///               iterators
+/// @param nthread : Number of threads to use in the process, including the
+///                  calling thread. When this value is lower than 2, the
+///                  sorting is done with 1 thread
+/// @param pool : thread pool where run the works of the other threads
+//-----------------------------------------------------------------------------
+template<class Iter_t, class Compare>
+void block_indirect_sort (Iter_t first, Iter_t last, Compare comp,
+                          uint32_t nthread, thread_pool &pool)
+{
+    typedef common::range<bscu::value_iter<Iter_t> *> range_buf;
+    blk_detail::block_indirect_sort_call(first, last, comp, nthread,
+                                         range_buf(nullptr, nullptr), pool);
+}
+//
+//-----------------------------------------------------------------------------
+//  function : block_indirect_sort
+/// @brief invocation of block_indirtect_sort with 5 parameters. The fifth is
+///        the memory for the buffers of the threads, instead of obtain it in
+///        each call
+///
+/// @param first : iterator to the first element of the range to sort
+/// @param last : iterator after the last element to the range to sort
+/// @param comp : object for to compare two elements pointed by Iter_t
+///               iterators
+/// @param nthread : Number of threads to use in the process. When this value
+///                  is lower than 2, the sorting is done with 1 thread
+/// @param rbuf : uninitialized memory, with space for
+///               block_indirect_sort_buffer_size<Iter_t> (last - first,
+///               nthread) elements. When it is smaller, the memory is
+///               obtained inside the algorithm
+//-----------------------------------------------------------------------------
+template<class Iter_t, class Compare>
+void block_indirect_sort (Iter_t first, Iter_t last, Compare comp,
+                          uint32_t nthread,
+                          common::range<bscu::value_iter<Iter_t> *> rbuf)
+{
+    blk_detail::block_indirect_sort_call(first, last, comp, nthread, rbuf);
+}
+//
+//-----------------------------------------------------------------------------
+//  function : block_indirect_sort
+/// @brief invocation of block_indirtect_sort with 6 parameters, with the
+///        memory for the buffers of the threads and the thread pool
+///
+/// @param first : iterator to the first element of the range to sort
+/// @param last : iterator after the last element to the range to sort
+/// @param comp : object for to compare two elements pointed by Iter_t
+///               iterators
+/// @param nthread : Number of threads to use in the process, including the
+///                  calling thread. When this value is lower than 2, the
+///                  sorting is done with 1 thread
+/// @param rbuf : uninitialized memory, with space for
+///               block_indirect_sort_buffer_size<Iter_t> (last - first,
+///               nthread) elements. When it is smaller, the memory is
+///               obtained inside the algorithm
+/// @param pool : thread pool where run the works of the other threads
+//-----------------------------------------------------------------------------
+template<class Iter_t, class Compare>
+void block_indirect_sort (Iter_t first, Iter_t last, Compare comp,
+                          uint32_t nthread,
+                          common::range<bscu::value_iter<Iter_t> *> rbuf,
+                          thread_pool &pool)
+{
+    blk_detail::block_indirect_sort_call(first, last, comp, nthread, rbuf,
+                                         pool);
+}
+//
+//-----------------------------------------------------------------------------
+//  function : block_indirect_sort
+/// @brief invocation of block_indirtect_sort with 7 parameters, with the
+///        memory for the buffers of the threads, the thread pool and the
+///        allocator of the internal data structures
+///
+/// @param first : iterator to the first element of the range to sort
+/// @param last : iterator after the last element to the range to sort
+/// @param comp : object for to compare two elements pointed by Iter_t
+///               iterators
+/// @param nthread : Number of threads to use in the process, including the
+///                  calling thread. When this value is lower than 2, the
+///                  sorting is done with 1 thread
+/// @param rbuf : uninitialized memory, with space for
+///               block_indirect_sort_buffer_size<Iter_t> (last - first,
+///               nthread) elements. When it is smaller, the memory is
+///               obtained inside the algorithm
+/// @param pool : thread pool where run the works of the other threads
+/// @param alloc : allocator for the index, the works and the other internal
+///                data structures. With rbuf big enough and an allocator
+///                which reuses its memory, as an arena, the sort doesn't
+///                allocate memory from the heap
+//-----------------------------------------------------------------------------
+template<class Iter_t, class Compare, class Allocator>
+void block_indirect_sort (Iter_t first, Iter_t last, Compare comp,
+                          uint32_t nthread,
+                          common::range<bscu::value_iter<Iter_t> *> rbuf,
+                          thread_pool &pool, const Allocator &alloc)
+{
+    blk_detail::block_indirect_sort_call(first, last, comp, nthread, rbuf,
+                                         pool, alloc);
+}
+//
+//-----------------------------------------------------------------------------
+//  function : block_indirect_sort_buffer_size
+/// @brief number of elements of the memory used by block_indirect_sort for
+///        the buffers of the threads
+///
+/// @param nelem : number of elements to sort
+/// @param nthread : Number of threads to use in the process
+/// @return number of elements. When 0, the sort doesn't need memory
+//-----------------------------------------------------------------------------
+template<class Iter_t>
+size_t block_indirect_sort_buffer_size (size_t nelem, uint32_t nthread)
+{
+    return blk_detail::block_indirect_buffer_size_call<Iter_t>(nelem, nthread);
+}
+//
 //****************************************************************************
 }; //    End namespace sort
 }; //    End namespace boost
@@ -0,0 +1,259 @@
+//----------------------------------------------------------------------------
+/// @file   deque_ws.hpp
+/// @brief  This file contains the implementation of a Chase-Lev work
+///         stealing deque
+///
+///         Distributed under the Boost Software License, Version 1.0.\n
+///         ( See accompanying file LICENSE_1_0.txt or copy at
+///           http://www.boost.org/LICENSE_1_0.txt  )
+/// @version 0.1
+///
+/// @remarks The algorithm is from "Correct and Efficient Work-Stealing for
+///          Weak Memory Models", by N.M. Le, A. Pop, A. Cohen and
+///          F. Zappa Nardelli (PPoPP 2013), with the seq_cst fences replaced
+///          by seq_cst operations on top and bottom
+//-----------------------------------------------------------------------------
+#ifndef __BOOST_SORT_PARALLEL_DETAIL_UTIL_DEQUE_WS_HPP
+#define __BOOST_SORT_PARALLEL_DETAIL_UTIL_DEQUE_WS_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+namespace boost
+{
+namespace sort
+{
+namespace common
+{
+
+//
+//###########################################################################
+//                                                                         ##
+//    ################################################################     ##
+//    #                                                              #     ##
+//    #                      C L A S S                               #     ##
+//    #                    D E Q U E _ W S                           #     ##
+//    #                                                              #     ##
+//    ################################################################     ##
+//                                                                         ##
+//###########################################################################
+//
+//---------------------------------------------------------------------------
+/// @class  deque_ws
+/// @brief This class is a lock free deque of pointers to T. The owner thread
+///        push and pop at the bottom, as in a stack, and the other threads
+///        steal from the top, taking the oldest elements
+/// @remarks Only the owner thread can call push and pop. The deque doesn't
+///          own the pointed elements
+/// @remarks The arrays are obtained from Allocator
+//---------------------------------------------------------------------------
+template<class T, class Allocator = std::allocator<T> >
+class deque_ws
+{
+    //------------------------------------------------------------------------
+    //                     D E F I N I T I O N S
+    //------------------------------------------------------------------------
+    typedef std::atomic<T *> slot_t;
+
+    // circular array with a power of two size
+    struct array_t
+    {
+        int64_t mask;
+        slot_t *slot;
+        // previous array, replaced by this
+        array_t *prev;
+
+        int64_t size(void) const { return mask + 1; };
+
+        T *get(int64_t pos) const
+        {
+            return slot[pos & mask].load(std::memory_order_relaxed);
+        };
+
+        void put(int64_t pos, T *ptr)
+        {
+            slot[pos & mask].store(ptr, std::memory_order_relaxed);
+        };
+    };
+
+    //-------------------------------------------------------------------------
+    //                   INTERNAL VARIABLES
+    //-------------------------------------------------------------------------
+    // top and bottom in different cache lines, the first is written by the
+    // thieves and the second only by the owner
+    std::atomic<int64_t> top;
+    char pad[64];
+    std::atomic<int64_t> bottom;
+    std::atomic<array_t *> array;
+
+    typedef typename std::allocator_traits<Allocator>::template
+                    rebind_alloc<array_t> array_alloc_t;
+    typedef typename std::allocator_traits<Allocator>::template
+                    rebind_alloc<slot_t> slot_alloc_t;
+
+    array_alloc_t array_alloc;
+    slot_alloc_t slot_alloc;
+
+    //-------------------------------------------------------------------------
+    //  function : create
+    /// @brief Create an empty array
+    /// @param size : number of elements, must be a power of two
+    /// @param prev : array replaced by the new one
+    //-------------------------------------------------------------------------
+    array_t *create(int64_t size, array_t *prev)
+    {
+        slot_t *slot = std::allocator_traits<slot_alloc_t>::allocate(
+                        slot_alloc, (size_t) size);
+        array_t *a;
+        try
+        {
+            a = std::allocator_traits<array_alloc_t>::allocate(array_alloc, 1);
+        }
+        catch (...)
+        {
+            std::allocator_traits<slot_alloc_t>::deallocate(slot_alloc, slot,
+                                                            (size_t) size);
+            throw;
+        };
+        for (int64_t i = 0; i < size; ++i) ::new (slot + i) slot_t(nullptr);
+        ::new (a) array_t;
+        a->mask = size - 1;
+        a->slot = slot;
+        a->prev = prev;
+        return a;
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : grow
+    /// @brief Replace the array by other with double size, copying the
+    ///        elements between t and b. The replaced array is kept until the
+    ///        destruction, because a thief can still be reading it
+    //-------------------------------------------------------------------------
+    array_t *grow(array_t *a, int64_t t, int64_t b)
+    {
+        array_t *a2 = create(a->size() << 1, a);
+        for (int64_t i = t; i < b; ++i) a2->put(i, a->get(i));
+        array.store(a2, std::memory_order_release);
+        return a2;
+    };
+
+public:
+    //
+    //-------------------------------------------------------------------------
+    //  function : deque_ws
+    /// @brief  constructor
+    /// @param [in] size : initial capacity, must be a power of two
+    /// @param [in] alloc : allocator of the arrays
+    //-------------------------------------------------------------------------
+    explicit deque_ws(int64_t size = 256, const Allocator &alloc = Allocator())
+    : top(0), bottom(0), array_alloc(alloc), slot_alloc(alloc)
+    {
+        array.store(create(size, nullptr), std::memory_order_relaxed);
+    };
+
+    deque_ws(const deque_ws &) = delete;
+    deque_ws &operator=(const deque_ws &) = delete;
+
+    //
+    //-------------------------------------------------------------------------
+    //  function : ~deque_ws
+    /// @brief  Destructor. Return the arrays to the allocator
+    //-------------------------------------------------------------------------
+    ~deque_ws(void)
+    {
+        array_t *a = array.load(std::memory_order_relaxed);
+        while (a != nullptr)
+        {
+            array_t *prev = a->prev;
+            for (int64_t i = 0; i < a->size(); ++i) a->slot[i].~slot_t();
+            std::allocator_traits<slot_alloc_t>::deallocate(
+                            slot_alloc, a->slot, (size_t) a->size());
+            std::allocator_traits<array_alloc_t>::deallocate(array_alloc, a, 1);
+            a = prev;
+        };
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : push
+    /// @brief Insert a pointer at the bottom. Only called by the owner
+    /// @param ptr : pointer to insert
+    //-------------------------------------------------------------------------
+    void push(T *ptr)
+    {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        array_t *a = array.load(std::memory_order_relaxed);
+        if (b - t > a->size() - 1) a = grow(a, t, b);
+        a->put(b, ptr);
+        bottom.store(b + 1, std::memory_order_release);
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : pop
+    /// @brief Extract the pointer at the bottom. Only called by the owner
+    /// @return pointer extracted, nullptr if the deque is empty
+    //-------------------------------------------------------------------------
+    T *pop(void)
+    {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        array_t *a = array.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_seq_cst);
+        if (t > b)
+        {   // empty
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        };
+        T *ptr = a->get(b);
+        if (t == b)
+        {   // last element, compete with the thieves
+            if (not top.compare_exchange_strong(t, t + 1,
+                                                std::memory_order_seq_cst,
+                                                std::memory_order_relaxed))
+                ptr = nullptr;
+            bottom.store(b + 1, std::memory_order_relaxed);
+        };
+        return ptr;
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : steal
+    /// @brief Extract the pointer at the top. Can be called by any thread
+    /// @return pointer extracted, nullptr if the deque is empty or other
+    ///         thread took the element first
+    //-------------------------------------------------------------------------
+    T *steal(void)
+    {
+        int64_t t = top.load(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_seq_cst);
+        if (t >= b) return nullptr;
+        array_t *a = array.load(std::memory_order_acquire);
+        T *ptr = a->get(t);
+        if (not top.compare_exchange_strong(t, t + 1,
+                                            std::memory_order_seq_cst,
+                                            std::memory_order_relaxed))
+            return nullptr;
+        return ptr;
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : empty
+    /// @brief Indicate if the deque seems empty. Only exact when there is no
+    ///        concurrent access
+    //-------------------------------------------------------------------------
+    bool empty(void) const
+    {
+        return bottom.load(std::memory_order_relaxed) <=
+               top.load(std::memory_order_relaxed);
+    };
+};
+// end class deque_ws
+
+//***************************************************************************
+};// end namespace common
+};// end namespace sort
+};// end namespace boost
+//***************************************************************************
+#endif
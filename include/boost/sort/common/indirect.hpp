@@ -15,8 +15,13 @@
 
 //#include <boost/sort/common/atomic.hpp>
 #include <boost/sort/common/util/traits.hpp>
+#include <boost/sort/common/thread_pool.hpp>
+#include <cassert>
+#include <ciso646>
 #include <functional>
 #include <iterator>
+#include <memory>
+#include <new>
 #include <type_traits>
 #include <vector>
 
@@ -129,7 +134,93 @@ static void sort_index(Iter_t global_first, std::vector<Iter_t> &index)
     };
 };
 
-template<class func, class Iter_t, class Compare = compare_iter<Iter_t> >
+//
+// minimun number of elements for to apply a permutation in parallel
+static const size_t permutation_nelem_min = (1 << 14);
+//
+//-----------------------------------------------------------------------------
+//  function : parallel_apply_permutation
+/// @brief Move to each position pos the element in the position source(pos),
+///        with several threads. Each thread gathers a part of the elements
+///        in a buffer, and after all of them, moves its part back. The
+///        reads of each thread don't depend on the previous moves, as in the
+///        walk of the cycles of the permutation, which have all the
+///        elements in a few long cycles with a random permutation, and can't
+///        be split between threads
+//
+/// @param first : iterator to the first element of the data
+/// @param nelem : number of elements
+/// @param source : function which returns the position of the element to
+///                 move to each position
+/// @param nthread : Number of threads to use in the process
+/// @param pool : pool where run the threads, except the calling thread
+/// @return false when the permutation is not applied, because there are
+///         less than 2 threads, few elements, or not memory for the buffer
+//-----------------------------------------------------------------------------
+template<class Iter_t, class Source>
+static bool parallel_apply_permutation(Iter_t first, size_t nelem,
+                                       Source source, uint32_t nthread,
+                                       thread_pool &pool)
+{
+    typedef util::value_iter<Iter_t> value_t;
+    if (nthread < 2 or nelem < permutation_nelem_min) return false;
+
+    std::pair<value_t *, std::ptrdiff_t> buf =
+                    std::get_temporary_buffer<value_t>(nelem);
+    if (buf.first == nullptr or size_t(buf.second) < nelem)
+    {
+        if (buf.first != nullptr) std::return_temporary_buffer(buf.first);
+        return false;
+    };
+    value_t *buffer = buf.first;
+
+    pool.run(nthread, [&](uint32_t i)
+    {
+        size_t pos_first = (nelem * i) / nthread;
+        size_t pos_last = (nelem * (i + 1)) / nthread;
+        for (size_t pos = pos_first; pos < pos_last; ++pos)
+            ::new (static_cast<void *>(buffer + pos))
+                            value_t(std::move(*(first + source(pos))));
+    });
+    pool.run(nthread, [&](uint32_t i)
+    {
+        size_t pos_first = (nelem * i) / nthread;
+        size_t pos_last = (nelem * (i + 1)) / nthread;
+        for (size_t pos = pos_first; pos < pos_last; ++pos)
+        {
+            *(first + pos) = std::move(buffer[pos]);
+            buffer[pos].~value_t();
+        };
+    });
+    std::return_temporary_buffer(buffer);
+    return true;
+};
+//
+//-----------------------------------------------------------------------------
+//  function : parallel_sort_index
+/// @brief sort_index with several threads. When the permutation can't be
+///        applied in parallel, it is done by sort_index
+//
+/// @param global_first : iterator to the first element of the data
+/// @param [in] index : vector of the iterators
+/// @param nthread : Number of threads to use in the process
+/// @param pool : pool where run the threads, except the calling thread
+//-----------------------------------------------------------------------------
+template<class Iter_t>
+static void parallel_sort_index(Iter_t global_first,
+                                std::vector<Iter_t> &index, uint32_t nthread,
+                                thread_pool &pool)
+{
+    if (not parallel_apply_permutation(global_first, index.size(),
+                        [&](size_t pos)
+                        {   return size_t(index[pos] - global_first);
+                        }, nthread, pool))
+    {
+        sort_index(global_first, index);
+    };
+};
+
+template<class func, class Iter_t, class Compare = util::compare_iter<Iter_t> >
 static void indirect_sort(func method, Iter_t first, Iter_t last, Compare comp)
 {
     auto nelem = (last - first);
@@ -142,6 +233,54 @@ static void indirect_sort(func method, Iter_t first, Iter_t last, Compare comp)
     method(index.begin(), index.end(), index_comp);
     sort_index(first, index);
 };
+//
+//-----------------------------------------------------------------------------
+//  function : parallel_indirect_sort
+/// @brief indirect_sort for a parallel sort method: the iterators are sorted
+///        by method, and the permutation is applied with nthread threads
+//
+/// @param method : sort of the vector of iterators, with the comparison of
+///                 the elements pointed
+/// @param first : iterator to the first element of the range
+/// @param last : iterator after the last element of the range
+/// @param comp : object for to compare two elements pointed by Iter_t
+/// @param nthread : Number of threads to use in the permutation
+/// @param pool : pool where run the threads, except the calling thread
+//-----------------------------------------------------------------------------
+template<class func, class Iter_t, class Compare>
+static void parallel_indirect_sort(func method, Iter_t first, Iter_t last,
+                                   Compare comp, uint32_t nthread,
+                                   thread_pool &pool)
+{
+    auto nelem = (last - first);
+    assert(nelem >= 0);
+    if (nelem < 2) return;
+    std::vector<Iter_t> index;
+    index.reserve((size_t) nelem);
+    create_index(first, last, index);
+    less_ptr_no_null<Iter_t, Compare> index_comp(comp);
+    method(index.begin(), index.end(), index_comp);
+    parallel_sort_index(first, index, nthread, pool);
+};
+//
+//-----------------------------------------------------------------------------
+//  function : parallel_indirect_sort
+/// @brief parallel_indirect_sort with the threads of the default pool
+//
+/// @param method : sort of the vector of iterators, with the comparison of
+///                 the elements pointed
+/// @param first : iterator to the first element of the range
+/// @param last : iterator after the last element of the range
+/// @param comp : object for to compare two elements pointed by Iter_t
+/// @param nthread : Number of threads to use in the permutation
+//-----------------------------------------------------------------------------
+template<class func, class Iter_t, class Compare>
+static void parallel_indirect_sort(func method, Iter_t first, Iter_t last,
+                                   Compare comp, uint32_t nthread)
+{
+    parallel_indirect_sort(method, first, last, comp, nthread,
+                           default_thread_pool( ));
+};
 
 //
 //****************************************************************************
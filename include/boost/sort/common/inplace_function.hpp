@@ -0,0 +1,185 @@
+//----------------------------------------------------------------------------
+/// @file   inplace_function.hpp
+/// @brief  This file contains the class inplace_function, a function object
+///         without dynamic memory
+///
+///         Distributed under the Boost Software License, Version 1.0.\n
+///         ( See accompanying file LICENSE_1_0.txt or copy at
+///           http://www.boost.org/LICENSE_1_0.txt  )
+/// @version 0.1
+///
+/// @remarks
+//-----------------------------------------------------------------------------
+#ifndef __BOOST_SORT_PARALLEL_DETAIL_UTIL_INPLACE_FUNCTION_HPP
+#define __BOOST_SORT_PARALLEL_DETAIL_UTIL_INPLACE_FUNCTION_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace boost
+{
+namespace sort
+{
+namespace common
+{
+//
+//---------------------------------------------------------------------------
+/// @class inplace_function
+/// @brief This class stores a callable object without arguments and without
+///        result, as std::function< void(void) >, inside an internal buffer
+///        of Size bytes. It never allocates memory
+/// @remarks The callable object must fit in the buffer, checked in the
+///          compilation. The class can be moved, but not copied
+//---------------------------------------------------------------------------
+template< size_t Size >
+class inplace_function
+{
+  private:
+    //------------------------------------------------------------------------
+    //                     D E F I N I T I O N S
+    //------------------------------------------------------------------------
+    typedef typename std::aligned_storage< Size,
+                    alignof(std::max_align_t) >::type storage_t;
+
+    // call to the object stored in ptr
+    typedef void (*invoke_t)(void *ptr);
+
+    // move the object from src to dest, and destroy the object in src. When
+    // dest is nullptr, only destroy
+    typedef void (*manage_t)(void *dest, void *src);
+
+    template< class Func >
+    static void invoke_func(void *ptr)
+    {
+        (*static_cast< Func * >(ptr))( );
+    };
+
+    template< class Func >
+    static void manage_func(void *dest, void *src)
+    {
+        Func *fsrc = static_cast< Func * >(src);
+        if (dest != nullptr) ::new (dest) Func(std::move(*fsrc));
+        fsrc->~Func( );
+    };
+
+    //------------------------------------------------------------------------
+    //                     V A R I A B L E S
+    //------------------------------------------------------------------------
+    storage_t data;
+    invoke_t invoke;
+    manage_t manage;
+
+  public:
+    //
+    //------------------------------------------------------------------------
+    //  function : inplace_function
+    /// @brief  constructor of an empty object
+    //------------------------------------------------------------------------
+    inplace_function(void) : invoke(nullptr), manage(nullptr) { };
+
+    //
+    //------------------------------------------------------------------------
+    //  function : inplace_function
+    /// @brief  constructor from a callable object
+    /// @param func : object to store
+    //------------------------------------------------------------------------
+    template< class Func, class Func2 = typename std::decay< Func >::type,
+              class = typename std::enable_if< not std::is_same< Func2,
+                                  inplace_function >::value >::type >
+    inplace_function(Func &&func)
+    : invoke(&invoke_func< Func2 >), manage(&manage_func< Func2 >)
+    {
+        static_assert(sizeof(Func2) <= Size,
+                      "The callable object doesn't fit in inplace_function");
+        static_assert(alignof(Func2) <= alignof(storage_t),
+                      "Bad alignment of the callable object");
+        ::new (&data) Func2(std::forward< Func >(func));
+    };
+
+    //
+    //------------------------------------------------------------------------
+    //  function : inplace_function
+    /// @brief  move constructor
+    //------------------------------------------------------------------------
+    inplace_function(inplace_function &&other)
+    : invoke(other.invoke), manage(other.manage)
+    {
+        if (manage != nullptr) manage(&data, &other.data);
+        other.invoke = nullptr;
+        other.manage = nullptr;
+    };
+
+    inplace_function(const inplace_function &) = delete;
+
+    //
+    //------------------------------------------------------------------------
+    //  function : ~inplace_function
+    /// @brief  destructor
+    //------------------------------------------------------------------------
+    ~inplace_function(void)
+    {
+        if (manage != nullptr) manage(nullptr, &data);
+    };
+
+    //
+    //------------------------------------------------------------------------
+    //  function : operator =
+    /// @brief  move assignment
+    //------------------------------------------------------------------------
+    inplace_function &operator=(inplace_function &&other)
+    {
+        if (this == &other) return *this;
+        *this = nullptr;
+        if (other.manage != nullptr) other.manage(&data, &other.data);
+        invoke = other.invoke;
+        manage = other.manage;
+        other.invoke = nullptr;
+        other.manage = nullptr;
+        return *this;
+    };
+
+    inplace_function &operator=(const inplace_function &) = delete;
+
+    //
+    //------------------------------------------------------------------------
+    //  function : operator =
+    /// @brief  destroy the stored object, leaving the object empty
+    //------------------------------------------------------------------------
+    inplace_function &operator=(std::nullptr_t)
+    {
+        if (manage != nullptr) manage(nullptr, &data);
+        invoke = nullptr;
+        manage = nullptr;
+        return *this;
+    };
+
+    //
+    //------------------------------------------------------------------------
+    //  function : operator bool
+    /// @brief  indicate if the object stores a callable object
+    //------------------------------------------------------------------------
+    explicit operator bool(void) const
+    {
+        return invoke != nullptr;
+    };
+
+    //
+    //------------------------------------------------------------------------
+    //  function : operator ( )
+    /// @brief  call to the stored object. It must not be empty
+    //------------------------------------------------------------------------
+    void operator()(void)
+    {
+        invoke(&data);
+    };
+};
+// end class inplace_function
+
+//***************************************************************************
+};// end namespace common
+};// end namespace sort
+};// end namespace boost
+//***************************************************************************
+#endif
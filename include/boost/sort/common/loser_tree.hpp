@@ -0,0 +1,254 @@
+//----------------------------------------------------------------------------
+/// @file loser_tree.hpp
+/// @brief This file contains the class loser_tree, for to do a stable merge
+///        of many sorted ranges at the same time
+///
+///         Distributed under the Boost Software License, Version 1.0.\n
+///         ( See accompanying file LICENSE_1_0.txt or copy at
+///           http://www.boost.org/LICENSE_1_0.txt  )
+/// @version 0.1
+///
+/// @remarks
+//-----------------------------------------------------------------------------
+#ifndef __BOOST_SORT_PARALLEL_DETAIL_UTIL_LOSER_TREE_HPP
+#define __BOOST_SORT_PARALLEL_DETAIL_UTIL_LOSER_TREE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <ciso646>
+#include <boost/sort/common/range.hpp>
+#include <boost/sort/common/util/algorithm.hpp>
+
+namespace boost
+{
+namespace sort
+{
+namespace common
+{
+//
+//###########################################################################
+//                                                                         ##
+//    ################################################################     ##
+//    #                                                              #     ##
+//    #                      C L A S S                               #     ##
+//    #                   L O S E R _ T R E E                        #     ##
+//    #                                                              #     ##
+//    ################################################################     ##
+//                                                                         ##
+//###########################################################################
+//
+//---------------------------------------------------------------------------
+/// @class  loser_tree
+/// @brief Tournament tree for to merge k sorted ranges. Each internal node
+///        keeps the range which lost the match in the node, and the root the
+///        winner, then extract an element needs log2(k) comparisons.
+/// @remarks The merge is stable : with equal elements, the element of the
+///          first range goes before
+//---------------------------------------------------------------------------
+template< class Iter_t, class Compare >
+class loser_tree
+{
+    //------------------------------------------------------------------------
+    //                     VARIABLES
+    //------------------------------------------------------------------------
+    // ranges not empty to merge, in the original order. The first iterator
+    // of each range advances, and the empty ranges are removed
+    std::vector< range< Iter_t > > vrange;
+
+    // loser of each internal node. In the position 0, the winner
+    std::vector< uint32_t > loser;
+
+    // number of elements not extracted
+    size_t nelem;
+
+    Compare comp;
+
+    //-------------------------------------------------------------------------
+    //  function : wins
+    /// @brief indicate if the range a goes before the range b. With equal
+    ///        elements, the range with the lower position wins. The
+    ///        expression has not branches, because the result is random
+    //-------------------------------------------------------------------------
+    bool wins(uint32_t a, uint32_t b) const
+    {
+        return bool(comp(*vrange[a].first, *vrange[b].first) |
+                    ((a < b) & not comp(*vrange[b].first, *vrange[a].first)));
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : build
+    /// @brief play all the matches, with the leaves in the positions k to
+    ///        2k-1 of a complete binary tree
+    //-------------------------------------------------------------------------
+    void build(void)
+    {
+        uint32_t k = uint32_t(vrange.size( ));
+        loser.assign(k + 1, 0);
+        if (k < 2) return;
+
+        std::vector< uint32_t > winner(2 * k);
+        for (uint32_t i = 0; i < k; ++i) winner[k + i] = i;
+        for (uint32_t node = k - 1; node != 0; --node)
+        {
+            uint32_t a = winner[2 * node], b = winner[2 * node + 1];
+            bool a_wins = wins(a, b);
+            winner[node] = a_wins ? a : b;
+            loser[node] = a_wins ? b : a;
+        };
+        loser[0] = winner[1];
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : replay
+    /// @brief play again the matches from the leaf of the winner to the root,
+    ///        after advance the winner range. When the range is empty, it is
+    ///        removed, and the tree is built again
+    //-------------------------------------------------------------------------
+    void replay(void)
+    {
+        uint32_t win = loser[0];
+        if (vrange[win].empty( ))
+        {
+            vrange.erase(vrange.begin( ) + win);
+            build( );
+            return;
+        };
+        uint32_t k = uint32_t(vrange.size( ));
+        for (uint32_t node = (win + k) >> 1; node != 0; node >>= 1)
+        {
+            uint32_t other = loser[node];
+            uint32_t mask = 0u - uint32_t(wins(other, win));
+            loser[node] = other ^ ((other ^ win) & mask);
+            win ^= (other ^ win) & mask;
+        };
+        loser[0] = win;
+    };
+
+public:
+    //-------------------------------------------------------------------------
+    //  function : loser_tree
+    /// @brief constructor. Play all the matches
+    /// @param vr : vector with the sorted ranges to merge. Can be empty
+    /// @param cmp : comparison object
+    //-------------------------------------------------------------------------
+    loser_tree(const std::vector< range< Iter_t > > &vr, Compare cmp)
+    : nelem(0), comp(cmp)
+    {
+        vrange.reserve(vr.size( ));
+        for (uint32_t i = 0; i < vr.size( ); ++i)
+        {
+            if (vr[i].empty( )) continue;
+            vrange.push_back(vr[i]);
+            nelem += vr[i].size( );
+        };
+        build( );
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : size
+    /// @brief number of elements pending of extraction
+    //-------------------------------------------------------------------------
+    size_t size(void) const { return nelem; };
+
+    bool empty(void) const { return nelem == 0; };
+
+    //-------------------------------------------------------------------------
+    //  function : top
+    /// @brief iterator to the next element of the merge. Must not be empty
+    //-------------------------------------------------------------------------
+    Iter_t top(void) const { return vrange[loser[0]].first; };
+
+    //-------------------------------------------------------------------------
+    //  function : pop
+    /// @brief advance to the next element of the merge. Must not be empty
+    //-------------------------------------------------------------------------
+    void pop(void)
+    {
+        ++vrange[loser[0]].first;
+        --nelem;
+        replay( );
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : merge
+    /// @brief move all the pending elements to dest, in order
+    /// @param dest : iterator to initialized memory
+    /// @return iterator after the last element moved
+    //-------------------------------------------------------------------------
+    template< class Iter2_t >
+    Iter2_t merge(Iter2_t dest)
+    {
+        while (vrange.size( ) > 1)
+        {
+            *(dest++) = std::move(*vrange[loser[0]].first);
+            pop( );
+        };
+        if (nelem != 0)
+        {
+            dest = util::move_forward(dest, vrange[0].first, vrange[0].last);
+            vrange[0].first = vrange[0].last;
+            nelem = 0;
+        };
+        return dest;
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : copy
+    /// @brief copy all the pending elements to dest, in order. The elements
+    ///        of the ranges are not modified
+    /// @param dest : iterator to initialized memory
+    /// @return iterator after the last element copied
+    //-------------------------------------------------------------------------
+    template< class Iter2_t >
+    Iter2_t copy(Iter2_t dest)
+    {
+        while (vrange.size( ) > 1)
+        {
+            *(dest++) = *vrange[loser[0]].first;
+            pop( );
+        };
+        if (nelem != 0)
+        {
+            dest = std::copy(vrange[0].first, vrange[0].last, dest);
+            vrange[0].first = vrange[0].last;
+            nelem = 0;
+        };
+        return dest;
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : merge_construct
+    /// @brief move all the pending elements to dest, in order, constructing
+    ///        them in uninitialized memory
+    /// @param dest : pointer to uninitialized memory
+    /// @return pointer after the last element constructed
+    //-------------------------------------------------------------------------
+    template< class Value_t >
+    Value_t *merge_construct(Value_t *dest)
+    {
+        while (vrange.size( ) > 1)
+        {
+            util::construct_object(dest++,
+                                   std::move(*vrange[loser[0]].first));
+            pop( );
+        };
+        if (nelem != 0)
+        {
+            dest = util::move_construct(dest, vrange[0].first,
+                                        vrange[0].last);
+            vrange[0].first = vrange[0].last;
+            nelem = 0;
+        };
+        return dest;
+    };
+};
+// end class loser_tree
+//
+//****************************************************************************
+};// end namespace common
+};// end namespace sort
+};// end namespace boost
+//****************************************************************************
+#endif
@@ -0,0 +1,200 @@
+//----------------------------------------------------------------------------
+/// @file mapped_file.hpp
+/// @brief This file contains the class mapped_file, which maps in memory a
+///        binary file of records, for to sort it in place with any of the
+///        algorithms of the library, without load it in a vector and write
+///        it again.
+///
+///        Only available in POSIX systems (mmap)
+///
+///         Distributed under the Boost Software License, Version 1.0.\n
+///         ( See accompanying file LICENSE_1_0.txt or copy at
+///           http://www.boost.org/LICENSE_1_0.txt  )
+/// @version 0.1
+///
+/// @remarks
+//-----------------------------------------------------------------------------
+#ifndef __BOOST_SORT_COMMON_MAPPED_FILE_HPP
+#define __BOOST_SORT_COMMON_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <ios>
+#include <string>
+#include <type_traits>
+#include <ciso646>
+#include <boost/sort/common/range.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace boost
+{
+namespace sort
+{
+namespace common
+{
+//
+//---------------------------------------------------------------------------
+/// @class  mapped_file
+/// @brief Map in memory a file of elements of type T. The elements are a
+///        random access range, and the changes are written in the file
+/// @tparam T : type of the elements of the file, trivially copyable
+/// @remarks The system reads the pages when they are accessed, and writes the
+///          modified pages when it needs the memory, or when the object is
+///          destroyed, then the file can be greater than the memory. The
+///          function advise indicates the next access pattern to the system
+/// @remarks A file opened read only is mapped copy on write : the elements
+///          can be modified, and sorted, but the changes are only in the
+///          memory, and are never written in the file
+//---------------------------------------------------------------------------
+template< class T >
+class mapped_file
+{
+    static_assert(std::is_trivially_copyable< T >::value,
+                  "mapped_file needs trivially copyable elements");
+
+    //-------------------------------------------------------------------------
+    //                   INTERNAL VARIABLES
+    //-------------------------------------------------------------------------
+    int fd;
+    T *ptr;
+    size_t nelem;
+    bool read_only;
+
+    //-------------------------------------------------------------------------
+    //  function : close
+    /// @brief unmap the file and close it
+    //-------------------------------------------------------------------------
+    void close(void)
+    {
+        if (ptr != nullptr) munmap(ptr, nelem * sizeof(T));
+        if (fd != -1) ::close(fd);
+        ptr = nullptr;
+        fd = -1;
+        nelem = 0;
+    };
+
+public:
+    //------------------------------------------------------------------------
+    //                     D E F I N I T I O N S
+    //------------------------------------------------------------------------
+    typedef T value_type;
+    typedef T *iterator;
+    typedef const T *const_iterator;
+
+    //------------------------------------------------------------------------
+    /// @enum  advice
+    /// @brief access patterns of the sorting algorithms
+    //------------------------------------------------------------------------
+    enum advice
+    {
+        normal,     // no information
+        sequential, // scans of the whole range, as counting or checking
+        random,     // accesses in any position, as swaps and merges
+        willneed    // read all the file now
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : mapped_file
+    /// @brief constructor. Open and map the file
+    /// @param filename : name of the file
+    /// @param read_only : if true, the file is opened read only, and the
+    ///                    changes of the elements are not written in it
+    /// @exception std::ios_base::failure : the file can't be opened or
+    ///            mapped, or its size is not a multiple of sizeof(T)
+    //-------------------------------------------------------------------------
+    explicit mapped_file(const std::string &filename, bool read_only = false)
+    : fd(-1), ptr(nullptr), nelem(0), read_only(read_only)
+    {
+        fd = ::open(filename.c_str( ), read_only ? O_RDONLY : O_RDWR);
+        if (fd == -1) throw std::ios_base::failure("could not open file \n");
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 or size_t(st.st_size) % sizeof(T) != 0)
+        {
+            close( );
+            throw std::ios_base::failure("incorrect length of the file\n");
+        };
+        if (st.st_size == 0) return;
+
+        // the pages of a read only file are copied when they are modified
+        int flags = read_only ? MAP_PRIVATE : MAP_SHARED;
+        void *p = mmap(nullptr, size_t(st.st_size), PROT_READ | PROT_WRITE,
+                       flags, fd, 0);
+        if (p == MAP_FAILED)
+        {
+            close( );
+            throw std::ios_base::failure("could not map file \n");
+        };
+        ptr = static_cast< T * >(p);
+        nelem = size_t(st.st_size) / sizeof(T);
+    };
+
+    mapped_file(const mapped_file &) = delete;
+    mapped_file &operator=(const mapped_file &) = delete;
+
+    //-------------------------------------------------------------------------
+    //  function : ~mapped_file
+    /// @brief destructor. The modified pages are written in the file by the
+    ///        system
+    //-------------------------------------------------------------------------
+    ~mapped_file(void) { close( ); };
+
+    //-------------------------------------------------------------------------
+    //  function : advise
+    /// @brief indicate to the system the next access pattern, for to read
+    ///        ahead the pages, or not
+    /// @param adv : access pattern
+    //-------------------------------------------------------------------------
+    void advise(advice adv)
+    {
+        if (ptr == nullptr) return;
+        int flag = (adv == sequential) ? MADV_SEQUENTIAL
+                 : (adv == random)     ? MADV_RANDOM
+                 : (adv == willneed)   ? MADV_WILLNEED : MADV_NORMAL;
+        madvise(ptr, nelem * sizeof(T), flag);
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : sync
+    /// @brief write now the modified pages in the file. Nothing is written
+    ///        in a file opened read only
+    /// @exception std::ios_base::failure : error writing the file
+    //-------------------------------------------------------------------------
+    void sync(void)
+    {
+        if (ptr != nullptr and not read_only and
+            msync(ptr, nelem * sizeof(T), MS_SYNC) != 0)
+            throw std::ios_base::failure("error writing a file\n");
+    };
+
+    //-------------------------------------------------------------------------
+    //                      A C C E S S
+    //-------------------------------------------------------------------------
+    size_t size(void) const { return nelem; };
+    bool empty(void) const { return nelem == 0; };
+
+    iterator begin(void) { return ptr; };
+    iterator end(void) { return ptr + nelem; };
+    const_iterator begin(void) const { return ptr; };
+    const_iterator end(void) const { return ptr + nelem; };
+
+    T &operator[](size_t pos) { return ptr[pos]; };
+    const T &operator[](size_t pos) const { return ptr[pos]; };
+
+    //-------------------------------------------------------------------------
+    //  function : get_range
+    /// @brief range with all the elements of the file
+    //-------------------------------------------------------------------------
+    range< T * > get_range(void) { return range< T * >(ptr, ptr + nelem); };
+};
+// end class mapped_file
+//
+//****************************************************************************
+};// end namespace common
+};// end namespace sort
+};// end namespace boost
+//****************************************************************************
+#endif
@@ -15,6 +15,7 @@
 #define __BOOST_SORT_PARALLEL_DETAIL_UTIL_MERGE_VECTOR_HPP
 
 #include <boost/sort/common/merge_four.hpp>
+#include <boost/sort/common/loser_tree.hpp>
 #include <functional>
 #include <iterator>
 #include <memory>
@@ -130,6 +131,42 @@ void uninit_merge_level4(range<Value_t *> dest,
 };
 //
 //-----------------------------------------------------------------------------
+//  function : uninit_merge_tree
+/// @brief merge the ranges of the vector v_input moving the objects and
+///        constructing them in uninitialized memory.
+///        With many ranges, merge all of them in only one pass with a
+///        loser_tree, and each element is moved one time, instead of one
+///        time for each level of uninit_merge_level4 and merge_vector4.
+///        With 16 ranges or less, the merge with full_merge4 needs the same
+///        number of moves, and is faster, because it reads only 4 ranges at
+///        the same time. The v_output vector contains the ranges obtained,
+///        inside dest
+///
+/// @param dest : range where move the elements merged
+/// @param v_input : vector of ranges to merge
+/// @param v_output : vector of ranges obtained
+/// @param comp : comparison object
+//-----------------------------------------------------------------------------
+template<class Value_t, class Iter_t, class Compare>
+void uninit_merge_tree(range<Value_t *> dest,
+                       std::vector<range<Iter_t> > &v_input,
+                       std::vector<range<Value_t *> > &v_output, Compare comp)
+{
+    typedef util::value_iter<Iter_t> type1;
+    static_assert (std::is_same< type1, Value_t >::value,
+                    "Incompatible iterators\n");
+
+    if (v_input.size() <= 16)
+    {
+        uninit_merge_level4(dest, v_input, v_output, comp);
+        return;
+    };
+    v_output.clear();
+    loser_tree<Iter_t, Compare> tree(v_input, comp);
+    v_output.emplace_back(dest.first, tree.merge_construct(dest.first));
+};
+//
+//-----------------------------------------------------------------------------
 //  function : merge_vector4
 /// @brief merge the ranges in the vector v_input using the merge_level4
 ///        function. The v_output vector is used as auxiliary memory in the
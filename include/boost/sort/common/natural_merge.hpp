@@ -0,0 +1,287 @@
+//----------------------------------------------------------------------------
+/// @file natural_merge.hpp
+/// @brief Detection of the natural runs of the data, and merge of them with
+///        the policy of powersort
+///
+/// @author Distributed under the Boost Software License, Version 1.0.\n
+///         ( See accompanying file LICENSE_1_0.txt or copy at
+///           http://www.boost.org/LICENSE_1_0.txt  )
+/// @version 0.1
+///
+/// @remarks The data made of a few long sorted or reverse sorted runs, as
+///          appended batches, are sorted merging the runs, with O(N log K)
+///          comparisons for K runs. The order of the merges is the one of
+///          powersort (J. I. Munro, S. Wild, "Nearly-Optimal Mergesorts",
+///          ESA 2018) : each boundary between two runs has a power, the
+///          depth of the boundary in a balanced merge tree of the data, and
+///          the runs are merged in the order of the powers
+//-----------------------------------------------------------------------------
+#ifndef __BOOST_SORT_COMMON_NATURAL_MERGE_HPP
+#define __BOOST_SORT_COMMON_NATURAL_MERGE_HPP
+
+#include <ciso646>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <boost/sort/insert_sort/insert_sort.hpp>
+#include <boost/sort/common/util/traits.hpp>
+#include <boost/sort/common/util/merge.hpp>
+#include <boost/sort/common/range.hpp>
+
+namespace boost
+{
+namespace sort
+{
+namespace common
+{
+//
+// the runs shorter are joined with the next short runs, and sorted with
+// the insertion sort
+static const size_t natural_min_run = 32;
+//
+//-----------------------------------------------------------------------------
+//  function : natural_run
+/// @brief size of the run which begins in first. The run is the elements
+///        not decreasing, or the elements strictly decreasing, which are
+///        reversed. As they are strictly decreasing, the reverse don't move
+///        equal elements, and the sort is stable
+//
+/// @param first : iterator to the first element of the range
+/// @param last : iterator after the last element of the range
+/// @param comp : object for to compare two elements
+/// @return number of elements of the run
+//-----------------------------------------------------------------------------
+template<class Iter_t, class Compare>
+static size_t natural_run(Iter_t first, Iter_t last, Compare comp)
+{
+    if ((last - first) < 2) return size_t(last - first);
+    Iter_t it = first + 1;
+    if (comp(*it, *first))
+    {
+        while (++it != last and comp(*it, *(it - 1)));
+        std::reverse(first, it);
+    }
+    else
+    {
+        while (++it != last and not comp(*it, *(it - 1)));
+    };
+    return size_t(it - first);
+};
+//
+//-----------------------------------------------------------------------------
+//  function : find_natural_runs
+/// @brief find the natural runs of the range, reversing the runs strictly
+///        decreasing. Stops when more than 1/8 of the elements seen are in
+///        runs shorter than natural_min_run, which happens after a few
+///        elements with random data
+//
+/// @param first : iterator to the first element of the range
+/// @param last : iterator after the last element of the range
+/// @param comp : object for to compare two elements
+/// @param vrun : position of the end of each run, from first
+/// @return true if the range is made of long runs, and can be sorted
+///         merging them
+/// @remarks The ends of the runs are kept in a local array, and moved to
+///          vrun when it is full, so vrun doesn't allocate memory when the
+///          search stops in the first runs, as with random data
+//-----------------------------------------------------------------------------
+template<class Iter_t, class Compare>
+static bool find_natural_runs(Iter_t first, Iter_t last, Compare comp,
+                              std::vector<size_t> &vrun)
+{
+    size_t nshort = 0, nbuf = 0;
+    size_t buf[natural_min_run];
+    vrun.clear();
+    for (Iter_t it = first; it != last;)
+    {
+        size_t nrun = natural_run(it, last, comp);
+        it += nrun;
+        if (nrun < natural_min_run)
+        {
+            nshort += nrun;
+            if ((nshort << 3) > size_t(it - first) + (natural_min_run << 3))
+                return false;
+        };
+        if (nbuf == natural_min_run)
+        {
+            vrun.insert(vrun.end(), buf, buf + nbuf);
+            nbuf = 0;
+        };
+        buf[nbuf++] = size_t(it - first);
+    };
+    vrun.insert(vrun.end(), buf, buf + nbuf);
+    return true;
+};
+//
+//-----------------------------------------------------------------------------
+//  function : node_power
+/// @brief power of the boundary between the runs [first1, first2) and
+///        [first2, last2) of a range of nelem elements: the first bit where
+///        the binary fractions of the middle points of the two runs differ
+//
+/// @param nelem : number of elements of the range
+/// @param first1 : position of the first element of the first run
+/// @param first2 : position of the first element of the second run
+/// @param last2 : position after the last element of the second run
+/// @return power of the boundary, from 1
+//-----------------------------------------------------------------------------
+static inline uint32_t node_power(size_t nelem, size_t first1, size_t first2,
+                                  size_t last2)
+{
+    // twice the middle points, in units of 1 / nelem
+    size_t mid1 = first1 + first2, mid2 = first2 + last2;
+    uint32_t power = 0;
+    while (true)
+    {
+        ++power;
+        if (mid1 >= nelem)
+        {
+            mid1 -= nelem;
+            mid2 -= nelem;
+        }
+        else if (mid2 >= nelem) break;
+        mid1 <<= 1;
+        mid2 <<= 1;
+    };
+    return power;
+};
+//
+//-----------------------------------------------------------------------------
+//  function : power_merge
+/// @brief merge the contiguous runs with the policy of powersort. Before
+///        putting a run in the stack, the runs of the stack with a power
+///        greater than the power of the boundary after the run are merged
+///        with it. The powers in the stack are increasing, so the stack has
+///        at most 64 runs
+//
+/// @param vrun : position of the end of each run. The last is the number of
+///               elements
+/// @param merge : function merge (first1, first2, last2), which merges the
+///                runs [first1, first2) and [first2, last2)
+//-----------------------------------------------------------------------------
+template<class Merge>
+static void power_merge(const std::vector<size_t> &vrun, Merge merge)
+{
+    struct run_t
+    {
+        size_t first;
+        uint32_t power;
+    };
+    if (vrun.size() < 2) return;
+    const size_t nelem = vrun.back();
+    run_t stack[64];
+    uint32_t nstack = 0;
+    size_t first1 = 0;
+
+    for (size_t i = 1; i < vrun.size(); ++i)
+    {
+        const size_t first2 = vrun[i - 1];
+        uint32_t power = node_power(nelem, first1, first2, vrun[i]);
+        while (nstack != 0 and stack[nstack - 1].power > power)
+        {
+            --nstack;
+            merge(stack[nstack].first, first1, first2);
+            first1 = stack[nstack].first;
+        };
+        stack[nstack].first = first1;
+        stack[nstack++].power = power;
+        first1 = first2;
+    };
+    while (nstack != 0)
+    {
+        --nstack;
+        merge(stack[nstack].first, first1, nelem);
+        first1 = stack[nstack].first;
+    };
+};
+//
+//-----------------------------------------------------------------------------
+//  function : merge_runs
+/// @brief stable merge of the sorted ranges [first, mid) and [mid, last).
+///        The elements of the first range not greater than *mid, and the
+///        elements of the second not less than *(mid - 1), are in their
+///        place. Of the others, the smaller part is moved to the auxiliary
+///        memory, and merged with merge_half or merge_half_backward
+//
+/// @param first : iterator to the first element of the first range
+/// @param mid : iterator to the first element of the second range
+/// @param last : iterator after the last element of the second range
+/// @param paux : pointer to uninitialized memory of at least
+///               min (mid - first, last - mid) elements
+/// @param comp : object for to compare two elements
+//-----------------------------------------------------------------------------
+template<class Iter_t, class Value_t, class Compare>
+static void merge_runs(Iter_t first, Iter_t mid, Iter_t last, Value_t *paux,
+                       Compare comp)
+{
+    first = std::upper_bound(first, mid, *mid, comp);
+    if (first == mid) return;
+    last = std::lower_bound(mid, last, *(mid - 1), comp);
+
+    if ((mid - first) <= (last - mid))
+    {
+        range<Value_t *> rng_aux = move_construct(
+                        range<Value_t *>(paux, paux + (mid - first)),
+                        range<Iter_t>(first, mid));
+        merge_half(range<Iter_t>(first, last), rng_aux,
+                   range<Iter_t>(mid, last), comp);
+        destroy(rng_aux);
+    }
+    else
+    {
+        range<Value_t *> rng_aux = move_construct(
+                        range<Value_t *>(paux, paux + (last - mid)),
+                        range<Iter_t>(mid, last));
+        util::merge_half_backward(first, mid, rng_aux.first, rng_aux.last,
+                                  last, comp);
+        destroy(rng_aux);
+    };
+};
+//
+//-----------------------------------------------------------------------------
+//  function : natural_merge
+/// @brief sort the range merging its natural runs, found by
+///        find_natural_runs. The runs shorter than natural_min_run are
+///        joined with the next short runs, and sorted with the insertion
+///        sort, and then the runs are merged with power_merge
+//
+/// @param first : iterator to the first element of the range
+/// @param vrun : position of the end of each run, from first
+/// @param comp : object for to compare two elements
+/// @param paux : pointer to uninitialized memory of at least the half of
+///               the elements of the range
+//-----------------------------------------------------------------------------
+template<class Iter_t, class Value_t, class Compare>
+static void natural_merge(Iter_t first, std::vector<size_t> &vrun,
+                          Compare comp, Value_t *paux)
+{
+    size_t nrun = 0, start = 0, i = 0;
+    while (i < vrun.size())
+    {
+        size_t end = vrun[i++];
+        if ((end - start) < natural_min_run)
+        {
+            while (i < vrun.size() and (end - start) < natural_min_run
+                   and (vrun[i] - end) < natural_min_run)
+                end = vrun[i++];
+            insert_sort(first + start, first + end, comp);
+        };
+        vrun[nrun++] = end;
+        start = end;
+    };
+    vrun.resize(nrun);
+
+    power_merge(vrun, [&](size_t first1, size_t first2, size_t last2)
+    {
+        merge_runs(first + first1, first + first2, first + last2, paux, comp);
+    });
+};
+//
+//****************************************************************************
+};//    End namespace common
+};//    End namespace sort
+};//    End namespace boost
+//****************************************************************************
+//
+#endif
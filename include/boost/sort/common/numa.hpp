@@ -0,0 +1,269 @@
+//----------------------------------------------------------------------------
+/// @file   numa.hpp
+/// @brief  This file contains the optional NUMA support of the parallel
+///         algorithms : the topology of the machine, the binding of a thread
+///         to the cpus of a node, and the first touch of the memory.
+///
+///         The NUMA mode is enabled defining BOOST_SORT_USE_NUMA before
+///         including the library, and only in Linux. Without it, or with
+///         only one node, all the functions of this file do nothing.
+///         BOOST_SORT_NUMA_SYSFS_PATH changes the directory where the nodes
+///         are read.
+///
+///         Distributed under the Boost Software License, Version 1.0.\n
+///         ( See accompanying file LICENSE_1_0.txt or copy at
+///           http://www.boost.org/LICENSE_1_0.txt  )
+/// @version 0.1
+///
+/// @remarks
+//-----------------------------------------------------------------------------
+#ifndef __BOOST_SORT_PARALLEL_DETAIL_UTIL_NUMA_HPP
+#define __BOOST_SORT_PARALLEL_DETAIL_UTIL_NUMA_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(BOOST_SORT_USE_NUMA) && defined(__linux__)
+#define __BOOST_SORT_NUMA_LINUX
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <fstream>
+#endif
+
+#ifndef BOOST_SORT_NUMA_SYSFS_PATH
+#define BOOST_SORT_NUMA_SYSFS_PATH "/sys/devices/system/node"
+#endif
+
+namespace boost
+{
+namespace sort
+{
+namespace common
+{
+
+//
+//###########################################################################
+//                                                                         ##
+//    ################################################################     ##
+//    #                                                              #     ##
+//    #                      C L A S S                               #     ##
+//    #                 N U M A _ T O P O L O G Y                    #     ##
+//    #                                                              #     ##
+//    ################################################################     ##
+//                                                                         ##
+//###########################################################################
+//
+//---------------------------------------------------------------------------
+/// @class  numa_topology
+/// @brief This class contains the cpus of each NUMA node with cpus of the
+///        machine, read from the directory /sys/devices/system/node
+/// @remarks When the directory can't be read, or the NUMA mode is not
+///          enabled, the machine is a single node
+//---------------------------------------------------------------------------
+class numa_topology
+{
+    //-------------------------------------------------------------------------
+    //                   INTERNAL VARIABLES
+    //-------------------------------------------------------------------------
+    // cpus of each node. The nodes without cpus are not stored
+    std::vector< std::vector< uint32_t > > vcpu;
+
+public:
+    //-------------------------------------------------------------------------
+    //  function : parse_cpulist
+    /// @brief Obtain the cpus of a list in the format of the sysfs files
+    ///        ("0-3,8,10-11")
+    /// @param list : string with the list
+    /// @return vector with the cpus
+    //-------------------------------------------------------------------------
+    static std::vector< uint32_t > parse_cpulist(const std::string &list)
+    {
+        std::vector< uint32_t > cpus;
+        const char *p = list.c_str( );
+        while (*p >= '0' and *p <= '9')
+        {
+            char *end;
+            uint32_t first = (uint32_t) std::strtoul(p, &end, 10);
+            uint32_t last = first;
+            if (*end == '-')
+                last = (uint32_t) std::strtoul(end + 1, &end, 10);
+            for (uint32_t cpu = first; cpu <= last; ++cpu)
+                cpus.push_back(cpu);
+            p = (*end == ',') ? end + 1 : end;
+        };
+        return cpus;
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : numa_topology
+    /// @brief constructor. Read the nodes from a directory with the format
+    ///        of /sys/devices/system/node
+    /// @param path : directory with a subdirectory nodeN for each node
+    //-------------------------------------------------------------------------
+    explicit numa_topology(const std::string &path = BOOST_SORT_NUMA_SYSFS_PATH)
+    {
+#ifdef __BOOST_SORT_NUMA_LINUX
+        DIR *dir = opendir(path.c_str( ));
+        if (dir != nullptr)
+        {
+            std::vector< std::pair< uint32_t, std::string > > vnode;
+            while (dirent *entry = readdir(dir))
+            {
+                const char *name = entry->d_name;
+                if (std::string(name).compare(0, 4, "node") != 0 or
+                    name[4] < '0' or name[4] > '9') continue;
+                vnode.emplace_back((uint32_t) std::atoi(name + 4), name);
+            };
+            closedir(dir);
+            std::sort(vnode.begin( ), vnode.end( ));
+
+            for (uint32_t i = 0; i < vnode.size( ); ++i)
+            {
+                std::ifstream file(path + "/" + vnode[i].second + "/cpulist");
+                std::string list;
+                if (not std::getline(file, list)) continue;
+                std::vector< uint32_t > cpus = parse_cpulist(list);
+                if (not cpus.empty( )) vcpu.push_back(std::move(cpus));
+            };
+        };
+#else
+        (void) path;
+#endif
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : nnodes
+    /// @brief number of nodes with cpus. It is 1 when the topology is unknown
+    //-------------------------------------------------------------------------
+    uint32_t nnodes(void) const
+    {
+        return vcpu.empty( ) ? 1 : (uint32_t) vcpu.size( );
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : cpus
+    /// @brief cpus of a node
+    /// @param node : number of the node, lower than nnodes()
+    //-------------------------------------------------------------------------
+    const std::vector< uint32_t > &cpus(uint32_t node) const
+    {
+        return vcpu[node];
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : node_of
+    /// @brief node assigned to the part i of a range divided in n parts.
+    ///        The consecutive parts are assigned to the same node
+    /// @param i : number of the part
+    /// @param n : number of parts
+    //-------------------------------------------------------------------------
+    uint32_t node_of(uint32_t i, uint32_t n) const
+    {
+        return (n == 0) ? 0 : (uint32_t) ((uint64_t(i) * nnodes( )) / n);
+    };
+};
+// end class numa_topology
+
+//-----------------------------------------------------------------------------
+//  function : numa_machine
+/// @brief topology of the machine, read in the first call
+//-----------------------------------------------------------------------------
+inline const numa_topology &numa_machine(void)
+{
+    static const numa_topology topology;
+    return topology;
+};
+
+//---------------------------------------------------------------------------
+/// @class  numa_bind
+/// @brief Bind the calling thread to the cpus of a node in the construction,
+///        and restore the previous cpus in the destruction.
+/// @remarks With only one node nothing is done. The cpus of the node not
+///          allowed to the thread are not used, and if there is none, the
+///          thread is not bound
+//---------------------------------------------------------------------------
+class numa_bind
+{
+#ifdef __BOOST_SORT_NUMA_LINUX
+    cpu_set_t old_set;
+    bool bound;
+
+public:
+    numa_bind(const numa_topology &topology, uint32_t node) : bound(false)
+    {
+        if (topology.nnodes( ) < 2) return;
+        if (pthread_getaffinity_np(pthread_self( ), sizeof(old_set),
+                                   &old_set) != 0) return;
+
+        const std::vector< uint32_t > &cpus =
+            topology.cpus(node % topology.nnodes( ));
+        cpu_set_t new_set;
+        CPU_ZERO(&new_set);
+        for (uint32_t i = 0; i < cpus.size( ); ++i)
+        {
+            if (cpus[i] < CPU_SETSIZE and CPU_ISSET(cpus[i], &old_set))
+                CPU_SET(cpus[i], &new_set);
+        };
+        if (CPU_COUNT(&new_set) == 0) return;
+        bound = (pthread_setaffinity_np(pthread_self( ), sizeof(new_set),
+                                        &new_set) == 0);
+    };
+
+    ~numa_bind(void)
+    {
+        if (bound)
+            pthread_setaffinity_np(pthread_self( ), sizeof(old_set), &old_set);
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : is_bound
+    /// @brief indicate if the thread is bound to the node
+    //-------------------------------------------------------------------------
+    bool is_bound(void) const { return bound; };
+#else
+public:
+    numa_bind(const numa_topology &, uint32_t) { };
+    bool is_bound(void) const { return false; };
+#endif
+
+    explicit numa_bind(uint32_t node) : numa_bind(numa_machine( ), node) { };
+
+    numa_bind(const numa_bind &) = delete;
+    numa_bind &operator=(const numa_bind &) = delete;
+};
+// end class numa_bind
+
+//-----------------------------------------------------------------------------
+//  function : numa_first_touch
+/// @brief Write in each page of a memory area, without change its content,
+///        for the pages be placed in the node of the calling thread. Only
+///        done when the machine has several nodes
+/// @param first : pointer to the first element of the memory
+/// @param last : pointer after the last element
+//-----------------------------------------------------------------------------
+template< class T >
+inline void numa_first_touch(T *first, T *last)
+{
+#ifdef __BOOST_SORT_NUMA_LINUX
+    if (numa_machine( ).nnodes( ) < 2 or first == last) return;
+    const size_t page_size = 4096;
+    volatile char *p = reinterpret_cast< volatile char * >(first);
+    volatile char *end = reinterpret_cast< volatile char * >(last);
+    for (; p < end; p += page_size) *p = *p;
+#else
+    (void) first;
+    (void) last;
+#endif
+};
+
+//***************************************************************************
+};// end namespace common
+};// end namespace sort
+};// end namespace boost
+//***************************************************************************
+#endif
@@ -0,0 +1,305 @@
+//----------------------------------------------------------------------------
+/// @file   scheduler_ws.hpp
+/// @brief  This file contains the implementation of a work stealing
+///         scheduler, with a deque_ws for each thread
+///
+///         Distributed under the Boost Software License, Version 1.0.\n
+///         ( See accompanying file LICENSE_1_0.txt or copy at
+///           http://www.boost.org/LICENSE_1_0.txt  )
+/// @version 0.1
+///
+/// @remarks
+//-----------------------------------------------------------------------------
+#ifndef __BOOST_SORT_PARALLEL_DETAIL_UTIL_SCHEDULER_WS_HPP
+#define __BOOST_SORT_PARALLEL_DETAIL_UTIL_SCHEDULER_WS_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <boost/sort/common/deque_ws.hpp>
+#include <boost/sort/common/stack_cnc.hpp>
+
+namespace boost
+{
+namespace sort
+{
+namespace common
+{
+
+//
+//###########################################################################
+//                                                                         ##
+//    ################################################################     ##
+//    #                                                              #     ##
+//    #                      C L A S S                               #     ##
+//    #                S C H E D U L E R _ W S                       #     ##
+//    #                                                              #     ##
+//    ################################################################     ##
+//                                                                         ##
+//###########################################################################
+//
+//---------------------------------------------------------------------------
+/// @class  scheduler_ws
+/// @brief This class is a concurrent container of works, with the same
+///        interface than stack_cnc. Each worker thread has its own deque_ws,
+///        where insert and extract its works without locks, and when it is
+///        empty, steal works from the other threads.
+/// @remarks A thread is a worker while a worker object of the scheduler
+///          exists in the thread. The works inserted by other threads go to
+///          a stack_cnc, from where all the threads extract them
+/// @remarks The works, the deques and the stack are obtained from Allocator
+//---------------------------------------------------------------------------
+template<class T, class Allocator = std::allocator<T> >
+class scheduler_ws
+{
+public:
+    //------------------------------------------------------------------------
+    //                     D E F I N I T I O N S
+    //------------------------------------------------------------------------
+    typedef T value_type;
+    typedef Allocator allocator_type;
+
+    //------------------------------------------------------------------------
+    /// @struct worker
+    /// @brief Attach the thread as worker in the construction, and restore
+    ///        the previous state of the thread in the destruction
+    //------------------------------------------------------------------------
+    struct worker
+    {
+        const scheduler_ws *prev_sch;
+        uint32_t prev_pos;
+
+        explicit worker(scheduler_ws &sch)
+        : prev_sch(slot.sch), prev_pos(slot.pos)
+        {
+            sch.attach();
+        };
+        ~worker(void)
+        {
+            slot.sch = prev_sch;
+            slot.pos = prev_pos;
+        };
+    };
+
+private:
+    //-------------------------------------------------------------------------
+    //                   INTERNAL VARIABLES
+    //-------------------------------------------------------------------------
+    // scheduler and position of the deque of this thread
+    struct slot_t
+    {
+        const scheduler_ws *sch;
+        uint32_t pos;
+    };
+    static thread_local slot_t slot;
+
+    typedef deque_ws<T, Allocator> deque_t;
+    typedef std::allocator_traits<Allocator> traits_t;
+    typedef typename traits_t::template rebind_alloc<deque_t> deque_alloc_t;
+    typedef typename traits_t::template rebind_alloc<deque_t *> vdeque_alloc_t;
+    typedef typename traits_t::template rebind_alloc<T *> ptr_alloc_t;
+
+    Allocator alloc;
+    std::vector<deque_t *, vdeque_alloc_t> vdeque;
+    std::atomic<uint32_t> nworker;
+
+    // works inserted by threads without deque
+    stack_cnc<T *, ptr_alloc_t> inject;
+
+    //-------------------------------------------------------------------------
+    //  function : destroy
+    /// @brief Destroy a work and return its memory to the allocator
+    //-------------------------------------------------------------------------
+    void destroy(T *ptr)
+    {
+        traits_t::destroy(alloc, ptr);
+        traits_t::deallocate(alloc, ptr, 1);
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : steal
+    /// @brief Extract a work from the deque of other thread
+    /// @param pos : position of the deque of this thread, where begin to
+    ///              search
+    /// @return pointer to the work, nullptr if all the deques are empty
+    //-------------------------------------------------------------------------
+    T *steal(uint32_t pos)
+    {
+        uint32_t nw = nworker.load(std::memory_order_acquire);
+        if (nw > vdeque.size()) nw = (uint32_t) vdeque.size();
+        for (uint32_t i = 1; i <= nw; ++i)
+        {
+            T *ptr = vdeque[(pos + i) % nw]->steal();
+            if (ptr != nullptr) return ptr;
+        };
+        return nullptr;
+    };
+
+public:
+    //
+    //-------------------------------------------------------------------------
+    //  function : scheduler_ws
+    /// @brief  constructor
+    /// @param [in] nthread : maximum number of worker threads. It can be
+    ///                       fixed later with set_nthread
+    //-------------------------------------------------------------------------
+    explicit scheduler_ws(uint32_t nthread = 0,
+                          const Allocator &alloc1 = Allocator())
+    : alloc(alloc1), vdeque(vdeque_alloc_t(alloc1)), nworker(0),
+      inject(ptr_alloc_t(alloc1))
+    {
+        set_nthread(nthread);
+    };
+
+    scheduler_ws(const scheduler_ws &) = delete;
+    scheduler_ws &operator=(const scheduler_ws &) = delete;
+
+    //
+    //-------------------------------------------------------------------------
+    //  function : ~scheduler_ws
+    /// @brief  Destructor. Delete the works not executed
+    //-------------------------------------------------------------------------
+    virtual ~scheduler_ws(void)
+    {
+        T *ptr;
+        deque_alloc_t deque_alloc(alloc);
+        for (uint32_t i = 0; i < vdeque.size(); ++i)
+        {
+            while ((ptr = vdeque[i]->steal()) != nullptr) destroy(ptr);
+            std::allocator_traits<deque_alloc_t>::destroy(deque_alloc,
+                                                          vdeque[i]);
+            std::allocator_traits<deque_alloc_t>::deallocate(deque_alloc,
+                                                             vdeque[i], 1);
+        };
+        while (inject.pop_move_back(ptr)) destroy(ptr);
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : set_nthread
+    /// @brief Create the deques for nthread worker threads. Must be called
+    ///        before any thread is attached
+    //-------------------------------------------------------------------------
+    void set_nthread(uint32_t nthread)
+    {
+        if (vdeque.size() >= nthread) return;
+        vdeque.reserve(nthread);
+        deque_alloc_t deque_alloc(alloc);
+        while (vdeque.size() < nthread)
+        {
+            deque_t *ptr =
+                std::allocator_traits<deque_alloc_t>::allocate(deque_alloc, 1);
+            try
+            {
+                std::allocator_traits<deque_alloc_t>::construct(
+                                deque_alloc, ptr, 256, alloc);
+            }
+            catch (...)
+            {
+                std::allocator_traits<deque_alloc_t>::deallocate(deque_alloc,
+                                                                 ptr, 1);
+                throw;
+            };
+            vdeque.push_back(ptr);
+        };
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : attach
+    /// @brief Assign a deque to this thread. When all the deques are
+    ///        assigned, the thread uses the shared stack. Use through the
+    ///        worker struct, which undo it
+    //-------------------------------------------------------------------------
+    void attach(void)
+    {
+        if (slot.sch == this) return;
+        uint32_t pos = nworker.fetch_add(1, std::memory_order_acq_rel);
+        if (pos < vdeque.size())
+        {
+            slot.sch = this;
+            slot.pos = pos;
+        };
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : emplace_back
+    /// @brief Insert one element in the deque of the thread, or in the
+    ///        shared stack if the thread is not a worker
+    /// @param args : group of arguments for to build the object to insert. Can
+    ///               be values, references or rvalues
+    //-------------------------------------------------------------------------
+    template<class ... Args>
+    void emplace_back(Args &&... args)
+    {
+        T *ptr = traits_t::allocate(alloc, 1);
+        try
+        {
+            traits_t::construct(alloc, ptr, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            traits_t::deallocate(alloc, ptr, 1);
+            throw;
+        };
+        try
+        {
+            if (slot.sch == this) vdeque[slot.pos]->push(ptr);
+            else inject.emplace_back(ptr);
+        }
+        catch (...)
+        {
+            destroy(ptr);
+            throw;
+        };
+    };
+
+    //-------------------------------------------------------------------------
+    //  function :pop_move_back
+    /// @brief if exist, move to P the last element of the deque of the
+    ///        thread; if not, an element of the shared stack or of the
+    ///        deque of other thread
+    /// @param P : reference to a variable where move the element
+    /// @return  true  - Element moved and deleted
+    ///          false - Nothing found
+    //-------------------------------------------------------------------------
+    bool pop_move_back(value_type &P)
+    {
+        T *ptr = nullptr;
+        uint32_t pos = 0;
+        if (slot.sch == this)
+        {
+            pos = slot.pos;
+            ptr = vdeque[pos]->pop();
+        };
+        if (ptr == nullptr and not inject.pop_move_back(ptr))
+        {
+            ptr = steal(pos);
+            if (ptr == nullptr) return false;
+        };
+        try
+        {
+            P = std::move(*ptr);
+        }
+        catch (...)
+        {
+            destroy(ptr);
+            throw;
+        };
+        destroy(ptr);
+        return true;
+    };
+};
+// end class scheduler_ws
+
+// initialization of the thread_local slot
+template<class T, class Allocator>
+thread_local typename scheduler_ws<T, Allocator>::slot_t
+scheduler_ws<T, Allocator>::slot = { nullptr, 0 };
+
+//***************************************************************************
+};// end namespace common
+};// end namespace sort
+};// end namespace boost
+//***************************************************************************
+#endif
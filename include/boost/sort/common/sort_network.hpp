@@ -0,0 +1,272 @@
+//----------------------------------------------------------------------------
+/// @file sort_network.hpp
+/// @brief Sorting networks of Bose-Nelson, generated at compile time, for
+///        to sort small ranges of integers
+///
+/// @author Distributed under the Boost Software License, Version 1.0.\n
+///         ( See accompanying file LICENSE_1_0.txt or copy at
+///           http://www.boost.org/LICENSE_1_0.txt  )
+/// @version 0.1
+///
+/// @remarks A sorting network is a fixed sequence of compare-exchanges,
+///          without loops, and with the min and max of each exchange made
+///          with conditional moves, so it doesn't have branches to predict.
+///          Only for the integers with std::less or std::greater. The
+///          floating point numbers are compared with branches, unless the
+///          min and max instructions are used, which don't keep -0.0 and
+///          0.0 when they are compared. This file doesn't need C++11,
+///          because it's used by pdqsort
+//-----------------------------------------------------------------------------
+#ifndef __BOOST_SORT_COMMON_SORT_NETWORK_HPP
+#define __BOOST_SORT_COMMON_SORT_NETWORK_HPP
+
+#include <ciso646>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <boost/type_traits.hpp>
+
+namespace boost
+{
+namespace sort
+{
+namespace common
+{
+//
+// maximum number of elements of the networks used by network_sort
+static const std::size_t sort_network_max = 32;
+//
+//---------------------------------------------------------------------------
+//  struct : is_network_compare
+/// @brief true when Compare is std::less or std::greater of T
+//---------------------------------------------------------------------------
+template<class Compare, class T>
+struct is_network_compare : boost::false_type { };
+
+template<class T>
+struct is_network_compare<std::less<T>, T> : boost::true_type { };
+
+template<class T>
+struct is_network_compare<std::greater<T>, T> : boost::true_type { };
+//
+//---------------------------------------------------------------------------
+//  struct : use_sort_network
+/// @brief true when the elements of Iter_t are integers compared with
+///        std::less or std::greater, and can be sorted with a network. The
+///        equal integers can't be distinguished, so the network can be used
+///        by the stable algorithms too
+//---------------------------------------------------------------------------
+template<class Iter_t, class Compare>
+struct use_sort_network
+{
+    typedef typename std::iterator_traits<Iter_t>::value_type value_t;
+    static const bool value =
+        is_network_compare<typename boost::decay<Compare>::type,
+                           value_t>::value and
+        boost::is_integral<value_t>::value;
+};
+
+namespace detail_network
+{
+//
+//---------------------------------------------------------------------------
+//  struct : network_exchange
+/// @brief compare-exchange of the elements in the positions I and J, I < J.
+///        The two conditional expressions are compiled as conditional moves
+//---------------------------------------------------------------------------
+template<std::size_t I, std::size_t J>
+struct network_exchange
+{
+    template<class Iter_t, class Compare>
+    static void sort(Iter_t first, Compare comp)
+    {
+        typedef typename std::iterator_traits<Iter_t>::value_type value_t;
+        value_t x = first[I], y = first[J];
+        bool swap = comp(y, x);
+        first[I] = swap ? y : x;
+        first[J] = swap ? x : y;
+    };
+};
+//
+//---------------------------------------------------------------------------
+//  struct : network_merge
+/// @brief Merge of Bose-Nelson of the sorted groups of X elements from I,
+///        and of Y elements from J. The Case is the size of the groups:
+///        0 : an empty group, 1 : 1 and 1, 2 : 1 and 2, 3 : 2 and 1,
+///        4 : the others, which are split in halves
+//---------------------------------------------------------------------------
+template<std::size_t I, std::size_t X, std::size_t J, std::size_t Y,
+         int Case = (X == 0 or Y == 0) ? 0
+                  : (X == 1 and Y == 1) ? 1
+                  : (X == 1 and Y == 2) ? 2
+                  : (X == 2 and Y == 1) ? 3 : 4>
+struct network_merge
+{
+    static const std::size_t A = X / 2;
+    static const std::size_t B = (X & 1) ? (Y / 2) : ((Y + 1) / 2);
+
+    template<class Iter_t, class Compare>
+    static void sort(Iter_t first, Compare comp)
+    {
+        network_merge<I, A, J, B>::sort(first, comp);
+        network_merge<I + A, X - A, J + B, Y - B>::sort(first, comp);
+        network_merge<I + A, X - A, J, B>::sort(first, comp);
+    };
+};
+
+template<std::size_t I, std::size_t X, std::size_t J, std::size_t Y>
+struct network_merge<I, X, J, Y, 0>
+{
+    template<class Iter_t, class Compare>
+    static void sort(Iter_t, Compare) { };
+};
+
+template<std::size_t I, std::size_t X, std::size_t J, std::size_t Y>
+struct network_merge<I, X, J, Y, 1>
+{
+    template<class Iter_t, class Compare>
+    static void sort(Iter_t first, Compare comp)
+    {
+        network_exchange<I, J>::sort(first, comp);
+    };
+};
+
+template<std::size_t I, std::size_t X, std::size_t J, std::size_t Y>
+struct network_merge<I, X, J, Y, 2>
+{
+    template<class Iter_t, class Compare>
+    static void sort(Iter_t first, Compare comp)
+    {
+        network_exchange<I, J + 1>::sort(first, comp);
+        network_exchange<I, J>::sort(first, comp);
+    };
+};
+
+template<std::size_t I, std::size_t X, std::size_t J, std::size_t Y>
+struct network_merge<I, X, J, Y, 3>
+{
+    template<class Iter_t, class Compare>
+    static void sort(Iter_t first, Compare comp)
+    {
+        network_exchange<I, J>::sort(first, comp);
+        network_exchange<I + 1, J>::sort(first, comp);
+    };
+};
+//
+//---------------------------------------------------------------------------
+//  struct : network_sort_from
+/// @brief Network of Bose-Nelson of the N elements from the position I: the
+///        two halves are sorted, and merged
+//---------------------------------------------------------------------------
+template<std::size_t I, std::size_t N>
+struct network_sort_from
+{
+    template<class Iter_t, class Compare>
+    static void sort(Iter_t first, Compare comp)
+    {
+        network_sort_from<I, N / 2>::sort(first, comp);
+        network_sort_from<I + N / 2, N - N / 2>::sort(first, comp);
+        network_merge<I, N / 2, I + N / 2, N - N / 2>::sort(first, comp);
+    };
+};
+
+template<std::size_t I>
+struct network_sort_from<I, 1>
+{
+    template<class Iter_t, class Compare>
+    static void sort(Iter_t, Compare) { };
+};
+
+template<std::size_t I>
+struct network_sort_from<I, 0>
+{
+    template<class Iter_t, class Compare>
+    static void sort(Iter_t, Compare) { };
+};
+//
+//****************************************************************************
+};//    End namespace detail_network
+//
+//-----------------------------------------------------------------------------
+//  function : sort_network
+/// @brief Sort the N elements from first with the network of Bose-Nelson of
+///        N elements
+//
+/// @param first : iterator to the first element of the range
+/// @param comp : object for to compare two elements, std::less or
+///               std::greater of an integer type
+/// @remarks The network is not stable
+//-----------------------------------------------------------------------------
+template<std::size_t N, class Iter_t, class Compare>
+inline void sort_network(Iter_t first, Compare comp)
+{
+    detail_network::network_sort_from<0, N>::sort(first, comp);
+};
+//
+//-----------------------------------------------------------------------------
+//  function : padded_network_sort
+/// @brief Sort the nelem elements from first, nelem <= N, with the network of
+///        N elements, in a copy filled with the greatest integer for comp.
+///        The copies of the greatest integer stay at the end, and as the
+///        integers equal can't be distinguished, the first nelem elements
+///        of the copy are the sorted data
+//
+/// @param first : iterator to the first element of the range
+/// @param nelem : number of elements of the range
+/// @param comp : object for to compare two elements, std::less or
+///               std::greater of an integer type
+//-----------------------------------------------------------------------------
+template<std::size_t N, class Iter_t, class Compare>
+inline void padded_network_sort(Iter_t first, std::size_t nelem, Compare comp)
+{
+    typedef typename std::iterator_traits<Iter_t>::value_type value_t;
+    const value_t lowest = (std::numeric_limits<value_t>::min)();
+    const value_t highest = (std::numeric_limits<value_t>::max)();
+    const value_t pad = comp(lowest, highest) ? highest : lowest;
+
+    value_t aux[N];
+    for (std::size_t i = 0; i < N; ++i) aux[i] = (i < nelem) ? first[i] : pad;
+    sort_network<N>(aux, comp);
+    for (std::size_t i = 0; i < N and i < nelem; ++i) first[i] = aux[i];
+};
+//
+//-----------------------------------------------------------------------------
+//  function : network_sort
+/// @brief Sort the range [first, last) with a network. The ranges of 2 to 4
+///        elements have a network of their size, and the others are padded
+///        to 8, 16 or 32 elements, for to have only these networks in the
+///        code
+//
+/// @param first : iterator to the first element of the range
+/// @param last : iterator after the last element of the range
+/// @param comp : object for to compare two elements, std::less or
+///               std::greater of an integer type
+/// @remarks The range must have at most sort_network_max elements
+//-----------------------------------------------------------------------------
+template<class Iter_t, class Compare>
+inline void network_sort(Iter_t first, Iter_t last, Compare comp)
+{
+    std::size_t nelem = std::size_t(last - first);
+    switch (nelem)
+    {
+    case 0:
+    case 1:  break;
+    case 2:  sort_network<2>(first, comp); break;
+    case 3:  sort_network<3>(first, comp); break;
+    case 4:  sort_network<4>(first, comp); break;
+    default:
+        if (nelem <= 8) padded_network_sort<8>(first, nelem, comp);
+        else if (nelem <= 16) padded_network_sort<16>(first, nelem, comp);
+        else padded_network_sort<32>(first, nelem, comp);
+        break;
+    };
+};
+//
+//****************************************************************************
+};//    End namespace common
+};//    End namespace sort
+};//    End namespace boost
+//****************************************************************************
+//
+#endif
@@ -73,6 +73,14 @@ public:
     //-------------------------------------------------------------------------
     explicit stack_cnc(void): v_t() { };
 
+    //
+    //-------------------------------------------------------------------------
+    //  function : stack_cnc
+    /// @brief  constructor
+    /// @param [in] alloc : allocator of the elements
+    //-------------------------------------------------------------------------
+    explicit stack_cnc(const Allocator &alloc): v_t(alloc) { };
+
     //
     //-------------------------------------------------------------------------
     //  function : stack_cnc
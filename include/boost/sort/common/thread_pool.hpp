@@ -0,0 +1,353 @@
+//----------------------------------------------------------------------------
+/// @file   thread_pool.hpp
+/// @brief  This file contains the class thread_pool, a set of persistent
+///         threads shared by the parallel algorithms, and the default pool
+///         used when the caller doesn't provide one
+///
+///         Distributed under the Boost Software License, Version 1.0.\n
+///         ( See accompanying file LICENSE_1_0.txt or copy at
+///           http://www.boost.org/LICENSE_1_0.txt  )
+/// @version 0.1
+///
+/// @remarks
+//-----------------------------------------------------------------------------
+#ifndef __BOOST_SORT_PARALLEL_DETAIL_UTIL_THREAD_POOL_HPP
+#define __BOOST_SORT_PARALLEL_DETAIL_UTIL_THREAD_POOL_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace boost
+{
+namespace sort
+{
+namespace common
+{
+
+//
+//###########################################################################
+//                                                                         ##
+//    ################################################################     ##
+//    #                                                              #     ##
+//    #                      C L A S S                               #     ##
+//    #                  T H R E A D _ P O O L                       #     ##
+//    #                                                              #     ##
+//    ################################################################     ##
+//                                                                         ##
+//###########################################################################
+//
+//---------------------------------------------------------------------------
+/// @class  thread_pool
+/// @brief This class contains a set of threads, created in the construction
+///        and joined in the destruction, which execute the works inserted
+///        with async.
+/// @remarks The threads waiting for a work with the function wait, execute
+///          the works pending meanwhile. Then a work can wait for other works
+///          inserted in the same pool without blocking the pool, and a pool
+///          with less threads than works still progress.
+/// @remarks The function run doesn't allocate memory : its calls are in a
+///          job in the stack of the calling thread, from where the threads
+///          of the pool take them
+//---------------------------------------------------------------------------
+class thread_pool
+{
+public:
+    //------------------------------------------------------------------------
+    //                     D E F I N I T I O N S
+    //------------------------------------------------------------------------
+    typedef std::function< void(void) > function_t;
+
+private:
+    //------------------------------------------------------------------------
+    /// @struct job_t
+    /// @brief calls func(1) ... func(ncall - 1) of a run. The variables,
+    ///        except call and func, are protected by the mutex of the pool
+    //------------------------------------------------------------------------
+    struct job_t
+    {
+        void (*call)(void *, uint32_t);
+        void *func;
+        uint32_t ncall;
+        uint32_t next;       // next call to start
+        uint32_t pending;    // calls not finished
+        std::exception_ptr error;
+        job_t *next_job;     // next job of the list of the pool
+    };
+
+    //-------------------------------------------------------------------------
+    //                   INTERNAL VARIABLES
+    //-------------------------------------------------------------------------
+    std::vector< std::thread > vthread;
+    std::deque< function_t > works;
+    // jobs with calls not started, the last inserted first
+    job_t *jobs;
+    std::mutex mtx;
+    std::condition_variable cv;
+    // notified when all the calls of a job are finished, and with the new
+    // jobs and works, to the threads waiting in run
+    std::condition_variable cv_done;
+    bool stop;
+
+    template< class Func >
+    static void call_func(void *func, uint32_t i)
+    {
+        (*static_cast< Func * >(func))(i);
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : execute_one
+    /// @brief Execute a call of the first job, or else a pending work
+    /// @param lk : lock of the mutex, locked. It is unlocked during the
+    ///             execution
+    /// @return true : a call or a work was executed, false : nothing pending
+    //-------------------------------------------------------------------------
+    bool execute_one(std::unique_lock< std::mutex > &lk)
+    {
+        if (jobs != nullptr)
+        {
+            job_t *job = jobs;
+            uint32_t i = job->next++;
+            if (job->next == job->ncall) jobs = job->next_job;
+            lk.unlock( );
+            std::exception_ptr error;
+            try
+            {
+                job->call(job->func, i);
+            }
+            catch (...)
+            {
+                error = std::current_exception( );
+            };
+            lk.lock( );
+            if (error and not job->error) job->error = error;
+            // the job can be destroyed when pending is 0
+            if (--job->pending == 0) cv_done.notify_all( );
+            return true;
+        };
+        if (works.empty( )) return false;
+        function_t func = std::move(works.front( ));
+        works.pop_front( );
+        lk.unlock( );
+        func( );
+        func = nullptr;
+        lk.lock( );
+        return true;
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : execute
+    /// @brief function executed by each thread of the pool, until the
+    ///        destruction of the pool
+    //-------------------------------------------------------------------------
+    void execute(void)
+    {
+        std::unique_lock< std::mutex > lk(mtx);
+        while (true)
+        {
+            cv.wait(lk, [this]( )
+            {
+                return stop or jobs != nullptr or not works.empty( );
+            });
+            if (not execute_one(lk)) return;
+        };
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : run_one
+    /// @brief Extract a pending work and execute it
+    /// @return true : a work was executed, false : there are no pending works
+    //-------------------------------------------------------------------------
+    bool run_one(void)
+    {
+        std::unique_lock< std::mutex > lk(mtx);
+        return execute_one(lk);
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : destroy
+    /// @brief Finish the threads when the pending works are done, and join
+    ///        them
+    //-------------------------------------------------------------------------
+    void destroy(void)
+    {
+        {
+            std::lock_guard< std::mutex > lk(mtx);
+            stop = true;
+        };
+        cv.notify_all( );
+        for (uint32_t i = 0; i < vthread.size( ); ++i) vthread[i].join( );
+        vthread.clear( );
+    };
+
+public:
+    //
+    //-------------------------------------------------------------------------
+    //  function : thread_pool
+    /// @brief  constructor
+    /// @param [in] nthread : number of threads of the pool
+    //-------------------------------------------------------------------------
+    explicit thread_pool(uint32_t nthread = std::thread::hardware_concurrency())
+    : jobs(nullptr), stop(false)
+    {
+        try
+        {
+            for (uint32_t i = 0; i < nthread; ++i)
+                vthread.emplace_back(&thread_pool::execute, this);
+        }
+        catch (...)
+        {
+            destroy( );
+            throw;
+        };
+    };
+
+    thread_pool(const thread_pool &) = delete;
+    thread_pool &operator=(const thread_pool &) = delete;
+
+    //
+    //-------------------------------------------------------------------------
+    //  function : ~thread_pool
+    /// @brief  Destructor. Execute the pending works and join the threads
+    //-------------------------------------------------------------------------
+    ~thread_pool(void) { destroy( ); };
+
+    //-------------------------------------------------------------------------
+    //  function : size
+    /// @brief number of threads of the pool
+    //-------------------------------------------------------------------------
+    uint32_t size(void) const { return (uint32_t) vthread.size( ); };
+
+    //-------------------------------------------------------------------------
+    //  function : async
+    /// @brief Insert a work in the pool
+    /// @param func : function without arguments to execute
+    /// @return future for to wait the end of the work, and obtain its result
+    ///         or its exception
+    //-------------------------------------------------------------------------
+    template< class Func >
+    std::future< decltype(std::declval< Func & >( )( )) > async(Func func)
+    {
+        typedef decltype(std::declval< Func & >( )( )) result_t;
+        std::shared_ptr< std::packaged_task< result_t( ) > > task =
+            std::make_shared< std::packaged_task< result_t( ) > >(
+                std::move(func));
+        std::future< result_t > fut = task->get_future( );
+        {
+            std::lock_guard< std::mutex > lk(mtx);
+            works.emplace_back([task]( ) { (*task)( ); });
+        };
+        cv.notify_one( );
+        cv_done.notify_all( );
+        return fut;
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : wait
+    /// @brief Wait until the future is ready, executing the pending works of
+    ///        the pool meanwhile
+    /// @param fut : future returned by async
+    //-------------------------------------------------------------------------
+    template< class T >
+    void wait(std::future< T > &fut)
+    {
+        while (fut.wait_for(std::chrono::seconds(0)) !=
+               std::future_status::ready)
+        {
+            if (not run_one( ))
+            {
+                fut.wait( );
+                return;
+            };
+        };
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : run
+    /// @brief Execute func(0) ... func(nthread - 1) in parallel, func(0) in
+    ///        the calling thread and the others in the pool, and wait the end
+    ///        of all of them
+    /// @param nthread : number of calls to func
+    /// @param func : function with an uint32_t argument
+    /// @remarks When a call throws an exception, the other calls finish
+    ///          before rethrowing the first exception, because they can use
+    ///          variables of the caller
+    /// @remarks Doesn't allocate memory. While the calls of the pool are not
+    ///          finished, the calling thread executes the pending calls and
+    ///          works
+    //-------------------------------------------------------------------------
+    template< class Func >
+    void run(uint32_t nthread, Func func)
+    {
+        job_t job;
+        job.call = &call_func< Func >;
+        job.func = &func;
+        job.ncall = nthread;
+        job.next = 1;
+        job.pending = (nthread > 1) ? nthread - 1 : 0;
+        job.next_job = nullptr;
+        if (job.pending != 0)
+        {
+            {
+                std::lock_guard< std::mutex > lk(mtx);
+                job.next_job = jobs;
+                jobs = &job;
+            };
+            cv.notify_all( );
+            cv_done.notify_all( );
+        };
+
+        std::exception_ptr error;
+        try
+        {
+            func(0);
+        }
+        catch (...)
+        {
+            error = std::current_exception( );
+        };
+
+        std::unique_lock< std::mutex > lk(mtx);
+        while (job.pending != 0)
+        {
+            if (not execute_one(lk)) cv_done.wait(lk);
+        };
+        if (not error) error = job.error;
+        lk.unlock( );
+        if (error) std::rethrow_exception(error);
+    };
+};
+// end class thread_pool
+
+//-----------------------------------------------------------------------------
+//  function : default_thread_pool
+/// @brief Pool used by the parallel algorithms when the caller doesn't
+///        provide one. Created in the first use, with one thread less than
+///        the hardware, because the calling thread works too
+//-----------------------------------------------------------------------------
+inline thread_pool &default_thread_pool(void)
+{
+    static thread_pool pool(std::thread::hardware_concurrency( ) > 2
+                            ? std::thread::hardware_concurrency( ) - 1 : 1);
+    return pool;
+};
+
+//***************************************************************************
+};// end namespace common
+
+using common::thread_pool;
+using common::default_thread_pool;
+
+};// end namespace sort
+};// end namespace boost
+//***************************************************************************
+#endif
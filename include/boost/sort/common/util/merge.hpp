@@ -49,7 +49,7 @@ namespace here = boost::sort::common::util;
 //                     const Iter2_t end_buf2, Iter2_t buf_out, Compare comp)
 //
 // template < class Iter1_t, class Iter2_t, class Compare >
-// Iter2_t merge_half_backward (Iter1_t buf1,  Iter1_t end_buf1,
+// Iter1_t merge_half_backward (Iter1_t buf1,  Iter1_t end_buf1,
 //                              Iter2_t buf2, Iter2_t end_buf2,
 //                              Iter1_t end_buf_out, Compare comp)
 //
@@ -268,7 +268,7 @@ static Iter2_t merge_half(Iter1_t buf1, const Iter1_t end_buf1, Iter2_t buf2,
 ///                by the Iter1_t and Iter2_t
 //---------------------------------------------------------------------------
 template<class Iter1_t, class Iter2_t, class Compare>
-static Iter2_t merge_half_backward(Iter1_t buf1, Iter1_t end_buf1, Iter2_t buf2,
+static Iter1_t merge_half_backward(Iter1_t buf1, Iter1_t end_buf1, Iter2_t buf2,
                                    Iter2_t end_buf2, Iter1_t end_buf_out,
                                    Compare comp)
 {
@@ -0,0 +1,233 @@
+//----------------------------------------------------------------------------
+/// @file file_run.hpp
+/// @brief This file contains the classes for to read and write the runs of
+///        the external sort, with large sequential accesses, and the class
+///        temp_file, which removes the temporary files
+///
+///         Distributed under the Boost Software License, Version 1.0.\n
+///         ( See accompanying file LICENSE_1_0.txt or copy at
+///           http://www.boost.org/LICENSE_1_0.txt  )
+/// @version 0.1
+///
+/// @remarks
+//-----------------------------------------------------------------------------
+#ifndef __BOOST_SORT_EXTERNAL_DETAIL_FILE_RUN_HPP
+#define __BOOST_SORT_EXTERNAL_DETAIL_FILE_RUN_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <ios>
+#include <string>
+#include <vector>
+#include <ciso646>
+
+namespace boost
+{
+namespace sort
+{
+namespace external_detail
+{
+//
+//---------------------------------------------------------------------------
+/// @class  temp_file
+/// @brief Name of a temporary file, which is removed in the destruction
+//---------------------------------------------------------------------------
+class temp_file
+{
+    std::string name;
+
+public:
+    explicit temp_file(const std::string &filename) : name(filename) { };
+
+    temp_file(const temp_file &) = delete;
+    temp_file &operator=(const temp_file &) = delete;
+
+    ~temp_file(void) { std::remove(name.c_str( )); };
+
+    const std::string &filename(void) const { return name; };
+};
+//
+//---------------------------------------------------------------------------
+/// @class  run_reader
+/// @brief Read sequentially the elements of a file, with a buffer of nbuf
+///        elements
+/// @tparam T : type of the elements, trivially copyable
+//---------------------------------------------------------------------------
+template< class T >
+class run_reader
+{
+    std::ifstream file;
+    std::vector< T > buf;
+    size_t pos, count;
+
+    //-------------------------------------------------------------------------
+    //  function : fill
+    /// @brief read the next elements of the file in the buffer
+    //-------------------------------------------------------------------------
+    void fill(void)
+    {
+        file.read(reinterpret_cast< char * >(buf.data( )),
+                  std::streamsize(buf.size( ) * sizeof(T)));
+        if (file.bad( ))
+            throw std::ios_base::failure("error reading a file\n");
+        if (size_t(file.gcount( )) % sizeof(T) != 0)
+            throw std::ios_base::failure("incorrect length of the file\n");
+        count = size_t(file.gcount( )) / sizeof(T);
+        pos = 0;
+    };
+
+public:
+    //-------------------------------------------------------------------------
+    //  function : run_reader
+    /// @brief constructor
+    /// @param filename : name of the file
+    /// @param nbuf : number of elements of the buffer
+    //-------------------------------------------------------------------------
+    run_reader(const std::string &filename, size_t nbuf)
+    : buf(nbuf == 0 ? 1 : nbuf), pos(0), count(0)
+    {
+        file.rdbuf( )->pubsetbuf(nullptr, 0);
+        file.open(filename, std::ios_base::in | std::ios_base::binary);
+        if (file.fail( ))
+            throw std::ios_base::failure("could not open file \n");
+        fill( );
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : empty
+    /// @brief indicate if all the elements of the file had been read
+    //-------------------------------------------------------------------------
+    bool empty(void) const { return pos == count; };
+
+    //-------------------------------------------------------------------------
+    //  function : top
+    /// @brief next element of the file. The reader must not be empty
+    //-------------------------------------------------------------------------
+    const T &top(void) const { return buf[pos]; };
+
+    //-------------------------------------------------------------------------
+    //  function : pop
+    /// @brief advance to the next element of the file
+    //-------------------------------------------------------------------------
+    void pop(void)
+    {
+        if (++pos == count and not file.eof( )) fill( );
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : read
+    /// @brief read up to n elements of the file
+    /// @param data : pointer to the memory where store the elements
+    /// @param n : maximum number of elements to read
+    /// @return number of elements read
+    //-------------------------------------------------------------------------
+    size_t read(T *data, size_t n)
+    {
+        size_t nread = 0;
+        while (nread < n and not empty( ))
+        {
+            size_t nmove = count - pos;
+            if (nmove > n - nread) nmove = n - nread;
+            std::copy(buf.data( ) + pos, buf.data( ) + pos + nmove,
+                      data + nread);
+            nread += nmove;
+            pos += nmove;
+            if (pos == count and not file.eof( )) fill( );
+        };
+        return nread;
+    };
+};
+//
+//---------------------------------------------------------------------------
+/// @class  run_writer
+/// @brief Write sequentially elements in a file, with a buffer of nbuf
+///        elements
+/// @tparam T : type of the elements, trivially copyable
+//---------------------------------------------------------------------------
+template< class T >
+class run_writer
+{
+    std::ofstream file;
+    std::vector< T > buf;
+    size_t count;
+
+    //-------------------------------------------------------------------------
+    //  function : write_data
+    /// @brief write n elements in the file, without pass through the buffer
+    //-------------------------------------------------------------------------
+    void write_data(const T *data, size_t n)
+    {
+        file.write(reinterpret_cast< const char * >(data),
+                   std::streamsize(n * sizeof(T)));
+        if (file.fail( ))
+            throw std::ios_base::failure("error writing a file\n");
+    };
+
+public:
+    //-------------------------------------------------------------------------
+    //  function : run_writer
+    /// @brief constructor. The file is truncated
+    /// @param filename : name of the file
+    /// @param nbuf : number of elements of the buffer
+    //-------------------------------------------------------------------------
+    run_writer(const std::string &filename, size_t nbuf)
+    : buf(nbuf == 0 ? 1 : nbuf), count(0)
+    {
+        file.rdbuf( )->pubsetbuf(nullptr, 0);
+        file.open(filename, std::ios_base::out | std::ios_base::binary |
+                            std::ios_base::trunc);
+        if (file.fail( ))
+            throw std::ios_base::failure("could not open file \n");
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : push
+    /// @brief insert an element at the end of the file
+    //-------------------------------------------------------------------------
+    void push(const T &val)
+    {
+        buf[count] = val;
+        if (++count == buf.size( )) flush( );
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : write
+    /// @brief insert n elements at the end of the file
+    //-------------------------------------------------------------------------
+    void write(const T *data, size_t n)
+    {
+        flush( );
+        write_data(data, n);
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : flush
+    /// @brief write in the file the elements of the buffer
+    //-------------------------------------------------------------------------
+    void flush(void)
+    {
+        if (count != 0) write_data(buf.data( ), count);
+        count = 0;
+    };
+
+    //-------------------------------------------------------------------------
+    //  function : close
+    /// @brief write the buffer, and close the file
+    //-------------------------------------------------------------------------
+    void close(void)
+    {
+        flush( );
+        file.close( );
+        if (file.fail( ))
+            throw std::ios_base::failure("error writing a file\n");
+    };
+};
+//
+//****************************************************************************
+};// end namespace external_detail
+};// end namespace sort
+};// end namespace boost
+//****************************************************************************
+#endif
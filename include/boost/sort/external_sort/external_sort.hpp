@@ -0,0 +1,376 @@
+//----------------------------------------------------------------------------
+/// @file external_sort.hpp
+/// @brief This file contains the external sort, for to sort binary files
+///        greater than the memory. The file is divided in runs which fit in
+///        the memory, each run is sorted and written in a temporary file,
+///        and the runs are merged in the output file.
+///
+///         Distributed under the Boost Software License, Version 1.0.\n
+///         ( See accompanying file LICENSE_1_0.txt or copy at
+///           http://www.boost.org/LICENSE_1_0.txt  )
+/// @version 0.1
+///
+/// @remarks
+//-----------------------------------------------------------------------------
+#ifndef __BOOST_SORT_EXTERNAL_SORT_HPP
+#define __BOOST_SORT_EXTERNAL_SORT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <ios>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <ciso646>
+#include <boost/sort/block_indirect_sort/block_indirect_sort.hpp>
+#include <boost/sort/spreadsort/integer_sort.hpp>
+#include <boost/sort/external_sort/ext_detail/file_run.hpp>
+
+namespace boost
+{
+namespace sort
+{
+//
+//---------------------------------------------------------------------------
+/// @struct external_sort_config
+/// @brief Parameters of the external sort
+//---------------------------------------------------------------------------
+struct external_sort_config
+{
+    // Bytes of memory used for the runs and for the buffers of the merge
+    size_t memory;
+
+    // Directory where create the temporary files with the runs
+    std::string temp_dir;
+
+    // Number of threads used for to sort each run
+    uint32_t nthread;
+
+    // Minimal number of bytes read from each run in the merge. It limits the
+    // number of runs merged at the same time to memory / io_block - 1. When
+    // there are more runs, they are merged in several passes
+    size_t io_block;
+
+    external_sort_config(void)
+    : memory(size_t(1) << 28), temp_dir("."),
+      nthread(std::thread::hardware_concurrency( )),
+      io_block(size_t(1) << 22) { };
+};
+
+namespace external_detail
+{
+//---------------------------------------------------------------------------
+//                    USING SENTENCES
+//---------------------------------------------------------------------------
+namespace bsp = boost::sort::spreadsort;
+//
+//-----------------------------------------------------------------------------
+//  function : sort_run
+/// @brief sort the elements of a run in memory with block_indirect_sort
+//-----------------------------------------------------------------------------
+template< class T, class Compare >
+inline void sort_run(T *first, T *last, Compare comp, uint32_t nthread,
+                     std::false_type)
+{
+    block_indirect_sort(first, last, comp, nthread);
+};
+//
+//-----------------------------------------------------------------------------
+//  function : sort_run
+/// @brief sort the elements of a run of integers with the default comparison.
+///        With only one thread, integer_sort is used
+//-----------------------------------------------------------------------------
+template< class T, class Compare >
+inline void sort_run(T *first, T *last, Compare comp, uint32_t nthread,
+                     std::true_type)
+{
+    if (nthread < 2)
+        bsp::integer_sort(first, last);
+    else
+        block_indirect_sort(first, last, comp, nthread);
+};
+//
+//-----------------------------------------------------------------------------
+//  function : sort_run
+/// @brief sort the elements of a run in memory
+//-----------------------------------------------------------------------------
+template< class T, class Compare >
+inline void sort_run(T *first, T *last, Compare comp, uint32_t nthread)
+{
+    typedef std::integral_constant< bool, std::is_integral< T >::value and
+        std::is_same< Compare, std::less< T > >::value > use_integer_sort;
+    sort_run(first, last, comp, nthread, use_integer_sort( ));
+};
+//
+///---------------------------------------------------------------------------
+/// @struct external_sort
+/// @brief This a structure for to implement the external sort. All the work
+///        is done in the constructor, and the temporary files are removed in
+///        the destruction, even when an exception is thrown
+/// @tparam T : type of the elements of the file, trivially copyable
+/// @tparam Compare : object for to compare two elements
+//----------------------------------------------------------------------------
+template< class T, class Compare >
+struct external_sort
+{
+    //-------------------------------------------------------------------------
+    //                      DEFINITIONS
+    //-------------------------------------------------------------------------
+    typedef std::unique_ptr< temp_file > file_ptr;
+
+    //-------------------------------------------------------------------------
+    //                     VARIABLES
+    //-------------------------------------------------------------------------
+    Compare comp;
+    external_sort_config config;
+
+    // number of elements of memory, and of the minimal buffer of a run
+    size_t nmem, nblock;
+
+    // prefix of the name of the temporary files, and number of files created
+    std::string prefix;
+    uint64_t nfile;
+
+    // temporary files with the runs pending of merge
+    std::deque< file_ptr > runs;
+
+    //------------------------------------------------------------------------
+    //                F U N C T I O N S
+    //------------------------------------------------------------------------
+    external_sort(const std::string &input, const std::string &output,
+                  Compare cmp, const external_sort_config &cfg);
+
+    file_ptr new_temp_file(void);
+
+    bool create_runs(const std::string &input, const std::string &output);
+
+    void merge(uint32_t nrun, const std::string &output);
+};
+//
+//############################################################################
+//                                                                          ##
+//              N O N    I N L I N E      F U N C T I O N S                 ##
+//                                                                          ##
+//                                                                          ##
+//############################################################################
+//
+//-----------------------------------------------------------------------------
+//  function : external_sort
+/// @brief constructor of the class, which does the sort
+///
+/// @param input : name of the file to sort
+/// @param output : name of the file with the sorted elements
+/// @param cmp : object for to compare two elements
+/// @param cfg : memory, directory and threads used
+//-----------------------------------------------------------------------------
+template< class T, class Compare >
+external_sort< T, Compare >
+::external_sort(const std::string &input, const std::string &output,
+                Compare cmp, const external_sort_config &cfg)
+: comp(cmp), config(cfg), nfile(0)
+{
+    nblock = std::max< size_t >(config.io_block / sizeof(T), 1);
+    nmem = std::max< size_t >(config.memory / sizeof(T), 3 * nblock);
+
+    std::ostringstream name;
+    name << config.temp_dir << "/boost_sort_" << std::hex
+         << std::random_device( )( ) << "_";
+    prefix = name.str( );
+
+    if (not create_runs(input, output)) return;
+
+    //------------------------------------------------------------------------
+    // while there are more runs than the fan-in, merge the oldest runs in a
+    // new run
+    //------------------------------------------------------------------------
+    uint32_t fan_in = uint32_t(std::min< size_t >(nmem / nblock - 1, 1 << 20));
+    while (runs.size( ) > fan_in)
+    {
+        file_ptr merged = new_temp_file( );
+        merge(fan_in, merged->filename( ));
+        runs.push_back(std::move(merged));
+    };
+    merge(uint32_t(runs.size( )), output);
+};
+//
+//-----------------------------------------------------------------------------
+//  function : new_temp_file
+/// @brief create a new name of temporary file, removed in the destruction
+//-----------------------------------------------------------------------------
+template< class T, class Compare >
+typename external_sort< T, Compare >::file_ptr
+external_sort< T, Compare >::new_temp_file(void)
+{
+    std::ostringstream name;
+    name << prefix << (nfile++) << ".run";
+    return file_ptr(new temp_file(name.str( )));
+};
+//
+//-----------------------------------------------------------------------------
+//  function : create_runs
+/// @brief read the input file in runs of nmem elements, sort them and write
+///        each in a temporary file
+/// @param input : name of the file to sort
+/// @param output : name of the output file
+/// @return false : the input fits in a run, and had been written in the output
+///         true : the runs are in temporary files
+//-----------------------------------------------------------------------------
+template< class T, class Compare >
+bool external_sort< T, Compare >
+::create_runs(const std::string &input, const std::string &output)
+{
+    std::ifstream file(input, std::ios_base::in | std::ios_base::binary |
+                              std::ios_base::ate);
+    if (file.fail( )) throw std::ios_base::failure("could not open file \n");
+    uint64_t length = uint64_t(file.tellg( ));
+    file.close( );
+    if (length % sizeof(T) != 0)
+        throw std::ios_base::failure("incorrect length of the file\n");
+
+    // the memory is used by the run and the buffer of the reader
+    std::vector< T > data(size_t(std::min< uint64_t >(length / sizeof(T),
+                                                      nmem - nblock)));
+    std::unique_ptr< run_reader< T > > reader(new run_reader< T >(input,
+                                                                  nblock));
+    while (true)
+    {
+        size_t nread = reader->read(data.data( ), data.size( ));
+
+        if (nread == 0 and not runs.empty( )) return true;
+        sort_run(data.data( ), data.data( ) + nread, comp, config.nthread);
+
+        if (runs.empty( ) and reader->empty( ))
+        {
+            // The input fits in memory. The input is closed before writing,
+            // in order to allow the input and the output be the same file
+            reader.reset( );
+            run_writer< T > writer(output, 0);
+            writer.write(data.data( ), nread);
+            writer.close( );
+            return false;
+        };
+        file_ptr run = new_temp_file( );
+        run_writer< T > writer(run->filename( ), 0);
+        writer.write(data.data( ), nread);
+        writer.close( );
+        runs.push_back(std::move(run));
+    };
+};
+//
+//-----------------------------------------------------------------------------
+//  function : merge
+/// @brief merge the first nrun runs in a file, and remove them
+/// @param nrun : number of runs to merge
+/// @param output : name of the file with the result
+//-----------------------------------------------------------------------------
+template< class T, class Compare >
+void external_sort< T, Compare >
+::merge(uint32_t nrun, const std::string &output)
+{
+    size_t nbuf = nmem / (nrun + 1);
+    std::vector< std::unique_ptr< run_reader< T > > > vreader;
+    vreader.reserve(nrun);
+    for (uint32_t i = 0; i < nrun; ++i)
+        vreader.emplace_back(new run_reader< T >(runs[i]->filename( ), nbuf));
+    run_writer< T > writer(output, nbuf);
+
+    //------------------------------------------------------------------------
+    // heap with the runs with elements. The first in the heap is the run with
+    // the lowest element, and with equal elements the first run
+    //------------------------------------------------------------------------
+    auto lower = [&](uint32_t a, uint32_t b)
+    {
+        if (comp(vreader[b]->top( ), vreader[a]->top( ))) return true;
+        if (comp(vreader[a]->top( ), vreader[b]->top( ))) return false;
+        return b < a;
+    };
+    std::vector< uint32_t > heap;
+    heap.reserve(nrun);
+    for (uint32_t i = 0; i < nrun; ++i)
+        if (not vreader[i]->empty( )) heap.push_back(i);
+    std::make_heap(heap.begin( ), heap.end( ), lower);
+
+    while (not heap.empty( ))
+    {
+        std::pop_heap(heap.begin( ), heap.end( ), lower);
+        run_reader< T > &reader = *vreader[heap.back( )];
+        writer.push(reader.top( ));
+        reader.pop( );
+        if (reader.empty( ))
+            heap.pop_back( );
+        else
+            std::push_heap(heap.begin( ), heap.end( ), lower);
+    };
+    writer.close( );
+    vreader.clear( );
+    for (uint32_t i = 0; i < nrun; ++i) runs.pop_front( );
+};
+//
+//****************************************************************************
+};// end namespace external_detail
+//****************************************************************************
+//
+//############################################################################
+//                                                                          ##
+//                                                                          ##
+//                     E X T E R N A L _ S O R T                            ##
+//                                                                          ##
+//                                                                          ##
+//############################################################################
+//
+//-----------------------------------------------------------------------------
+//  function : external_sort
+/// @brief sort a binary file of elements of type T, which can be greater than
+///        the memory
+///
+/// @param input : name of the file to sort
+/// @param output : name of the file with the sorted elements. It can be the
+///                 same than the input
+/// @param comp : object for to compare two elements
+/// @param config : memory, directory of the temporary files and number of
+///                 threads used
+/// @exception std::ios_base::failure : error reading or writing a file, or
+///            the size of the input is not a multiple of sizeof(T)
+/// @remarks The disk space needed is the size of the input for the temporary
+///          files, plus the output
+//-----------------------------------------------------------------------------
+template< class T, class Compare = std::less< T > >
+void external_sort(const std::string &input, const std::string &output,
+                   Compare comp = Compare( ),
+                   const external_sort_config &config = external_sort_config( ))
+{
+    static_assert(std::is_trivially_copyable< T >::value,
+                  "external_sort needs trivially copyable elements");
+    external_detail::external_sort< T, Compare >(input, output, comp, config);
+};
+//
+//-----------------------------------------------------------------------------
+//  function : external_sort
+/// @brief sort a binary file of elements of type T with std::less
+///
+/// @param input : name of the file to sort
+/// @param output : name of the file with the sorted elements
+/// @param config : memory, directory of the temporary files and number of
+///                 threads used
+//-----------------------------------------------------------------------------
+template< class T >
+void external_sort(const std::string &input, const std::string &output,
+                   const external_sort_config &config)
+{
+    external_sort< T, std::less< T > >(input, output, std::less< T >( ),
+                                       config);
+};
+//
+//****************************************************************************
+};//    End namespace sort
+};//    End namespace boost
+//****************************************************************************
+//
+#endif
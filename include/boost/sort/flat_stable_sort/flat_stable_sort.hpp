@@ -20,6 +20,7 @@
 #include <boost/sort/common/range.hpp>
 #include <boost/sort/common/util/traits.hpp>
 #include <boost/sort/common/indirect.hpp>
+#include <boost/sort/common/natural_merge.hpp>
 
 #include <cstdlib>
 #include <functional>
@@ -84,13 +85,16 @@ public:
                      circular_t *ptr_circ)
                     : merge_block_t(first, last, comp, ptr_circ)
     {
-        divide(index.begin(), index.end());
+        if (not natural_divide(index.begin(), index.end()))
+            divide(index.begin(), index.end());
         rearrange_with_index();
     };
 
     flat_stable_sort(Iter_t first, Iter_t last, Compare comp = Compare())
                     : flat_stable_sort(first, last, comp, nullptr) { };
 
+    bool natural_divide(it_index itx_first, it_index itx_last);
+
     void divide(it_index itx_first, it_index itx_last);
 
     void sort_small(it_index itx_first, it_index itx_last);
@@ -104,6 +108,51 @@ public:
 //----------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------
+//  function : natural_divide
+/// @brief : sort the data made of a few long runs merging the runs. The
+///          blocks with the end of a run inside are sorted, and the blocks
+///          are merged in runs of blocks, with the policy of powersort
+/// @param itx_first : iterator to the first block in the index
+/// @param itx_last : iterator to the last block in the index
+/// @return : true : the data are sorted, false : the runs are too short,
+///           and the data must be sorted with divide
+//------------------------------------------------------------------------
+template <class Iter_t, typename Compare, uint32_t Power2>
+bool flat_stable_sort <Iter_t, Compare, Power2>
+::natural_divide(it_index itx_first, it_index itx_last)
+{
+    size_t nblock = size_t(itx_last - itx_first);
+    if (nblock < 8) return false;
+    range_it rng = get_group_range(*itx_first, nblock);
+
+    std::vector<size_t> vrun;
+    if (not bsc::find_natural_runs(rng.first, rng.last, cmp, vrun))
+        return false;
+    if (vrun.size() == 1) return true;
+
+    // end of each run of blocks
+    std::vector<size_t> vblock;
+    size_t irun = 0;
+    for (size_t i = 0; i < nblock; ++i)
+    {
+        range_it rng_block = get_range(*(itx_first + i));
+        while (vrun[irun] <= size_t(rng_block.first - rng.first)) ++irun;
+        if (vrun[irun] < size_t(rng_block.last - rng.first))
+            sort_small(itx_first + i, itx_first + i + 1);
+        if (i != 0 and cmp(*rng_block.first, *(rng_block.first - 1)))
+            vblock.push_back(i);
+    };
+    vblock.push_back(nblock);
+
+    bsc::power_merge(vblock, [&](size_t first1, size_t first2, size_t last2)
+    {
+        merge_range_pos(itx_first + first1, itx_first + first2,
+                        itx_first + last2);
+    });
+    return true;
+};
+//
+//------------------------------------------------------------------------
 //  function :
 /// @brief :
 /// @param Pos :
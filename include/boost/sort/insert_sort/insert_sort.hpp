@@ -17,8 +17,10 @@
 #include <iterator>
 #include <algorithm>
 #include <utility> // std::swap
+#include <type_traits>
 #include <boost/sort/common/util/traits.hpp>
 #include <boost/sort/common/util/insert.hpp>
+#include <boost/sort/common/sort_network.hpp>
 
 namespace boost
 {
@@ -28,12 +30,39 @@ using common::util::compare_iter;
 using common::util::value_iter;
 //
 //-----------------------------------------------------------------------------
+//  function : network_insert_sort
+/// @brief : Sort the range with a sorting network, when the elements are
+///          integers compared with std::less or std::greater, and they are
+///          no more than common::sort_network_max
+/// @param first: iterator to the first element of the range
+/// @param last : iterator to the next element of the last in the range
+/// @param comp : object for to do the comparison between the elements
+/// @return true : the range is sorted, false : not sorted
+//-----------------------------------------------------------------------------
+template < class Iter_t, typename Compare >
+static bool network_insert_sort (Iter_t first, Iter_t last, Compare comp,
+                                 std::true_type)
+{
+    if (size_t (last - first) > common::sort_network_max) return false;
+    common::network_sort (first, last, comp);
+    return true;
+};
+
+template < class Iter_t, typename Compare >
+static bool network_insert_sort (Iter_t, Iter_t, Compare, std::false_type)
+{
+    return false;
+};
+//
+//-----------------------------------------------------------------------------
 //  function : insert_sort
 /// @brief : Insertion sort algorithm
 /// @param first: iterator to the first element of the range
 /// @param last : iterator to the next element of the last in the range
 /// @param comp : object for to do the comparison between the elements
-/// @remarks This algorithm is O(N^2)
+/// @remarks This algorithm is O(N^2). The small ranges of integers are
+///          sorted with a sorting network, which is not stable, but the
+///          equal integers can't be distinguished
 //-----------------------------------------------------------------------------
 template < class Iter_t, typename Compare = compare_iter < Iter_t > >
 static void insert_sort (Iter_t first, Iter_t last,
@@ -45,6 +74,9 @@ static void insert_sort (Iter_t first, Iter_t last,
     typedef value_iter< Iter_t > value_t;
 
     if ((last - first) < 2) return;
+    if (network_insert_sort (first, last, comp, std::integral_constant<bool,
+                    common::use_sort_network<Iter_t, Compare>::value> ()))
+        return;
 
     for (Iter_t it_examine = first + 1; it_examine != last; ++it_examine)
     {
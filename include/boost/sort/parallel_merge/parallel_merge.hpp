@@ -0,0 +1,318 @@
+//----------------------------------------------------------------------------
+/// @file parallel_merge.hpp
+/// @brief This file contains the parallel_merge, a stable merge of many
+///        sorted ranges with several threads
+///
+///         Distributed under the Boost Software License, Version 1.0.\n
+///         ( See accompanying file LICENSE_1_0.txt or copy at
+///           http://www.boost.org/LICENSE_1_0.txt  )
+/// @version 0.1
+///
+/// @remarks
+//-----------------------------------------------------------------------------
+#ifndef __BOOST_SORT_PARALLEL_DETAIL_PARALLEL_MERGE_HPP
+#define __BOOST_SORT_PARALLEL_DETAIL_PARALLEL_MERGE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <ciso646>
+#include <boost/sort/common/loser_tree.hpp>
+#include <boost/sort/common/range.hpp>
+#include <boost/sort/common/thread_pool.hpp>
+#include <boost/sort/common/util/atomic.hpp>
+#include <boost/sort/common/util/traits.hpp>
+
+namespace boost
+{
+namespace sort
+{
+namespace merge_detail
+{
+//---------------------------------------------------------------------------
+//                    USING SENTENCES
+//---------------------------------------------------------------------------
+namespace bsc = boost::sort::common;
+namespace bscu = boost::sort::common::util;
+using bsc::range;
+using bsc::loser_tree;
+using bscu::atomic_add;
+//
+///---------------------------------------------------------------------------
+/// @struct parallel_merge
+/// @brief This a structure for to implement the parallel merge. The output
+///        is divided in slices with splitters obtained from a sample of the
+///        ranges, and each slice is merged by a thread with a loser tree
+//----------------------------------------------------------------------------
+template< class Iter_t, class Iter2_t, class Compare >
+struct parallel_merge
+{
+    //------------------------------------------------------------------------
+    //                     DEFINITIONS
+    //------------------------------------------------------------------------
+    typedef range< Iter_t > range_it;
+
+    //------------------------------------------------------------------------
+    //                VARIABLES AND CONSTANTS
+    //------------------------------------------------------------------------
+    // minimun numbers of elements for to be merged in parallel mode
+    static const size_t nelem_min = (1 << 16);
+
+    // number of samples of each slice
+    static const uint32_t nsample_slice = 8;
+
+    Compare comp;
+
+    // for each slice, the part of each range which is inside, and the
+    // position of the slice in the output
+    std::vector< std::vector< range_it > > vv_slice;
+    std::vector< Iter2_t > vdest;
+
+    // counter of the slices merged
+    std::atomic< uint32_t > njob;
+
+    // iterator after the last element of the output
+    Iter2_t dest_last;
+
+    //------------------------------------------------------------------------
+    //                       FUNCTIONS OF THE STRUCT
+    //------------------------------------------------------------------------
+    parallel_merge(const std::vector< range_it > &vrange, Iter2_t dest,
+                   Compare cmp, uint32_t nthread, thread_pool &pool);
+
+    void split(const std::vector< range_it > &vrange, Iter2_t dest,
+               uint32_t nslice);
+
+    //-----------------------------------------------------------------------
+    //  function : merge_slice
+    /// @brief copy the merge of the ranges of a slice in its position of
+    ///        the output
+    //-----------------------------------------------------------------------
+    void merge_slice(uint32_t job)
+    {
+        std::vector< range_it > &vr = vv_slice[job];
+        if (vr.size( ) == 1)
+            std::copy(vr[0].first, vr[0].last, vdest[job]);
+        else if (vr.size( ) > 1)
+            loser_tree< Iter_t, Compare >(vr, comp).copy(vdest[job]);
+    };
+
+    //-----------------------------------------------------------------------
+    //  function : execute
+    /// @brief function executed by each thread, merging slices until all are
+    ///        merged
+    //-----------------------------------------------------------------------
+    void execute(void)
+    {
+        uint32_t job = 0;
+        while ((job = atomic_add(njob, 1)) < vv_slice.size( ))
+            merge_slice(job);
+    };
+};
+//
+//############################################################################
+//                                                                          ##
+//              N O N    I N L I N E      F U N C T I O N S                 ##
+//                                                                          ##
+//                                                                          ##
+//############################################################################
+//
+//-----------------------------------------------------------------------------
+//  function : parallel_merge
+/// @brief constructor of the class, which does the merge
+///
+/// @param vrange : vector with the sorted ranges to merge
+/// @param dest : iterator to the output, with space for all the elements
+/// @param cmp : object for to compare two elements pointed by Iter_t
+/// @param nthread : Number of threads to use in the process
+/// @param pool : pool where run the threads, except the calling thread
+//-----------------------------------------------------------------------------
+template< class Iter_t, class Iter2_t, class Compare >
+parallel_merge< Iter_t, Iter2_t, Compare >
+::parallel_merge(const std::vector< range_it > &vrange, Iter2_t dest,
+                 Compare cmp, uint32_t nthread, thread_pool &pool)
+: comp(cmp), njob(0)
+{
+    size_t nelem = 0;
+    for (uint32_t i = 0; i < vrange.size( ); ++i) nelem += vrange[i].size( );
+    dest_last = dest + nelem;
+
+    if (nthread < 2 or nelem < nelem_min)
+    {
+        loser_tree< Iter_t, Compare >(vrange, comp).copy(dest);
+        return;
+    };
+    split(vrange, dest, nthread << 3);
+    pool.run(nthread, [this](uint32_t) { execute( ); });
+};
+//
+//-----------------------------------------------------------------------------
+//  function : split
+/// @brief divide the ranges in slices. The splitters are elements of a
+///        sample of the ranges, and each range is divided with upper_bound,
+///        then the elements equal to a splitter are in the same slice, and
+///        the merge is stable
+/// @param vrange : vector with the sorted ranges to merge
+/// @param dest : iterator to the output
+/// @param nslice : number of slices
+//-----------------------------------------------------------------------------
+template< class Iter_t, class Iter2_t, class Compare >
+void parallel_merge< Iter_t, Iter2_t, Compare >
+::split(const std::vector< range_it > &vrange, Iter2_t dest, uint32_t nslice)
+{
+    size_t nelem = size_t(dest_last - dest);
+    size_t step = nelem / (nslice * nsample_slice);
+    if (step == 0) step = 1;
+
+    //------------------------------------------------------------------------
+    // Sample with an element each step in all the ranges, and splitters
+    //------------------------------------------------------------------------
+    std::vector< Iter_t > vsample;
+    vsample.reserve(nslice * nsample_slice + vrange.size( ));
+    for (uint32_t i = 0; i < vrange.size( ); ++i)
+    {
+        for (size_t pos = step >> 1; pos < vrange[i].size( ); pos += step)
+            vsample.push_back(vrange[i].first + pos);
+    };
+    std::sort(vsample.begin( ), vsample.end( ),
+              [this](Iter_t it1, Iter_t it2) { return comp(*it1, *it2); });
+
+    std::vector< Iter_t > vsplitter;
+    vsplitter.reserve(nslice);
+    for (uint32_t j = 1; j < nslice; ++j)
+        vsplitter.push_back(vsample[(vsample.size( ) * j) / nslice]);
+
+    //------------------------------------------------------------------------
+    // Division of each range with the splitters
+    //------------------------------------------------------------------------
+    vv_slice.resize(nslice);
+    vdest.reserve(nslice);
+    std::vector< Iter_t > vpos(vrange.size( ));
+    for (uint32_t i = 0; i < vrange.size( ); ++i) vpos[i] = vrange[i].first;
+
+    Iter2_t it_dest = dest;
+    for (uint32_t j = 0; j < nslice; ++j)
+    {
+        vdest.push_back(it_dest);
+        for (uint32_t i = 0; i < vrange.size( ); ++i)
+        {
+            Iter_t it = (j + 1 == nslice) ? vrange[i].last
+                        : std::upper_bound(vpos[i], vrange[i].last,
+                                           *vsplitter[j], comp);
+            if (it != vpos[i]) vv_slice[j].emplace_back(vpos[i], it);
+            it_dest += (it - vpos[i]);
+            vpos[i] = it;
+        };
+    };
+};
+//
+//****************************************************************************
+};//    End namespace merge_detail
+//****************************************************************************
+//
+namespace bscu = boost::sort::common::util;
+//
+//############################################################################
+//                                                                          ##
+//                                                                          ##
+//                    P A R A L L E L _ M E R G E                           ##
+//                                                                          ##
+//                                                                          ##
+//############################################################################
+//
+//-----------------------------------------------------------------------------
+//  function : parallel_merge
+/// @brief stable merge of sorted ranges, with several threads. With equal
+///        elements, the elements of the first ranges go before. As
+///        std::merge, the elements are copied to dest, and the ranges are
+///        not modified
+///
+/// @param vrange : vector with the sorted ranges to merge. The ranges can be
+///                 empty
+/// @param dest : iterator to the output, with space for all the elements.
+///               Must not overlap the ranges
+/// @param comp : object for to compare two elements pointed by Iter_t
+///               iterators
+/// @param nthread : Number of threads to use in the process, including the
+///                  calling thread. When this value is lower than 2, the
+///                  merge is done with 1 thread
+/// @param pool : thread pool where run the works of the other threads
+/// @return iterator after the last element of the output
+//-----------------------------------------------------------------------------
+template< class Iter_t, class Iter2_t, class Compare >
+Iter2_t parallel_merge(const std::vector< common::range< Iter_t > > &vrange,
+                       Iter2_t dest, Compare comp, uint32_t nthread,
+                       thread_pool &pool)
+{
+    static_assert(std::is_same< bscu::value_iter< Iter_t >,
+                                bscu::value_iter< Iter2_t > >::value,
+                  "Incompatible iterators\n");
+    return merge_detail::parallel_merge< Iter_t, Iter2_t, Compare >(
+               vrange, dest, comp, nthread, pool).dest_last;
+};
+//
+//-----------------------------------------------------------------------------
+//  function : parallel_merge
+/// @brief stable merge of sorted ranges, with several threads of the default
+///        thread pool. The elements are copied, and the ranges are not
+///        modified
+///
+/// @param vrange : vector with the sorted ranges to merge
+/// @param dest : iterator to the output, with space for all the elements
+/// @param comp : object for to compare two elements pointed by Iter_t
+///               iterators
+/// @param nthread : Number of threads to use in the process
+/// @return iterator after the last element of the output
+//-----------------------------------------------------------------------------
+template< class Iter_t, class Iter2_t, class Compare >
+Iter2_t parallel_merge(const std::vector< common::range< Iter_t > > &vrange,
+                       Iter2_t dest, Compare comp, uint32_t nthread)
+{
+    return parallel_merge(vrange, dest, comp, nthread, default_thread_pool( ));
+};
+//
+//-----------------------------------------------------------------------------
+//  function : parallel_merge
+/// @brief stable merge of sorted ranges, with all the hardware threads.
+///        The elements are copied, and the ranges are not modified
+///
+/// @param vrange : vector with the sorted ranges to merge
+/// @param dest : iterator to the output, with space for all the elements
+/// @param comp : object for to compare two elements pointed by Iter_t
+///               iterators
+/// @return iterator after the last element of the output
+//-----------------------------------------------------------------------------
+template< class Iter_t, class Iter2_t, class Compare >
+Iter2_t parallel_merge(const std::vector< common::range< Iter_t > > &vrange,
+                       Iter2_t dest, Compare comp)
+{
+    return parallel_merge(vrange, dest, comp,
+                          std::thread::hardware_concurrency( ));
+};
+//
+//-----------------------------------------------------------------------------
+//  function : parallel_merge
+/// @brief stable merge of sorted ranges with the operator <, with all the
+///        hardware threads. The elements are copied, and the ranges are not
+///        modified
+///
+/// @param vrange : vector with the sorted ranges to merge
+/// @param dest : iterator to the output, with space for all the elements
+/// @return iterator after the last element of the output
+//-----------------------------------------------------------------------------
+template< class Iter_t, class Iter2_t >
+Iter2_t parallel_merge(const std::vector< common::range< Iter_t > > &vrange,
+                       Iter2_t dest)
+{
+    return parallel_merge(vrange, dest, bscu::compare_iter< Iter_t >( ));
+};
+//
+//****************************************************************************
+};//    End namespace sort
+};//    End namespace boost
+//****************************************************************************
+//
+#endif
@@ -0,0 +1,207 @@
+//----------------------------------------------------------------------------
+/// @file parallel_partial_sort.hpp
+/// @brief This file contains the parallel_partial_sort, which sorts the
+///        smallest elements of a range with several threads
+///
+///         Distributed under the Boost Software License, Version 1.0.\n
+///         ( See accompanying file LICENSE_1_0.txt or copy at
+///           http://www.boost.org/LICENSE_1_0.txt  )
+/// @version 0.1
+///
+/// @remarks
+//-----------------------------------------------------------------------------
+#ifndef __BOOST_SORT_PARALLEL_DETAIL_PARALLEL_PARTIAL_SORT_HPP
+#define __BOOST_SORT_PARALLEL_DETAIL_PARALLEL_PARTIAL_SORT_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <thread>
+#include <ciso646>
+#include <boost/sort/pdqsort/pdqselect.hpp>
+#include <boost/sort/common/thread_pool.hpp>
+#include <boost/sort/common/util/traits.hpp>
+
+namespace boost
+{
+namespace sort
+{
+namespace partial_detail
+{
+//---------------------------------------------------------------------------
+//                    USING SENTENCES
+//---------------------------------------------------------------------------
+namespace bscu = boost::sort::common::util;
+
+// minimun numbers of elements for to be sorted in parallel mode
+static const size_t nelem_min = (1 << 16);
+//
+//-----------------------------------------------------------------------------
+//  function : parallel_partial_sort
+/// @brief each thread selects with nth_element the candidates of a part of
+///        the range, the candidates are moved to the beginning of the range,
+///        and the final partial_sort is done only with the candidates
+///
+/// @param first : iterator to the first element of the range
+/// @param middle : iterator after the last element to sort
+/// @param last : iterator after the last element of the range
+/// @param comp : object for to compare two elements pointed by Iter_t
+/// @param nthread : Number of threads to use in the process
+/// @param pool : pool where run the threads, except the calling thread
+//-----------------------------------------------------------------------------
+template< class Iter_t, class Compare >
+void parallel_partial_sort(Iter_t first, Iter_t middle, Iter_t last,
+                           Compare comp, uint32_t nthread, thread_pool &pool)
+{
+    size_t nelem = size_t(last - first), nsel = size_t(middle - first);
+    if (nsel == 0) return;
+
+    // With many elements to sort, the candidates are nearly all the range
+    if (nthread < 2 or nelem < nelem_min or (nsel * nthread * 2) > nelem)
+    {
+        boost::sort::partial_sort(first, middle, last, comp);
+        return;
+    };
+
+    //------------------------------------------------------------------------
+    // Selection of the nsel smallest elements of each part. Each part has
+    // more than 2 * nsel elements
+    //------------------------------------------------------------------------
+    size_t cupo = nelem / nthread;
+    pool.run(nthread, [&](uint32_t i)
+    {
+        Iter_t it1 = first + cupo * i;
+        Iter_t it2 = (i + 1 == nthread) ? last : it1 + cupo;
+        boost::sort::nth_element(it1, it1 + (nsel - 1), it2, comp);
+    });
+
+    //------------------------------------------------------------------------
+    // Move the candidates of each part after the candidates of the previous
+    // parts. The part i begins i * (cupo - nsel) elements after the end of
+    // the candidates moved, then the ranges swapped don't overlap
+    //------------------------------------------------------------------------
+    Iter_t dest = first + nsel;
+    for (uint32_t i = 1; i < nthread; ++i, dest += nsel)
+    {
+        Iter_t it = first + cupo * i;
+        std::swap_ranges(it, it + nsel, dest);
+    };
+
+    boost::sort::partial_sort(first, middle, dest, comp);
+};
+//
+//****************************************************************************
+};//    End namespace partial_detail
+//****************************************************************************
+//
+namespace bscu = boost::sort::common::util;
+//
+//############################################################################
+//                                                                          ##
+//                                                                          ##
+//              P A R A L L E L _ P A R T I A L _ S O R T                   ##
+//                                                                          ##
+//                                                                          ##
+//############################################################################
+//
+//-----------------------------------------------------------------------------
+//  function : parallel_partial_sort
+/// @brief put in [first, middle), sorted, the smallest elements of
+///        [first, last), with several threads. The other elements are in
+///        [middle, last), in an unspecified order. Not stable
+///
+/// @param first : iterator to the first element of the range
+/// @param middle : iterator after the last element to sort
+/// @param last : iterator after the last element of the range
+/// @param comp : object for to compare two elements pointed by Iter_t
+///               iterators
+/// @param nthread : Number of threads to use in the process, including the
+///                  calling thread. When this value is lower than 2, or
+///                  middle - first is greater than the size of the range
+///                  divided by 2 * nthread, the partial sort is done with 1
+///                  thread
+/// @param pool : thread pool where run the works of the other threads
+//-----------------------------------------------------------------------------
+template< class Iter_t, class Compare >
+void parallel_partial_sort(Iter_t first, Iter_t middle, Iter_t last,
+                           Compare comp, uint32_t nthread, thread_pool &pool)
+{
+    partial_detail::parallel_partial_sort(first, middle, last, comp, nthread,
+                                          pool);
+};
+//
+//-----------------------------------------------------------------------------
+//  function : parallel_partial_sort
+/// @brief partial sort with several threads of the default thread pool
+///
+/// @param first : iterator to the first element of the range
+/// @param middle : iterator after the last element to sort
+/// @param last : iterator after the last element of the range
+/// @param comp : object for to compare two elements pointed by Iter_t
+///               iterators
+/// @param nthread : Number of threads to use in the process
+//-----------------------------------------------------------------------------
+template< class Iter_t, class Compare >
+void parallel_partial_sort(Iter_t first, Iter_t middle, Iter_t last,
+                           Compare comp, uint32_t nthread)
+{
+    partial_detail::parallel_partial_sort(first, middle, last, comp, nthread,
+                                          default_thread_pool( ));
+};
+//
+//-----------------------------------------------------------------------------
+//  function : parallel_partial_sort
+/// @brief partial sort with all the hardware threads
+///
+/// @param first : iterator to the first element of the range
+/// @param middle : iterator after the last element to sort
+/// @param last : iterator after the last element of the range
+/// @param comp : object for to compare two elements pointed by Iter_t
+///               iterators
+//-----------------------------------------------------------------------------
+template< class Iter_t, class Compare,
+          bscu::enable_if_not_integral< Compare > * = nullptr >
+void parallel_partial_sort(Iter_t first, Iter_t middle, Iter_t last,
+                           Compare comp)
+{
+    parallel_partial_sort(first, middle, last, comp,
+                          std::thread::hardware_concurrency( ));
+};
+//
+//-----------------------------------------------------------------------------
+//  function : parallel_partial_sort
+/// @brief partial sort with the operator <, and nthread threads
+///
+/// @param first : iterator to the first element of the range
+/// @param middle : iterator after the last element to sort
+/// @param last : iterator after the last element of the range
+/// @param nthread : Number of threads to use in the process
+//-----------------------------------------------------------------------------
+template< class Iter_t >
+void parallel_partial_sort(Iter_t first, Iter_t middle, Iter_t last,
+                           uint32_t nthread)
+{
+    parallel_partial_sort(first, middle, last,
+                          std::less< bscu::value_iter< Iter_t > >( ), nthread);
+};
+//
+//-----------------------------------------------------------------------------
+//  function : parallel_partial_sort
+/// @brief partial sort with the operator <, and all the hardware threads
+///
+/// @param first : iterator to the first element of the range
+/// @param middle : iterator after the last element to sort
+/// @param last : iterator after the last element of the range
+//-----------------------------------------------------------------------------
+template< class Iter_t >
+void parallel_partial_sort(Iter_t first, Iter_t middle, Iter_t last)
+{
+    parallel_partial_sort(first, middle, last,
+                          std::thread::hardware_concurrency( ));
+};
+//
+//****************************************************************************
+};//    End namespace sort
+};//    End namespace boost
+//****************************************************************************
+//
+#endif
@@ -50,6 +50,7 @@ struct parallel_stable_sort
     //                      DEFINITIONS
     //-------------------------------------------------------------------------
     typedef value_iter<Iter_t> value_t;
+    typedef range<value_t *> range_buf;
 
     //-------------------------------------------------------------------------
     //                     VARIABLES
@@ -58,8 +59,11 @@ struct parallel_stable_sort
     size_t nelem;
     // Pointer to the auxiliary memory needed for the algorithm
     value_t *ptr;
+    // indicate if the memory pointed by ptr had been obtained inside the
+    // algorithm, or had been received as a parameter
+    bool owner;
     // Minimal number of elements for to be sorted in parallel mode
-    const size_t nelem_min = 1 << 16;
+    static constexpr size_t nelem_min = 1 << 16;
 
     //------------------------------------------------------------------------
     //                F U N C T I O N S
@@ -76,7 +80,26 @@ struct parallel_stable_sort
     : parallel_stable_sort (first, last, Compare(), num_thread) { };
 
     parallel_stable_sort (Iter_t first, Iter_t last, Compare cmp,
-                          uint32_t num_thread);
+                          uint32_t num_thread, range_buf rbuf,
+                          thread_pool &pool = default_thread_pool());
+
+    parallel_stable_sort (Iter_t first, Iter_t last, Compare cmp,
+                          uint32_t num_thread,
+                          thread_pool &pool = default_thread_pool())
+    : parallel_stable_sort (first, last, cmp, num_thread,
+                            range_buf (nullptr, nullptr), pool) { };
+
+    //
+    //-----------------------------------------------------------------------------
+    //  function : required_buffer_size
+    /// @brief number of elements of the auxiliary memory used for to sort
+    ///        nelem elements. The same with any number of threads, because
+    ///        the sort with 1 thread (spinsort) needs the same memory
+    //-----------------------------------------------------------------------------
+    static size_t required_buffer_size (size_t nelem, uint32_t)
+    {
+        return (nelem + 1) >> 1;
+    };
 
     //
     //-----------------------------------------------------------------------------
@@ -86,7 +109,7 @@ struct parallel_stable_sort
     //-----------------------------------------------------------------------------
     void destroy_all()
     {
-        if (ptr != nullptr) std::return_temporary_buffer(ptr);
+        if (ptr != nullptr and owner) std::return_temporary_buffer(ptr);
     };
     //
     //-----------------------------------------------------------------------------
@@ -117,22 +140,28 @@ struct parallel_stable_sort
 ///                    iterators
 /// @param nthread : Number of threads to use in the process. When this value
 ///                  is lower than 2, the sorting is done with 1 thread
+/// @param rbuf : uninitialized auxiliary memory. If it is smaller than
+///               required_buffer_size (nelem, nthread), the memory is
+///               obtained inside the class
+/// @param pool : pool where run the threads, except the calling thread
 //-----------------------------------------------------------------------------
 template <class Iter_t, class Compare>
 parallel_stable_sort <Iter_t, Compare>
 ::parallel_stable_sort (Iter_t first, Iter_t last, Compare comp,
-                        uint32_t nthread) : nelem(0), ptr(nullptr)
+                        uint32_t nthread, range_buf rbuf, thread_pool &pool)
+: nelem(0), ptr(nullptr), owner(false)
 {
     range<Iter_t> range_initial(first, last);
     assert(range_initial.valid());
 
     nelem = range_initial.size();
-    size_t nptr = (nelem + 1) >> 1;
+    size_t nptr = required_buffer_size(nelem, nthread);
+    if (rbuf.size() < nptr) rbuf = range_buf(nullptr, nullptr);
 
     if (nelem < nelem_min or nthread < 2)
     {
         bss::spinsort<Iter_t, Compare>
-            (range_initial.first, range_initial.last, comp);
+            (range_initial.first, range_initial.last, comp, rbuf);
         return;
     };
 
@@ -155,8 +184,16 @@ parallel_stable_sort <Iter_t, Compare>
         return;
     };
 
-    ptr = std::get_temporary_buffer<value_t>(nptr).first;
-    if (ptr == nullptr) throw std::bad_alloc();
+    if (rbuf.first != nullptr)
+    {
+        ptr = rbuf.first;
+    }
+    else
+    {
+        ptr = std::get_temporary_buffer<value_t>(nptr).first;
+        if (ptr == nullptr) throw std::bad_alloc();
+        owner = true;
+    };
 
     //---------------------------------------------------------------------
     //     Parallel Process
@@ -171,7 +208,7 @@ parallel_stable_sort <Iter_t, Compare>
     {
         sample_sort<Iter_t, Compare>
             (range_initial.first, range_initial.first + nptr,
-             comp, nthread, range_buffer);
+             comp, nthread, range_buffer, pool);
     } catch (std::bad_alloc &)
     {
         destroy_all();
@@ -182,7 +219,7 @@ parallel_stable_sort <Iter_t, Compare>
     {
         sample_sort<Iter_t, Compare>
             (range_initial.first + nptr,
-             range_initial.last, comp, nthread, range_buffer);
+             range_initial.last, comp, nthread, range_buffer, pool);
     } catch (std::bad_alloc &)
     {
         destroy_all();
@@ -284,6 +321,98 @@ void parallel_stable_sort (Iter_t first, Iter_t last, Compare comp,
                                                 (first, last, comp, nthread);
 }
 //
+//-----------------------------------------------------------------------------
+//  function : parallel_stable_sort
+/// @brief : parallel stable sort with 5 parameters. The fifth is the thread
+///          pool where run the threads, instead of the default pool
+///
+/// @param first : iterator to the first element of the range to sort
+/// @param last : iterator after the last element to the range to sort
+/// @param comp : object for to compare two elements pointed by Iter_t
+///               iterators
+/// @param nthread : Number of threads to use in the process, including the
+///                  calling thread. When this value is lower than 2, the
+///                  sorting is done with 1 thread
+/// @param pool : thread pool where run the works of the other threads
+//-----------------------------------------------------------------------------
+template<class Iter_t, class Compare>
+void parallel_stable_sort (Iter_t first, Iter_t last, Compare comp,
+                           uint32_t nthread, thread_pool &pool)
+{
+    stable_detail::parallel_stable_sort<Iter_t, Compare>
+                                          (first, last, comp, nthread, pool);
+}
+//
+//-----------------------------------------------------------------------------
+//  function : parallel_stable_sort
+/// @brief : parallel stable sort with 5 parameters. The fifth is the
+///          auxiliary memory, instead of obtain it in each call
+///
+/// @param first : iterator to the first element of the range to sort
+/// @param last : iterator after the last element to the range to sort
+/// @param comp : object for to compare two elements pointed by Iter_t
+///               iterators
+/// @param nthread : Number of threads to use in the process. When this value
+///                  is lower than 2, the sorting is done with 1 thread
+/// @param rbuf : uninitialized memory, with space for
+///               parallel_stable_sort_buffer_size<Iter_t> (last - first,
+///               nthread) elements. When it is smaller, the memory is
+///               obtained inside the algorithm
+//-----------------------------------------------------------------------------
+template<class Iter_t, class Compare>
+void parallel_stable_sort (Iter_t first, Iter_t last, Compare comp,
+                           uint32_t nthread,
+                           range<bscu::value_iter<Iter_t> *> rbuf)
+{
+    stable_detail::parallel_stable_sort<Iter_t, Compare>
+                                          (first, last, comp, nthread, rbuf);
+}
+//
+//-----------------------------------------------------------------------------
+//  function : parallel_stable_sort
+/// @brief : parallel stable sort with 6 parameters, with the auxiliary memory
+///          and the thread pool
+///
+/// @param first : iterator to the first element of the range to sort
+/// @param last : iterator after the last element to the range to sort
+/// @param comp : object for to compare two elements pointed by Iter_t
+///               iterators
+/// @param nthread : Number of threads to use in the process, including the
+///                  calling thread. When this value is lower than 2, the
+///                  sorting is done with 1 thread
+/// @param rbuf : uninitialized memory, with space for
+///               parallel_stable_sort_buffer_size<Iter_t> (last - first,
+///               nthread) elements. When it is smaller, the memory is
+///               obtained inside the algorithm
+/// @param pool : thread pool where run the works of the other threads
+//-----------------------------------------------------------------------------
+template<class Iter_t, class Compare>
+void parallel_stable_sort (Iter_t first, Iter_t last, Compare comp,
+                           uint32_t nthread,
+                           range<bscu::value_iter<Iter_t> *> rbuf,
+                           thread_pool &pool)
+{
+    stable_detail::parallel_stable_sort<Iter_t, Compare>
+                                    (first, last, comp, nthread, rbuf, pool);
+}
+//
+//-----------------------------------------------------------------------------
+//  function : parallel_stable_sort_buffer_size
+/// @brief number of elements of the auxiliary memory used by
+///        parallel_stable_sort
+///
+/// @param nelem : number of elements to sort
+/// @param nthread : Number of threads to use in the process
+/// @return number of elements
+//-----------------------------------------------------------------------------
+template<class Iter_t>
+size_t parallel_stable_sort_buffer_size (size_t nelem, uint32_t nthread)
+{
+    typedef bscu::compare_iter<Iter_t> Compare;
+    return stable_detail::parallel_stable_sort<Iter_t, Compare>
+        ::required_buffer_size(nelem, nthread);
+}
+//
 //****************************************************************************
 };//    End namespace sort
 };//    End namespace boost
@@ -0,0 +1,381 @@
+// Vectorized partition of pdqsort for the primitive types.
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort/ for library home page.
+
+
+#ifndef BOOST_SORT_PDQSORT_DETAIL_SIMD_PARTITION_HPP
+#define BOOST_SORT_PDQSORT_DETAIL_SIMD_PARTITION_HPP
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <boost/type_traits.hpp>
+
+// The AVX2 partition needs the target attribute of GCC and Clang, for compiling it without
+// -mavx2, and checks the CPU at runtime. Define BOOST_SORT_PDQSORT_NO_SIMD to use only the scalar
+// partition.
+#if !defined(BOOST_SORT_PDQSORT_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) && \
+    ((defined(__clang__) && __clang_major__ >= 4) || \
+     (!defined(__clang__) && defined(__GNUC__) && (__GNUC__ * 100 + __GNUC_MINOR__ >= 409)))
+    #define BOOST_SORT_PDQSORT_AVX2
+    #define BOOST_SORT_PDQSORT_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+    #include <immintrin.h>
+#endif
+
+namespace boost {
+namespace sort {
+namespace pdqsort_detail {
+    // Kind of the vector partition of T: 0 for none, or 32 and 64 bit signed and unsigned
+    // integers, float and double.
+    enum { simd_none, simd_i32, simd_u32, simd_i64, simd_u64, simd_float, simd_double };
+
+    template<class T>
+    struct simd_kind {
+        static const int value =
+            boost::is_same<T, float>::value ? int(simd_float) :
+            boost::is_same<T, double>::value ? int(simd_double) :
+            !boost::is_integral<T>::value || boost::is_same<T, bool>::value ? int(simd_none) :
+            sizeof(T) == 4 ? (boost::is_signed<T>::value ? int(simd_i32) : int(simd_u32)) :
+            sizeof(T) == 8 ? (boost::is_signed<T>::value ? int(simd_i64) : int(simd_u64)) :
+            int(simd_none);
+    };
+
+    // Whether the comparison is std::less or std::greater of T.
+    template<class Compare, class T> struct simd_compare : boost::false_type { };
+    template<class T> struct simd_compare<std::less<T>, T> : boost::true_type { };
+    template<class T> struct simd_compare<std::greater<T>, T> : boost::true_type { };
+
+    template<class Compare> struct simd_is_greater : boost::false_type { };
+    template<class T> struct simd_is_greater<std::greater<T> > : boost::true_type { };
+
+    // Whether [begin, end) of Iter can be partitioned with vectors: the elements are contiguous
+    // in memory, of a primitive type, and compared with std::less or std::greater.
+    template<class Iter, class Compare>
+    struct use_simd_partition {
+        typedef typename std::iterator_traits<Iter>::value_type T;
+        static const bool value =
+#ifdef BOOST_SORT_PDQSORT_AVX2
+            simd_kind<T>::value != simd_none &&
+            simd_compare<typename boost::decay<Compare>::type, T>::value &&
+            (boost::is_pointer<Iter>::value ||
+             boost::is_same<Iter, typename std::vector<T>::iterator>::value);
+#else
+            false;
+#endif
+    };
+
+#ifdef BOOST_SORT_PDQSORT_AVX2
+    // Whether the CPU has AVX2, checked once.
+    inline bool avx2_enabled() {
+        static const bool enabled = __builtin_cpu_supports("avx2") &&
+                                    __builtin_cpu_supports("popcnt");
+        return enabled;
+    }
+
+    // Permutations which move the lanes of the bits set in the mask to the start of the vector, in
+    // order, and the others after them. Each nibble is the source of a 32 bit lane, and with 4
+    // lanes of 64 bits, each lane is two 32 bit lanes.
+    template<class Dummy>
+    struct avx2_permutations {
+        static const boost::uint32_t lanes8[256];
+        static const boost::uint32_t lanes4[16];
+    };
+
+    template<class Dummy>
+    const boost::uint32_t avx2_permutations<Dummy>::lanes8[256] = {
+            0x76543210u, 0x76543210u, 0x76543201u, 0x76543210u, 0x76543102u, 0x76543120u,
+            0x76543021u, 0x76543210u, 0x76542103u, 0x76542130u, 0x76542031u, 0x76542310u,
+            0x76541032u, 0x76541320u, 0x76540321u, 0x76543210u, 0x76532104u, 0x76532140u,
+            0x76532041u, 0x76532410u, 0x76531042u, 0x76531420u, 0x76530421u, 0x76534210u,
+            0x76521043u, 0x76521430u, 0x76520431u, 0x76524310u, 0x76510432u, 0x76514320u,
+            0x76504321u, 0x76543210u, 0x76432105u, 0x76432150u, 0x76432051u, 0x76432510u,
+            0x76431052u, 0x76431520u, 0x76430521u, 0x76435210u, 0x76421053u, 0x76421530u,
+            0x76420531u, 0x76425310u, 0x76410532u, 0x76415320u, 0x76405321u, 0x76453210u,
+            0x76321054u, 0x76321540u, 0x76320541u, 0x76325410u, 0x76310542u, 0x76315420u,
+            0x76305421u, 0x76354210u, 0x76210543u, 0x76215430u, 0x76205431u, 0x76254310u,
+            0x76105432u, 0x76154320u, 0x76054321u, 0x76543210u, 0x75432106u, 0x75432160u,
+            0x75432061u, 0x75432610u, 0x75431062u, 0x75431620u, 0x75430621u, 0x75436210u,
+            0x75421063u, 0x75421630u, 0x75420631u, 0x75426310u, 0x75410632u, 0x75416320u,
+            0x75406321u, 0x75463210u, 0x75321064u, 0x75321640u, 0x75320641u, 0x75326410u,
+            0x75310642u, 0x75316420u, 0x75306421u, 0x75364210u, 0x75210643u, 0x75216430u,
+            0x75206431u, 0x75264310u, 0x75106432u, 0x75164320u, 0x75064321u, 0x75643210u,
+            0x74321065u, 0x74321650u, 0x74320651u, 0x74326510u, 0x74310652u, 0x74316520u,
+            0x74306521u, 0x74365210u, 0x74210653u, 0x74216530u, 0x74206531u, 0x74265310u,
+            0x74106532u, 0x74165320u, 0x74065321u, 0x74653210u, 0x73210654u, 0x73216540u,
+            0x73206541u, 0x73265410u, 0x73106542u, 0x73165420u, 0x73065421u, 0x73654210u,
+            0x72106543u, 0x72165430u, 0x72065431u, 0x72654310u, 0x71065432u, 0x71654320u,
+            0x70654321u, 0x76543210u, 0x65432107u, 0x65432170u, 0x65432071u, 0x65432710u,
+            0x65431072u, 0x65431720u, 0x65430721u, 0x65437210u, 0x65421073u, 0x65421730u,
+            0x65420731u, 0x65427310u, 0x65410732u, 0x65417320u, 0x65407321u, 0x65473210u,
+            0x65321074u, 0x65321740u, 0x65320741u, 0x65327410u, 0x65310742u, 0x65317420u,
+            0x65307421u, 0x65374210u, 0x65210743u, 0x65217430u, 0x65207431u, 0x65274310u,
+            0x65107432u, 0x65174320u, 0x65074321u, 0x65743210u, 0x64321075u, 0x64321750u,
+            0x64320751u, 0x64327510u, 0x64310752u, 0x64317520u, 0x64307521u, 0x64375210u,
+            0x64210753u, 0x64217530u, 0x64207531u, 0x64275310u, 0x64107532u, 0x64175320u,
+            0x64075321u, 0x64753210u, 0x63210754u, 0x63217540u, 0x63207541u, 0x63275410u,
+            0x63107542u, 0x63175420u, 0x63075421u, 0x63754210u, 0x62107543u, 0x62175430u,
+            0x62075431u, 0x62754310u, 0x61075432u, 0x61754320u, 0x60754321u, 0x67543210u,
+            0x54321076u, 0x54321760u, 0x54320761u, 0x54327610u, 0x54310762u, 0x54317620u,
+            0x54307621u, 0x54376210u, 0x54210763u, 0x54217630u, 0x54207631u, 0x54276310u,
+            0x54107632u, 0x54176320u, 0x54076321u, 0x54763210u, 0x53210764u, 0x53217640u,
+            0x53207641u, 0x53276410u, 0x53107642u, 0x53176420u, 0x53076421u, 0x53764210u,
+            0x52107643u, 0x52176430u, 0x52076431u, 0x52764310u, 0x51076432u, 0x51764320u,
+            0x50764321u, 0x57643210u, 0x43210765u, 0x43217650u, 0x43207651u, 0x43276510u,
+            0x43107652u, 0x43176520u, 0x43076521u, 0x43765210u, 0x42107653u, 0x42176530u,
+            0x42076531u, 0x42765310u, 0x41076532u, 0x41765320u, 0x40765321u, 0x47653210u,
+            0x32107654u, 0x32176540u, 0x32076541u, 0x32765410u, 0x31076542u, 0x31765420u,
+            0x30765421u, 0x37654210u, 0x21076543u, 0x21765430u, 0x20765431u, 0x27654310u,
+            0x10765432u, 0x17654320u, 0x07654321u, 0x76543210u
+    };
+
+    template<class Dummy>
+    const boost::uint32_t avx2_permutations<Dummy>::lanes4[16] = {
+            0x76543210u, 0x76543210u, 0x76541032u, 0x76543210u, 0x76321054u, 0x76325410u,
+            0x76105432u, 0x76543210u, 0x54321076u, 0x54327610u, 0x54107632u, 0x54763210u,
+            0x32107654u, 0x32765410u, 0x10765432u, 0x76543210u
+    };
+
+    BOOST_SORT_PDQSORT_TARGET_AVX2
+    inline __m256i avx2_permutation(boost::uint32_t nibbles) {
+        const __m256i shifts = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+        return _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32(int(nibbles)), shifts),
+                                _mm256_set1_epi32(0xF));
+    }
+
+    // Operations on a vector of AVX2 for each kind of element. less_mask has a bit set for each
+    // lane where x < y, and compress moves the lanes of the bits set to the start.
+    template<int Kind> struct avx2_vector;
+
+    template<> struct avx2_vector<simd_i32> {
+        enum { lanes = 8 };
+        typedef __m256i type;
+
+        template<class T> BOOST_SORT_PDQSORT_TARGET_AVX2
+        static type load(const T* p) { return _mm256_loadu_si256((const __m256i*) p); }
+        template<class T> BOOST_SORT_PDQSORT_TARGET_AVX2
+        static void store(T* p, type v) { _mm256_storeu_si256((__m256i*) p, v); }
+        template<class T> BOOST_SORT_PDQSORT_TARGET_AVX2
+        static type set1(T x) { return _mm256_set1_epi32(int(x)); }
+        BOOST_SORT_PDQSORT_TARGET_AVX2
+        static int less_mask(type x, type y) {
+            return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(y, x)));
+        }
+        BOOST_SORT_PDQSORT_TARGET_AVX2
+        static type compress(type v, int mask) {
+            return _mm256_permutevar8x32_epi32(
+                v, avx2_permutation(avx2_permutations<void>::lanes8[mask]));
+        }
+    };
+
+    // The unsigned integers are compared as signed, with the sign bit flipped.
+    template<> struct avx2_vector<simd_u32> : avx2_vector<simd_i32> {
+        BOOST_SORT_PDQSORT_TARGET_AVX2
+        static int less_mask(type x, type y) {
+            const __m256i sign = _mm256_set1_epi32(int(0x80000000u));
+            return avx2_vector<simd_i32>::less_mask(_mm256_xor_si256(x, sign),
+                                                    _mm256_xor_si256(y, sign));
+        }
+    };
+
+    template<> struct avx2_vector<simd_i64> {
+        enum { lanes = 4 };
+        typedef __m256i type;
+
+        template<class T> BOOST_SORT_PDQSORT_TARGET_AVX2
+        static type load(const T* p) { return _mm256_loadu_si256((const __m256i*) p); }
+        template<class T> BOOST_SORT_PDQSORT_TARGET_AVX2
+        static void store(T* p, type v) { _mm256_storeu_si256((__m256i*) p, v); }
+        template<class T> BOOST_SORT_PDQSORT_TARGET_AVX2
+        static type set1(T x) { return _mm256_set1_epi64x((long long) x); }
+        BOOST_SORT_PDQSORT_TARGET_AVX2
+        static int less_mask(type x, type y) {
+            return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(y, x)));
+        }
+        BOOST_SORT_PDQSORT_TARGET_AVX2
+        static type compress(type v, int mask) {
+            return _mm256_permutevar8x32_epi32(
+                v, avx2_permutation(avx2_permutations<void>::lanes4[mask]));
+        }
+    };
+
+    template<> struct avx2_vector<simd_u64> : avx2_vector<simd_i64> {
+        BOOST_SORT_PDQSORT_TARGET_AVX2
+        static int less_mask(type x, type y) {
+            const __m256i sign = _mm256_set1_epi64x((long long) 0x8000000000000000ull);
+            return avx2_vector<simd_i64>::less_mask(_mm256_xor_si256(x, sign),
+                                                    _mm256_xor_si256(y, sign));
+        }
+    };
+
+    template<> struct avx2_vector<simd_float> {
+        enum { lanes = 8 };
+        typedef __m256 type;
+
+        BOOST_SORT_PDQSORT_TARGET_AVX2
+        static type load(const float* p) { return _mm256_loadu_ps(p); }
+        BOOST_SORT_PDQSORT_TARGET_AVX2
+        static void store(float* p, type v) { _mm256_storeu_ps(p, v); }
+        BOOST_SORT_PDQSORT_TARGET_AVX2
+        static type set1(float x) { return _mm256_set1_ps(x); }
+        BOOST_SORT_PDQSORT_TARGET_AVX2
+        static int less_mask(type x, type y) {
+            return _mm256_movemask_ps(_mm256_cmp_ps(x, y, _CMP_LT_OQ));
+        }
+        BOOST_SORT_PDQSORT_TARGET_AVX2
+        static type compress(type v, int mask) {
+            return _mm256_permutevar8x32_ps(
+                v, avx2_permutation(avx2_permutations<void>::lanes8[mask]));
+        }
+    };
+
+    template<> struct avx2_vector<simd_double> {
+        enum { lanes = 4 };
+        typedef __m256d type;
+
+        BOOST_SORT_PDQSORT_TARGET_AVX2
+        static type load(const double* p) { return _mm256_loadu_pd(p); }
+        BOOST_SORT_PDQSORT_TARGET_AVX2
+        static void store(double* p, type v) { _mm256_storeu_pd(p, v); }
+        BOOST_SORT_PDQSORT_TARGET_AVX2
+        static type set1(double x) { return _mm256_set1_pd(x); }
+        BOOST_SORT_PDQSORT_TARGET_AVX2
+        static int less_mask(type x, type y) {
+            return _mm256_movemask_pd(_mm256_cmp_pd(x, y, _CMP_LT_OQ));
+        }
+        BOOST_SORT_PDQSORT_TARGET_AVX2
+        static type compress(type v, int mask) {
+            return _mm256_castps_pd(_mm256_permutevar8x32_ps(_mm256_castpd_ps(v),
+                avx2_permutation(avx2_permutations<void>::lanes4[mask])));
+        }
+    };
+
+    // Stores the elements of v which go before the pivot at *left, and the others before *right,
+    // writing a whole vector at each side. There must be a vector of free space at each side.
+    template<class Vector, bool Greater, class T>
+    BOOST_SORT_PDQSORT_TARGET_AVX2
+    inline void avx2_partition_vector(typename Vector::type v, typename Vector::type pivot,
+                                      T*& left, T*& right) {
+        int mask = Greater ? Vector::less_mask(pivot, v) : Vector::less_mask(v, pivot);
+        int num_l = __builtin_popcount(mask);
+        typename Vector::type compressed = Vector::compress(v, mask);
+        Vector::store(left, compressed);
+        Vector::store(right - int(Vector::lanes), compressed);
+        left += num_l;
+        right -= int(Vector::lanes) - num_l;
+    }
+
+    // Vectors read in each step of avx2_partition, which are unrolled by hand.
+    enum { avx2_unroll = 4 };
+
+    // Partitions [first, last) around pivot, with the elements for which comp(x, pivot) is true
+    // before the others, and returns the first of the others. Assumes [first, last) has at least
+    // 2 * avx2_unroll + 1 vectors of elements.
+    //
+    // First the extra elements of the last partial vector are partitioned one by one at the ends.
+    // Then avx2_unroll vectors are read from each end, and kept, which leaves that free space at
+    // each side. Each vector read, from the side with less free space, is compressed into the
+    // elements which go left and the elements which go right, and stored at both sides of the
+    // free space, as in the vectorized quicksorts of Bramas and of Intel's x86-simd-sort. The
+    // vectors are read avx2_unroll at a time, so the reads don't wait for the stores of the
+    // previous vector, and a mispredicted side costs less.
+    template<int Kind, class T, class Compare>
+    BOOST_SORT_PDQSORT_TARGET_AVX2
+    inline T* avx2_partition(T* first, T* last, const T& pivot, Compare comp) {
+        typedef avx2_vector<Kind> Vector;
+        typedef typename Vector::type V;
+        const bool greater = simd_is_greater<typename boost::decay<Compare>::type>::value;
+        const std::ptrdiff_t lanes = Vector::lanes;
+        const std::ptrdiff_t step = lanes * avx2_unroll;
+
+        for (std::ptrdiff_t i = (last - first) % lanes; i > 0; --i) {
+            T x = first[0], y = last[-1];
+            bool is_left = comp(x, pivot);
+            first[0] = is_left ? x : y;
+            last[-1] = is_left ? y : x;
+            first += is_left;
+            last -= !is_left;
+        }
+
+        // The kept vectors are stored in a buffer, and not in an array of vectors, which the
+        // compiler may copy in halves, stalling the reads of the whole vectors.
+        T kept[2 * avx2_unroll * Vector::lanes];
+        for (int i = 0; i < avx2_unroll; ++i) {
+            Vector::store(kept + i * lanes, Vector::load(first + i * lanes));
+            Vector::store(kept + (avx2_unroll + i) * lanes, Vector::load(last - (i + 1) * lanes));
+        }
+        V vpivot = Vector::set1(pivot);
+        T* left = first;
+        T* right = last;
+        first += step;
+        last -= step;
+
+        while (last - first >= step) {
+            T* next;
+            if (first - left <= right - last) {
+                next = first;
+                first += step;
+            } else {
+                last -= step;
+                next = last;
+            }
+            V v0 = Vector::load(next);
+            V v1 = Vector::load(next + lanes);
+            V v2 = Vector::load(next + 2 * lanes);
+            V v3 = Vector::load(next + 3 * lanes);
+            avx2_partition_vector<Vector, greater>(v0, vpivot, left, right);
+            avx2_partition_vector<Vector, greater>(v1, vpivot, left, right);
+            avx2_partition_vector<Vector, greater>(v2, vpivot, left, right);
+            avx2_partition_vector<Vector, greater>(v3, vpivot, left, right);
+        }
+
+        while (first != last) {
+            T* next;
+            if (first - left <= right - last) {
+                next = first;
+                first += lanes;
+            } else {
+                last -= lanes;
+                next = last;
+            }
+            avx2_partition_vector<Vector, greater>(Vector::load(next), vpivot, left, right);
+        }
+
+        for (int i = 0; i < 2 * avx2_unroll; ++i)
+            avx2_partition_vector<Vector, greater>(Vector::load(kept + i * lanes), vpivot,
+                                                   left, right);
+        return left;
+    }
+#endif
+
+    // Partitions [first, last) around pivot with vectors, if the CPU can and the range is long
+    // enough, with the elements for which comp(x, pivot) is true before the others. Returns false
+    // when it can't, or else moves first to the first of the others and returns true.
+    template<class Iter, class Compare, class T>
+    inline bool simd_partition(Iter&, Iter, const T&, Compare, boost::false_type) {
+        return false;
+    }
+
+#ifdef BOOST_SORT_PDQSORT_AVX2
+    template<class Iter, class Compare, class T>
+    inline bool simd_partition(Iter& first, Iter last, const T& pivot, Compare comp,
+                               boost::true_type) {
+        const int kind = simd_kind<T>::value;
+        const std::ptrdiff_t min_size = (2 * avx2_unroll + 1) * avx2_vector<kind>::lanes;
+        if (last - first < min_size || !avx2_enabled()) return false;
+
+        T* begin = &*first;
+        first += avx2_partition<kind>(begin, begin + (last - first), pivot, comp) - begin;
+        return true;
+    }
+#endif
+}
+}
+}
+
+#endif
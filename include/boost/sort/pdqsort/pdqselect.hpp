@@ -0,0 +1,240 @@
+// Pattern-defeating quickselect
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort/ for library home page.
+
+
+#ifndef BOOST_SORT_PDQSELECT_HPP
+#define BOOST_SORT_PDQSELECT_HPP
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <boost/type_traits.hpp>
+#include <boost/sort/pdqsort/pdqsort.hpp>
+
+namespace boost {
+namespace sort {
+
+namespace pdqsort_detail {
+    enum {
+        // Partitions above this size take the pivot from a sample, near the position of nth.
+        sample_threshold = 4096,
+
+        // Number of elements of the sample.
+        sample_size = 128,
+
+        // Positions of the sample between nth and the pivot, for the partition which contains
+        // nth to be small, but containing nth with high probability.
+        sample_margin = 8
+    };
+
+    // Puts in nth the element which would be there if [begin, end) were sorted, with the
+    // elements before nth not greater, and the elements after nth not smaller. Is the
+    // pdqsort_loop, recursing only in the partition that contains nth. In the big partitions
+    // the pivot is not a median, but an element of a sample with a position near of nth, then
+    // when nth is near of an end, as in partial_sort, the first partition leaves only a small
+    // part of the elements.
+    template<class Iter, class Compare, bool Branchless>
+    inline void pdqselect_loop(Iter begin, Iter end, Iter nth, Compare comp, int bad_allowed,
+                               bool leftmost = true) {
+        typedef typename std::iterator_traits<Iter>::difference_type diff_t;
+
+        while (true) {
+            diff_t size = end - begin;
+
+            // Insertion sort is faster for small arrays.
+            if (size < insertion_sort_threshold) {
+                if (leftmost) insertion_sort(begin, end, comp);
+                else unguarded_insertion_sort(begin, end, comp);
+                return;
+            }
+
+            // Choose pivot as median of 3 or pseudomedian of 9, or from a sample moved to the
+            // beginning. The pivot is never the greatest element of the sample, for to have an
+            // element not smaller after it, as needed by partition_right.
+            bool sampled = size >= sample_threshold;
+            if (sampled) {
+                diff_t step = size / sample_size;
+                for (diff_t i = 1; i < sample_size; ++i) std::iter_swap(begin + i, begin + i * step);
+
+                diff_t pos = (nth - begin) / step;
+                if (2 * (nth - begin) < size) pos += sample_margin;
+                else pos -= sample_margin;
+                pos = (std::max)(diff_t(0), (std::min)(pos, diff_t(sample_size - 2)));
+
+                pdqselect_loop<Iter, Compare, Branchless>(begin, begin + sample_size, begin + pos,
+                                                          comp, log2(int(sample_size)), leftmost);
+                std::iter_swap(begin, begin + pos);
+            } else choose_pivot(begin, end, comp);
+
+            // Pivot equal to *(begin - 1), see pdqsort_loop. The left partition is all equal, and
+            // if it contains nth, nth is already in place.
+            if (!leftmost && !comp(*(begin - 1), *begin)) {
+                begin = partition_left(begin, end, comp) + 1;
+                if (nth < begin) return;
+                continue;
+            }
+
+            // Partition and get results.
+            std::pair<Iter, bool> part_result =
+                Branchless ? partition_right_branchless(begin, end, comp)
+                           : partition_right(begin, end, comp);
+            Iter pivot_pos = part_result.first;
+            bool already_partitioned = part_result.second;
+            if (pivot_pos == nth) return;
+
+            // Check for a highly unbalanced partition. With a pivot from the sample, only when the
+            // partition which contains nth is the big one.
+            diff_t l_size = pivot_pos - begin;
+            diff_t r_size = end - (pivot_pos + 1);
+            bool highly_unbalanced = sampled ? (nth < pivot_pos ? r_size : l_size) < size / 8
+                                             : l_size < size / 8 || r_size < size / 8;
+
+            if (highly_unbalanced) {
+                // If we had too many bad partitions, switch to heap selection to guarantee
+                // O(n * log(n)).
+                if (--bad_allowed == 0) {
+                    if (nth < pivot_pos) end = pivot_pos;
+                    else begin = pivot_pos + 1;
+                    std::partial_sort(begin, nth + 1, end, comp);
+                    return;
+                }
+
+                break_patterns(begin, pivot_pos, end);
+            } else if (already_partitioned) {
+                // Try to sort with insertion sort the partition which contains nth.
+                if (nth < pivot_pos ? partial_insertion_sort(begin, pivot_pos, comp)
+                                    : partial_insertion_sort(pivot_pos + 1, end, comp)) return;
+            }
+
+            // Continue only with the partition which contains nth.
+            if (nth < pivot_pos) end = pivot_pos;
+            else {
+                begin = pivot_pos + 1;
+                leftmost = false;
+            }
+        }
+    }
+
+    template<class Iter, class Compare>
+    struct use_branchless {
+        static const bool value =
+            is_default_compare<typename boost::decay<Compare>::type>::value &&
+            boost::is_arithmetic<typename std::iterator_traits<Iter>::value_type>::value;
+    };
+}
+
+
+/*! \brief Selection algorithm using random access iterators and a user-defined comparison operator.
+
+    \details @c nth_element rearranges the elements so that the element pointed by @c nth is the
+element that would be there if [@c first, @c last) were sorted, all the elements before it are not
+greater, and all the elements after it are not smaller. It is the loop of @c pdqsort, with the same
+pivot selection and partitions, recursing only in the partition that contains @c nth. Has an
+average runtime of <em>O(N)</em> and a worst case of <em>O(N * lg(N))</em>.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] nth Iterator pointing to the element to select.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] comp A binary functor that returns whether the first element passed to it should go before the second in order.
+   \pre [@c first, @c last) is a valid range, and @c nth is in it.
+   \pre @c RandomAccessIter @c value_type is <a href="http://en.cppreference.com/w/cpp/concept/MoveAssignable">MoveAssignable</a>
+   \pre @c RandomAccessIter @c value_type is <a href="http://en.cppreference.com/w/cpp/concept/MoveConstructible">MoveConstructible</a>
+   \post @c *nth is the element of its position in sorted order, and [@c first, @c last) is partitioned around it.
+
+   \return @c void.
+
+   \throws std::exception Propagates exceptions if any of the element comparisons, the element swaps
+   (or moves), functors, or any operations on iterators throw.
+   \warning Invalid arguments cause undefined behaviour.
+   \warning Throwing an exception may cause data loss.
+*/
+template<class Iter, class Compare>
+inline void nth_element(Iter first, Iter nth, Iter last, Compare comp) {
+    if (first == last || nth == last) return;
+    pdqsort_detail::pdqselect_loop<Iter, Compare,
+        pdqsort_detail::use_branchless<Iter, Compare>::value>(
+        first, last, nth, comp, pdqsort_detail::log2(last - first));
+}
+
+
+/*! \brief Selection algorithm using random access iterators.
+
+    \details @c nth_element with the operator < of the elements.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] nth Iterator pointing to the element to select.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \pre [@c first, @c last) is a valid range, and @c nth is in it.
+   \pre @c RandomAccessIter @c value_type is <a href="http://en.cppreference.com/w/cpp/concept/LessThanComparable">LessThanComparable</a>
+   \post @c *nth is the element of its position in sorted order, and [@c first, @c last) is partitioned around it.
+
+   \return @c void.
+*/
+template<class Iter>
+inline void nth_element(Iter first, Iter nth, Iter last) {
+    typedef typename std::iterator_traits<Iter>::value_type T;
+    boost::sort::nth_element(first, nth, last, std::less<T>());
+}
+
+
+/*! \brief Partial sort algorithm using random access iterators and a user-defined comparison operator.
+
+    \details @c partial_sort puts in [@c first, @c middle), sorted, the smallest elements of
+[@c first, @c last). The remaining elements are in [@c middle, @c last) in an unspecified order.
+Selects the elements with @c nth_element and sorts them with @c pdqsort, with a runtime of
+<em>O(N + K * lg(K))</em>, where K is @c middle - @c first, instead of the <em>O(N * lg(K))</em>
+of the heap based @c std::partial_sort.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] middle Iterator pointing to one beyond the last element to sort.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] comp A binary functor that returns whether the first element passed to it should go before the second in order.
+   \pre [@c first, @c middle) and [@c middle, @c last) are valid ranges.
+   \pre @c RandomAccessIter @c value_type is <a href="http://en.cppreference.com/w/cpp/concept/MoveAssignable">MoveAssignable</a>
+   \pre @c RandomAccessIter @c value_type is <a href="http://en.cppreference.com/w/cpp/concept/MoveConstructible">MoveConstructible</a>
+   \post The elements in the range [@c first, @c middle) are the smallest, sorted in ascending order.
+
+   \return @c void.
+
+   \throws std::exception Propagates exceptions if any of the element comparisons, the element swaps
+   (or moves), functors, or any operations on iterators throw.
+   \warning Invalid arguments cause undefined behaviour.
+   \warning Throwing an exception may cause data loss.
+*/
+template<class Iter, class Compare>
+inline void partial_sort(Iter first, Iter middle, Iter last, Compare comp) {
+    if (first == middle) return;
+    boost::sort::nth_element(first, middle - 1, last, comp);
+    boost::sort::pdqsort(first, middle - 1, comp);
+}
+
+
+/*! \brief Partial sort algorithm using random access iterators.
+
+    \details @c partial_sort with the operator < of the elements.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] middle Iterator pointing to one beyond the last element to sort.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \pre [@c first, @c middle) and [@c middle, @c last) are valid ranges.
+   \pre @c RandomAccessIter @c value_type is <a href="http://en.cppreference.com/w/cpp/concept/LessThanComparable">LessThanComparable</a>
+   \post The elements in the range [@c first, @c middle) are the smallest, sorted in ascending order.
+
+   \return @c void.
+*/
+template<class Iter>
+inline void partial_sort(Iter first, Iter middle, Iter last) {
+    typedef typename std::iterator_traits<Iter>::value_type T;
+    boost::sort::partial_sort(first, middle, last, std::less<T>());
+}
+
+}
+}
+
+#endif
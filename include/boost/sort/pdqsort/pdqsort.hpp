@@ -17,6 +17,8 @@
 #include <iterator>
 #include <utility>
 #include <boost/type_traits.hpp>
+#include <boost/sort/common/sort_network.hpp>
+#include <boost/sort/pdqsort/detail/simd_partition.hpp>
 
 #if __cplusplus >= 201103L
     #include <cstdint>
@@ -104,6 +106,21 @@ namespace pdqsort_detail {
         }
     }
 
+    // Sorts [begin, end), shorter than insertion_sort_threshold. Integers compared with std::less
+    // or std::greater use a branchless sorting network up to common::sort_network_max elements.
+    template<class Iter, class Compare>
+    inline void small_sort(Iter begin, Iter end, Compare comp, bool leftmost, boost::true_type) {
+        if (std::size_t(end - begin) <= common::sort_network_max) common::network_sort(begin, end, comp);
+        else if (leftmost) insertion_sort(begin, end, comp);
+        else unguarded_insertion_sort(begin, end, comp);
+    }
+
+    template<class Iter, class Compare>
+    inline void small_sort(Iter begin, Iter end, Compare comp, bool leftmost, boost::false_type) {
+        if (leftmost) insertion_sort(begin, end, comp);
+        else unguarded_insertion_sort(begin, end, comp);
+    }
+
     // Attempts to use insertion sort on [begin, end). Will return false if more than
     // partial_insertion_sort_limit elements were moved, and abort sorting. Otherwise it will
     // successfully sort and return true.
@@ -211,6 +228,17 @@ namespace pdqsort_detail {
             ++first;
         }
 
+        // Primitive types compared with std::less or std::greater are partitioned with vector
+        // instructions, if the CPU has them.
+        if (simd_partition(first, last, pivot, comp,
+                           boost::integral_constant<bool,
+                               use_simd_partition<Iter, Compare>::value>())) {
+            Iter pivot_pos = first - 1;
+            *begin = BOOST_PDQSORT_PREFER_MOVE(*pivot_pos);
+            *pivot_pos = BOOST_PDQSORT_PREFER_MOVE(pivot);
+            return std::make_pair(pivot_pos, already_partitioned);
+        }
+
         // The following branchless partitioning is derived from "BlockQuicksort: How Branch
         // Mispredictions don't affect Quicksort" by Stefan Edelkamp and Armin Weiss.
         unsigned char offsets_l_storage[block_size + cacheline_size];
@@ -395,6 +423,56 @@ namespace pdqsort_detail {
     }
 
 
+    // Chooses the pivot of [begin, end) as median of 3 or pseudomedian of 9, and puts it in
+    // *begin. Assumes end - begin >= insertion_sort_threshold.
+    template<class Iter, class Compare>
+    inline void choose_pivot(Iter begin, Iter end, Compare comp) {
+        typedef typename std::iterator_traits<Iter>::difference_type diff_t;
+        diff_t size = end - begin;
+        diff_t s2 = size / 2;
+        if (size > ninther_threshold) {
+            sort3(begin, begin + s2, end - 1, comp);
+            sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+            sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+            sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+            std::iter_swap(begin, begin + s2);
+        } else sort3(begin + s2, begin, end - 1, comp);
+    }
+
+    // After a highly unbalanced partition of [begin, end) around pivot_pos, swaps some elements
+    // of both partitions to break the patterns that produced it.
+    template<class Iter>
+    inline void break_patterns(Iter begin, Iter pivot_pos, Iter end) {
+        typedef typename std::iterator_traits<Iter>::difference_type diff_t;
+        diff_t l_size = pivot_pos - begin;
+        diff_t r_size = end - (pivot_pos + 1);
+
+        if (l_size >= insertion_sort_threshold) {
+            std::iter_swap(begin,             begin + l_size / 4);
+            std::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+
+            if (l_size > ninther_threshold) {
+                std::iter_swap(begin + 1,         begin + (l_size / 4 + 1));
+                std::iter_swap(begin + 2,         begin + (l_size / 4 + 2));
+                std::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                std::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+            }
+        }
+
+        if (r_size >= insertion_sort_threshold) {
+            std::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+            std::iter_swap(end - 1,                   end - r_size / 4);
+
+            if (r_size > ninther_threshold) {
+                std::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                std::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                std::iter_swap(end - 2,             end - (1 + r_size / 4));
+                std::iter_swap(end - 3,             end - (2 + r_size / 4));
+            }
+        }
+    }
+
+
     template<class Iter, class Compare, bool Branchless>
     inline void pdqsort_loop(Iter begin, Iter end, Compare comp, int bad_allowed, bool leftmost = true) {
         typedef typename std::iterator_traits<Iter>::difference_type diff_t;
@@ -403,22 +481,16 @@ namespace pdqsort_detail {
         while (true) {
             diff_t size = end - begin;
 
-            // Insertion sort is faster for small arrays.
+            // Insertion sort or a sorting network is faster for small arrays.
             if (size < insertion_sort_threshold) {
-                if (leftmost) insertion_sort(begin, end, comp);
-                else unguarded_insertion_sort(begin, end, comp);
+                small_sort(begin, end, comp, leftmost,
+                           boost::integral_constant<bool,
+                               common::use_sort_network<Iter, Compare>::value>());
                 return;
             }
 
             // Choose pivot as median of 3 or pseudomedian of 9.
-            diff_t s2 = size / 2;
-            if (size > ninther_threshold) {
-                sort3(begin, begin + s2, end - 1, comp);
-                sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
-                sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
-                sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
-                std::iter_swap(begin, begin + s2);
-            } else sort3(begin + s2, begin, end - 1, comp);
+            choose_pivot(begin, end, comp);
 
             // If *(begin - 1) is the end of the right partition of a previous partition operation
             // there is no element in [begin, end) that is smaller than *(begin - 1). Then if our
@@ -451,29 +523,7 @@ namespace pdqsort_detail {
                     return;
                 }
 
-                if (l_size >= insertion_sort_threshold) {
-                    std::iter_swap(begin,             begin + l_size / 4);
-                    std::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
-
-                    if (l_size > ninther_threshold) {
-                        std::iter_swap(begin + 1,         begin + (l_size / 4 + 1));
-                        std::iter_swap(begin + 2,         begin + (l_size / 4 + 2));
-                        std::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
-                        std::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
-                    }
-                }
-                
-                if (r_size >= insertion_sort_threshold) {
-                    std::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
-                    std::iter_swap(end - 1,                   end - r_size / 4);
-                    
-                    if (r_size > ninther_threshold) {
-                        std::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
-                        std::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
-                        std::iter_swap(end - 2,             end - (1 + r_size / 4));
-                        std::iter_swap(end - 3,             end - (2 + r_size / 4));
-                    }
-                }
+                break_patterns(begin, pivot_pos, end);
             } else {
                 // If we were decently balanced and we tried to sort an already partitioned
                 // sequence try to use insertion sort.
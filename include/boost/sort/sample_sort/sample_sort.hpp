@@ -27,6 +27,8 @@
 #include <boost/sort/common/merge_four.hpp>
 #include <boost/sort/common/merge_vector.hpp>
 #include <boost/sort/common/range.hpp>
+#include <boost/sort/common/numa.hpp>
+#include <boost/sort/common/thread_pool.hpp>
 
 namespace boost
 {
@@ -43,8 +45,11 @@ namespace bscu = boost::sort::common::util;
 using bsc::range;
 using bscu::atomic_add;
 using bsc::merge_vector4;
-using bsc::uninit_merge_level4;
+using bsc::uninit_merge_tree;
 using bsc::less_ptr_no_null;
+using bsc::numa_bind;
+using bsc::numa_machine;
+using bsc::numa_first_touch;
 
 //
 ///---------------------------------------------------------------------------
@@ -89,8 +94,8 @@ struct sample_sort
     // range with the auxiliary memory
     range_buf global_buf;
 
-    // vector of futures
-    std::vector<std::future<void>> vfuture;
+    // pool where run the threads, except the calling thread
+    thread_pool &pool;
 
     // vector of vectors which contains the ranges to merge obtained in the
     // subdivision
@@ -119,7 +124,8 @@ struct sample_sort
     void initial_configuration(void);
 
     sample_sort (Iter_t first, Iter_t last, Compare cmp, uint32_t num_thread,
-                 value_t *paux, size_t naux);
+                 value_t *paux, size_t naux,
+                 thread_pool &pl = default_thread_pool());
 
     sample_sort(Iter_t first, Iter_t last)
     : sample_sort (first, last, Compare(), std::thread::hardware_concurrency(),
@@ -136,12 +142,28 @@ struct sample_sort
     : sample_sort(first, last, cmp, num_thread, nullptr, 0) { };
 
     sample_sort(Iter_t first, Iter_t last, Compare cmp, uint32_t num_thread,
-                range_buf range_buf_initial)
+                range_buf range_buf_initial,
+                thread_pool &pl = default_thread_pool())
     : sample_sort(first, last, cmp, num_thread,
-                  range_buf_initial.first, range_buf_initial.size()) { };
+                  range_buf_initial.first, range_buf_initial.size(), pl) { };
 
     void destroy_all(void);
     //
+    //-----------------------------------------------------------------------
+    //  function : node_of_interval
+    /// @brief NUMA node of the buffer of an interval. The buffer of the
+    ///        range sorted by each thread in the initial_configuration is
+    ///        placed in the node of the thread
+    /// @param job : number of the interval
+    //-----------------------------------------------------------------------
+    uint32_t node_of_interval(uint32_t job) const
+    {
+        size_t pos = size_t(vrange_buf_ini[job].first - global_buf.first);
+        size_t part = pos / (global_range.size() / nthread);
+        if (part >= nthread) part = nthread - 1;
+        return numa_machine().node_of(uint32_t(part), nthread);
+    };
+    //
     //-----------------------------------------------------------------------------
     //  function :~sample_sort
     /// @brief destructor of the class. The utility is to destroy the temporary
@@ -158,8 +180,9 @@ struct sample_sort
         uint32_t job = 0;
         while ((job = atomic_add(njob, 1)) < ninterval)
         {
-            uninit_merge_level4(vrange_buf_ini[job], vv_range_it[job],
-                            vv_range_buf[job], comp);
+            numa_bind nb(node_of_interval(job));
+            uninit_merge_tree(vrange_buf_ini[job], vv_range_it[job],
+                              vv_range_buf[job], comp);
         };
     };
     //
@@ -172,6 +195,7 @@ struct sample_sort
         uint32_t job = 0;
         while ((job = atomic_add(njob, 1)) < ninterval)
         {
+            numa_bind nb(node_of_interval(job));
             merge_vector4(vrange_buf_ini[job], vrange_it_ini[job],
                             vv_range_buf[job], vv_range_it[job], comp);
         };
@@ -184,14 +208,7 @@ struct sample_sort
     void first_merge(void)
     { //---------------------------------- begin --------------------------
         njob = 0;
-
-        for (uint32_t i = 0; i < nthread; ++i)
-        {
-            vfuture[i] = std::async(std::launch::async, &this_t::execute_first,
-                            this);
-        };
-        for (uint32_t i = 0; i < nthread; ++i)
-            vfuture[i].get();
+        pool.run(nthread, [this](uint32_t) { execute_first(); });
     };
     //
     //-----------------------------------------------------------------------
@@ -201,13 +218,7 @@ struct sample_sort
     void final_merge(void)
     { //---------------------------------- begin --------------------------
         njob = 0;
-
-        for (uint32_t i = 0; i < nthread; ++i)
-        {
-            vfuture[i] = std::async(std::launch::async, &this_t::execute, this);
-        };
-        for (uint32_t i = 0; i < nthread; ++i)
-            vfuture[i].get();
+        pool.run(nthread, [this](uint32_t) { execute(); });
     };
     //----------------------------------------------------------------------------
 };
@@ -233,19 +244,19 @@ struct sample_sort
 /// @param paux : pointer to the auxiliary memory. If nullptr, the memory is
 ///               created inside the class
 /// @param naux : number of elements of the memory pointed by paux
+/// @param pl : pool where run the threads, except the calling thread
 //-----------------------------------------------------------------------------
 template<class Iter_t, typename Compare>
 sample_sort<Iter_t, Compare>
 ::sample_sort (Iter_t first, Iter_t last, Compare cmp, uint32_t num_thread,
-               value_t *paux, size_t naux)
+               value_t *paux, size_t naux, thread_pool &pl)
 : nthread(num_thread), owner(false), comp(cmp), global_range(first, last),
-  global_buf(nullptr, nullptr), error(false)
+  global_buf(nullptr, nullptr), pool(pl), error(false)
 {
     assert((last - first) >= 0);
     size_t nelem = size_t(last - first);
     construct = false;
     njob = 0;
-    vfuture.resize(nthread);
 
     // Adjust when have many threads and only a few elements
     while (nelem > thread_min and (nthread * nthread) > (nelem >> 3))
@@ -256,7 +267,8 @@ sample_sort<Iter_t, Compare>
 
     if (nthread < 2 or nelem <= (thread_min))
     {
-        bss::spinsort<Iter_t, Compare>(first, last, comp);
+        bss::spinsort<Iter_t, Compare>(first, last, comp,
+                                       range_buf(paux, paux + naux));
         return;
     };
 
@@ -364,23 +376,17 @@ void sample_sort<Iter_t, Compare>::initial_configuration(void)
     vbuf_thread.emplace_back(buf_first, global_buf.last);
 
     //------------------------------------------------------------------------
-    // Sorting of the ranges
+    // Sorting of the ranges. In NUMA mode, each range is sorted in a node,
+    // and its buffer is placed in the same node
     //------------------------------------------------------------------------
-    std::vector<std::future<void>> vfuture(nthread);
-
-    for (uint32_t i = 0; i < nthread; ++i)
+    pool.run(nthread, [&](uint32_t i)
     {
-        auto func = [=]()
-        {
-            bss::spinsort<Iter_t, Compare> (vmem_thread[i].first,
-                            vmem_thread[i].last, comp,
-                            vbuf_thread[i]);
-        };
-        vfuture[i] = std::async(std::launch::async, func);
-    };
-
-    for (uint32_t i = 0; i < nthread; ++i)
-        vfuture[i].get();
+        numa_bind nb(numa_machine().node_of(i, nthread));
+        numa_first_touch(vbuf_thread[i].first, vbuf_thread[i].last);
+        bss::spinsort<Iter_t, Compare> (vmem_thread[i].first,
+                        vmem_thread[i].last, comp,
+                        vbuf_thread[i]);
+    });
 
     //------------------------------------------------------------------------
     // Obtain the vector of milestones
@@ -552,6 +558,28 @@ void sample_sort(Iter_t first, Iter_t last, Compare comp, uint32_t nthread)
     sample_detail::sample_sort<Iter_t, Compare>(first, last, comp, nthread);
 };
 //
+//-----------------------------------------------------------------------------
+//  function : sample_sort
+/// @brief parallel sample sort  algorithm (stable sort), running the threads
+///        in the thread pool received, instead of the default pool
+///
+/// @param first : iterator to the first element of the range to sort
+/// @param last : iterator after the last element to the range to sort
+/// @param comp : object for to compare two elements pointed by Iter_t
+///               iterators
+/// @param nthread : Number of threads to use in the process, including the
+///                  calling thread. When this value is lower than 2, the
+///                  sorting is done with 1 thread
+/// @param pool : thread pool where run the works of the other threads
+//-----------------------------------------------------------------------------
+template<class Iter_t, class Compare>
+void sample_sort(Iter_t first, Iter_t last, Compare comp, uint32_t nthread,
+                 thread_pool &pool)
+{
+    sample_detail::sample_sort<Iter_t, Compare>(first, last, comp, nthread,
+                                                nullptr, 0, pool);
+};
+//
 //****************************************************************************
 };//    End namespace sort
 };//    End namespace boost
@@ -13,12 +13,23 @@
 /*
 Cumulative include for the Boost Sort library
 */
+#include <boost/sort/common/thread_pool.hpp>
 #include <boost/sort/spreadsort/spreadsort.hpp>
+#include <boost/sort/spreadsort/parallel_integer_sort.hpp>
+#include <boost/sort/spreadsort/parallel_integer_tag_sort.hpp>
+#include <boost/sort/spreadsort/parallel_stable_integer_sort.hpp>
+#include <boost/sort/spreadsort/parallel_stable_float_sort.hpp>
+#include <boost/sort/spreadsort/parallel_string_sort.hpp>
+#include <boost/sort/spreadsort/calibrate.hpp>
 #include <boost/sort/spinsort/spinsort.hpp>
 #include <boost/sort/flat_stable_sort/flat_stable_sort.hpp>
 #include <boost/sort/pdqsort/pdqsort.hpp>
+#include <boost/sort/pdqsort/pdqselect.hpp>
 #include <boost/sort/block_indirect_sort/block_indirect_sort.hpp>
 #include <boost/sort/sample_sort/sample_sort.hpp>
 #include <boost/sort/parallel_stable_sort/parallel_stable_sort.hpp>
+#include <boost/sort/parallel_merge/parallel_merge.hpp>
+#include <boost/sort/parallel_partial_sort/parallel_partial_sort.hpp>
+#include <boost/sort/external_sort/external_sort.hpp>
 
 #endif
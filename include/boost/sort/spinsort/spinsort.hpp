@@ -19,6 +19,7 @@
 #include <boost/sort/common/util/algorithm.hpp>
 #include <boost/sort/common/range.hpp>
 #include <boost/sort/common/indirect.hpp>
+#include <boost/sort/common/natural_merge.hpp>
 #include <cstdlib>
 #include <functional>
 #include <iterator>
@@ -456,24 +457,12 @@ spinsort <Iter_t, Compare>
         return;
     };
 
-    //------------------- check if sort ---------------------------------
-    bool sw = true;
-    for (Iter_t it1 = first, it2 = first + 1; it2 != last
-         and (sw = not comp(*it2, *it1)); it1 = it2++) ;
-    if (sw) return;
-
-    //------------------- check if reverse sort -------------------------
-    sw = true;
-    for (Iter_t it1 = first, it2 = first + 1;
-         it2 != last and (sw = comp(*it2, *it1)); it1 = it2++);
-    if (sw)
-    {
-        size_t nelem2 = nelem >> 1;
-        Iter_t it1 = first, it2 = last - 1;
-        for (size_t i = 0; i < nelem2; ++i)
-            std::swap(*(it1++), *(it2--));
-        return;
-    };
+    //------------------- check the natural runs ------------------------
+    // the sorted and the reverse sorted data are a single run, and the
+    // data made of a few long runs are sorted merging them
+    std::vector<size_t> vrun;
+    bool natural = bsc::find_natural_runs(first, last, comp, vrun);
+    if (natural and vrun.size() == 1) return;
 
     if (ptr == nullptr)
     {
@@ -481,6 +470,11 @@ spinsort <Iter_t, Compare>
         if (ptr == nullptr) throw std::bad_alloc();
         owner = true;
     };
+    if (natural)
+    {
+        bsc::natural_merge(first, vrun, comp, ptr);
+        return;
+    };
     range_buf range_aux(ptr, (ptr + nptr));
 
     //---------------------------------------------------------------------
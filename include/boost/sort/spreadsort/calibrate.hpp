@@ -0,0 +1,72 @@
+// Measurement of the tuning values of spreadsort on the running machine.
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort for library home page.
+
+#ifndef BOOST_SORT_SPREADSORT_CALIBRATE_HPP
+#define BOOST_SORT_SPREADSORT_CALIBRATE_HPP
+#include <cstddef>
+#include <boost/sort/spreadsort/tuning.hpp>
+#include <boost/sort/spreadsort/detail/calibrate.hpp>
+
+namespace boost {
+namespace sort {
+namespace spreadsort {
+
+/*! \brief Measures the tuning values of @c integer_sort, @c float_sort and @c string_sort on this machine.
+
+  \details The sizes of the level 1 and level 2 caches give the range of
+@c max_splits tried.  Then each value is tried in a small range around its
+default, timing @c integer_sort or @c float_sort on random samples, and the
+fastest is kept.  Last, @c min_sort_size is the size from which the radix
+sorts are faster than @c pdqsort.  The finishing counts keep their defaults.
+
+  \param[in] sample_size Number of elements of each sample; the values are best
+  for sorts of about this size.  At least 4096.
+  \return The measured values.  The values used by the sorts are unchanged,
+  also while it runs: the values tried are only passed to the sorts of the
+  measurement, so other threads can sort at the same time.
+
+  \warning Takes a few seconds with the default sample size.
+*/
+  inline tuning measure_tuning(size_t sample_size = 1 << 20)
+  {
+    return detail::measure_tuning(sample_size < 4096 ? 4096 : sample_size);
+  }
+
+/*! \brief Tunes @c integer_sort, @c float_sort and @c string_sort for this machine.
+
+  \details Loads the values of the profile if it is valid, and otherwise
+measures them with @c measure_tuning and saves them to the profile, so the
+measurement runs only the first time on each machine.  The values are then
+used by the sorts.\n
+Setting the environment variable @c BOOST_SORT_TUNING_PROFILE to the name of
+the profile loads it on the first use of the sorts, without this call.
+
+  \param[in] profile Name of the profile file; if null, the values are measured
+  and not saved.
+  \param[in] sample_size Number of elements of each sample of @c measure_tuning.
+  \return The values now used by the sorts.
+
+  \warning No sort may run at the same time.
+*/
+  inline tuning calibrate(const char *profile = 0,
+                          size_t sample_size = 1 << 20)
+  {
+    tuning values;
+    if (!profile || !load_tuning(profile, values)) {
+      values = measure_tuning(sample_size);
+      if (profile)
+        save_tuning(profile, values);
+    }
+    set_tuning(values);
+    return values;
+  }
+}
+}
+}
+
+#endif
@@ -0,0 +1,329 @@
+// Details for calibrate, measuring the tuning values of spreadsort.
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort for library home page.
+
+#ifndef BOOST_SORT_SPREADSORT_DETAIL_CALIBRATE_HPP
+#define BOOST_SORT_SPREADSORT_DETAIL_CALIBRATE_HPP
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+#include <boost/sort/pdqsort/pdqsort.hpp>
+#include <boost/sort/spreadsort/tuning.hpp>
+#include <boost/sort/spreadsort/detail/integer_sort.hpp>
+#include <boost/sort/spreadsort/detail/float_sort.hpp>
+#include <boost/cstdint.hpp>
+
+namespace boost {
+namespace sort {
+namespace spreadsort {
+  namespace detail {
+    //Each time is the median of this many runs
+    const unsigned calibration_runs = 5;
+    //A candidate value replaces the current one only if it is this much
+    //faster, so the noise of the timings doesn't move the values around
+    const double calibration_gain = 0.95;
+
+    //Seconds taken by sort on copies of the samples
+    template <class Data_type, class Sort>
+    inline double
+    time_sort(const std::vector<std::vector<Data_type> > &samples, Sort sort)
+    {
+      std::vector<double> times;
+      std::vector<Data_type> data;
+      for (unsigned run = 0; run < calibration_runs; ++run) {
+        double total = 0;
+        for (size_t u = 0; u < samples.size(); ++u) {
+          data = samples[u];
+          std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+          sort(data);
+          total += std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        }
+        times.push_back(total);
+      }
+      std::sort(times.begin(), times.end());
+      return times[times.size() / 2];
+    }
+
+    //Nanoseconds per read, following a random cycle through the cache
+    //lines of bytes of memory; each read depends on the one before
+    inline double read_latency(size_t bytes)
+    {
+      const size_t line = 64 / sizeof(size_t);
+      const size_t line_count = bytes / 64;
+      const size_t reads = 1 << 20;
+      std::vector<size_t> memory(line_count * line);
+      std::vector<size_t> order(line_count);
+      for (size_t u = 0; u < line_count; ++u)
+        order[u] = u * line;
+      std::shuffle(order.begin(), order.end(), std::mt19937(1));
+      for (size_t u = 0; u < line_count; ++u)
+        memory[order[u]] = order[(u + 1) % line_count];
+      size_t position = order[0];
+      std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+      for (size_t u = 0; u < reads; ++u)
+        position = memory[position];
+      double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+      //Using the position keeps the reads
+      volatile size_t end = position;
+      (void)end;
+      return seconds * 1e9 / reads;
+    }
+
+    //Sizes in bytes of the level 1 data cache and of the level 2 cache.
+    //They are asked to the system when it can tell them, and otherwise
+    //found where the read latency jumps; 0 if not found.
+    inline void measure_cache_sizes(size_t &l1_size, size_t &l2_size)
+    {
+      l1_size = l2_size = 0;
+#if defined(_SC_LEVEL1_DCACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE)
+      long size = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+      l1_size = size > 0 ? size_t(size) : 0;
+      size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+      l2_size = size > 0 ? size_t(size) : 0;
+#endif
+      if (l1_size && l2_size)
+        return;
+      const size_t min_bytes = 4 << 10, max_bytes = 16 << 20;
+      size_t found[2] = { 0, 0 };
+      unsigned level = 0;
+      double base = read_latency(min_bytes);
+      for (size_t bytes = 2 * min_bytes; bytes <= max_bytes && level < 2;
+          bytes *= 2) {
+        double latency = read_latency(bytes);
+        if (latency > 1.5 * base) {
+          found[level++] = bytes / 2;
+          base = latency;
+        }
+      }
+      if (!l1_size)
+        l1_size = found[0];
+      if (!l2_size)
+        l2_size = found[1];
+    }
+
+    //Tries the values low to high of one field, and keeps the fastest
+    template <class Measure>
+    inline void
+    tune_value(tuning &values, unsigned tuning::*field, unsigned low,
+               unsigned high, Measure measure)
+    {
+      double best_time = measure(values);
+      unsigned best = values.*field;
+      for (unsigned value = low; value <= high; ++value) {
+        tuning candidate = values;
+        candidate.*field = value;
+        if (value == best || !valid_tuning(candidate))
+          continue;
+        double time = measure(candidate);
+        if (time < best_time * calibration_gain) {
+          best_time = time;
+          best = value;
+        }
+      }
+      values.*field = best;
+    }
+
+    //Integers of full range, and integers of random bit widths
+    inline std::vector<std::vector<boost::uint32_t> >
+    integer_samples(size_t count)
+    {
+      std::mt19937 generator(1);
+      std::vector<std::vector<boost::uint32_t> > samples(2);
+      for (size_t u = 0; u < count; ++u) {
+        boost::uint32_t value = generator();
+        samples[0].push_back(value);
+        samples[1].push_back(value >> (generator() % 32));
+      }
+      return samples;
+    }
+
+    //Floats in [-1, 1), and floats of random sign and exponent
+    inline std::vector<std::vector<float> > float_samples(size_t count)
+    {
+      std::mt19937 generator(2);
+      std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+      std::vector<std::vector<float> > samples(2);
+      for (size_t u = 0; u < count; ++u) {
+        float value = distribution(generator);
+        samples[0].push_back(value);
+        samples[1].push_back(std::ldexp(value, int(generator() % 64) - 32));
+      }
+      return samples;
+    }
+
+    //Values tried by the calibration in this thread.  The sorts of the
+    //calibration read them instead of current_tuning(), which stays
+    //unchanged for the sorts of the other threads.
+    inline const tuning *&trial_tuning()
+    {
+      static thread_local const tuning *values = 0;
+      return values;
+    }
+
+    //Sets the values tried while it exists, and restores the previous ones
+    //when it is destroyed, also by an exception
+    class trial_scope {
+      const tuning *previous;
+      trial_scope(const trial_scope &);
+      trial_scope &operator=(const trial_scope &);
+    public:
+      explicit trial_scope(const tuning &values) : previous(trial_tuning())
+      { trial_tuning() = &values; }
+      ~trial_scope() { trial_tuning() = previous; }
+    };
+
+    //The values tried, for integer_sort and float_sort
+    struct int_trial_tuning {
+      static unsigned max_splits() { return trial_tuning()->max_splits; }
+      static unsigned log_mean_bin_size()
+      { return trial_tuning()->int_log_mean_bin_size; }
+      static unsigned log_min_split_count()
+      { return trial_tuning()->int_log_min_split_count; }
+      static unsigned log_finishing_count()
+      { return trial_tuning()->int_log_finishing_count; }
+    };
+
+    struct float_trial_tuning {
+      static unsigned max_splits() { return trial_tuning()->max_splits; }
+      static unsigned log_mean_bin_size()
+      { return trial_tuning()->float_log_mean_bin_size; }
+      static unsigned log_min_split_count()
+      { return trial_tuning()->float_log_min_split_count; }
+      static unsigned log_finishing_count()
+      { return trial_tuning()->float_log_finishing_count; }
+    };
+
+    //Sorts with integer_sort and float_sort and the values tried, for any
+    //size
+    struct integer_sorter {
+      void operator()(std::vector<boost::uint32_t> &data) const
+      {
+        integer_sort<int_trial_tuning>(data.begin(), data.end(),
+                                       data[0] >> 0);
+      }
+    };
+
+    struct float_sorter {
+      void operator()(std::vector<float> &data) const
+      { float_sort<float_trial_tuning>(data.begin(), data.end()); }
+    };
+
+    struct comparison_sorter {
+      template <class Data_type>
+      void operator()(std::vector<Data_type> &data) const
+      { boost::sort::pdqsort(data.begin(), data.end()); }
+    };
+
+    //Time of Sort on the samples with the candidate values
+    template <class Data_type, class Sort>
+    struct tuning_measure {
+      const std::vector<std::vector<Data_type> > *samples;
+
+      double operator()(const tuning &values) const
+      {
+        trial_scope scope(values);
+        return time_sort(*samples, Sort());
+      }
+    };
+
+    //The smallest size from which integer_sort and float_sort with values
+    //are faster than pdqsort, sorting about sample_size elements in small
+    //pieces.
+    //The times of each size are added to those of the next larger size,
+    //which smooths out the noise.
+    inline unsigned measure_min_sort_size(const tuning &values,
+                                          size_t sample_size)
+    {
+      trial_scope scope(values);
+      const size_t min_size = 64, max_size = 1 << 14;
+      std::vector<std::vector<boost::uint32_t> > integers =
+        integer_samples(sample_size);
+      std::vector<std::vector<float> > floats = float_samples(sample_size);
+      size_t result = 2 * max_size;
+      double larger_radix_time = 0, larger_comparison_time = 0;
+      for (size_t size = max_size; size >= min_size; size /= 2) {
+        std::vector<std::vector<boost::uint32_t> > integer_pieces;
+        std::vector<std::vector<float> > float_pieces;
+        for (size_t u = 0; u + size <= sample_size; u += size) {
+          integer_pieces.push_back(std::vector<boost::uint32_t>(
+            integers[0].begin() + u, integers[0].begin() + u + size));
+          float_pieces.push_back(std::vector<float>(
+            floats[0].begin() + u, floats[0].begin() + u + size));
+        }
+        if (integer_pieces.empty())
+          continue;
+        double radix_time = time_sort(integer_pieces, integer_sorter()) +
+          time_sort(float_pieces, float_sorter());
+        double comparison_time = time_sort(integer_pieces,
+          comparison_sorter()) + time_sort(float_pieces, comparison_sorter());
+        if (radix_time + larger_radix_time >=
+            comparison_time + larger_comparison_time) {
+          result = (std::min)(result, 2 * size);
+          break;
+        }
+        larger_radix_time = radix_time;
+        larger_comparison_time = comparison_time;
+        result = size;
+      }
+      return unsigned(result);
+    }
+
+    //Measures the tuning values, one at a time, starting from the defaults
+    inline tuning measure_tuning(size_t sample_size)
+    {
+      tuning values = default_tuning();
+
+      //The bins of an iteration are read and written at random; their
+      //positions, and the next cache line of each, should fit in the
+      //level 1 cache
+      size_t l1_size, l2_size;
+      measure_cache_sizes(l1_size, l2_size);
+      unsigned log_l1 = rough_log_2_size(l1_size);
+      if (log_l1 > 5)
+        values.max_splits = (std::min)(unsigned(max_tuned_splits),
+          (std::max)(log_l1 - 5, unsigned(values.int_log_min_split_count)));
+      //A level 2 cache much larger than the level 1 hides some misses
+      unsigned extra = rough_log_2_size(l2_size / (l1_size ? l1_size : 1)) > 4
+        ? 2 : 1;
+
+      std::vector<std::vector<boost::uint32_t> > integers =
+        integer_samples(sample_size / 2);
+      std::vector<std::vector<float> > floats = float_samples(sample_size / 2);
+      tuning_measure<boost::uint32_t, integer_sorter> integer_measure =
+        { &integers };
+      tuning_measure<float, float_sorter> float_measure = { &floats };
+      tune_value(values, &tuning::max_splits, values.max_splits - 1,
+                 values.max_splits + extra, integer_measure);
+      tune_value(values, &tuning::int_log_mean_bin_size, 0, 4,
+                 integer_measure);
+      tune_value(values, &tuning::int_log_min_split_count,
+                 values.int_log_min_split_count - 2,
+                 values.int_log_min_split_count + 2, integer_measure);
+      tune_value(values, &tuning::float_log_mean_bin_size, 0, 4,
+                 float_measure);
+      tune_value(values, &tuning::float_log_min_split_count,
+                 values.float_log_min_split_count - 2,
+                 values.float_log_min_split_count + 2, float_measure);
+      values.min_sort_size = measure_min_sort_size(values, sample_size);
+      return values;
+    }
+  }
+}
+}
+}
+
+#endif
@@ -13,6 +13,8 @@ namespace sort {
 namespace spreadsort {
 namespace detail {
 //Tuning constants
+//These are the defaults of the runtime tuning values of tuning.hpp, which
+//calibrate() measures on the machine.
 //This should be tuned to your processor cache;
 //if you go too large you get cache misses on bins
 //The smaller this number, the less worst-case memory usage.
@@ -38,7 +40,19 @@ float_log_min_split_count = 8,
 //iteration.  Make this larger the faster boost::sort::pdqsort is relative to float_sort.
 float_log_finishing_count = 4,
 //There is a minimum size below which it is not worth using spreadsort
-min_sort_size = 1000 };
+min_sort_size = 1000,
+//Largest max_splits accepted at runtime by set_tuning; the bin counts of a
+//larger max_splits than the one above are allocated on the heap
+max_tuned_splits = 20,
+//Minimum number of elements per thread for the parallel variants;
+//below this, the cost of starting a thread outweighs the work it does
+min_parallel_size = 1 << 16,
+//How far past the bin position just written to prefetch in the swap loops;
+//one cache line, so the next write to that bin doesn't miss the cache
+bin_prefetch_bytes = 64,
+//Minimum number of elements for integer_select and float_select to narrow
+//the range with a sample before counting the bins
+min_sample_size = 1 << 15 };
 }
 }
 }
@@ -26,6 +26,7 @@ Scott McMurray
 #include <boost/sort/spreadsort/detail/constants.hpp>
 #include <boost/sort/spreadsort/detail/integer_sort.hpp>
 #include <boost/sort/spreadsort/detail/spreadsort_common.hpp>
+#include <boost/sort/spreadsort/detail/spreadsort_simd.hpp>
 #include <boost/cstdint.hpp>
 
 namespace boost {
@@ -110,12 +111,14 @@ namespace spreadsort {
                                (current) >> log_divisor) - div_min)) {
           typename std::iterator_traits<RandomAccessIter>::value_type tmp;
           RandomAccessIter b = (*target_bin)++;
+          prefetch_bin_position(b);
           RandomAccessIter * b_bin = bins + ((cast_float_iter<Div_type,
                               RandomAccessIter>(b) >> log_divisor) - div_min);
           //Three-way swap; if the item to be swapped doesn't belong in the
           //current bin, swap it to where it belongs
           if (b_bin != local_bin) {
             RandomAccessIter c = (*b_bin)++;
+            prefetch_bin_position(c);
             tmp = *c;
             *c = *b;
           }
@@ -146,6 +149,10 @@ namespace spreadsort {
     is_sorted_or_find_extremes(RandomAccessIter current, RandomAccessIter last,
                   Cast_type & max, Cast_type & min)
     {
+      //Use a vector kernel when there is one for this data
+      int simd_result = simd_float_sorted_or_extremes(current, last, max, min);
+      if (simd_result >= 0)
+        return simd_result != 0;
       min = max = cast_float_iter<Cast_type, RandomAccessIter>(current);
       RandomAccessIter prev = current;
       bool sorted = true;
@@ -162,7 +169,8 @@ namespace spreadsort {
     }
 
     //Special-case sorting of positive floats with casting
-    template <class RandomAccessIter, class Div_type, class Size_type>
+    template <class RandomAccessIter, class Div_type, class Size_type,
+              class Tuning>
     inline void
     positive_float_sort_rec(RandomAccessIter first, RandomAccessIter last,
               std::vector<RandomAccessIter> &bin_cache, unsigned cache_offset
@@ -172,7 +180,7 @@ namespace spreadsort {
       if (is_sorted_or_find_extremes<RandomAccessIter, Div_type>(first, last, 
                                                                 max, min))
         return;
-      unsigned log_divisor = get_log_divisor<float_log_mean_bin_size>(
+      unsigned log_divisor = get_log_divisor<Tuning>(
           last - first, rough_log_2_size(Size_type(max - min)));
       Div_type div_min = min >> log_divisor;
       Div_type div_max = max >> log_divisor;
@@ -182,9 +190,8 @@ namespace spreadsort {
                                           cache_end, bin_count);
 
       //Calculating the size of each bin
-      for (RandomAccessIter current = first; current != last;)
-        bin_sizes[unsigned((cast_float_iter<Div_type, RandomAccessIter>(
-            current++) >> log_divisor) - div_min)]++;
+      count_float_bins(first, last, bin_sizes, bin_count, log_divisor,
+                       div_min);
       bins[0] = first;
       for (unsigned u = 0; u < bin_count - 1; u++)
         bins[u + 1] = bins[u] + bin_sizes[u];
@@ -202,9 +209,7 @@ namespace spreadsort {
         return;
 
       //Recursing
-      size_t max_count = get_min_count<float_log_mean_bin_size,
-                                       float_log_min_split_count,
-                                       float_log_finishing_count>(log_divisor);
+      size_t max_count = get_min_count<Tuning>(log_divisor);
       RandomAccessIter lastPos = first;
       for (unsigned u = cache_offset; u < cache_end; lastPos = bin_cache[u],
           ++u) {
@@ -214,14 +219,15 @@ namespace spreadsort {
         if (count < max_count)
           boost::sort::pdqsort(lastPos, bin_cache[u]);
         else
-          positive_float_sort_rec<RandomAccessIter, Div_type, Size_type>
+          positive_float_sort_rec<RandomAccessIter, Div_type, Size_type, Tuning>
             (lastPos, bin_cache[u], bin_cache, cache_end, bin_sizes);
       }
     }
 
     //Sorting negative floats
     //Bins are iterated in reverse because max_neg_float = min_neg_int
-    template <class RandomAccessIter, class Div_type, class Size_type>
+    template <class RandomAccessIter, class Div_type, class Size_type,
+              class Tuning>
     inline void
     negative_float_sort_rec(RandomAccessIter first, RandomAccessIter last,
                         std::vector<RandomAccessIter> &bin_cache,
@@ -232,7 +238,7 @@ namespace spreadsort {
                                                                  max, min))
         return;
 
-      unsigned log_divisor = get_log_divisor<float_log_mean_bin_size>(
+      unsigned log_divisor = get_log_divisor<Tuning>(
           last - first, rough_log_2_size(Size_type(max - min)));
       Div_type div_min = min >> log_divisor;
       Div_type div_max = max >> log_divisor;
@@ -242,9 +248,8 @@ namespace spreadsort {
                                           cache_end, bin_count);
 
       //Calculating the size of each bin
-      for (RandomAccessIter current = first; current != last;)
-        bin_sizes[unsigned((cast_float_iter<Div_type, RandomAccessIter>(
-            current++) >> log_divisor) - div_min)]++;
+      count_float_bins(first, last, bin_sizes, bin_count, log_divisor,
+                       div_min);
       bins[bin_count - 1] = first;
       for (int ii = bin_count - 2; ii >= 0; --ii)
         bins[ii] = bins[ii + 1] + bin_sizes[ii + 1];
@@ -263,9 +268,7 @@ namespace spreadsort {
         return;
 
       //Recursing
-      size_t max_count = get_min_count<float_log_mean_bin_size,
-                                       float_log_min_split_count,
-                                       float_log_finishing_count>(log_divisor);
+      size_t max_count = get_min_count<Tuning>(log_divisor);
       RandomAccessIter lastPos = first;
       for (int ii = cache_end - 1; ii >= static_cast<int>(cache_offset);
           lastPos = bin_cache[ii], --ii) {
@@ -275,7 +278,7 @@ namespace spreadsort {
         if (count < max_count)
           boost::sort::pdqsort(lastPos, bin_cache[ii]);
         else
-          negative_float_sort_rec<RandomAccessIter, Div_type, Size_type>
+          negative_float_sort_rec<RandomAccessIter, Div_type, Size_type, Tuning>
             (lastPos, bin_cache[ii], bin_cache, cache_end, bin_sizes);
       }
     }
@@ -283,7 +286,7 @@ namespace spreadsort {
     //Sorting negative floats
     //Bins are iterated in reverse order because max_neg_float = min_neg_int
     template <class RandomAccessIter, class Div_type, class Right_shift,
-              class Size_type>
+              class Size_type, class Tuning>
     inline void
     negative_float_sort_rec(RandomAccessIter first, RandomAccessIter last,
               std::vector<RandomAccessIter> &bin_cache, unsigned cache_offset
@@ -292,7 +295,7 @@ namespace spreadsort {
       Div_type max, min;
       if (is_sorted_or_find_extremes(first, last, max, min, rshift))
         return;
-      unsigned log_divisor = get_log_divisor<float_log_mean_bin_size>(
+      unsigned log_divisor = get_log_divisor<Tuning>(
           last - first, rough_log_2_size(Size_type(max - min)));
       Div_type div_min = min >> log_divisor;
       Div_type div_max = max >> log_divisor;
@@ -322,9 +325,7 @@ namespace spreadsort {
         return;
 
       //Recursing
-      size_t max_count = get_min_count<float_log_mean_bin_size,
-                                       float_log_min_split_count,
-                                       float_log_finishing_count>(log_divisor);
+      size_t max_count = get_min_count<Tuning>(log_divisor);
       RandomAccessIter lastPos = first;
       for (int ii = cache_end - 1; ii >= static_cast<int>(cache_offset);
           lastPos = bin_cache[ii], --ii) {
@@ -335,13 +336,13 @@ namespace spreadsort {
           boost::sort::pdqsort(lastPos, bin_cache[ii]);
         else
           negative_float_sort_rec<RandomAccessIter, Div_type, Right_shift,
-                                  Size_type>
+                                  Size_type, Tuning>
             (lastPos, bin_cache[ii], bin_cache, cache_end, bin_sizes, rshift);
       }
     }
 
     template <class RandomAccessIter, class Div_type, class Right_shift,
-              class Compare, class Size_type>
+              class Compare, class Size_type, class Tuning>
     inline void
     negative_float_sort_rec(RandomAccessIter first, RandomAccessIter last,
             std::vector<RandomAccessIter> &bin_cache, unsigned cache_offset,
@@ -350,7 +351,7 @@ namespace spreadsort {
       Div_type max, min;
       if (is_sorted_or_find_extremes(first, last, max, min, rshift, comp))
         return;
-      unsigned log_divisor = get_log_divisor<float_log_mean_bin_size>(
+      unsigned log_divisor = get_log_divisor<Tuning>(
           last - first, rough_log_2_size(Size_type(max - min)));
       Div_type div_min = min >> log_divisor;
       Div_type div_max = max >> log_divisor;
@@ -380,9 +381,7 @@ namespace spreadsort {
         return;
 
       //Recursing
-      size_t max_count = get_min_count<float_log_mean_bin_size,
-                                       float_log_min_split_count,
-                                       float_log_finishing_count>(log_divisor);
+      size_t max_count = get_min_count<Tuning>(log_divisor);
       RandomAccessIter lastPos = first;
       for (int ii = cache_end - 1; ii >= static_cast<int>(cache_offset);
           lastPos = bin_cache[ii], --ii) {
@@ -393,14 +392,15 @@ namespace spreadsort {
           boost::sort::pdqsort(lastPos, bin_cache[ii], comp);
         else
           negative_float_sort_rec<RandomAccessIter, Div_type, Right_shift,
-                                  Compare, Size_type>(lastPos, bin_cache[ii],
-                                                      bin_cache, cache_end,
-                                                      bin_sizes, rshift, comp);
+                                  Compare, Size_type, Tuning>
+            (lastPos, bin_cache[ii], bin_cache, cache_end, bin_sizes, rshift,
+             comp);
       }
     }
 
     //Casting special-case for floating-point sorting
-    template <class RandomAccessIter, class Div_type, class Size_type>
+    template <class RandomAccessIter, class Div_type, class Size_type,
+              class Tuning>
     inline void
     float_sort_rec(RandomAccessIter first, RandomAccessIter last,
                 std::vector<RandomAccessIter> &bin_cache, unsigned cache_offset
@@ -410,7 +410,7 @@ namespace spreadsort {
       if (is_sorted_or_find_extremes<RandomAccessIter, Div_type>(first, last, 
                                                                 max, min))
         return;
-      unsigned log_divisor = get_log_divisor<float_log_mean_bin_size>(
+      unsigned log_divisor = get_log_divisor<Tuning>(
           last - first, rough_log_2_size(Size_type(max - min)));
       Div_type div_min = min >> log_divisor;
       Div_type div_max = max >> log_divisor;
@@ -420,9 +420,8 @@ namespace spreadsort {
                                           cache_end, bin_count);
 
       //Calculating the size of each bin
-      for (RandomAccessIter current = first; current != last;)
-        bin_sizes[unsigned((cast_float_iter<Div_type, RandomAccessIter>(
-            current++) >> log_divisor) - div_min)]++;
+      count_float_bins(first, last, bin_sizes, bin_count, log_divisor,
+                       div_min);
       //The index of the first positive bin
       //Must be divided small enough to fit into an integer
       unsigned first_positive = (div_min < 0) ? unsigned(-div_min) : 0;
@@ -464,9 +463,7 @@ namespace spreadsort {
         return;
 
       //Handling negative values first
-      size_t max_count = get_min_count<float_log_mean_bin_size,
-                                       float_log_min_split_count,
-                                       float_log_finishing_count>(log_divisor);
+      size_t max_count = get_min_count<Tuning>(log_divisor);
       RandomAccessIter lastPos = first;
       for (int ii = cache_offset + first_positive - 1; 
            ii >= static_cast<int>(cache_offset);
@@ -478,7 +475,7 @@ namespace spreadsort {
           boost::sort::pdqsort(lastPos, bin_cache[ii]);
         //sort negative values using reversed-bin spreadsort
         else
-          negative_float_sort_rec<RandomAccessIter, Div_type, Size_type>
+          negative_float_sort_rec<RandomAccessIter, Div_type, Size_type, Tuning>
             (lastPos, bin_cache[ii], bin_cache, cache_end, bin_sizes);
       }
 
@@ -491,14 +488,14 @@ namespace spreadsort {
           boost::sort::pdqsort(lastPos, bin_cache[u]);
         //sort positive values using normal spreadsort
         else
-          positive_float_sort_rec<RandomAccessIter, Div_type, Size_type>
+          positive_float_sort_rec<RandomAccessIter, Div_type, Size_type, Tuning>
             (lastPos, bin_cache[u], bin_cache, cache_end, bin_sizes);
       }
     }
 
     //Functor implementation for recursive sorting
     template <class RandomAccessIter, class Div_type, class Right_shift
-      , class Size_type>
+      , class Size_type, class Tuning>
     inline void
     float_sort_rec(RandomAccessIter first, RandomAccessIter last,
               std::vector<RandomAccessIter> &bin_cache, unsigned cache_offset
@@ -507,7 +504,7 @@ namespace spreadsort {
       Div_type max, min;
       if (is_sorted_or_find_extremes(first, last, max, min, rshift))
         return;
-      unsigned log_divisor = get_log_divisor<float_log_mean_bin_size>(
+      unsigned log_divisor = get_log_divisor<Tuning>(
           last - first, rough_log_2_size(Size_type(max - min)));
       Div_type div_min = min >> log_divisor;
       Div_type div_max = max >> log_divisor;
@@ -560,9 +557,7 @@ namespace spreadsort {
         return;
 
       //Handling negative values first
-      size_t max_count = get_min_count<float_log_mean_bin_size,
-                                       float_log_min_split_count,
-                                       float_log_finishing_count>(log_divisor);
+      size_t max_count = get_min_count<Tuning>(log_divisor);
       RandomAccessIter lastPos = first;
       for (int ii = cache_offset + first_positive - 1; 
            ii >= static_cast<int>(cache_offset);
@@ -575,7 +570,7 @@ namespace spreadsort {
         //sort negative values using reversed-bin spreadsort
         else
           negative_float_sort_rec<RandomAccessIter, Div_type,
-            Right_shift, Size_type>(lastPos, bin_cache[ii], bin_cache,
+            Right_shift, Size_type, Tuning>(lastPos, bin_cache[ii], bin_cache,
                                     cache_end, bin_sizes, rshift);
       }
 
@@ -589,14 +584,13 @@ namespace spreadsort {
         //sort positive values using normal spreadsort
         else
           spreadsort_rec<RandomAccessIter, Div_type, Right_shift, Size_type,
-                          float_log_mean_bin_size, float_log_min_split_count,
-                          float_log_finishing_count>
+                         Tuning>
             (lastPos, bin_cache[u], bin_cache, cache_end, bin_sizes, rshift);
       }
     }
 
     template <class RandomAccessIter, class Div_type, class Right_shift,
-              class Compare, class Size_type>
+              class Compare, class Size_type, class Tuning>
     inline void
     float_sort_rec(RandomAccessIter first, RandomAccessIter last,
             std::vector<RandomAccessIter> &bin_cache, unsigned cache_offset,
@@ -605,7 +599,7 @@ namespace spreadsort {
       Div_type max, min;
       if (is_sorted_or_find_extremes(first, last, max, min, rshift, comp))
         return;
-      unsigned log_divisor = get_log_divisor<float_log_mean_bin_size>(
+      unsigned log_divisor = get_log_divisor<Tuning>(
           last - first, rough_log_2_size(Size_type(max - min)));
       Div_type div_min = min >> log_divisor;
       Div_type div_max = max >> log_divisor;
@@ -659,9 +653,7 @@ namespace spreadsort {
         return;
 
       //Handling negative values first
-      size_t max_count = get_min_count<float_log_mean_bin_size,
-                                       float_log_min_split_count,
-                                       float_log_finishing_count>(log_divisor);
+      size_t max_count = get_min_count<Tuning>(log_divisor);
       RandomAccessIter lastPos = first;
       for (int ii = cache_offset + first_positive - 1; 
            ii >= static_cast<int>(cache_offset);
@@ -674,9 +666,9 @@ namespace spreadsort {
         //sort negative values using reversed-bin spreadsort
         else
           negative_float_sort_rec<RandomAccessIter, Div_type, Right_shift,
-                                  Compare, Size_type>(lastPos, bin_cache[ii],
-                                                      bin_cache, cache_end,
-                                                      bin_sizes, rshift, comp);
+                                  Compare, Size_type, Tuning>
+            (lastPos, bin_cache[ii], bin_cache, cache_end, bin_sizes, rshift,
+             comp);
       }
 
       for (unsigned u = cache_offset + first_positive; u < cache_end;
@@ -689,43 +681,48 @@ namespace spreadsort {
         //sort positive values using normal spreadsort
         else
           spreadsort_rec<RandomAccessIter, Div_type, Right_shift, Compare,
-                          Size_type, float_log_mean_bin_size,
-                          float_log_min_split_count, float_log_finishing_count>
+                         Size_type, Tuning>
       (lastPos, bin_cache[u], bin_cache, cache_end, bin_sizes, rshift, comp);
       }
     }
 
     //Checking whether the value type is a float, and trying a 32-bit integer
-    template <class RandomAccessIter>
+    template <class Tuning, class RandomAccessIter>
     inline typename boost::enable_if_c< sizeof(boost::uint32_t) ==
       sizeof(typename std::iterator_traits<RandomAccessIter>::value_type)
       && std::numeric_limits<typename
       std::iterator_traits<RandomAccessIter>::value_type>::is_iec559,
       void >::type
-    float_sort(RandomAccessIter first, RandomAccessIter last)
+    float_sort(RandomAccessIter first, RandomAccessIter last,
+               spreadsort_context<RandomAccessIter> *context = 0)
     {
-      size_t bin_sizes[1 << max_finishing_splits];
-      std::vector<RandomAccessIter> bin_cache;
-      float_sort_rec<RandomAccessIter, boost::int32_t, boost::uint32_t>
-        (first, last, bin_cache, 0, bin_sizes);
+      bin_size_buffer bin_sizes(Tuning::max_splits());
+      std::vector<RandomAccessIter> local_cache;
+      std::vector<RandomAccessIter> &bin_cache =
+        context ? context->bin_cache() : local_cache;
+      float_sort_rec<RandomAccessIter, boost::int32_t, boost::uint32_t, Tuning>
+        (first, last, bin_cache, 0, bin_sizes.get());
     }
 
     //Checking whether the value type is a double, and using a 64-bit integer
-    template <class RandomAccessIter>
+    template <class Tuning, class RandomAccessIter>
     inline typename boost::enable_if_c< sizeof(boost::uint64_t) ==
       sizeof(typename std::iterator_traits<RandomAccessIter>::value_type)
       && std::numeric_limits<typename
       std::iterator_traits<RandomAccessIter>::value_type>::is_iec559,
       void >::type
-    float_sort(RandomAccessIter first, RandomAccessIter last)
+    float_sort(RandomAccessIter first, RandomAccessIter last,
+               spreadsort_context<RandomAccessIter> *context = 0)
     {
-      size_t bin_sizes[1 << max_finishing_splits];
-      std::vector<RandomAccessIter> bin_cache;
-      float_sort_rec<RandomAccessIter, boost::int64_t, boost::uint64_t>
-        (first, last, bin_cache, 0, bin_sizes);
+      bin_size_buffer bin_sizes(Tuning::max_splits());
+      std::vector<RandomAccessIter> local_cache;
+      std::vector<RandomAccessIter> &bin_cache =
+        context ? context->bin_cache() : local_cache;
+      float_sort_rec<RandomAccessIter, boost::int64_t, boost::uint64_t, Tuning>
+        (first, last, bin_cache, 0, bin_sizes.get());
     }
 
-    template <class RandomAccessIter>
+    template <class Tuning, class RandomAccessIter>
     inline typename boost::disable_if_c< (sizeof(boost::uint64_t) ==
       sizeof(typename std::iterator_traits<RandomAccessIter>::value_type)
       || sizeof(boost::uint32_t) ==
@@ -733,7 +730,8 @@ namespace spreadsort {
       && std::numeric_limits<typename
       std::iterator_traits<RandomAccessIter>::value_type>::is_iec559,
       void >::type
-    float_sort(RandomAccessIter first, RandomAccessIter last)
+    float_sort(RandomAccessIter first, RandomAccessIter last,
+               spreadsort_context<RandomAccessIter> * = 0)
     {
       BOOST_STATIC_WARNING(!(sizeof(boost::uint64_t) ==
       sizeof(typename std::iterator_traits<RandomAccessIter>::value_type)
@@ -746,79 +744,96 @@ namespace spreadsort {
 
     //These approaches require the user to do the typecast
     //with rshift but default comparision
-    template <class RandomAccessIter, class Div_type, class Right_shift>
+    template <class Tuning, class RandomAccessIter, class Div_type,
+              class Right_shift>
     inline typename boost::enable_if_c< sizeof(size_t) >= sizeof(Div_type),
       void >::type
     float_sort(RandomAccessIter first, RandomAccessIter last, Div_type,
-               Right_shift rshift)
+               Right_shift rshift,
+               spreadsort_context<RandomAccessIter> *context = 0)
     {
-      size_t bin_sizes[1 << max_finishing_splits];
-      std::vector<RandomAccessIter> bin_cache;
-      float_sort_rec<RandomAccessIter, Div_type, Right_shift, size_t>
-        (first, last, bin_cache, 0, bin_sizes, rshift);
+      bin_size_buffer bin_sizes(Tuning::max_splits());
+      std::vector<RandomAccessIter> local_cache;
+      std::vector<RandomAccessIter> &bin_cache =
+        context ? context->bin_cache() : local_cache;
+      float_sort_rec<RandomAccessIter, Div_type, Right_shift, size_t, Tuning>
+        (first, last, bin_cache, 0, bin_sizes.get(), rshift);
     }
 
     //maximum integer size with rshift but default comparision
-    template <class RandomAccessIter, class Div_type, class Right_shift>
+    template <class Tuning, class RandomAccessIter, class Div_type,
+              class Right_shift>
     inline typename boost::enable_if_c< sizeof(size_t) < sizeof(Div_type)
       && sizeof(boost::uintmax_t) >= sizeof(Div_type), void >::type
     float_sort(RandomAccessIter first, RandomAccessIter last, Div_type,
-               Right_shift rshift)
+               Right_shift rshift,
+               spreadsort_context<RandomAccessIter> *context = 0)
     {
-      size_t bin_sizes[1 << max_finishing_splits];
-      std::vector<RandomAccessIter> bin_cache;
-      float_sort_rec<RandomAccessIter, Div_type, Right_shift, boost::uintmax_t>
-        (first, last, bin_cache, 0, bin_sizes, rshift);
+      bin_size_buffer bin_sizes(Tuning::max_splits());
+      std::vector<RandomAccessIter> local_cache;
+      std::vector<RandomAccessIter> &bin_cache =
+        context ? context->bin_cache() : local_cache;
+      float_sort_rec<RandomAccessIter, Div_type, Right_shift, boost::uintmax_t,
+                     Tuning>
+        (first, last, bin_cache, 0, bin_sizes.get(), rshift);
     }
 
     //sizeof(Div_type) doesn't match, so use boost::sort::pdqsort
-    template <class RandomAccessIter, class Div_type, class Right_shift>
+    template <class Tuning, class RandomAccessIter, class Div_type,
+              class Right_shift>
     inline typename boost::disable_if_c< sizeof(boost::uintmax_t) >=
       sizeof(Div_type), void >::type
     float_sort(RandomAccessIter first, RandomAccessIter last, Div_type,
-               Right_shift rshift)
+               Right_shift rshift, spreadsort_context<RandomAccessIter> * = 0)
     {
       BOOST_STATIC_WARNING(sizeof(boost::uintmax_t) >= sizeof(Div_type));
       boost::sort::pdqsort(first, last);
     }
 
     //specialized comparison
-    template <class RandomAccessIter, class Div_type, class Right_shift,
-              class Compare>
+    template <class Tuning, class RandomAccessIter, class Div_type,
+              class Right_shift, class Compare>
     inline typename boost::enable_if_c< sizeof(size_t) >= sizeof(Div_type),
       void >::type
     float_sort(RandomAccessIter first, RandomAccessIter last, Div_type,
-               Right_shift rshift, Compare comp)
+               Right_shift rshift, Compare comp,
+               spreadsort_context<RandomAccessIter> *context = 0)
     {
-      size_t bin_sizes[1 << max_finishing_splits];
-      std::vector<RandomAccessIter> bin_cache;
+      bin_size_buffer bin_sizes(Tuning::max_splits());
+      std::vector<RandomAccessIter> local_cache;
+      std::vector<RandomAccessIter> &bin_cache =
+        context ? context->bin_cache() : local_cache;
       float_sort_rec<RandomAccessIter, Div_type, Right_shift, Compare,
-        size_t>
-        (first, last, bin_cache, 0, bin_sizes, rshift, comp);
+        size_t, Tuning>
+        (first, last, bin_cache, 0, bin_sizes.get(), rshift, comp);
     }
 
     //max-sized integer with specialized comparison
-    template <class RandomAccessIter, class Div_type, class Right_shift,
-              class Compare>
+    template <class Tuning, class RandomAccessIter, class Div_type,
+              class Right_shift, class Compare>
     inline typename boost::enable_if_c< sizeof(size_t) < sizeof(Div_type)
       && sizeof(boost::uintmax_t) >= sizeof(Div_type), void >::type
     float_sort(RandomAccessIter first, RandomAccessIter last, Div_type,
-               Right_shift rshift, Compare comp)
+               Right_shift rshift, Compare comp,
+               spreadsort_context<RandomAccessIter> *context = 0)
     {
-      size_t bin_sizes[1 << max_finishing_splits];
-      std::vector<RandomAccessIter> bin_cache;
+      bin_size_buffer bin_sizes(Tuning::max_splits());
+      std::vector<RandomAccessIter> local_cache;
+      std::vector<RandomAccessIter> &bin_cache =
+        context ? context->bin_cache() : local_cache;
       float_sort_rec<RandomAccessIter, Div_type, Right_shift, Compare,
-        boost::uintmax_t>
-        (first, last, bin_cache, 0, bin_sizes, rshift, comp);
+        boost::uintmax_t, Tuning>
+        (first, last, bin_cache, 0, bin_sizes.get(), rshift, comp);
     }
 
     //sizeof(Div_type) doesn't match, so use boost::sort::pdqsort
-    template <class RandomAccessIter, class Div_type, class Right_shift,
-              class Compare>
+    template <class Tuning, class RandomAccessIter, class Div_type,
+              class Right_shift, class Compare>
     inline typename boost::disable_if_c< sizeof(boost::uintmax_t) >=
       sizeof(Div_type), void >::type
     float_sort(RandomAccessIter first, RandomAccessIter last, Div_type,
-               Right_shift rshift, Compare comp)
+               Right_shift rshift, Compare comp,
+               spreadsort_context<RandomAccessIter> * = 0)
     {
       BOOST_STATIC_WARNING(sizeof(boost::uintmax_t) >= sizeof(Div_type));
       boost::sort::pdqsort(first, last, comp);
@@ -21,8 +21,14 @@ Phil Endecott and Frank Gennari
 #include <boost/static_assert.hpp>
 #include <boost/serialization/static_warning.hpp>
 #include <boost/utility/enable_if.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_signed.hpp>
+#include <boost/type_traits/make_unsigned.hpp>
+#include <boost/move/algorithm.hpp>
+#include <boost/move/utility_core.hpp>
 #include <boost/sort/spreadsort/detail/constants.hpp>
 #include <boost/sort/spreadsort/detail/spreadsort_common.hpp>
+#include <boost/sort/spreadsort/detail/spreadsort_simd.hpp>
 #include <boost/cstdint.hpp>
 
 namespace boost {
@@ -36,6 +42,10 @@ namespace spreadsort {
     is_sorted_or_find_extremes(RandomAccessIter current, RandomAccessIter last,
                                RandomAccessIter & max, RandomAccessIter & min)
     {
+      //Use a vector kernel when there is one for this data
+      int simd_result = simd_sorted_or_extremes(current, last, max, min);
+      if (simd_result >= 0)
+        return simd_result != 0;
       min = max = current;
       //This assumes we have more than 1 element based on prior checks.
       while (!(*(current + 1) < *current)) {
@@ -83,19 +93,20 @@ namespace spreadsort {
     }
 
     //Gets a non-negative right bit shift to operate as a logarithmic divisor
-    template<unsigned log_mean_bin_size>
+    template<class Tuning>
     inline int
     get_log_divisor(size_t count, int log_range)
     {
+      const int max_splits = Tuning::max_splits();
       int log_divisor;
       //If we can finish in one iteration without exceeding either
       //(2 to the max_finishing_splits) or n bins, do so
       if ((log_divisor = log_range - rough_log_2_size(count)) <= 0 && 
-         log_range <= max_finishing_splits)
+         log_range <= max_splits + 1)
         log_divisor = 0; 
       else {
         //otherwise divide the data into an optimized number of pieces
-        log_divisor += log_mean_bin_size;
+        log_divisor += Tuning::log_mean_bin_size();
         //Cannot exceed max_splits or cache misses slow down bin lookups
         if ((log_range - log_divisor) > max_splits)
           log_divisor = log_range - max_splits;
@@ -104,7 +115,8 @@ namespace spreadsort {
     }
 
     //Implementation for recursive integer sorting
-    template <class RandomAccessIter, class Div_type, class Size_type>
+    template <class RandomAccessIter, class Div_type, class Size_type,
+              class Tuning>
     inline void
     spreadsort_rec(RandomAccessIter first, RandomAccessIter last,
               std::vector<RandomAccessIter> &bin_cache, unsigned cache_offset
@@ -118,7 +130,7 @@ namespace spreadsort {
       if (is_sorted_or_find_extremes(first, last, max, min))
         return;
       RandomAccessIter * target_bin;
-      unsigned log_divisor = get_log_divisor<int_log_mean_bin_size>(
+      unsigned log_divisor = get_log_divisor<Tuning>(
           last - first, rough_log_2_size(Size_type((*max >> 0) - (*min >> 0))));
       Div_type div_min = *min >> log_divisor;
       Div_type div_max = *max >> log_divisor;
@@ -128,8 +140,7 @@ namespace spreadsort {
         size_bins(bin_sizes, bin_cache, cache_offset, cache_end, bin_count);
 
       //Calculating the size of each bin; this takes roughly 10% of runtime
-      for (RandomAccessIter current = first; current != last;)
-        bin_sizes[size_t((*(current++) >> log_divisor) - div_min)]++;
+      count_bins(first, last, bin_sizes, bin_count, log_divisor, div_min);
       //Assign the bin positions
       bins[0] = first;
       for (unsigned u = 0; u < bin_count - 1; u++)
@@ -154,9 +165,11 @@ namespace spreadsort {
             //put in the correct place
             typename std::iterator_traits<RandomAccessIter>::value_type tmp;
             RandomAccessIter b = (*target_bin)++;
+            prefetch_bin_position(b);
             RandomAccessIter * b_bin = bins + ((*b >> log_divisor) - div_min);
             if (b_bin != local_bin) {
               RandomAccessIter c = (*b_bin)++;
+              prefetch_bin_position(c);
               tmp = *c;
               *c = *b;
             }
@@ -174,9 +187,7 @@ namespace spreadsort {
       if (!log_divisor)
         return;
       //log_divisor is the remaining range; calculating the comparison threshold
-      size_t max_count =
-        get_min_count<int_log_mean_bin_size, int_log_min_split_count,
-                      int_log_finishing_count>(log_divisor);
+      size_t max_count = get_min_count<Tuning>(log_divisor);
 
       //Recursing
       RandomAccessIter lastPos = first;
@@ -190,11 +201,8 @@ namespace spreadsort {
         if (count < max_count)
           boost::sort::pdqsort(lastPos, bin_cache[u]);
         else
-          spreadsort_rec<RandomAccessIter, Div_type, Size_type>(lastPos,
-                                                                 bin_cache[u],
-                                                                 bin_cache,
-                                                                 cache_end,
-                                                                 bin_sizes);
+          spreadsort_rec<RandomAccessIter, Div_type, Size_type, Tuning>
+            (lastPos, bin_cache[u], bin_cache, cache_end, bin_sizes);
       }
     }
 
@@ -213,12 +221,14 @@ namespace spreadsort {
             target_bin = bins + (rshift(*current, log_divisor) - div_min)) {
           typename std::iterator_traits<RandomAccessIter>::value_type tmp;
           RandomAccessIter b = (*target_bin)++;
+          prefetch_bin_position(b);
           RandomAccessIter * b_bin =
             bins + (rshift(*b, log_divisor) - div_min);
           //Three-way swap; if the item to be swapped doesn't belong
           //in the current bin, swap it to where it belongs
           if (b_bin != local_bin) {
             RandomAccessIter c = (*b_bin)++;
+            prefetch_bin_position(c);
             tmp = *c;
             *c = *b;
           }
@@ -247,8 +257,7 @@ namespace spreadsort {
 
     //Functor implementation for recursive sorting
     template <class RandomAccessIter, class Div_type, class Right_shift,
-              class Compare, class Size_type, unsigned log_mean_bin_size,
-                unsigned log_min_split_count, unsigned log_finishing_count>
+              class Compare, class Size_type, class Tuning>
     inline void
     spreadsort_rec(RandomAccessIter first, RandomAccessIter last,
           std::vector<RandomAccessIter> &bin_cache, unsigned cache_offset
@@ -257,7 +266,7 @@ namespace spreadsort {
       RandomAccessIter max, min;
       if (is_sorted_or_find_extremes(first, last, max, min, comp))
         return;
-      unsigned log_divisor = get_log_divisor<log_mean_bin_size>(last - first,
+      unsigned log_divisor = get_log_divisor<Tuning>(last - first,
             rough_log_2_size(Size_type(rshift(*max, 0) - rshift(*min, 0))));
       Div_type div_min = rshift(*min, log_divisor);
       Div_type div_max = rshift(*max, log_divisor);
@@ -285,8 +294,7 @@ namespace spreadsort {
         return;
 
       //Recursing
-      size_t max_count = get_min_count<log_mean_bin_size, log_min_split_count,
-                          log_finishing_count>(log_divisor);
+      size_t max_count = get_min_count<Tuning>(log_divisor);
       RandomAccessIter lastPos = first;
       for (unsigned u = cache_offset; u < cache_end; lastPos = bin_cache[u],
           ++u) {
@@ -297,15 +305,14 @@ namespace spreadsort {
           boost::sort::pdqsort(lastPos, bin_cache[u], comp);
         else
           spreadsort_rec<RandomAccessIter, Div_type, Right_shift, Compare,
-        Size_type, log_mean_bin_size, log_min_split_count, log_finishing_count>
+                         Size_type, Tuning>
       (lastPos, bin_cache[u], bin_cache, cache_end, bin_sizes, rshift, comp);
       }
     }
 
     //Functor implementation for recursive sorting with only Shift overridden
     template <class RandomAccessIter, class Div_type, class Right_shift,
-              class Size_type, unsigned log_mean_bin_size,
-              unsigned log_min_split_count, unsigned log_finishing_count>
+              class Size_type, class Tuning>
     inline void
     spreadsort_rec(RandomAccessIter first, RandomAccessIter last,
               std::vector<RandomAccessIter> &bin_cache, unsigned cache_offset
@@ -314,7 +321,7 @@ namespace spreadsort {
       RandomAccessIter max, min;
       if (is_sorted_or_find_extremes(first, last, max, min))
         return;
-      unsigned log_divisor = get_log_divisor<log_mean_bin_size>(last - first,
+      unsigned log_divisor = get_log_divisor<Tuning>(last - first,
             rough_log_2_size(Size_type(rshift(*max, 0) - rshift(*min, 0))));
       Div_type div_min = rshift(*min, log_divisor);
       Div_type div_max = rshift(*max, log_divisor);
@@ -342,8 +349,7 @@ namespace spreadsort {
         return;
 
       //Recursing
-      size_t max_count = get_min_count<log_mean_bin_size, log_min_split_count,
-                          log_finishing_count>(log_divisor);
+      size_t max_count = get_min_count<Tuning>(log_divisor);
       RandomAccessIter lastPos = first;
       for (unsigned u = cache_offset; u < cache_end; lastPos = bin_cache[u],
           ++u) {
@@ -354,42 +360,49 @@ namespace spreadsort {
           boost::sort::pdqsort(lastPos, bin_cache[u]);
         else
           spreadsort_rec<RandomAccessIter, Div_type, Right_shift, Size_type,
-          log_mean_bin_size, log_min_split_count, log_finishing_count>(lastPos,
+                         Tuning>(lastPos,
                       bin_cache[u], bin_cache, cache_end, bin_sizes, rshift);
       }
     }
 
     //Holds the bin vector and makes the initial recursive call
-    template <class RandomAccessIter, class Div_type>
+    template <class Tuning, class RandomAccessIter, class Div_type>
     //Only use spreadsort if the integer can fit in a size_t
     inline typename boost::enable_if_c< sizeof(Div_type) <= sizeof(size_t),
                                                             void >::type
-    integer_sort(RandomAccessIter first, RandomAccessIter last, Div_type)
+    integer_sort(RandomAccessIter first, RandomAccessIter last, Div_type,
+                 spreadsort_context<RandomAccessIter> *context = 0)
     {
-      size_t bin_sizes[1 << max_finishing_splits];
-      std::vector<RandomAccessIter> bin_cache;
-      spreadsort_rec<RandomAccessIter, Div_type, size_t>(first, last,
-          bin_cache, 0, bin_sizes);
+      bin_size_buffer bin_sizes(Tuning::max_splits());
+      std::vector<RandomAccessIter> local_cache;
+      std::vector<RandomAccessIter> &bin_cache =
+        context ? context->bin_cache() : local_cache;
+      spreadsort_rec<RandomAccessIter, Div_type, size_t, Tuning>(first, last,
+          bin_cache, 0, bin_sizes.get());
     }
 
     //Holds the bin vector and makes the initial recursive call
-    template <class RandomAccessIter, class Div_type>
+    template <class Tuning, class RandomAccessIter, class Div_type>
     //Only use spreadsort if the integer can fit in a uintmax_t
     inline typename boost::enable_if_c< (sizeof(Div_type) > sizeof(size_t))
       && sizeof(Div_type) <= sizeof(boost::uintmax_t), void >::type
-    integer_sort(RandomAccessIter first, RandomAccessIter last, Div_type)
+    integer_sort(RandomAccessIter first, RandomAccessIter last, Div_type,
+                 spreadsort_context<RandomAccessIter> *context = 0)
     {
-      size_t bin_sizes[1 << max_finishing_splits];
-      std::vector<RandomAccessIter> bin_cache;
-      spreadsort_rec<RandomAccessIter, Div_type, boost::uintmax_t>(first,
-          last, bin_cache, 0, bin_sizes);
+      bin_size_buffer bin_sizes(Tuning::max_splits());
+      std::vector<RandomAccessIter> local_cache;
+      std::vector<RandomAccessIter> &bin_cache =
+        context ? context->bin_cache() : local_cache;
+      spreadsort_rec<RandomAccessIter, Div_type, boost::uintmax_t, Tuning>
+          (first, last, bin_cache, 0, bin_sizes.get());
     }
 
-    template <class RandomAccessIter, class Div_type>
+    template <class Tuning, class RandomAccessIter, class Div_type>
     inline typename boost::disable_if_c< sizeof(Div_type) <= sizeof(size_t)
       || sizeof(Div_type) <= sizeof(boost::uintmax_t), void >::type
     //defaulting to boost::sort::pdqsort when integer_sort won't work
-    integer_sort(RandomAccessIter first, RandomAccessIter last, Div_type)
+    integer_sort(RandomAccessIter first, RandomAccessIter last, Div_type,
+                 spreadsort_context<RandomAccessIter> * = 0)
     {
       //Warning that we're using boost::sort::pdqsort, even though integer_sort was called
       BOOST_STATIC_WARNING( sizeof(Div_type) <= sizeof(size_t) );
@@ -398,45 +411,50 @@ namespace spreadsort {
 
 
     //Same for the full functor version
-    template <class RandomAccessIter, class Div_type, class Right_shift,
-              class Compare>
+    template <class Tuning, class RandomAccessIter, class Div_type,
+              class Right_shift, class Compare>
     //Only use spreadsort if the integer can fit in a size_t
     inline typename boost::enable_if_c< sizeof(Div_type) <= sizeof(size_t),
                                  void >::type
     integer_sort(RandomAccessIter first, RandomAccessIter last, Div_type,
-                Right_shift shift, Compare comp)
+                Right_shift shift, Compare comp,
+                spreadsort_context<RandomAccessIter> *context = 0)
     {
-      size_t bin_sizes[1 << max_finishing_splits];
-      std::vector<RandomAccessIter> bin_cache;
+      bin_size_buffer bin_sizes(Tuning::max_splits());
+      std::vector<RandomAccessIter> local_cache;
+      std::vector<RandomAccessIter> &bin_cache =
+        context ? context->bin_cache() : local_cache;
       spreadsort_rec<RandomAccessIter, Div_type, Right_shift, Compare,
-          size_t, int_log_mean_bin_size, int_log_min_split_count, 
-                        int_log_finishing_count>
-          (first, last, bin_cache, 0, bin_sizes, shift, comp);
+          size_t, Tuning>
+          (first, last, bin_cache, 0, bin_sizes.get(), shift, comp);
     }
 
-    template <class RandomAccessIter, class Div_type, class Right_shift,
-              class Compare>
+    template <class Tuning, class RandomAccessIter, class Div_type,
+              class Right_shift, class Compare>
     //Only use spreadsort if the integer can fit in a uintmax_t
     inline typename boost::enable_if_c< (sizeof(Div_type) > sizeof(size_t))
       && sizeof(Div_type) <= sizeof(boost::uintmax_t), void >::type
     integer_sort(RandomAccessIter first, RandomAccessIter last, Div_type,
-                Right_shift shift, Compare comp)
+                Right_shift shift, Compare comp,
+                spreadsort_context<RandomAccessIter> *context = 0)
     {
-      size_t bin_sizes[1 << max_finishing_splits];
-      std::vector<RandomAccessIter> bin_cache;
+      bin_size_buffer bin_sizes(Tuning::max_splits());
+      std::vector<RandomAccessIter> local_cache;
+      std::vector<RandomAccessIter> &bin_cache =
+        context ? context->bin_cache() : local_cache;
       spreadsort_rec<RandomAccessIter, Div_type, Right_shift, Compare,
-                        boost::uintmax_t, int_log_mean_bin_size,
-                        int_log_min_split_count, int_log_finishing_count>
-          (first, last, bin_cache, 0, bin_sizes, shift, comp);
+                        boost::uintmax_t, Tuning>
+          (first, last, bin_cache, 0, bin_sizes.get(), shift, comp);
     }
 
-    template <class RandomAccessIter, class Div_type, class Right_shift,
-              class Compare>
+    template <class Tuning, class RandomAccessIter, class Div_type,
+              class Right_shift, class Compare>
     inline typename boost::disable_if_c< sizeof(Div_type) <= sizeof(size_t)
       || sizeof(Div_type) <= sizeof(boost::uintmax_t), void >::type
     //defaulting to boost::sort::pdqsort when integer_sort won't work
     integer_sort(RandomAccessIter first, RandomAccessIter last, Div_type,
-                Right_shift shift, Compare comp)
+                Right_shift shift, Compare comp,
+                spreadsort_context<RandomAccessIter> * = 0)
     {
       //Warning that we're using boost::sort::pdqsort, even though integer_sort was called
       BOOST_STATIC_WARNING( sizeof(Div_type) <= sizeof(size_t) );
@@ -445,47 +463,186 @@ namespace spreadsort {
 
 
     //Same for the right shift version
-    template <class RandomAccessIter, class Div_type, class Right_shift>
+    template <class Tuning, class RandomAccessIter, class Div_type,
+              class Right_shift>
     //Only use spreadsort if the integer can fit in a size_t
     inline typename boost::enable_if_c< sizeof(Div_type) <= sizeof(size_t),
                                  void >::type
     integer_sort(RandomAccessIter first, RandomAccessIter last, Div_type,
-                Right_shift shift)
+                Right_shift shift,
+                spreadsort_context<RandomAccessIter> *context = 0)
     {
-      size_t bin_sizes[1 << max_finishing_splits];
-      std::vector<RandomAccessIter> bin_cache;
+      bin_size_buffer bin_sizes(Tuning::max_splits());
+      std::vector<RandomAccessIter> local_cache;
+      std::vector<RandomAccessIter> &bin_cache =
+        context ? context->bin_cache() : local_cache;
       spreadsort_rec<RandomAccessIter, Div_type, Right_shift, size_t,
-          int_log_mean_bin_size, int_log_min_split_count, 
-                        int_log_finishing_count>
-          (first, last, bin_cache, 0, bin_sizes, shift);
+                     Tuning>(first, last, bin_cache, 0, bin_sizes.get(), shift);
     }
 
-    template <class RandomAccessIter, class Div_type, class Right_shift>
+    template <class Tuning, class RandomAccessIter, class Div_type,
+              class Right_shift>
     //Only use spreadsort if the integer can fit in a uintmax_t
     inline typename boost::enable_if_c< (sizeof(Div_type) > sizeof(size_t))
       && sizeof(Div_type) <= sizeof(boost::uintmax_t), void >::type
     integer_sort(RandomAccessIter first, RandomAccessIter last, Div_type,
-                Right_shift shift)
+                Right_shift shift,
+                spreadsort_context<RandomAccessIter> *context = 0)
     {
-      size_t bin_sizes[1 << max_finishing_splits];
-      std::vector<RandomAccessIter> bin_cache;
+      bin_size_buffer bin_sizes(Tuning::max_splits());
+      std::vector<RandomAccessIter> local_cache;
+      std::vector<RandomAccessIter> &bin_cache =
+        context ? context->bin_cache() : local_cache;
       spreadsort_rec<RandomAccessIter, Div_type, Right_shift,
-                        boost::uintmax_t, int_log_mean_bin_size,
-                        int_log_min_split_count, int_log_finishing_count>
-          (first, last, bin_cache, 0, bin_sizes, shift);
+                        boost::uintmax_t, Tuning>
+          (first, last, bin_cache, 0, bin_sizes.get(), shift);
     }
 
-    template <class RandomAccessIter, class Div_type, class Right_shift>
+    template <class Tuning, class RandomAccessIter, class Div_type,
+              class Right_shift>
     inline typename boost::disable_if_c< sizeof(Div_type) <= sizeof(size_t)
       || sizeof(Div_type) <= sizeof(boost::uintmax_t), void >::type
     //defaulting to boost::sort::pdqsort when integer_sort won't work
     integer_sort(RandomAccessIter first, RandomAccessIter last, Div_type,
-                Right_shift shift)
+                Right_shift shift, spreadsort_context<RandomAccessIter> * = 0)
     {
       //Warning that we're using boost::sort::pdqsort, even though integer_sort was called
       BOOST_STATIC_WARNING( sizeof(Div_type) <= sizeof(size_t) );
       boost::sort::pdqsort(first, last);
     }
+
+    //Maps a key to an unsigned type with the same order, flipping the sign
+    //bit of signed keys so negative values come first
+    template <class Div_type>
+    inline typename boost::make_unsigned<Div_type>::type
+    lsd_key(Div_type key)
+    {
+      typedef typename boost::make_unsigned<Div_type>::type Unsigned_type;
+      const Unsigned_type sign_bit = boost::is_signed<Div_type>::value ?
+        Unsigned_type(Unsigned_type(1) << (8 * sizeof(Div_type) - 1)) : 0;
+      return Unsigned_type(key) ^ sign_bit;
+    }
+
+    //Least significant digit radix sort, moving the elements between
+    //[first, last) and a buffer of the same size.
+    //The digits are 8 bits, or 12 bits for keys wider than 4 bytes, so 64 bit
+    //keys take 6 passes instead of 8, the last one with only 16 bins.
+    //The histograms of all the digits are counted in a single pass, and
+    //a pass is skipped when every key has the same digit.
+    template <class RandomAccessIter, class Buffer_iter, class Div_type,
+              class Right_shift>
+    inline void
+    lsd_sort(RandomAccessIter first, RandomAccessIter last, Buffer_iter buffer,
+             Right_shift &rshift)
+    {
+      typedef typename boost::make_unsigned<Div_type>::type Unsigned_type;
+      const unsigned digit_bits = sizeof(Div_type) > 4 ? 12 : 8;
+      const unsigned digit_count =
+        (8 * sizeof(Div_type) + digit_bits - 1) / digit_bits;
+      const unsigned radix = 1 << digit_bits;
+      const size_t count = last - first;
+      if (count < 2)
+        return;
+      size_t histograms[digit_count][radix];
+      for (unsigned d = 0; d < digit_count; ++d)
+        for (unsigned u = 0; u < radix; ++u)
+          histograms[d][u] = 0;
+      for (RandomAccessIter current = first; current != last; ++current) {
+        Unsigned_type key = lsd_key<Div_type>(rshift(*current, 0));
+        for (unsigned d = 0; d < digit_count; ++d)
+          histograms[d][(key >> (d * digit_bits)) & (radix - 1)]++;
+      }
+      const Unsigned_type first_key = lsd_key<Div_type>(rshift(*first, 0));
+      bool in_buffer = false;
+      for (unsigned d = 0; d < digit_count; ++d) {
+        size_t * bin_sizes = histograms[d];
+        //Every key has the same digit; this pass wouldn't move anything
+        if (bin_sizes[(first_key >> (d * digit_bits)) & (radix - 1)] == count)
+          continue;
+        //Turning the sizes into the start of each bin
+        size_t offset = 0;
+        for (unsigned u = 0; u < radix; ++u) {
+          size_t bin_size = bin_sizes[u];
+          bin_sizes[u] = offset;
+          offset += bin_size;
+        }
+        if (in_buffer) {
+          for (Buffer_iter current = buffer; current != buffer + count;
+              ++current) {
+            Unsigned_type key = lsd_key<Div_type>(rshift(*current, 0));
+            *(first + bin_sizes[(key >> (d * digit_bits)) & (radix - 1)]++) =
+              boost::move(*current);
+          }
+        }
+        else {
+          for (RandomAccessIter current = first; current != last; ++current) {
+            Unsigned_type key = lsd_key<Div_type>(rshift(*current, 0));
+            *(buffer + bin_sizes[(key >> (d * digit_bits)) & (radix - 1)]++) =
+              boost::move(*current);
+          }
+        }
+        in_buffer = !in_buffer;
+      }
+      //An odd number of passes leaves the data in the buffer
+      if (in_buffer)
+        boost::move(buffer, buffer + count, first);
+    }
+
+    //LSD radix sort for integer keys that fit in a uintmax_t
+    template <class RandomAccessIter, class Buffer_iter, class Div_type,
+              class Right_shift>
+    inline typename boost::enable_if_c< boost::is_integral<Div_type>::value
+      && sizeof(Div_type) <= sizeof(boost::uintmax_t), void >::type
+    integer_sort_lsd(RandomAccessIter first, RandomAccessIter last, Div_type,
+                     Right_shift shift, Buffer_iter buffer)
+    {
+      lsd_sort<RandomAccessIter, Buffer_iter, Div_type, Right_shift>(first,
+                                                       last, buffer, shift);
+    }
+
+    //Comparison of the elements by rshift(x, 0), for the keys which aren't
+    //integers
+    template <class Right_shift>
+    struct shift_less {
+      Right_shift rshift;
+      shift_less(Right_shift shift) : rshift(shift) {}
+
+      template <class Data_type>
+      inline bool operator()(const Data_type &x, const Data_type &y)
+      { return rshift(x, 0) < rshift(y, 0); }
+    };
+
+    //defaulting to std::stable_sort by the key when it isn't an integer,
+    //so the sort stays stable
+    template <class RandomAccessIter, class Buffer_iter, class Div_type,
+              class Right_shift>
+    inline typename boost::disable_if_c< boost::is_integral<Div_type>::value
+      && sizeof(Div_type) <= sizeof(boost::uintmax_t), void >::type
+    integer_sort_lsd(RandomAccessIter first, RandomAccessIter last,
+                     Div_type, Right_shift shift, Buffer_iter)
+    {
+      BOOST_STATIC_WARNING(boost::is_integral<Div_type>::value
+        && sizeof(Div_type) <= sizeof(boost::uintmax_t));
+      std::stable_sort(first, last, shift_less<Right_shift>(shift));
+    }
+
+    //Shifts with operator>>, for the variants without a Right_shift functor
+    template <class Data_type, class Div_type>
+    struct shift_operator {
+      inline Div_type operator()(const Data_type &x, unsigned offset) const
+      { return x >> offset; }
+    };
+
+    template <class RandomAccessIter, class Buffer_iter, class Div_type>
+    inline void
+    integer_sort_lsd(RandomAccessIter first, RandomAccessIter last,
+                     Div_type key, Buffer_iter buffer)
+    {
+      typedef typename std::iterator_traits<RandomAccessIter>::value_type
+        Data_type;
+      integer_sort_lsd(first, last, key,
+                       shift_operator<Data_type, Div_type>(), buffer);
+    }
   }
 }
 }
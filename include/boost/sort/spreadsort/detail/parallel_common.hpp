@@ -0,0 +1,30 @@
+// Thread helpers shared by the multithreaded Spreadsort variants.
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort for library home page.
+
+#ifndef BOOST_SORT_SPREADSORT_DETAIL_PARALLEL_COMMON_HPP
+#define BOOST_SORT_SPREADSORT_DETAIL_PARALLEL_COMMON_HPP
+#include <boost/sort/common/thread_pool.hpp>
+
+namespace boost {
+namespace sort {
+namespace spreadsort {
+  namespace detail {
+    //Runs func(0) ... func(nthread - 1) in parallel: func(0) on the calling
+    //thread and the rest on the pool, which the caller helps while waiting.
+    template <class Function>
+    inline void run_threads(thread_pool &pool, unsigned nthread,
+                            Function func)
+    {
+      pool.run(nthread, func);
+    }
+  }
+}
+}
+}
+
+#endif
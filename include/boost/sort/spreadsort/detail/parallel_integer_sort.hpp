@@ -0,0 +1,222 @@
+// Details for the multithreaded Spreadsort-based parallel_integer_sort.
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort for library home page.
+
+#ifndef BOOST_SORT_SPREADSORT_DETAIL_PARALLEL_INTEGER_SORT_HPP
+#define BOOST_SORT_SPREADSORT_DETAIL_PARALLEL_INTEGER_SORT_HPP
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include <boost/utility/enable_if.hpp>
+#include <boost/sort/spreadsort/detail/constants.hpp>
+#include <boost/sort/spreadsort/detail/spreadsort_common.hpp>
+#include <boost/sort/spreadsort/detail/integer_sort.hpp>
+#include <boost/sort/spreadsort/detail/parallel_common.hpp>
+#include <boost/sort/spreadsort/integer_sort.hpp>
+#include <boost/cstdint.hpp>
+
+namespace boost {
+namespace sort {
+namespace spreadsort {
+  namespace detail {
+    //Right shift functor matching the operator>> used by the plain variant
+    struct default_right_shift {
+      template <class T>
+      inline auto operator()(const T &x, unsigned offset) const
+        -> decltype(x >> offset)
+      { return x >> offset; }
+    };
+
+    //Splits the data into the top level of spreadsort bins using nthread
+    //threads, then sorts the bins in parallel.
+    //Each thread finds the extremes and counts the bin sizes of its own chunk;
+    //a prefix sum over the per-thread counts gives every thread a private
+    //write position in each bin, so the scatter needs no synchronization.
+    template <class RandomAccessIter, class Div_type, class Right_shift,
+              class Compare>
+    inline void
+    parallel_spreadsort_rec(RandomAccessIter first, RandomAccessIter last,
+                            Right_shift rshift, Compare comp, unsigned nthread,
+                            thread_pool &pool)
+    {
+      typedef typename std::iterator_traits<RandomAccessIter>::value_type
+        value_type;
+      const size_t nelem = last - first;
+      if (nthread > nelem / min_parallel_size)
+        nthread = unsigned(nelem / min_parallel_size);
+      if (nthread < 2) {
+        boost::sort::spreadsort::integer_sort(first, last, rshift, comp);
+        return;
+      }
+
+      //One contiguous chunk of the input per thread
+      std::vector<RandomAccessIter> chunk(nthread + 1);
+      for (unsigned i = 0; i <= nthread; ++i)
+        chunk[i] = first + (nelem * i) / nthread;
+
+      //Finding the extremes; this also detects already sorted input
+      std::vector<RandomAccessIter> vmax(nthread), vmin(nthread);
+      std::vector<char> vsorted(nthread);
+      run_threads(pool, nthread, [&](unsigned i) {
+        vsorted[i] = is_sorted_or_find_extremes(chunk[i], chunk[i + 1],
+                                                vmax[i], vmin[i], comp);
+        if (vsorted[i])
+          vmax[i] = chunk[i + 1] - 1;
+      });
+      bool sorted = true;
+      RandomAccessIter max = vmax[0], min = vmin[0];
+      for (unsigned i = 0; i < nthread; ++i) {
+        if (!vsorted[i] || (i && comp(*chunk[i], *(chunk[i] - 1))))
+          sorted = false;
+        if (comp(*max, *vmax[i]))
+          max = vmax[i];
+        if (comp(*vmin[i], *min))
+          min = vmin[i];
+      }
+      if (sorted)
+        return;
+      //Subtracting as size_t avoids signed overflow on the full int range
+      unsigned log_range = rough_log_2_size(size_t(rshift(*max, 0)) -
+                                            size_t(rshift(*min, 0)));
+      //Every key is the same, so there is nothing left to sort
+      if (!log_range)
+        return;
+      const unsigned max_splits = int_tuning::max_splits();
+      unsigned log_divisor = (log_range > max_splits) ?
+                             log_range - max_splits : 0;
+      Div_type div_min = rshift(*min, log_divisor);
+      unsigned bin_count = unsigned(rshift(*max, log_divisor) - div_min) + 1;
+
+      //Calculating the size of each bin, per thread
+      std::vector<size_t> bin_sizes(size_t(nthread) * bin_count, 0);
+      run_threads(pool, nthread, [&](unsigned i) {
+        size_t * sizes = &bin_sizes[size_t(i) * bin_count];
+        for (RandomAccessIter current = chunk[i]; current != chunk[i + 1];)
+          sizes[size_t(rshift(*(current++), log_divisor) - div_min)]++;
+      });
+
+      //Turning the counts into the write position of each thread in each bin
+      std::vector<size_t> bin_start(bin_count + 1);
+      size_t offset = 0;
+      for (unsigned u = 0; u < bin_count; ++u) {
+        bin_start[u] = offset;
+        for (unsigned i = 0; i < nthread; ++i) {
+          size_t & position = bin_sizes[size_t(i) * bin_count + u];
+          size_t count = position;
+          position = offset;
+          offset += count;
+        }
+      }
+      bin_start[bin_count] = nelem;
+
+      //The scatter is done out of place; without the memory, sort in place
+      std::pair<value_type *, std::ptrdiff_t> buf =
+        std::get_temporary_buffer<value_type>(nelem);
+      if (buf.first == 0 || size_t(buf.second) < nelem) {
+        if (buf.first != 0)
+          std::return_temporary_buffer(buf.first);
+        boost::sort::spreadsort::integer_sort(first, last, rshift, comp);
+        return;
+      }
+      value_type * buffer = buf.first;
+      run_threads(pool, nthread, [&](unsigned i) {
+        size_t * position = &bin_sizes[size_t(i) * bin_count];
+        for (RandomAccessIter current = chunk[i]; current != chunk[i + 1];
+            ++current) {
+          value_type * target = buffer +
+            position[size_t(rshift(*current, log_divisor) - div_min)]++;
+          ::new (static_cast<void *>(target)) value_type(std::move(*current));
+        }
+      });
+      run_threads(pool, nthread, [&](unsigned i) {
+        value_type * source = buffer + (chunk[i] - first);
+        value_type * source_end = buffer + (chunk[i + 1] - first);
+        for (RandomAccessIter current = chunk[i]; source != source_end;
+            ++source, ++current) {
+          *current = std::move(*source);
+          source->~value_type();
+        }
+      });
+      std::return_temporary_buffer(buffer);
+
+      //If we've bucketsorted, the array is sorted
+      if (!log_divisor)
+        return;
+
+      //Bins big enough to unbalance the threads are split again with all the
+      //threads; the rest are handed out to the threads largest first
+      const size_t max_bin_size = nelem / nthread;
+      std::vector<unsigned> small_bins, large_bins;
+      for (unsigned u = 0; u < bin_count; ++u) {
+        size_t count = bin_start[u + 1] - bin_start[u];
+        if (count < 2)
+          continue;
+        if (count > max_bin_size)
+          large_bins.push_back(u);
+        else
+          small_bins.push_back(u);
+      }
+      std::sort(small_bins.begin(), small_bins.end(),
+                [&](unsigned x, unsigned y) {
+        return (bin_start[x + 1] - bin_start[x]) >
+               (bin_start[y + 1] - bin_start[y]);
+      });
+      if (!small_bins.empty()) {
+        std::atomic<size_t> next_bin(0);
+        unsigned nworker = unsigned(std::min(size_t(nthread),
+                                             small_bins.size()));
+        run_threads(pool, nworker, [&](unsigned) {
+          size_t job;
+          while ((job = next_bin++) < small_bins.size()) {
+            unsigned u = small_bins[job];
+            boost::sort::spreadsort::integer_sort(first + bin_start[u],
+                                  first + bin_start[u + 1], rshift, comp);
+          }
+        });
+      }
+      for (size_t job = 0; job < large_bins.size(); ++job) {
+        unsigned u = large_bins[job];
+        parallel_spreadsort_rec<RandomAccessIter, Div_type, Right_shift,
+                                Compare>(first + bin_start[u],
+                      first + bin_start[u + 1], rshift, comp, nthread, pool);
+      }
+    }
+
+    //Only split in parallel if the integer can fit in a size_t
+    template <class RandomAccessIter, class Div_type, class Right_shift,
+              class Compare>
+    inline typename boost::enable_if_c< sizeof(Div_type) <= sizeof(size_t),
+                                        void >::type
+    parallel_integer_sort(RandomAccessIter first, RandomAccessIter last,
+                          Div_type, Right_shift shift, Compare comp,
+                          unsigned nthread, thread_pool &pool)
+    {
+      parallel_spreadsort_rec<RandomAccessIter, Div_type, Right_shift,
+                              Compare>(first, last, shift, comp, nthread, pool);
+    }
+
+    //defaulting to the single threaded integer_sort for wider keys
+    template <class RandomAccessIter, class Div_type, class Right_shift,
+              class Compare>
+    inline typename boost::disable_if_c< sizeof(Div_type) <= sizeof(size_t),
+                                         void >::type
+    parallel_integer_sort(RandomAccessIter first, RandomAccessIter last,
+                          Div_type, Right_shift shift, Compare comp,
+                          unsigned, thread_pool &)
+    {
+      boost::sort::spreadsort::integer_sort(first, last, shift, comp);
+    }
+  }
+}
+}
+}
+
+#endif
@@ -0,0 +1,267 @@
+// Details for the multithreaded parallel_stable_integer_sort and
+// parallel_stable_float_sort.
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort for library home page.
+
+#ifndef BOOST_SORT_SPREADSORT_DETAIL_PARALLEL_STABLE_RADIX_SORT_HPP
+#define BOOST_SORT_SPREADSORT_DETAIL_PARALLEL_STABLE_RADIX_SORT_HPP
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include <boost/utility/enable_if.hpp>
+#include <boost/type_traits/conditional.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/sort/spreadsort/detail/constants.hpp>
+#include <boost/sort/spreadsort/detail/stable_radix_sort.hpp>
+#include <boost/sort/spreadsort/detail/parallel_common.hpp>
+#include <boost/cstdint.hpp>
+
+namespace boost {
+namespace sort {
+namespace spreadsort {
+  namespace detail {
+    //LSD radix sort by the unsigned key of get_key using nthread threads.
+    //Each thread counts the digits of its own chunk, and a prefix sum over
+    //the counts, by digit and then by thread, gives every thread a private
+    //write position in each bin.  The threads scatter their chunks in order,
+    //and the chunks are in order, so every pass is stable.  The data moves
+    //between [first, last) and a temporary buffer; the buffer is constructed
+    //by the first pass, and a pass is skipped when every key has the same
+    //digit, as in lsd_sort.
+    template <class RandomAccessIter, class Get_key>
+    inline void
+    parallel_stable_radix_sort(RandomAccessIter first, RandomAccessIter last,
+                               Get_key get_key, unsigned nthread,
+                               thread_pool &pool)
+    {
+      typedef typename std::iterator_traits<RandomAccessIter>::value_type
+        value_type;
+      typedef typename Get_key::Key_type Key_type;
+      const unsigned digit_bits = 8;
+      const unsigned digit_count = sizeof(Key_type);
+      const unsigned radix = 1 << digit_bits;
+      const size_t nelem = last - first;
+      if (nthread > nelem / min_parallel_size)
+        nthread = unsigned(nelem / min_parallel_size);
+      if (nthread < 2) {
+        stable_radix_sort(first, last, get_key);
+        return;
+      }
+      std::pair<value_type *, std::ptrdiff_t> buf =
+        std::get_temporary_buffer<value_type>(nelem);
+      if (buf.first == 0 || size_t(buf.second) < nelem) {
+        if (buf.first != 0)
+          std::return_temporary_buffer(buf.first);
+        stable_radix_sort(first, last, get_key);
+        return;
+      }
+      value_type * buffer = buf.first;
+
+      //One contiguous chunk of the input per thread
+      std::vector<size_t> chunk(nthread + 1);
+      for (unsigned i = 0; i <= nthread; ++i)
+        chunk[i] = (nelem * i) / nthread;
+
+      //Counting every digit of each chunk; the totals are the same after
+      //each pass, and tell which passes can be skipped
+      std::vector<size_t> counts(size_t(nthread) * digit_count * radix, 0);
+      run_threads(pool, nthread, [&](unsigned i) {
+        Get_key key_of = get_key;
+        size_t * sizes = &counts[size_t(i) * digit_count * radix];
+        for (size_t u = chunk[i]; u < chunk[i + 1]; ++u) {
+          Key_type key = key_of(*(first + u));
+          for (unsigned d = 0; d < digit_count; ++d)
+            sizes[d * radix + ((key >> (d * digit_bits)) & (radix - 1))]++;
+        }
+      });
+      std::vector<char> skip(digit_count, 0);
+      const Key_type first_key = get_key(*first);
+      for (unsigned d = 0; d < digit_count; ++d) {
+        const unsigned digit = (first_key >> (d * digit_bits)) & (radix - 1);
+        size_t total = 0;
+        for (unsigned i = 0; i < nthread; ++i)
+          total += counts[(size_t(i) * digit_count + d) * radix + digit];
+        skip[d] = total == nelem;
+      }
+
+      //The write position of each thread in each bin, for one digit
+      std::vector<size_t> position(size_t(nthread) * radix);
+      bool in_buffer = false, constructed = false, counted = true;
+      for (unsigned d = 0; d < digit_count; ++d) {
+        if (skip[d])
+          continue;
+        const unsigned shift = d * digit_bits;
+        //After the first pass the chunks hold other elements
+        if (!counted) {
+          run_threads(pool, nthread, [&](unsigned i) {
+            Get_key key_of = get_key;
+            size_t * sizes = &counts[(size_t(i) * digit_count + d) * radix];
+            for (unsigned u = 0; u < radix; ++u)
+              sizes[u] = 0;
+            if (in_buffer) {
+              for (size_t u = chunk[i]; u < chunk[i + 1]; ++u)
+                sizes[(key_of(buffer[u]) >> shift) & (radix - 1)]++;
+            }
+            else {
+              for (size_t u = chunk[i]; u < chunk[i + 1]; ++u)
+                sizes[(key_of(*(first + u)) >> shift) & (radix - 1)]++;
+            }
+          });
+        }
+        counted = false;
+        size_t offset = 0;
+        for (unsigned u = 0; u < radix; ++u) {
+          for (unsigned i = 0; i < nthread; ++i) {
+            position[size_t(i) * radix + u] = offset;
+            offset += counts[(size_t(i) * digit_count + d) * radix + u];
+          }
+        }
+        run_threads(pool, nthread, [&](unsigned i) {
+          Get_key key_of = get_key;
+          size_t * pos = &position[size_t(i) * radix];
+          if (in_buffer) {
+            for (size_t u = chunk[i]; u < chunk[i + 1]; ++u) {
+              size_t target = pos[(key_of(buffer[u]) >> shift) & (radix - 1)]++;
+              *(first + target) = std::move(buffer[u]);
+            }
+          }
+          else if (constructed) {
+            for (size_t u = chunk[i]; u < chunk[i + 1]; ++u) {
+              size_t target =
+                pos[(key_of(*(first + u)) >> shift) & (radix - 1)]++;
+              buffer[target] = std::move(*(first + u));
+            }
+          }
+          else {
+            for (size_t u = chunk[i]; u < chunk[i + 1]; ++u) {
+              size_t target =
+                pos[(key_of(*(first + u)) >> shift) & (radix - 1)]++;
+              ::new (static_cast<void *>(buffer + target))
+                value_type(std::move(*(first + u)));
+            }
+          }
+        });
+        constructed = true;
+        in_buffer = !in_buffer;
+      }
+
+      //An odd number of passes leaves the data in the buffer
+      if (constructed) {
+        run_threads(pool, nthread, [&](unsigned i) {
+          for (size_t u = chunk[i]; u < chunk[i + 1]; ++u) {
+            if (in_buffer)
+              *(first + u) = std::move(buffer[u]);
+            buffer[u].~value_type();
+          }
+        });
+      }
+      std::return_temporary_buffer(buffer);
+    }
+
+    //Integer keys that fit in a uintmax_t
+    template <class RandomAccessIter, class Div_type, class Right_shift>
+    inline typename boost::enable_if_c< boost::is_integral<Div_type>::value
+      && sizeof(Div_type) <= sizeof(boost::uintmax_t), void >::type
+    parallel_stable_integer_sort(RandomAccessIter first,
+                                 RandomAccessIter last, Div_type,
+                                 Right_shift shift, unsigned nthread,
+                                 thread_pool &pool)
+    {
+      parallel_stable_radix_sort(first, last,
+        integer_select_key<Div_type, Right_shift>(shift), nthread, pool);
+    }
+
+    //defaulting to the single-threaded fallback when the key isn't an
+    //integer
+    template <class RandomAccessIter, class Div_type, class Right_shift>
+    inline typename boost::disable_if_c< boost::is_integral<Div_type>::value
+      && sizeof(Div_type) <= sizeof(boost::uintmax_t), void >::type
+    parallel_stable_integer_sort(RandomAccessIter first,
+                                 RandomAccessIter last, Div_type key,
+                                 Right_shift shift, unsigned, thread_pool &)
+    {
+      stable_integer_sort(first, last, key, shift);
+    }
+
+    //Without a Right_shift functor, the key is the element
+    template <class RandomAccessIter, class Div_type>
+    inline void
+    parallel_stable_integer_sort(RandomAccessIter first,
+                                 RandomAccessIter last, Div_type key,
+                                 unsigned nthread, thread_pool &pool)
+    {
+      typedef typename std::iterator_traits<RandomAccessIter>::value_type
+        Data_type;
+      parallel_stable_integer_sort(first, last, key,
+        shift_operator<Data_type, Div_type>(), nthread, pool);
+    }
+
+    //Floats cast to integers that fit in a uintmax_t
+    template <class RandomAccessIter, class Div_type, class Right_shift>
+    inline typename boost::enable_if_c< boost::is_integral<Div_type>::value
+      && sizeof(Div_type) <= sizeof(boost::uintmax_t), void >::type
+    parallel_stable_float_sort(RandomAccessIter first, RandomAccessIter last,
+                               Div_type, Right_shift shift, unsigned nthread,
+                               thread_pool &pool)
+    {
+      parallel_stable_radix_sort(first, last,
+        float_select_key<Div_type, Right_shift>(shift), nthread, pool);
+    }
+
+    template <class RandomAccessIter, class Div_type, class Right_shift>
+    inline typename boost::disable_if_c< boost::is_integral<Div_type>::value
+      && sizeof(Div_type) <= sizeof(boost::uintmax_t), void >::type
+    parallel_stable_float_sort(RandomAccessIter first, RandomAccessIter last,
+                               Div_type key, Right_shift shift, unsigned,
+                               thread_pool &)
+    {
+      stable_float_sort(first, last, key, shift);
+    }
+
+    //Casting a float to a 32-bit integer, or a double to a 64-bit integer
+    template <class RandomAccessIter>
+    inline typename boost::enable_if_c< (sizeof(boost::uint32_t) ==
+      sizeof(typename std::iterator_traits<RandomAccessIter>::value_type)
+      || sizeof(boost::uint64_t) ==
+      sizeof(typename std::iterator_traits<RandomAccessIter>::value_type))
+      && std::numeric_limits<typename
+      std::iterator_traits<RandomAccessIter>::value_type>::is_iec559,
+      void >::type
+    parallel_stable_float_sort(RandomAccessIter first, RandomAccessIter last,
+                               unsigned nthread, thread_pool &pool)
+    {
+      typedef typename std::iterator_traits<RandomAccessIter>::value_type
+        Data_type;
+      typedef typename boost::conditional<
+        sizeof(Data_type) == sizeof(boost::uint32_t),
+        boost::int32_t, boost::int64_t>::type Cast_type;
+      parallel_stable_float_sort(first, last, Cast_type(),
+        float_cast_shift<Data_type, Cast_type>(), nthread, pool);
+    }
+
+    template <class RandomAccessIter>
+    inline typename boost::disable_if_c< (sizeof(boost::uint32_t) ==
+      sizeof(typename std::iterator_traits<RandomAccessIter>::value_type)
+      || sizeof(boost::uint64_t) ==
+      sizeof(typename std::iterator_traits<RandomAccessIter>::value_type))
+      && std::numeric_limits<typename
+      std::iterator_traits<RandomAccessIter>::value_type>::is_iec559,
+      void >::type
+    parallel_stable_float_sort(RandomAccessIter first, RandomAccessIter last,
+                               unsigned, thread_pool &)
+    {
+      stable_float_sort(first, last);
+    }
+  }
+}
+}
+}
+
+#endif
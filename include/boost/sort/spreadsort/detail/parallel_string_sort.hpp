@@ -0,0 +1,167 @@
+// Details for the multithreaded hybrid-radix parallel_string_sort.
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort for library home page.
+
+#ifndef BOOST_SORT_SPREADSORT_DETAIL_PARALLEL_STRING_SORT_HPP
+#define BOOST_SORT_SPREADSORT_DETAIL_PARALLEL_STRING_SORT_HPP
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <boost/utility/enable_if.hpp>
+#include <boost/sort/common/stack_cnc.hpp>
+#include <boost/sort/common/util/atomic.hpp>
+#include <boost/sort/spreadsort/detail/constants.hpp>
+#include <boost/sort/spreadsort/detail/spreadsort_common.hpp>
+#include <boost/sort/spreadsort/detail/string_sort.hpp>
+#include <boost/sort/spreadsort/detail/parallel_common.hpp>
+
+namespace boost {
+namespace sort {
+namespace spreadsort {
+  namespace detail {
+    //Smallest bin worth handing to another thread instead of recursing on it
+    static const size_t min_string_task_size = 1 << 12;
+
+    //Sorts strings with a pool of threads sharing a stack of bins to sort.
+    //A split task does one level of string_sort_rec and pushes the large bins
+    //it produces; bins too large for one thread are split again, the others
+    //are sorted serially by whichever thread pops them.  Each thread has its
+    //own bin_cache and bin_sizes, reused by every task it runs.
+    template <class RandomAccessIter, class Unsigned_char_type>
+    class parallel_string_sorter {
+    public:
+      parallel_string_sorter(RandomAccessIter first, RandomAccessIter last,
+                             unsigned nthread, thread_pool &pool)
+        : pending(0), vbin_cache(nthread), vbin_sizes(nthread)
+      {
+        split_size = (std::max)(size_t(last - first) / (size_t(nthread) * 8),
+                                size_t(min_string_task_size));
+        for (unsigned i = 0; i < nthread; ++i)
+          vbin_sizes[i].resize(bin_count + 1);
+        push(first, last, 0, true);
+        run_threads(pool, nthread, [this](unsigned i) { exec(i); });
+        if (error)
+          std::rethrow_exception(error);
+      }
+
+    private:
+      typedef typename std::iterator_traits<RandomAccessIter>::value_type
+        Data_type;
+      static const unsigned bin_count = 1 << (8 * sizeof(Unsigned_char_type));
+
+      struct string_task {
+        RandomAccessIter first, last;
+        size_t char_offset;
+        bool split;
+      };
+
+      void push(RandomAccessIter first, RandomAccessIter last,
+                size_t char_offset, bool split)
+      {
+        string_task task = { first, last, char_offset, split };
+        common::util::atomic_add(pending, 1);
+        works.emplace_back(task);
+      }
+
+      //Runs tasks until every pushed task has finished
+      void exec(unsigned id)
+      {
+        string_task task;
+        while (common::util::atomic_read(pending) != 0) {
+          if (works.pop_move_back(task)) {
+            try {
+              run(task, vbin_cache[id], &(vbin_sizes[id][0]));
+            }
+            catch (...) {
+              std::lock_guard<std::mutex> guard(error_mutex);
+              if (!error)
+                error = std::current_exception();
+            }
+            common::util::atomic_sub(pending, 1);
+          }
+          else
+            std::this_thread::yield();
+        }
+      }
+
+      void run(const string_task & task,
+               std::vector<RandomAccessIter> &bin_cache, size_t *bin_sizes)
+      {
+        if (!task.split) {
+          string_sort_rec<RandomAccessIter, Unsigned_char_type>(task.first,
+            task.last, task.char_offset, bin_cache, 0, bin_sizes);
+          return;
+        }
+        size_t char_offset = task.char_offset;
+        unsigned cache_end, last_bin;
+        if (!string_split_bins<RandomAccessIter, Unsigned_char_type>(
+              task.first, task.last, char_offset, bin_cache, 0, bin_sizes,
+              cache_end, last_bin))
+          return;
+        //Equal worst-case of radix and comparison is when bin_count = n*log(n).
+        const unsigned max_size = bin_count;
+        RandomAccessIter lastPos = bin_cache[0];
+        //Skip this loop for empties
+        for (unsigned u = 1; u < last_bin + 2; lastPos = bin_cache[u], ++u) {
+          size_t count = bin_cache[u] - lastPos;
+          if (count < 2)
+            continue;
+          if (count < max_size)
+            boost::sort::pdqsort(lastPos, bin_cache[u],
+              offset_less_than<Data_type, Unsigned_char_type>(char_offset + 1));
+          else if (count >= min_string_task_size)
+            push(lastPos, bin_cache[u], char_offset + 1, count > split_size);
+          else
+            string_sort_rec<RandomAccessIter, Unsigned_char_type>(lastPos,
+              bin_cache[u], char_offset + 1, bin_cache, cache_end, bin_sizes);
+        }
+      }
+
+      common::stack_cnc<string_task> works;
+      std::atomic<size_t> pending;
+      size_t split_size;
+      std::vector<std::vector<RandomAccessIter> > vbin_cache;
+      std::vector<std::vector<size_t> > vbin_sizes;
+      std::mutex error_mutex;
+      std::exception_ptr error;
+    };
+
+    template <class RandomAccessIter, class Unsigned_char_type>
+    inline typename boost::enable_if_c< sizeof(Unsigned_char_type) <= 2, void
+                                                                      >::type
+    parallel_string_sort(RandomAccessIter first, RandomAccessIter last,
+                         Unsigned_char_type unused, unsigned nthread,
+                         thread_pool &pool)
+    {
+      if (nthread > size_t(last - first) / min_parallel_size)
+        nthread = unsigned(size_t(last - first) / min_parallel_size);
+      if (nthread < 2)
+        string_sort(first, last, unused);
+      else {
+        parallel_string_sorter<RandomAccessIter, Unsigned_char_type>
+          sorter(first, last, nthread, pool);
+      }
+    }
+
+    template <class RandomAccessIter, class Unsigned_char_type>
+    inline typename boost::disable_if_c< sizeof(Unsigned_char_type) <= 2, void
+                                                                       >::type
+    parallel_string_sort(RandomAccessIter first, RandomAccessIter last,
+                         Unsigned_char_type unused, unsigned, thread_pool &)
+    {
+      string_sort(first, last, unused);
+    }
+  }
+}
+}
+}
+
+#endif
@@ -0,0 +1,79 @@
+// Details for the multithreaded parallel_integer_tag_sort.
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort for library home page.
+
+#ifndef BOOST_SORT_SPREADSORT_DETAIL_PARALLEL_TAG_SORT_HPP
+#define BOOST_SORT_SPREADSORT_DETAIL_PARALLEL_TAG_SORT_HPP
+#include <limits>
+#include <memory>
+#include <boost/sort/spreadsort/detail/constants.hpp>
+#include <boost/sort/spreadsort/detail/tag_sort.hpp>
+#include <boost/sort/spreadsort/detail/parallel_common.hpp>
+#include <boost/sort/spreadsort/detail/parallel_integer_sort.hpp>
+#include <boost/sort/common/indirect.hpp>
+#include <boost/cstdint.hpp>
+
+namespace boost {
+namespace sort {
+namespace spreadsort {
+  namespace detail {
+    //The tags are made by nthread threads, each in its own chunk, sorted
+    //with parallel_integer_sort, and the elements are gathered in their
+    //sorted order by the threads
+    template <class RandomAccessIter, class Div_type, class Right_shift,
+              class Index_type>
+    inline void
+    parallel_integer_tag_sort(RandomAccessIter first, RandomAccessIter last,
+                              Right_shift rshift, unsigned nthread,
+                              thread_pool &pool, Index_type)
+    {
+      typedef sort_tag<Div_type, Index_type> Tag;
+      const size_t nelem = last - first;
+      if (nthread > nelem / min_parallel_size)
+        nthread = unsigned(nelem / min_parallel_size);
+      if (nthread < 2) {
+        integer_tag_sort<RandomAccessIter, Div_type>(first, last, rshift,
+                                                     Index_type());
+        return;
+      }
+
+      //Not initialized, as every tag is written by the threads
+      std::unique_ptr<Tag[]> tags(new Tag[nelem]);
+      run_threads(pool, nthread, [&](unsigned i) {
+        size_t start = (nelem * i) / nthread;
+        size_t end = (nelem * (i + 1)) / nthread;
+        make_tags(first, start, end - start, rshift, tags.get() + start);
+      });
+      parallel_integer_sort(tags.get(), tags.get() + nelem, Div_type(),
+                            tag_shift<Div_type, Index_type>(),
+                            tag_less<Div_type, Index_type>(), nthread, pool);
+      Tag *sorted_tags = tags.get();
+      if (!common::parallel_apply_permutation(first, nelem,
+            [sorted_tags](size_t pos)
+            { return size_t(sorted_tags[pos].index); }, nthread, pool))
+        apply_tags(first, sorted_tags, nelem);
+    }
+
+    template <class RandomAccessIter, class Div_type, class Right_shift>
+    inline void
+    parallel_integer_tag_sort(RandomAccessIter first, RandomAccessIter last,
+                              Div_type, Right_shift rshift, unsigned nthread,
+                              thread_pool &pool)
+    {
+      if (size_t(last - first) <= (std::numeric_limits<boost::uint32_t>::max)())
+        parallel_integer_tag_sort<RandomAccessIter, Div_type>(first, last,
+          rshift, nthread, pool, boost::uint32_t());
+      else
+        parallel_integer_tag_sort<RandomAccessIter, Div_type>(first, last,
+          rshift, nthread, pool, size_t());
+    }
+  }
+}
+}
+}
+
+#endif
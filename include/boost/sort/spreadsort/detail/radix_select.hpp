@@ -0,0 +1,519 @@
+// Details for the radix-based integer_select and float_select.
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort for library home page.
+
+#ifndef BOOST_SORT_SPREADSORT_DETAIL_RADIX_SELECT_HPP
+#define BOOST_SORT_SPREADSORT_DETAIL_RADIX_SELECT_HPP
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <boost/serialization/static_warning.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <boost/type_traits/conditional.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/make_unsigned.hpp>
+#include <boost/sort/pdqsort/pdqselect.hpp>
+#include <boost/sort/spreadsort/detail/constants.hpp>
+#include <boost/sort/spreadsort/detail/spreadsort_common.hpp>
+#include <boost/sort/spreadsort/detail/integer_sort.hpp>
+#include <boost/sort/spreadsort/detail/float_sort.hpp>
+#include <boost/cstdint.hpp>
+
+namespace boost {
+namespace sort {
+namespace spreadsort {
+  namespace detail {
+    //Unsigned key of an integer_select, from the Div_type returned by
+    //rshift(x, 0), with the same order
+    template <class Div_type, class Right_shift>
+    struct integer_select_key {
+      typedef typename boost::make_unsigned<Div_type>::type Key_type;
+      Right_shift rshift;
+      integer_select_key(Right_shift shift) : rshift(shift) {}
+
+      template <class Data_type>
+      inline Key_type operator()(const Data_type &x)
+      { return lsd_key<Div_type>(rshift(x, 0)); }
+    };
+
+    //Unsigned key of a float_select, from the float cast to an integer by
+    //rshift(x, 0).  Negative floats are stored as sign and magnitude, so
+    //their bits are inverted to reverse their order; the sign bit is set on
+    //positive floats, which go after them.
+    template <class Div_type, class Right_shift>
+    struct float_select_key {
+      typedef typename boost::make_unsigned<Div_type>::type Key_type;
+      Right_shift rshift;
+      float_select_key(Right_shift shift) : rshift(shift) {}
+
+      template <class Data_type>
+      inline Key_type operator()(const Data_type &x)
+      {
+        const unsigned sign_shift = 8 * sizeof(Key_type) - 1;
+        Key_type key = Key_type(rshift(x, 0));
+        return (key >> sign_shift) ? Key_type(~key)
+          : Key_type(key | (Key_type(1) << sign_shift));
+      }
+    };
+
+    //Right_shift of float_select without a functor: the float cast to a
+    //signed integer of the same size
+    template <class Data_type, class Cast_type>
+    struct float_cast_shift {
+      inline Cast_type operator()(const Data_type &x, unsigned offset) const
+      { return cast_float_iter<Cast_type, const Data_type *>(&x) >> offset; }
+    };
+
+    //Whether the bin of an element is lower than bound
+    template <class Get_key>
+    struct bin_below {
+      typedef typename Get_key::Key_type Key_type;
+      Get_key get_key;
+      unsigned log_divisor;
+      Key_type div_min;
+      unsigned bound;
+      bin_below(Get_key key, unsigned divisor, Key_type min, unsigned bin)
+        : get_key(key), log_divisor(divisor), div_min(min), bound(bin) {}
+
+      template <class Data_type>
+      inline bool operator()(const Data_type &x)
+      { return unsigned((get_key(x) >> log_divisor) - div_min) < bound; }
+    };
+
+    //Moves the elements which satisfy pred before mid and the others after
+    //it, when the number of elements which satisfy pred is mid - first.
+    //Each element is read once, and only the elements in the wrong side are
+    //swapped.  The offsets of those elements are taken in blocks, without
+    //branches depending on pred, as in the pdqsort partition.
+    template <class RandomAccessIter, class Pred>
+    inline void
+    partition_bins(RandomAccessIter first, RandomAccessIter mid,
+                   RandomAccessIter last, Pred pred)
+    {
+      const unsigned block_size = 64;
+      unsigned char offsets_l[block_size], offsets_r[block_size];
+      unsigned num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+      RandomAccessIter block_l = first, block_r = mid;
+      RandomAccessIter next_l = first, next_r = mid;
+      while (true) {
+        //Taking the elements of the next block which don't satisfy pred
+        if (!num_l) {
+          if (next_l == mid)
+            return;
+          unsigned size = unsigned((std::min)(mid - next_l,
+            typename std::iterator_traits<RandomAccessIter>::difference_type(
+              block_size)));
+          block_l = next_l;
+          start_l = 0;
+          for (unsigned u = 0; u < size; ++u) {
+            offsets_l[num_l] = (unsigned char)u;
+            num_l += !pred(*next_l++);
+          }
+          continue;
+        }
+        //As many elements after mid satisfy pred as before it don't
+        if (!num_r) {
+          unsigned size = unsigned((std::min)(last - next_r,
+            typename std::iterator_traits<RandomAccessIter>::difference_type(
+              block_size)));
+          block_r = next_r;
+          start_r = 0;
+          for (unsigned u = 0; u < size; ++u) {
+            offsets_r[num_r] = (unsigned char)u;
+            num_r += pred(*next_r++);
+          }
+        }
+        unsigned num = (std::min)(num_l, num_r);
+        for (unsigned u = 0; u < num; ++u)
+          std::iter_swap(block_l + offsets_l[start_l + u],
+                         block_r + offsets_r[start_r + u]);
+        num_l -= num;
+        num_r -= num;
+        start_l += num;
+        start_r += num;
+      }
+    }
+
+    //Moves the elements which satisfy pred before the others, and returns
+    //the first of the others.  The elements in the wrong side are found in
+    //blocks from both ends, without branches depending on pred, as in the
+    //pdqsort partition; the few elements between the last blocks are
+    //finished with std::partition.
+    template <class RandomAccessIter, class Pred>
+    inline RandomAccessIter
+    partition_blocks(RandomAccessIter first, RandomAccessIter last, Pred pred)
+    {
+      const int block_size = 64;
+      unsigned char offsets_l[block_size], offsets_r[block_size];
+      int num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+      //[first, last) is unknown, the elements before it satisfy pred and
+      //those after it don't
+      while (last - first > 2 * block_size) {
+        if (!num_l) {
+          start_l = 0;
+          RandomAccessIter current = first;
+          for (int i = 0; i < block_size; ++i) {
+            offsets_l[num_l] = (unsigned char)i;
+            num_l += !pred(*current++);
+          }
+        }
+        if (!num_r) {
+          start_r = 0;
+          RandomAccessIter current = last;
+          for (int i = 1; i <= block_size; ++i) {
+            offsets_r[num_r] = (unsigned char)i;
+            num_r += pred(*--current);
+          }
+        }
+        int num = (std::min)(num_l, num_r);
+        for (int i = 0; i < num; ++i)
+          std::iter_swap(first + offsets_l[start_l + i],
+                         last - offsets_r[start_r + i]);
+        num_l -= num;
+        num_r -= num;
+        start_l += num;
+        start_r += num;
+        if (!num_l)
+          first += block_size;
+        if (!num_r)
+          last -= block_size;
+      }
+      return std::partition(first, last, pred);
+    }
+
+    //Whether an element goes before pivot
+    template <class Data_type, class Compare>
+    struct value_below {
+      const Data_type &pivot;
+      Compare comp;
+      value_below(const Data_type &value, Compare compare)
+        : pivot(value), comp(compare) {}
+
+      inline bool operator()(const Data_type &x) { return comp(x, pivot); }
+    };
+
+    //Whether an element doesn't go after pivot
+    template <class Data_type, class Compare>
+    struct value_not_above {
+      const Data_type &pivot;
+      Compare comp;
+      value_not_above(const Data_type &value, Compare compare)
+        : pivot(value), comp(compare) {}
+
+      inline bool operator()(const Data_type &x) { return !comp(pivot, x); }
+    };
+
+    //Moves the elements which go before pivot to the start, with the vector
+    //partition of pdqsort when the elements are primitive types compared
+    //with std::less or std::greater, and returns the first of the others
+    template <class RandomAccessIter, class Data_type, class Compare>
+    inline RandomAccessIter
+    partition_below(RandomAccessIter first, RandomAccessIter last,
+                    const Data_type &pivot, Compare comp)
+    {
+      if (boost::sort::pdqsort_detail::simd_partition(first, last, pivot, comp,
+            boost::integral_constant<bool, boost::sort::pdqsort_detail::
+              use_simd_partition<RandomAccessIter, Compare>::value>()))
+        return first;
+      return partition_blocks(first, last,
+                              value_below<Data_type, Compare>(pivot, comp));
+    }
+
+    //Narrows [first, last) to a range around nth before counting any bin.
+    //A sample of about count^(2/3) elements, moved to the start, gives two
+    //pivots a few standard deviations around the rank of nth, and the
+    //elements are partitioned around them, the second partition only in
+    //the side which contains nth.  The range left is a few percent of the
+    //input, and the full count is only done on it.
+    //Returns true when nth is already in its place.
+    template <class RandomAccessIter, class Compare>
+    inline bool
+    narrow_by_sample(RandomAccessIter &first, RandomAccessIter nth,
+                     RandomAccessIter &last, Compare comp)
+    {
+      typedef typename std::iterator_traits<RandomAccessIter>::value_type
+        Data_type;
+      const size_t count = last - first;
+      const unsigned log_sample = (2 * rough_log_2_size(count)) / 3;
+      const size_t sample = size_t(1) << log_sample;
+      const size_t stride = count / sample;
+      for (size_t u = 1; u < sample; ++u)
+        std::iter_swap(first + u, first + u * stride);
+
+      //The rank of nth in the sample has a standard deviation of at most
+      //sqrt(sample) / 2; the pivots are 4 of them away
+      const size_t target = nth - first;
+      const size_t rank = (std::min)(target / stride, sample - 1);
+      const size_t delta = size_t(2) << (log_sample / 2);
+      const size_t rank_low = rank > delta ? rank - delta : 0;
+      const size_t rank_high = (std::min)(rank + delta, sample - 1);
+      boost::sort::nth_element(first, first + rank_low, first + sample, comp);
+      const Data_type low(*(first + rank_low));
+      boost::sort::nth_element(first + rank_low, first + rank_high,
+                               first + sample, comp);
+      const Data_type high(*(first + rank_high));
+      //When the pivots are equal, the middle are the elements equal to them
+      const bool equal = !comp(low, high);
+
+      RandomAccessIter mid_first = first, mid_last = last;
+      if (2 * target < count) {
+        mid_last = equal ? partition_blocks(first, last,
+                             value_not_above<Data_type, Compare>(high, comp))
+                         : partition_below(first, last, high, comp);
+        if (nth >= mid_last) {
+          first = mid_last;
+          return false;
+        }
+        if (rank_low)
+          mid_first = partition_below(first, mid_last, low, comp);
+      }
+      else {
+        if (rank_low)
+          mid_first = partition_below(first, last, low, comp);
+        if (nth < mid_first) {
+          last = mid_first;
+          return false;
+        }
+        mid_last = equal ? partition_blocks(mid_first, last,
+                             value_not_above<Data_type, Compare>(high, comp))
+                         : partition_below(mid_first, last, high, comp);
+      }
+      if (nth < mid_first)
+        last = mid_first;
+      else if (nth >= mid_last)
+        first = mid_last;
+      else {
+        first = mid_first;
+        last = mid_last;
+        //Without the partition by low, smaller elements may be left there
+        return equal && rank_low;
+      }
+      return false;
+    }
+
+    //Radix-based selection: each iteration counts the elements of each bin,
+    //as in spreadsort, finds the bin which contains nth, and moves the
+    //elements of the lower bins before it and those of the higher bins after
+    //it with two partitions.  Only that bin is processed in the next
+    //iteration.
+    //Large inputs are first narrowed with a sample, and small bins are
+    //finished with the comparison-based nth_element.
+    template <class RandomAccessIter, class Get_key, class Compare>
+    inline void
+    radix_select(RandomAccessIter first, RandomAccessIter nth,
+                 RandomAccessIter last, Get_key get_key, Compare comp)
+    {
+      typedef typename Get_key::Key_type Key_type;
+      const unsigned key_bits = 8 * sizeof(Key_type);
+      const unsigned top_shift =
+        key_bits > unsigned(max_splits) ? key_bits - max_splits : 0;
+      size_t bin_sizes[(1 << max_splits) + 1];
+      if (nth == last)
+        return;
+      if (last - first >= min_sample_size &&
+          narrow_by_sample(first, nth, last, comp))
+        return;
+      //The first iteration counts the bins of the highest bits of the keys
+      //while finding the range, and if the range is as wide as the keys,
+      //they are the bins of the range, saving a pass over the elements
+      bool first_iteration = true;
+      while (last - first >= min_sort_size) {
+        //Finding the range of the keys
+        Key_type min = get_key(*first), max = min;
+        if (first_iteration) {
+          for (unsigned u = 0; u < (1u << (key_bits - top_shift)); ++u)
+            bin_sizes[u] = 0;
+          for (RandomAccessIter current = first; current != last;
+              ++current) {
+            Key_type key = get_key(*current);
+            if (key < min)
+              min = key;
+            if (max < key)
+              max = key;
+            bin_sizes[key >> top_shift]++;
+          }
+        }
+        else {
+          for (RandomAccessIter current = first + 1; current != last;
+              ++current) {
+            Key_type key = get_key(*current);
+            if (key < min)
+              min = key;
+            if (max < key)
+              max = key;
+          }
+        }
+        //If every key is equal, so are the elements
+        if (min == max)
+          return;
+        unsigned log_range = rough_log_2_size(Key_type(max - min));
+        unsigned log_divisor =
+          log_range > unsigned(max_splits) ? log_range - max_splits : 0;
+        Key_type div_min = min >> log_divisor;
+        unsigned bin_count = unsigned((max >> log_divisor) - div_min) + 1;
+
+        //Calculating the size of each bin
+        size_t *bins = bin_sizes;
+        if (first_iteration && log_divisor == top_shift)
+          bins += size_t(div_min);
+        else {
+          for (unsigned u = 0; u < bin_count; ++u)
+            bin_sizes[u] = 0;
+          for (RandomAccessIter current = first; current != last; ++current)
+            bin_sizes[unsigned((get_key(*current) >> log_divisor) - div_min)]++;
+        }
+        first_iteration = false;
+
+        //Finding the bin which contains nth
+        size_t target = nth - first, below = 0;
+        unsigned target_bin = 0;
+        while (below + bins[target_bin] <= target)
+          below += bins[target_bin++];
+
+        //Moving the lower bins before the bin of nth, and the higher bins
+        //after it.  The second partition is done in the smaller side.
+        typedef bin_below<Get_key> Pred;
+        RandomAccessIter bin_first = first + below;
+        RandomAccessIter bin_last = bin_first + bins[target_bin];
+        if (2 * target < size_t(last - first)) {
+          partition_bins(first, bin_last, last,
+                         Pred(get_key, log_divisor, div_min, target_bin + 1));
+          partition_bins(first, bin_first, bin_last,
+                         Pred(get_key, log_divisor, div_min, target_bin));
+        }
+        else {
+          partition_bins(first, bin_first, last,
+                         Pred(get_key, log_divisor, div_min, target_bin));
+          partition_bins(bin_first, bin_last, last,
+                         Pred(get_key, log_divisor, div_min, target_bin + 1));
+        }
+        first = bin_first;
+        last = bin_last;
+
+        //If we've bucketsorted, the bin has only one key
+        if (!log_divisor)
+          return;
+      }
+      boost::sort::nth_element(first, nth, last, comp);
+    }
+
+    //Integer keys that fit in a uintmax_t
+    template <class RandomAccessIter, class Div_type, class Right_shift,
+              class Compare>
+    inline typename boost::enable_if_c< boost::is_integral<Div_type>::value
+      && sizeof(Div_type) <= sizeof(boost::uintmax_t), void >::type
+    integer_select(RandomAccessIter first, RandomAccessIter nth,
+                   RandomAccessIter last, Div_type, Right_shift shift,
+                   Compare comp)
+    {
+      radix_select(first, nth, last,
+                   integer_select_key<Div_type, Right_shift>(shift), comp);
+    }
+
+    //defaulting to boost::sort::nth_element when integer_select won't work
+    template <class RandomAccessIter, class Div_type, class Right_shift,
+              class Compare>
+    inline typename boost::disable_if_c< boost::is_integral<Div_type>::value
+      && sizeof(Div_type) <= sizeof(boost::uintmax_t), void >::type
+    integer_select(RandomAccessIter first, RandomAccessIter nth,
+                   RandomAccessIter last, Div_type, Right_shift, Compare comp)
+    {
+      BOOST_STATIC_WARNING(boost::is_integral<Div_type>::value
+        && sizeof(Div_type) <= sizeof(boost::uintmax_t));
+      boost::sort::nth_element(first, nth, last, comp);
+    }
+
+    //Without a Right_shift functor, the key is the element
+    template <class RandomAccessIter, class Div_type>
+    inline void
+    integer_select(RandomAccessIter first, RandomAccessIter nth,
+                   RandomAccessIter last, Div_type key)
+    {
+      typedef typename std::iterator_traits<RandomAccessIter>::value_type
+        Data_type;
+      integer_select(first, nth, last, key,
+                     shift_operator<Data_type, Div_type>(),
+                     std::less<Data_type>());
+    }
+
+    //Floats cast to integers that fit in a uintmax_t
+    template <class RandomAccessIter, class Div_type, class Right_shift,
+              class Compare>
+    inline typename boost::enable_if_c< boost::is_integral<Div_type>::value
+      && sizeof(Div_type) <= sizeof(boost::uintmax_t), void >::type
+    float_select(RandomAccessIter first, RandomAccessIter nth,
+                 RandomAccessIter last, Div_type, Right_shift shift,
+                 Compare comp)
+    {
+      radix_select(first, nth, last,
+                   float_select_key<Div_type, Right_shift>(shift), comp);
+    }
+
+    //defaulting to boost::sort::nth_element when float_select won't work
+    template <class RandomAccessIter, class Div_type, class Right_shift,
+              class Compare>
+    inline typename boost::disable_if_c< boost::is_integral<Div_type>::value
+      && sizeof(Div_type) <= sizeof(boost::uintmax_t), void >::type
+    float_select(RandomAccessIter first, RandomAccessIter nth,
+                 RandomAccessIter last, Div_type, Right_shift, Compare comp)
+    {
+      BOOST_STATIC_WARNING(boost::is_integral<Div_type>::value
+        && sizeof(Div_type) <= sizeof(boost::uintmax_t));
+      boost::sort::nth_element(first, nth, last, comp);
+    }
+
+    //Checking whether the value type is a float, and casting it to a 32-bit
+    //integer, or a double, and casting it to a 64-bit integer
+    template <class RandomAccessIter>
+    inline typename boost::enable_if_c< (sizeof(boost::uint32_t) ==
+      sizeof(typename std::iterator_traits<RandomAccessIter>::value_type)
+      || sizeof(boost::uint64_t) ==
+      sizeof(typename std::iterator_traits<RandomAccessIter>::value_type))
+      && std::numeric_limits<typename
+      std::iterator_traits<RandomAccessIter>::value_type>::is_iec559,
+      void >::type
+    float_select(RandomAccessIter first, RandomAccessIter nth,
+                 RandomAccessIter last)
+    {
+      typedef typename std::iterator_traits<RandomAccessIter>::value_type
+        Data_type;
+      typedef typename boost::conditional<
+        sizeof(Data_type) == sizeof(boost::uint32_t),
+        boost::int32_t, boost::int64_t>::type Cast_type;
+      radix_select(first, nth, last,
+                   float_select_key<Cast_type,
+                     float_cast_shift<Data_type, Cast_type> >(
+                       float_cast_shift<Data_type, Cast_type>()),
+                   std::less<Data_type>());
+    }
+
+    template <class RandomAccessIter>
+    inline typename boost::disable_if_c< (sizeof(boost::uint32_t) ==
+      sizeof(typename std::iterator_traits<RandomAccessIter>::value_type)
+      || sizeof(boost::uint64_t) ==
+      sizeof(typename std::iterator_traits<RandomAccessIter>::value_type))
+      && std::numeric_limits<typename
+      std::iterator_traits<RandomAccessIter>::value_type>::is_iec559,
+      void >::type
+    float_select(RandomAccessIter first, RandomAccessIter nth,
+                 RandomAccessIter last)
+    {
+      BOOST_STATIC_WARNING(!(sizeof(boost::uint64_t) ==
+      sizeof(typename std::iterator_traits<RandomAccessIter>::value_type)
+      || sizeof(boost::uint32_t) ==
+      sizeof(typename std::iterator_traits<RandomAccessIter>::value_type))
+      || !std::numeric_limits<typename
+      std::iterator_traits<RandomAccessIter>::value_type>::is_iec559);
+      boost::sort::nth_element(first, nth, last);
+    }
+  }
+}
+}
+}
+
+#endif
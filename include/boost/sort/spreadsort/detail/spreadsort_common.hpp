@@ -20,10 +20,16 @@ Phil Endecott and Frank Gennari
 #include <cstring>
 #include <limits>
 #include <functional>
+#include <iterator>
 #include <boost/static_assert.hpp>
 #include <boost/serialization/static_warning.hpp>
+#include <boost/type_traits/is_pointer.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/utility/enable_if.hpp>
 #include <boost/sort/pdqsort/pdqsort.hpp>
 #include <boost/sort/spreadsort/detail/constants.hpp>
+#include <boost/sort/spreadsort/spreadsort_context.hpp>
+#include <boost/sort/spreadsort/tuning.hpp>
 #include <boost/cstdint.hpp>
 
 namespace boost {
@@ -42,27 +48,46 @@ namespace spreadsort {
       return result;
     }
 
+    //The tuning values of integer_sort, and of the integers float_sort
+    //casts its floats to, read from current_tuning().  The sorts are
+    //templated on these, so a tuning_policy can replace them for one call.
+    struct int_tuning {
+      static unsigned max_splits() { return current_tuning().max_splits; }
+      static unsigned log_mean_bin_size()
+      { return current_tuning().int_log_mean_bin_size; }
+      static unsigned log_min_split_count()
+      { return current_tuning().int_log_min_split_count; }
+      static unsigned log_finishing_count()
+      { return current_tuning().int_log_finishing_count; }
+    };
+
+    //The tuning values of float_sort
+    struct float_tuning {
+      static unsigned max_splits() { return current_tuning().max_splits; }
+      static unsigned log_mean_bin_size()
+      { return current_tuning().float_log_mean_bin_size; }
+      static unsigned log_min_split_count()
+      { return current_tuning().float_log_min_split_count; }
+      static unsigned log_finishing_count()
+      { return current_tuning().float_log_finishing_count; }
+    };
+
     //Gets the minimum size to call spreadsort on to control worst-case runtime.
     //This is called for a set of bins, instead of bin-by-bin, to minimize
     //runtime overhead.
     //This could be replaced by a lookup table of sizeof(Div_type)*8 but this
     //function is more general.
-    template<unsigned log_mean_bin_size,
-      unsigned log_min_split_count, unsigned log_finishing_count>
+    //The values of Tuning are checked by set_tuning, or by tuning_policy.
+    template<class Tuning>
     inline size_t
     get_min_count(unsigned log_range)
     {
       const size_t typed_one = 1;
+      const unsigned max_splits = Tuning::max_splits();
+      const unsigned log_mean_bin_size = Tuning::log_mean_bin_size();
+      const unsigned log_min_split_count = Tuning::log_min_split_count();
+      const unsigned log_finishing_count = Tuning::log_finishing_count();
       const unsigned min_size = log_mean_bin_size + log_min_split_count;
-      //Assuring that constants have valid settings
-      BOOST_STATIC_ASSERT(log_min_split_count <= max_splits &&
-                          log_min_split_count > 0);
-      BOOST_STATIC_ASSERT(max_splits > 1 &&
-                          max_splits < (8 * sizeof(unsigned)));
-      BOOST_STATIC_ASSERT(max_finishing_splits >= max_splits &&
-                          max_finishing_splits < (8 * sizeof(unsigned)));
-      BOOST_STATIC_ASSERT(log_mean_bin_size >= 0);
-      BOOST_STATIC_ASSERT(log_finishing_count >= 0);
       //if we can complete in one iteration, do so
       //This first check allows the compiler to optimize never-executed code out
       if (log_finishing_count < min_size) {
@@ -101,6 +126,24 @@ namespace spreadsort {
       return typed_one << bit_length;
     }
 
+    //The bin sizes of a sort, shared by all its iterations.  They are on
+    //the stack for the default max_splits, and on the heap for a larger
+    //tuned max_splits.
+    class bin_size_buffer {
+    public:
+      explicit bin_size_buffer(unsigned max_splits)
+      {
+        if (max_splits + 1 > unsigned(max_finishing_splits))
+          heap_sizes.resize(size_t(1) << (max_splits + 1));
+      }
+
+      size_t *get() { return heap_sizes.empty() ? sizes : &heap_sizes[0]; }
+
+    private:
+      size_t sizes[1 << max_finishing_splits];
+      std::vector<size_t> heap_sizes;
+    };
+
     // Resizes the bin cache and bin sizes, and initializes each bin size to 0.
     // This generates the memory overhead to use in radix sorting.
     template <class RandomAccessIter>
@@ -117,6 +160,45 @@ namespace spreadsort {
         bin_cache.resize(cache_end);
       return &(bin_cache[cache_offset]);
     }
+
+    //Pointers and std::vector iterators point into contiguous memory,
+    //so the data can be read as an array
+    template <class RandomAccessIter>
+    struct is_contiguous_iter {
+      typedef typename std::iterator_traits<RandomAccessIter>::value_type
+        Data_type;
+      static const bool value = boost::is_pointer<RandomAccessIter>::value ||
+        boost::is_same<RandomAccessIter,
+                       typename std::vector<Data_type>::iterator>::value;
+    };
+
+    //The swap loops write each bin sequentially, but jump between bins on
+    //every write; with thousands of bins, most of those writes miss the
+    //cache.  Prefetching the memory just past the position written hides
+    //the miss on the next write to the same bin.
+    //Define BOOST_SORT_SPREADSORT_NO_PREFETCH to turn this off.
+    template <class RandomAccessIter>
+    inline typename boost::enable_if_c<
+      is_contiguous_iter<RandomAccessIter>::value, void >::type
+    prefetch_bin_position(RandomAccessIter position)
+    {
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    !defined(BOOST_SORT_SPREADSORT_NO_PREFETCH)
+      //Integer arithmetic, as the address may be past the end of the data
+      __builtin_prefetch(reinterpret_cast<const void *>(
+        reinterpret_cast<boost::uintptr_t>(&(*position)) + bin_prefetch_bytes),
+        1);
+#else
+      (void)position;
+#endif
+    }
+
+    template <class RandomAccessIter>
+    inline typename boost::disable_if_c<
+      is_contiguous_iter<RandomAccessIter>::value, void >::type
+    prefetch_bin_position(RandomAccessIter)
+    {
+    }
   }
 }
 }
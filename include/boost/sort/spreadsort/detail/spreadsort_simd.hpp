@@ -0,0 +1,432 @@
+// Vectorized kernels for the per-level passes of the plain integer_sort and
+// float_sort: the sortedness check with the minimum and maximum, and the
+// bin size count.
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort for library home page.
+
+/*
+The AVX2 kernels are compiled with a target attribute and picked at runtime
+on GCC and Clang for x86, so they don't need -mavx2.  Everywhere else, and
+for iterators that aren't pointers or std::vector iterators, the scalar code
+is used.  Define BOOST_SORT_SPREADSORT_NO_SIMD to always use the scalar code.
+*/
+
+#ifndef BOOST_SORT_SPREADSORT_DETAIL_SPREADSORT_SIMD_HPP
+#define BOOST_SORT_SPREADSORT_DETAIL_SPREADSORT_SIMD_HPP
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <vector>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_signed.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <boost/sort/spreadsort/detail/spreadsort_common.hpp>
+#include <boost/cstdint.hpp>
+
+#if !defined(BOOST_SORT_SPREADSORT_NO_SIMD) && \
+    (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define BOOST_SORT_SPREADSORT_AVX2
+#define BOOST_SORT_SPREADSORT_AVX2_TARGET __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+
+namespace boost {
+namespace sort {
+namespace spreadsort {
+  namespace detail {
+    //Integers of 4 or 8 bytes have vector kernels
+    template <class RandomAccessIter>
+    struct has_integer_kernel {
+      typedef typename std::iterator_traits<RandomAccessIter>::value_type
+        Data_type;
+      static const bool value = is_contiguous_iter<RandomAccessIter>::value &&
+        boost::is_integral<Data_type>::value &&
+        (sizeof(Data_type) == 4 || sizeof(Data_type) == 8);
+    };
+
+    //IEEE floats and doubles have vector kernels
+    template <class RandomAccessIter, class Cast_type>
+    struct has_float_kernel {
+      typedef typename std::iterator_traits<RandomAccessIter>::value_type
+        Data_type;
+      static const bool value = is_contiguous_iter<RandomAccessIter>::value &&
+        std::numeric_limits<Data_type>::is_iec559 &&
+        boost::is_integral<Cast_type>::value &&
+        boost::is_signed<Cast_type>::value &&
+        sizeof(Data_type) == sizeof(Cast_type) &&
+        (sizeof(Data_type) == 4 || sizeof(Data_type) == 8);
+    };
+
+    //Below this many elements the kernels aren't worth the setup
+    static const size_t min_simd_size = 64;
+
+#ifdef BOOST_SORT_SPREADSORT_AVX2
+    inline bool has_avx2()
+    {
+#ifdef __AVX2__
+      return true;
+#else
+      static const bool result = __builtin_cpu_supports("avx2") != 0;
+      return result;
+#endif
+    }
+
+    //Lane operations, by element size and signedness.
+    //Unsigned comparisons flip the sign bit and use the signed ones.
+    template <unsigned Size, bool Signed> struct avx2_int_ops;
+
+    template <bool Signed> struct avx2_int_ops<4, Signed> {
+      static const unsigned lanes = 8;
+      static BOOST_SORT_SPREADSORT_AVX2_TARGET inline __m256i bias()
+      { return _mm256_set1_epi32(Signed ? 0 : int(0x80000000u)); }
+      static BOOST_SORT_SPREADSORT_AVX2_TARGET inline __m256i
+      greater(__m256i x, __m256i y, __m256i b)
+      { return _mm256_cmpgt_epi32(_mm256_xor_si256(x, b),
+                                  _mm256_xor_si256(y, b)); }
+      static BOOST_SORT_SPREADSORT_AVX2_TARGET inline __m256i first_index()
+      { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+      static BOOST_SORT_SPREADSORT_AVX2_TARGET inline __m256i index_step()
+      { return _mm256_set1_epi32(lanes); }
+      static BOOST_SORT_SPREADSORT_AVX2_TARGET inline __m256i
+      add(__m256i x, __m256i y) { return _mm256_add_epi32(x, y); }
+    };
+
+    template <bool Signed> struct avx2_int_ops<8, Signed> {
+      static const unsigned lanes = 4;
+      static BOOST_SORT_SPREADSORT_AVX2_TARGET inline __m256i bias()
+      { return _mm256_set1_epi64x(Signed ? 0 :
+          (long long)(boost::uint64_t(1) << 63)); }
+      static BOOST_SORT_SPREADSORT_AVX2_TARGET inline __m256i
+      greater(__m256i x, __m256i y, __m256i b)
+      { return _mm256_cmpgt_epi64(_mm256_xor_si256(x, b),
+                                  _mm256_xor_si256(y, b)); }
+      static BOOST_SORT_SPREADSORT_AVX2_TARGET inline __m256i first_index()
+      { return _mm256_setr_epi64x(0, 1, 2, 3); }
+      static BOOST_SORT_SPREADSORT_AVX2_TARGET inline __m256i index_step()
+      { return _mm256_set1_epi64x(lanes); }
+      static BOOST_SORT_SPREADSORT_AVX2_TARGET inline __m256i
+      add(__m256i x, __m256i y) { return _mm256_add_epi64(x, y); }
+    };
+
+    //One pass checking whether data is sorted and finding the positions of
+    //the minimum and maximum.  Each lane keeps its own extremes and where
+    //they were found; the lanes are merged at the end.
+    template <class Data_type>
+    BOOST_SORT_SPREADSORT_AVX2_TARGET inline bool
+    avx2_sorted_or_extremes(const Data_type *data, size_t count,
+                            size_t &max_pos, size_t &min_pos)
+    {
+      typedef avx2_int_ops<sizeof(Data_type),
+                           boost::is_signed<Data_type>::value> ops;
+      const unsigned lanes = ops::lanes;
+      const __m256i b = ops::bias();
+      const __m256i step = ops::index_step();
+      __m256i vmin = _mm256_loadu_si256((const __m256i *)data);
+      __m256i vmax = vmin;
+      __m256i index = ops::first_index();
+      __m256i min_index = index, max_index = index;
+      __m256i unsorted = _mm256_setzero_si256();
+      size_t u = lanes;
+      for (; u + lanes <= count; u += lanes) {
+        __m256i value = _mm256_loadu_si256((const __m256i *)(data + u));
+        __m256i prev = _mm256_loadu_si256((const __m256i *)(data + u - 1));
+        unsorted = _mm256_or_si256(unsorted, ops::greater(prev, value, b));
+        index = ops::add(index, step);
+        __m256i less = ops::greater(vmin, value, b);
+        vmin = _mm256_blendv_epi8(vmin, value, less);
+        min_index = _mm256_blendv_epi8(min_index, index, less);
+        __m256i more = ops::greater(value, vmax, b);
+        vmax = _mm256_blendv_epi8(vmax, value, more);
+        max_index = _mm256_blendv_epi8(max_index, index, more);
+      }
+      //The first element of each vector was compared to its predecessor by
+      //the unaligned load; only the tail is left
+      bool sorted = _mm256_testz_si256(unsorted, unsorted) != 0;
+      for (unsigned lane = 1; lane < lanes; ++lane)
+        sorted &= !(data[lane] < data[lane - 1]);
+      for (size_t v = u; v < count; ++v)
+        sorted &= !(data[v] < data[v - 1]);
+      if (sorted)
+        return true;
+      Data_type lane_value[lanes];
+      Data_type lane_index_value[lanes];
+      _mm256_storeu_si256((__m256i *)lane_value, vmin);
+      _mm256_storeu_si256((__m256i *)lane_index_value, min_index);
+      min_pos = size_t(lane_index_value[0]);
+      for (unsigned lane = 1; lane < lanes; ++lane)
+        if (lane_value[lane] < data[min_pos])
+          min_pos = size_t(lane_index_value[lane]);
+      _mm256_storeu_si256((__m256i *)lane_value, vmax);
+      _mm256_storeu_si256((__m256i *)lane_index_value, max_index);
+      max_pos = size_t(lane_index_value[0]);
+      for (unsigned lane = 1; lane < lanes; ++lane)
+        if (data[max_pos] < lane_value[lane])
+          max_pos = size_t(lane_index_value[lane]);
+      for (size_t v = u; v < count; ++v) {
+        if (data[max_pos] < data[v])
+          max_pos = v;
+        else if (data[v] < data[min_pos])
+          min_pos = v;
+      }
+      return false;
+    }
+
+    //Same for floats: the extremes are taken on the integer cast, and the
+    //order on the floating-point values, so NaNs count as unsorted
+    template <class Cast_type>
+    BOOST_SORT_SPREADSORT_AVX2_TARGET inline bool
+    avx2_float_sorted_or_extremes(const float *data, size_t count,
+                                  Cast_type &max, Cast_type &min)
+    {
+      const unsigned lanes = 8;
+      __m256i vmin = _mm256_loadu_si256((const __m256i *)data);
+      __m256i vmax = vmin;
+      __m256 unsorted = _mm256_setzero_ps();
+      size_t u = lanes;
+      for (; u + lanes <= count; u += lanes) {
+        __m256 value = _mm256_loadu_ps(data + u);
+        __m256 prev = _mm256_loadu_ps(data + u - 1);
+        unsorted = _mm256_or_ps(unsorted,
+                                _mm256_cmp_ps(value, prev, _CMP_NGE_UQ));
+        __m256i cast = _mm256_castps_si256(value);
+        vmin = _mm256_min_epi32(vmin, cast);
+        vmax = _mm256_max_epi32(vmax, cast);
+      }
+      bool sorted = _mm256_testz_ps(unsorted, unsorted) != 0;
+      for (unsigned lane = 1; lane < lanes; ++lane)
+        sorted &= data[lane] >= data[lane - 1];
+      for (size_t v = u; v < count; ++v)
+        sorted &= data[v] >= data[v - 1];
+      Cast_type lane_min[lanes], lane_max[lanes];
+      _mm256_storeu_si256((__m256i *)lane_min, vmin);
+      _mm256_storeu_si256((__m256i *)lane_max, vmax);
+      min = lane_min[0];
+      max = lane_max[0];
+      for (unsigned lane = 1; lane < lanes; ++lane) {
+        if (lane_min[lane] < min)
+          min = lane_min[lane];
+        if (max < lane_max[lane])
+          max = lane_max[lane];
+      }
+      for (size_t v = u; v < count; ++v) {
+        Cast_type value;
+        std::memcpy(&value, data + v, sizeof(value));
+        if (max < value)
+          max = value;
+        else if (value < min)
+          min = value;
+      }
+      return sorted;
+    }
+
+    template <class Cast_type>
+    BOOST_SORT_SPREADSORT_AVX2_TARGET inline bool
+    avx2_float_sorted_or_extremes(const double *data, size_t count,
+                                  Cast_type &max, Cast_type &min)
+    {
+      const unsigned lanes = 4;
+      __m256i vmin = _mm256_loadu_si256((const __m256i *)data);
+      __m256i vmax = vmin;
+      __m256d unsorted = _mm256_setzero_pd();
+      size_t u = lanes;
+      for (; u + lanes <= count; u += lanes) {
+        __m256d value = _mm256_loadu_pd(data + u);
+        __m256d prev = _mm256_loadu_pd(data + u - 1);
+        unsorted = _mm256_or_pd(unsorted,
+                                _mm256_cmp_pd(value, prev, _CMP_NGE_UQ));
+        __m256i cast = _mm256_castpd_si256(value);
+        vmin = _mm256_blendv_epi8(vmin, cast, _mm256_cmpgt_epi64(vmin, cast));
+        vmax = _mm256_blendv_epi8(vmax, cast, _mm256_cmpgt_epi64(cast, vmax));
+      }
+      bool sorted = _mm256_testz_pd(unsorted, unsorted) != 0;
+      for (unsigned lane = 1; lane < lanes; ++lane)
+        sorted &= data[lane] >= data[lane - 1];
+      for (size_t v = u; v < count; ++v)
+        sorted &= data[v] >= data[v - 1];
+      Cast_type lane_min[lanes], lane_max[lanes];
+      _mm256_storeu_si256((__m256i *)lane_min, vmin);
+      _mm256_storeu_si256((__m256i *)lane_max, vmax);
+      min = lane_min[0];
+      max = lane_max[0];
+      for (unsigned lane = 1; lane < lanes; ++lane) {
+        if (lane_min[lane] < min)
+          min = lane_min[lane];
+        if (max < lane_max[lane])
+          max = lane_max[lane];
+      }
+      for (size_t v = u; v < count; ++v) {
+        Cast_type value;
+        std::memcpy(&value, data + v, sizeof(value));
+        if (max < value)
+          max = value;
+        else if (value < min)
+          min = value;
+      }
+      return sorted;
+    }
+#endif
+
+    //Returns 1 if [first, last) is sorted, 0 if not and the extremes were
+    //found, and -1 if there is no vector kernel for this data
+    template <class RandomAccessIter>
+    inline typename boost::disable_if_c<
+      has_integer_kernel<RandomAccessIter>::value, int >::type
+    simd_sorted_or_extremes(RandomAccessIter, RandomAccessIter,
+                            RandomAccessIter &, RandomAccessIter &)
+    {
+      return -1;
+    }
+
+    template <class RandomAccessIter>
+    inline typename boost::enable_if_c<
+      has_integer_kernel<RandomAccessIter>::value, int >::type
+    simd_sorted_or_extremes(RandomAccessIter first, RandomAccessIter last,
+                            RandomAccessIter & max, RandomAccessIter & min)
+    {
+#ifdef BOOST_SORT_SPREADSORT_AVX2
+      const size_t count = last - first;
+      //32-bit lanes hold 32-bit positions
+      if (count >= min_simd_size && has_avx2() &&
+          (sizeof(*first) == 8 || count <= 0x7fffffff)) {
+        size_t max_pos, min_pos;
+        if (avx2_sorted_or_extremes(&(*first), count, max_pos, min_pos))
+          return 1;
+        max = first + max_pos;
+        min = first + min_pos;
+        return 0;
+      }
+#else
+      (void)first; (void)last; (void)max; (void)min;
+#endif
+      return -1;
+    }
+
+    template <class RandomAccessIter, class Cast_type>
+    inline typename boost::disable_if_c<
+      has_float_kernel<RandomAccessIter, Cast_type>::value, int >::type
+    simd_float_sorted_or_extremes(RandomAccessIter, RandomAccessIter,
+                                  Cast_type &, Cast_type &)
+    {
+      return -1;
+    }
+
+    template <class RandomAccessIter, class Cast_type>
+    inline typename boost::enable_if_c<
+      has_float_kernel<RandomAccessIter, Cast_type>::value, int >::type
+    simd_float_sorted_or_extremes(RandomAccessIter first,
+                   RandomAccessIter last, Cast_type & max, Cast_type & min)
+    {
+#ifdef BOOST_SORT_SPREADSORT_AVX2
+      const size_t count = last - first;
+      if (count >= min_simd_size && has_avx2())
+        return avx2_float_sorted_or_extremes(&(*first), count, max, min) ?
+               1 : 0;
+#else
+      (void)first; (void)last; (void)max; (void)min;
+#endif
+      return -1;
+    }
+
+    //Bin counts are kept in this many interleaved tables, so runs of
+    //elements in the same bin increment different counters and don't wait
+    //on each other's stores
+    static const unsigned histogram_tables = 4;
+    //Largest bin count the interleaved tables are used for
+    static const unsigned max_histogram_table_bins = 1 << 12;
+
+    //Counts the elements of each bin with interleaved tables, for integer
+    //keys returned by key(x).
+    //Only used when there are many elements per bin; it returns false when
+    //the plain count should be used instead.
+    template <class RandomAccessIter, class Div_type, class Get_key>
+    inline bool
+    count_bins_interleaved(RandomAccessIter first, RandomAccessIter last,
+                           size_t *bin_sizes, unsigned bin_count,
+                           unsigned log_divisor, Div_type div_min, Get_key key)
+    {
+      const size_t count = last - first;
+      if (bin_count > max_histogram_table_bins ||
+          count < size_t(bin_count) * 16 || count > 0xffffffffu)
+        return false;
+      boost::uint32_t tables[histogram_tables][max_histogram_table_bins];
+      for (unsigned t = 0; t < histogram_tables; ++t)
+        std::memset(tables[t], 0, bin_count * sizeof(boost::uint32_t));
+      RandomAccessIter current = first;
+      for (size_t u = count / histogram_tables; u; --u) {
+        tables[0][size_t((key(current[0]) >> log_divisor) - div_min)]++;
+        tables[1][size_t((key(current[1]) >> log_divisor) - div_min)]++;
+        tables[2][size_t((key(current[2]) >> log_divisor) - div_min)]++;
+        tables[3][size_t((key(current[3]) >> log_divisor) - div_min)]++;
+        current += histogram_tables;
+      }
+      for (; current != last; ++current)
+        tables[0][size_t((key(*current) >> log_divisor) - div_min)]++;
+      for (unsigned u = 0; u < bin_count; ++u)
+        bin_sizes[u] = size_t(tables[0][u]) + tables[1][u] + tables[2][u] +
+                       tables[3][u];
+      return true;
+    }
+
+    //The element itself is the key for integers
+    template <class Data_type>
+    struct identity_key {
+      inline const Data_type & operator()(const Data_type &x) const
+      { return x; }
+    };
+
+    //The integer cast of the bits is the key for floats
+    template <class Data_type, class Cast_type>
+    struct float_cast_key {
+      inline Cast_type operator()(const Data_type &x) const
+      {
+        Cast_type result;
+        std::memcpy(&result, &x, sizeof(Data_type));
+        return result;
+      }
+    };
+
+    //Counts the bin sizes for the plain float variant
+    template <class RandomAccessIter, class Cast_type>
+    inline void
+    count_float_bins(RandomAccessIter first, RandomAccessIter last,
+                     size_t *bin_sizes, unsigned bin_count,
+                     unsigned log_divisor, Cast_type div_min)
+    {
+      typedef typename std::iterator_traits<RandomAccessIter>::value_type
+        Data_type;
+      float_cast_key<Data_type, Cast_type> key;
+      if (count_bins_interleaved(first, last, bin_sizes, bin_count,
+                                 log_divisor, div_min, key))
+        return;
+      for (RandomAccessIter current = first; current != last;)
+        bin_sizes[size_t((key(*(current++)) >> log_divisor) - div_min)]++;
+    }
+
+    //Counts the bin sizes for the plain integer variant
+    template <class RandomAccessIter, class Div_type>
+    inline void
+    count_bins(RandomAccessIter first, RandomAccessIter last,
+               size_t *bin_sizes, unsigned bin_count, unsigned log_divisor,
+               Div_type div_min)
+    {
+      typedef typename std::iterator_traits<RandomAccessIter>::value_type
+        Data_type;
+      if (boost::is_integral<Data_type>::value &&
+          count_bins_interleaved(first, last, bin_sizes, bin_count,
+                                 log_divisor, div_min,
+                                 identity_key<Data_type>()))
+        return;
+      for (RandomAccessIter current = first; current != last;)
+        bin_sizes[size_t((*(current++) >> log_divisor) - div_min)]++;
+    }
+  }
+}
+}
+}
+
+#endif
@@ -0,0 +1,176 @@
+// Details for stable_integer_sort and stable_float_sort.
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort for library home page.
+
+#ifndef BOOST_SORT_SPREADSORT_DETAIL_STABLE_RADIX_SORT_HPP
+#define BOOST_SORT_SPREADSORT_DETAIL_STABLE_RADIX_SORT_HPP
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <vector>
+#include <boost/serialization/static_warning.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <boost/type_traits/conditional.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/sort/spreadsort/detail/constants.hpp>
+#include <boost/sort/spreadsort/detail/integer_sort.hpp>
+#include <boost/sort/spreadsort/detail/radix_select.hpp>
+#include <boost/cstdint.hpp>
+
+namespace boost {
+namespace sort {
+namespace spreadsort {
+  namespace detail {
+    //Right_shift of lsd_sort returning the unsigned key of Get_key
+    template <class Get_key>
+    struct key_shift {
+      typedef typename Get_key::Key_type Key_type;
+      Get_key get_key;
+      key_shift(Get_key key) : get_key(key) {}
+
+      template <class Data_type>
+      inline Key_type operator()(const Data_type &x, unsigned offset)
+      { return get_key(x) >> offset; }
+    };
+
+    //Comparison of the elements by the key of Get_key, for the small ranges
+    template <class Get_key>
+    struct key_less {
+      Get_key get_key;
+      key_less(Get_key key) : get_key(key) {}
+
+      template <class Data_type>
+      inline bool operator()(const Data_type &x, const Data_type &y)
+      { return get_key(x) < get_key(y); }
+    };
+
+    //LSD radix sort by the unsigned key of get_key, which is stable.
+    //Below min_sort_size the histograms cost more than the elements, and
+    //a stable merge sort by the same key is used.
+    template <class RandomAccessIter, class Get_key>
+    inline void
+    stable_radix_sort(RandomAccessIter first, RandomAccessIter last,
+                      Get_key get_key)
+    {
+      typedef typename std::iterator_traits<RandomAccessIter>::value_type
+        Data_type;
+      typedef typename Get_key::Key_type Key_type;
+      if (last - first < min_sort_size) {
+        std::stable_sort(first, last, key_less<Get_key>(get_key));
+        return;
+      }
+      std::vector<Data_type> buffer(last - first);
+      key_shift<Get_key> shift(get_key);
+      lsd_sort<RandomAccessIter, typename std::vector<Data_type>::iterator,
+               Key_type, key_shift<Get_key> >(first, last, buffer.begin(),
+                                              shift);
+    }
+
+    //Integer keys that fit in a uintmax_t
+    template <class RandomAccessIter, class Div_type, class Right_shift>
+    inline typename boost::enable_if_c< boost::is_integral<Div_type>::value
+      && sizeof(Div_type) <= sizeof(boost::uintmax_t), void >::type
+    stable_integer_sort(RandomAccessIter first, RandomAccessIter last,
+                        Div_type, Right_shift shift)
+    {
+      stable_radix_sort(first, last,
+                        integer_select_key<Div_type, Right_shift>(shift));
+    }
+
+    //defaulting to std::stable_sort by the key when it isn't an integer
+    template <class RandomAccessIter, class Div_type, class Right_shift>
+    inline typename boost::disable_if_c< boost::is_integral<Div_type>::value
+      && sizeof(Div_type) <= sizeof(boost::uintmax_t), void >::type
+    stable_integer_sort(RandomAccessIter first, RandomAccessIter last,
+                        Div_type, Right_shift shift)
+    {
+      BOOST_STATIC_WARNING(boost::is_integral<Div_type>::value
+        && sizeof(Div_type) <= sizeof(boost::uintmax_t));
+      std::stable_sort(first, last, shift_less<Right_shift>(shift));
+    }
+
+    //Without a Right_shift functor, the key is the element
+    template <class RandomAccessIter, class Div_type>
+    inline void
+    stable_integer_sort(RandomAccessIter first, RandomAccessIter last,
+                        Div_type key)
+    {
+      typedef typename std::iterator_traits<RandomAccessIter>::value_type
+        Data_type;
+      stable_integer_sort(first, last, key,
+                          shift_operator<Data_type, Div_type>());
+    }
+
+    //Floats cast to integers that fit in a uintmax_t
+    template <class RandomAccessIter, class Div_type, class Right_shift>
+    inline typename boost::enable_if_c< boost::is_integral<Div_type>::value
+      && sizeof(Div_type) <= sizeof(boost::uintmax_t), void >::type
+    stable_float_sort(RandomAccessIter first, RandomAccessIter last,
+                      Div_type, Right_shift shift)
+    {
+      stable_radix_sort(first, last,
+                        float_select_key<Div_type, Right_shift>(shift));
+    }
+
+    //defaulting to std::stable_sort when stable_float_sort won't work
+    template <class RandomAccessIter, class Div_type, class Right_shift>
+    inline typename boost::disable_if_c< boost::is_integral<Div_type>::value
+      && sizeof(Div_type) <= sizeof(boost::uintmax_t), void >::type
+    stable_float_sort(RandomAccessIter first, RandomAccessIter last,
+                      Div_type, Right_shift)
+    {
+      BOOST_STATIC_WARNING(boost::is_integral<Div_type>::value
+        && sizeof(Div_type) <= sizeof(boost::uintmax_t));
+      std::stable_sort(first, last);
+    }
+
+    //Checking whether the value type is a float, and casting it to a 32-bit
+    //integer, or a double, and casting it to a 64-bit integer
+    template <class RandomAccessIter>
+    inline typename boost::enable_if_c< (sizeof(boost::uint32_t) ==
+      sizeof(typename std::iterator_traits<RandomAccessIter>::value_type)
+      || sizeof(boost::uint64_t) ==
+      sizeof(typename std::iterator_traits<RandomAccessIter>::value_type))
+      && std::numeric_limits<typename
+      std::iterator_traits<RandomAccessIter>::value_type>::is_iec559,
+      void >::type
+    stable_float_sort(RandomAccessIter first, RandomAccessIter last)
+    {
+      typedef typename std::iterator_traits<RandomAccessIter>::value_type
+        Data_type;
+      typedef typename boost::conditional<
+        sizeof(Data_type) == sizeof(boost::uint32_t),
+        boost::int32_t, boost::int64_t>::type Cast_type;
+      stable_float_sort(first, last, Cast_type(),
+                        float_cast_shift<Data_type, Cast_type>());
+    }
+
+    template <class RandomAccessIter>
+    inline typename boost::disable_if_c< (sizeof(boost::uint32_t) ==
+      sizeof(typename std::iterator_traits<RandomAccessIter>::value_type)
+      || sizeof(boost::uint64_t) ==
+      sizeof(typename std::iterator_traits<RandomAccessIter>::value_type))
+      && std::numeric_limits<typename
+      std::iterator_traits<RandomAccessIter>::value_type>::is_iec559,
+      void >::type
+    stable_float_sort(RandomAccessIter first, RandomAccessIter last)
+    {
+      BOOST_STATIC_WARNING(!(sizeof(boost::uint64_t) ==
+      sizeof(typename std::iterator_traits<RandomAccessIter>::value_type)
+      || sizeof(boost::uint32_t) ==
+      sizeof(typename std::iterator_traits<RandomAccessIter>::value_type))
+      || !std::numeric_limits<typename
+      std::iterator_traits<RandomAccessIter>::value_type>::is_iec559);
+      std::stable_sort(first, last);
+    }
+  }
+}
+}
+}
+
+#endif
@@ -156,22 +156,25 @@ namespace spreadsort {
       Get_length length;
     };
 
-    //String sorting recursive implementation
+    //Splits the strings into bins on the first character past char_offset
+    //that they don't all share, and returns false if they are all empty.
+    //char_offset is advanced to that character; bin_cache[cache_offset] is
+    //left at the end of the empties, followed by the end of each character
+    //bin up to bin_cache[cache_offset + last_bin + 1].
     template <class RandomAccessIter, class Unsigned_char_type>
-    inline void
-    string_sort_rec(RandomAccessIter first, RandomAccessIter last,
-                    size_t char_offset,
-                    std::vector<RandomAccessIter> &bin_cache,
-                    unsigned cache_offset, size_t *bin_sizes)
+    inline bool
+    string_split_bins(RandomAccessIter first, RandomAccessIter last,
+                      size_t &char_offset,
+                      std::vector<RandomAccessIter> &bin_cache,
+                      unsigned cache_offset, size_t *bin_sizes,
+                      unsigned &cache_end, unsigned &last_bin)
     {
-      typedef typename std::iterator_traits<RandomAccessIter>::value_type
-        Data_type;
       //This section makes handling of long identical substrings much faster
       //with a mild average performance impact.
       //Iterate to the end of the empties.  If all empty, return
       while ((*first).size() <= char_offset) {
         if (++first == last)
-          return;
+          return false;
       }
       RandomAccessIter finish = last - 1;
       //Getting the last non-empty
@@ -183,10 +186,7 @@ namespace spreadsort {
                                                           char_offset);
       
       const unsigned bin_count = (1 << (sizeof(Unsigned_char_type)*8));
-      //Equal worst-case of radix and comparison is when bin_count = n*log(n).
-      const unsigned max_size = bin_count;
       const unsigned membin_count = bin_count + 1;
-      unsigned cache_end;
       RandomAccessIter * bins = size_bins(bin_sizes, bin_cache, cache_offset,
                                           cache_end, membin_count) + 1;
 
@@ -224,7 +224,7 @@ namespace spreadsort {
       *local_bin = next_bin_start;
       //iterate backwards to find the last bin with elements in it
       //this saves iterations in multiple loops
-      unsigned last_bin = bin_count - 1;
+      last_bin = bin_count - 1;
       for (; last_bin && !bin_sizes[last_bin + 1]; --last_bin);
       //This dominates runtime, mostly in the swap and bin lookups
       for (unsigned u = 0; u < last_bin; ++u) {
@@ -242,6 +242,26 @@ namespace spreadsort {
         *local_bin = next_bin_start;
       }
       bins[last_bin] = last;
+      return true;
+    }
+
+    //String sorting recursive implementation
+    template <class RandomAccessIter, class Unsigned_char_type>
+    inline void
+    string_sort_rec(RandomAccessIter first, RandomAccessIter last,
+                    size_t char_offset,
+                    std::vector<RandomAccessIter> &bin_cache,
+                    unsigned cache_offset, size_t *bin_sizes)
+    {
+      typedef typename std::iterator_traits<RandomAccessIter>::value_type
+        Data_type;
+      //Equal worst-case of radix and comparison is when bin_count = n*log(n).
+      const unsigned max_size = (1 << (sizeof(Unsigned_char_type)*8));
+      unsigned cache_end, last_bin;
+      if (!string_split_bins<RandomAccessIter, Unsigned_char_type>(first, last,
+            char_offset, bin_cache, cache_offset, bin_sizes, cache_end,
+            last_bin))
+        return;
       //Recursing
       RandomAccessIter lastPos = bin_cache[cache_offset];
       //Skip this loop for empties
@@ -686,10 +706,13 @@ namespace spreadsort {
     inline typename boost::enable_if_c< sizeof(Unsigned_char_type) <= 2, void
                                                                       >::type
     string_sort(RandomAccessIter first, RandomAccessIter last,
-                Unsigned_char_type)
+                Unsigned_char_type,
+                spreadsort_context<RandomAccessIter> *context = 0)
     {
       size_t bin_sizes[(1 << (8 * sizeof(Unsigned_char_type))) + 1];
-      std::vector<RandomAccessIter> bin_cache;
+      std::vector<RandomAccessIter> local_cache;
+      std::vector<RandomAccessIter> &bin_cache =
+        context ? context->bin_cache() : local_cache;
       string_sort_rec<RandomAccessIter, Unsigned_char_type>
         (first, last, 0, bin_cache, 0, bin_sizes);
     }
@@ -698,7 +721,7 @@ namespace spreadsort {
     inline typename boost::disable_if_c< sizeof(Unsigned_char_type) <= 2, void
                                                                        >::type
     string_sort(RandomAccessIter first, RandomAccessIter last,
-                Unsigned_char_type)
+                Unsigned_char_type, spreadsort_context<RandomAccessIter> * = 0)
     {
       //Warning that we're using boost::sort::pdqsort, even though string_sort was called
       BOOST_STATIC_WARNING( sizeof(Unsigned_char_type) <= 2 );
@@ -710,10 +733,13 @@ namespace spreadsort {
     inline typename boost::enable_if_c< sizeof(Unsigned_char_type) <= 2, void
                                                                       >::type
     reverse_string_sort(RandomAccessIter first, RandomAccessIter last,
-                        Unsigned_char_type)
+                        Unsigned_char_type,
+                        spreadsort_context<RandomAccessIter> *context = 0)
     {
       size_t bin_sizes[(1 << (8 * sizeof(Unsigned_char_type))) + 1];
-      std::vector<RandomAccessIter> bin_cache;
+      std::vector<RandomAccessIter> local_cache;
+      std::vector<RandomAccessIter> &bin_cache =
+        context ? context->bin_cache() : local_cache;
       reverse_string_sort_rec<RandomAccessIter, Unsigned_char_type>
         (first, last, 0, bin_cache, 0, bin_sizes);
     }
@@ -722,7 +748,7 @@ namespace spreadsort {
     inline typename boost::disable_if_c< sizeof(Unsigned_char_type) <= 2, void
                                                                        >::type
     reverse_string_sort(RandomAccessIter first, RandomAccessIter last,
-                Unsigned_char_type)
+                Unsigned_char_type, spreadsort_context<RandomAccessIter> * = 0)
     {
       typedef typename std::iterator_traits<RandomAccessIter>::value_type
         Data_type;
@@ -737,10 +763,13 @@ namespace spreadsort {
     inline typename boost::enable_if_c< sizeof(Unsigned_char_type) <= 2, void
                                                                       >::type
     string_sort(RandomAccessIter first, RandomAccessIter last,
-                Get_char get_character, Get_length length, Unsigned_char_type)
+                Get_char get_character, Get_length length, Unsigned_char_type,
+                spreadsort_context<RandomAccessIter> *context = 0)
     {
       size_t bin_sizes[(1 << (8 * sizeof(Unsigned_char_type))) + 1];
-      std::vector<RandomAccessIter> bin_cache;
+      std::vector<RandomAccessIter> local_cache;
+      std::vector<RandomAccessIter> &bin_cache =
+        context ? context->bin_cache() : local_cache;
       string_sort_rec<RandomAccessIter, Unsigned_char_type, Get_char,
         Get_length>(first, last, 0, bin_cache, 0, bin_sizes, get_character, length);
     }
@@ -750,7 +779,8 @@ namespace spreadsort {
     inline typename boost::disable_if_c< sizeof(Unsigned_char_type) <= 2, void
                                                                        >::type
     string_sort(RandomAccessIter first, RandomAccessIter last,
-                Get_char get_character, Get_length length, Unsigned_char_type)
+                Get_char get_character, Get_length length, Unsigned_char_type,
+                spreadsort_context<RandomAccessIter> * = 0)
     {
       //Warning that we're using boost::sort::pdqsort, even though string_sort was called
       BOOST_STATIC_WARNING( sizeof(Unsigned_char_type) <= 2 );
@@ -763,10 +793,13 @@ namespace spreadsort {
     inline typename boost::enable_if_c< sizeof(Unsigned_char_type) <= 2, void
                                                                       >::type
     string_sort(RandomAccessIter first, RandomAccessIter last,
-        Get_char get_character, Get_length length, Compare comp, Unsigned_char_type)
+        Get_char get_character, Get_length length, Compare comp, Unsigned_char_type,
+        spreadsort_context<RandomAccessIter> *context = 0)
     {
       size_t bin_sizes[(1 << (8 * sizeof(Unsigned_char_type))) + 1];
-      std::vector<RandomAccessIter> bin_cache;
+      std::vector<RandomAccessIter> local_cache;
+      std::vector<RandomAccessIter> &bin_cache =
+        context ? context->bin_cache() : local_cache;
       string_sort_rec<RandomAccessIter, Unsigned_char_type, Get_char
         , Get_length, Compare>
         (first, last, 0, bin_cache, 0, bin_sizes, get_character, length, comp);
@@ -778,7 +811,8 @@ namespace spreadsort {
     inline typename boost::enable_if_c< (sizeof(Unsigned_char_type) > 2), void
                                         >::type
     string_sort(RandomAccessIter first, RandomAccessIter last,
-        Get_char get_character, Get_length length, Compare comp, Unsigned_char_type)
+        Get_char get_character, Get_length length, Compare comp, Unsigned_char_type,
+        spreadsort_context<RandomAccessIter> * = 0)
     {
       //Warning that we're using boost::sort::pdqsort, even though string_sort was called
       BOOST_STATIC_WARNING( sizeof(Unsigned_char_type) <= 2 );
@@ -791,10 +825,13 @@ namespace spreadsort {
     inline typename boost::enable_if_c< sizeof(Unsigned_char_type) <= 2, void
                                                                       >::type
     reverse_string_sort(RandomAccessIter first, RandomAccessIter last,
-        Get_char get_character, Get_length length, Compare comp, Unsigned_char_type)
+        Get_char get_character, Get_length length, Compare comp, Unsigned_char_type,
+        spreadsort_context<RandomAccessIter> *context = 0)
     {
       size_t bin_sizes[(1 << (8 * sizeof(Unsigned_char_type))) + 1];
-      std::vector<RandomAccessIter> bin_cache;
+      std::vector<RandomAccessIter> local_cache;
+      std::vector<RandomAccessIter> &bin_cache =
+        context ? context->bin_cache() : local_cache;
       reverse_string_sort_rec<RandomAccessIter, Unsigned_char_type, Get_char,
                               Get_length, Compare>
         (first, last, 0, bin_cache, 0, bin_sizes, get_character, length, comp);
@@ -805,7 +842,8 @@ namespace spreadsort {
     inline typename boost::disable_if_c< sizeof(Unsigned_char_type) <= 2, void
                                                                        >::type
     reverse_string_sort(RandomAccessIter first, RandomAccessIter last,
-        Get_char get_character, Get_length length, Compare comp, Unsigned_char_type)
+        Get_char get_character, Get_length length, Compare comp, Unsigned_char_type,
+        spreadsort_context<RandomAccessIter> * = 0)
     {
       //Warning that we're using boost::sort::pdqsort, even though string_sort was called
       BOOST_STATIC_WARNING( sizeof(Unsigned_char_type) <= 2 );
@@ -0,0 +1,113 @@
+// Details for integer_tag_sort, which sorts (key, index) tags of the elements.
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort for library home page.
+
+#ifndef BOOST_SORT_SPREADSORT_DETAIL_TAG_SORT_HPP
+#define BOOST_SORT_SPREADSORT_DETAIL_TAG_SORT_HPP
+#include <iterator>
+#include <limits>
+#include <vector>
+#include <boost/move/utility_core.hpp>
+#include <boost/sort/spreadsort/integer_sort.hpp>
+#include <boost/cstdint.hpp>
+
+namespace boost {
+namespace sort {
+namespace spreadsort {
+  namespace detail {
+    //Key of an element, with its position before the sort
+    template <class Div_type, class Index_type>
+    struct sort_tag {
+      Div_type key;
+      Index_type index;
+    };
+
+    //Right_shift and comparison of the tags, by their keys
+    template <class Div_type, class Index_type>
+    struct tag_shift {
+      inline Div_type operator()(const sort_tag<Div_type, Index_type> &x,
+                                 unsigned offset) const
+      { return x.key >> offset; }
+    };
+
+    template <class Div_type, class Index_type>
+    struct tag_less {
+      inline bool operator()(const sort_tag<Div_type, Index_type> &x,
+                             const sort_tag<Div_type, Index_type> &y) const
+      { return x.key < y.key; }
+    };
+
+    //Fills tags with the keys and positions of [first, first + count)
+    template <class RandomAccessIter, class Right_shift, class Tag_iter>
+    inline void
+    make_tags(RandomAccessIter first, size_t start, size_t count,
+              Right_shift rshift, Tag_iter tags)
+    {
+      for (size_t u = start; u < start + count; ++u, ++tags) {
+        tags->key = rshift(*(first + u), 0);
+        tags->index = u;
+      }
+    }
+
+    //Moves the elements to their sorted positions: tags[u].index is the
+    //original position of the element which goes in position u.  Each cycle
+    //of the permutation is followed once, keeping its first element aside,
+    //so every element is moved once, plus one move per cycle.
+    template <class RandomAccessIter, class Tag_iter>
+    inline void
+    apply_tags(RandomAccessIter first, Tag_iter tags, size_t count)
+    {
+      typedef typename std::iterator_traits<RandomAccessIter>::value_type
+        Data_type;
+      for (size_t start = 0; start < count; ++start) {
+        if (size_t(tags[start].index) == start)
+          continue;
+        Data_type tmp = boost::move(*(first + start));
+        size_t dest = start, source;
+        while ((source = size_t(tags[dest].index)) != start) {
+          *(first + dest) = boost::move(*(first + source));
+          tags[dest].index = dest;
+          dest = source;
+        }
+        *(first + dest) = boost::move(tmp);
+        tags[dest].index = dest;
+      }
+    }
+
+    template <class RandomAccessIter, class Div_type, class Right_shift,
+              class Index_type>
+    inline void
+    integer_tag_sort(RandomAccessIter first, RandomAccessIter last,
+                     Right_shift rshift, Index_type)
+    {
+      typedef sort_tag<Div_type, Index_type> Tag;
+      std::vector<Tag> tags(last - first);
+      make_tags(first, 0, tags.size(), rshift, tags.begin());
+      boost::sort::spreadsort::integer_sort(tags.begin(), tags.end(),
+        tag_shift<Div_type, Index_type>(), tag_less<Div_type, Index_type>());
+      apply_tags(first, tags.begin(), tags.size());
+    }
+
+    //The index is 32 bits when it's enough, for the tags to be smaller
+    template <class RandomAccessIter, class Div_type, class Right_shift>
+    inline void
+    integer_tag_sort(RandomAccessIter first, RandomAccessIter last, Div_type,
+                     Right_shift rshift)
+    {
+      if (size_t(last - first) <= (std::numeric_limits<boost::uint32_t>::max)())
+        integer_tag_sort<RandomAccessIter, Div_type>(first, last, rshift,
+                                                     boost::uint32_t());
+      else
+        integer_tag_sort<RandomAccessIter, Div_type>(first, last, rshift,
+                                                     size_t());
+    }
+  }
+}
+}
+}
+
+#endif
@@ -0,0 +1,95 @@
+//Templated Spreadsort-based implementation of float_select
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort/ for library home page.
+
+#ifndef BOOST_FLOAT_SELECT_HPP
+#define BOOST_FLOAT_SELECT_HPP
+#include <algorithm>
+#include <boost/sort/spreadsort/detail/constants.hpp>
+#include <boost/sort/spreadsort/detail/radix_select.hpp>
+#include <boost/sort/pdqsort/pdqselect.hpp>
+
+namespace boost {
+namespace sort {
+namespace spreadsort {
+
+  /*!
+    \brief Floating-point selection algorithm using random access iterators, with casting to the appropriate size.
+
+    \details @c float_select rearranges the elements so that the element pointed by @c nth is
+    the element that would be there if [@c first, @c last) were sorted, all the elements before it
+    are not greater, and all the elements after it are not smaller. As @c float_sort, it casts
+    the floats to integers of the same size, and, as @c integer_select, it narrows large ranges
+    with a sample and then keeps in each iteration only the bin which contains @c nth.
+    Falls back to @c boost::sort::nth_element if the data size is too small, < @c detail::min_sort_size,
+    or if the value type isn't an IEEE 754 float or double.
+
+    \param[in] first Iterator pointer to first element.
+    \param[in] nth Iterator pointing to the element to select.
+    \param[in] last Iterator pointing to one beyond the end of data.
+
+    \pre [@c first, @c last) is a valid range, and @c nth is in it.
+    \post @c *nth is the element of its position in sorted order, and [@c first, @c last) is partitioned around it.
+    \warning NaNs have no position in sorted order, and cause undefined behaviour.
+  */
+  template <class RandomAccessIter>
+  inline void float_select(RandomAccessIter first, RandomAccessIter nth,
+                           RandomAccessIter last)
+  {
+    if (last - first < detail::min_sort_size)
+      boost::sort::nth_element(first, nth, last);
+    else
+      detail::float_select(first, nth, last);
+  }
+
+  /*!
+    \brief Floating-point selection algorithm using random access iterators with just right-shift functor.
+
+    \param[in] first Iterator pointer to first element.
+    \param[in] nth Iterator pointing to the element to select.
+    \param[in] last Iterator pointing to one beyond the end of data.
+    \param[in] rshift Functor that returns the result of shifting the value_type right a specified number of bits.
+
+  */
+  template <class RandomAccessIter, class Right_shift>
+  inline void float_select(RandomAccessIter first, RandomAccessIter nth,
+                           RandomAccessIter last, Right_shift rshift)
+  {
+    typedef typename std::iterator_traits<RandomAccessIter>::value_type
+      Data_type;
+    if (last - first < detail::min_sort_size)
+      boost::sort::nth_element(first, nth, last);
+    else
+      detail::float_select(first, nth, last, rshift(*first, 0), rshift,
+                           std::less<Data_type>());
+  }
+
+  /*!
+   \brief Floating-point selection algorithm using random access iterators with both right-shift and user-defined comparison operator.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] nth Iterator pointing to the element to select.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] rshift Functor that returns the result of shifting the value_type right a specified number of bits.
+   \param[in] comp A binary functor that returns whether the first element passed to it should go before the second in order.
+  */
+  template <class RandomAccessIter, class Right_shift, class Compare>
+  inline void float_select(RandomAccessIter first, RandomAccessIter nth,
+                           RandomAccessIter last, Right_shift rshift,
+                           Compare comp)
+  {
+    if (last - first < detail::min_sort_size)
+      boost::sort::nth_element(first, nth, last, comp);
+    else
+      detail::float_select(first, nth, last, rshift(*first, 0), rshift,
+                           comp);
+  }
+}
+}
+}
+
+#endif
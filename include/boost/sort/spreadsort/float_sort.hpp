@@ -22,6 +22,7 @@ Scott McMurray
 #include <limits>
 #include <boost/static_assert.hpp>
 #include <boost/sort/spreadsort/detail/constants.hpp>
+#include <boost/sort/spreadsort/tuning.hpp>
 #include <boost/sort/spreadsort/detail/float_sort.hpp>
 #include <boost/range/begin.hpp>
 #include <boost/range/end.hpp>
@@ -86,10 +87,33 @@ Some performance plots of runtime vs. n and log(range) are provided:\n
   template <class RandomAccessIter>
   inline void float_sort(RandomAccessIter first, RandomAccessIter last)
   {
-    if (last - first < detail::min_sort_size)
+    if (size_t(last - first) < current_tuning().min_sort_size)
       boost::sort::pdqsort(first, last);
     else
-      detail::float_sort(first, last);
+      detail::float_sort<detail::float_tuning>(first, last);
+  }
+
+  /*!
+    \brief Floating-point sort algorithm using random access iterators and a reusable @c spreadsort_context.
+
+    \details Same as @c float_sort(first, last), but the bin positions are kept
+    in @c context instead of in memory allocated by the call, so sorting many
+    ranges with the same context doesn't allocate memory in each sort.
+
+    \param[in] first Iterator pointer to first element.
+    \param[in] last Iterator pointing to one beyond the end of data.
+    \param[in,out] context Scratch space reused across calls.
+
+    \warning The context must not be used by another sort at the same time.
+  */
+  template <class RandomAccessIter>
+  inline void float_sort(RandomAccessIter first, RandomAccessIter last,
+                         spreadsort_context<RandomAccessIter> &context)
+  {
+    if (size_t(last - first) < current_tuning().min_sort_size)
+      boost::sort::pdqsort(first, last);
+    else
+      detail::float_sort<detail::float_tuning>(first, last, &context);
   }
 
     /*!
@@ -116,10 +140,11 @@ Some performance plots of runtime vs. n and log(range) are provided:\n
   inline void float_sort(RandomAccessIter first, RandomAccessIter last,
                          Right_shift rshift)
   {
-    if (last - first < detail::min_sort_size)
+    if (size_t(last - first) < current_tuning().min_sort_size)
       boost::sort::pdqsort(first, last);
     else
-      detail::float_sort(first, last, rshift(*first, 0), rshift);
+      detail::float_sort<detail::float_tuning>(first, last, rshift(*first, 0),
+                                               rshift);
   }
 
     /*!
@@ -149,10 +174,34 @@ Some performance plots of runtime vs. n and log(range) are provided:\n
   inline void float_sort(RandomAccessIter first, RandomAccessIter last,
                          Right_shift rshift, Compare comp)
   {
-    if (last - first < detail::min_sort_size)
+    if (size_t(last - first) < current_tuning().min_sort_size)
       boost::sort::pdqsort(first, last, comp);
     else
-      detail::float_sort(first, last, rshift(*first, 0), rshift, comp);
+      detail::float_sort<detail::float_tuning>(first, last, rshift(*first, 0),
+                                               rshift, comp);
+  }
+
+  /*!
+    \brief Float sort algorithm using random access iterators with both right-shift and user-defined comparison operator, and a reusable @c spreadsort_context.
+
+    \param[in] first Iterator pointer to first element.
+    \param[in] last Iterator pointing to one beyond the end of data.
+    \param[in] rshift Functor that returns the result of shifting the value_type right a specified number of bits.
+    \param[in] comp A binary functor that returns whether the first element passed to it should go before the second in order.
+    \param[in,out] context Scratch space reused across calls.
+
+    \warning The context must not be used by another sort at the same time.
+  */
+  template <class RandomAccessIter, class Right_shift, class Compare>
+  inline void float_sort(RandomAccessIter first, RandomAccessIter last,
+                         Right_shift rshift, Compare comp,
+                         spreadsort_context<RandomAccessIter> &context)
+  {
+    if (size_t(last - first) < current_tuning().min_sort_size)
+      boost::sort::pdqsort(first, last, comp);
+    else
+      detail::float_sort<detail::float_tuning>(first, last, rshift(*first, 0),
+                                               rshift, comp, &context);
   }
 
 
@@ -169,6 +218,70 @@ Some performance plots of runtime vs. n and log(range) are provided:\n
   {
       float_sort(boost::begin(range), boost::end(range), rshift, comp);
   }
+
+  /*!
+    \brief @c float_sort with casting to the appropriate size, with the compile-time tuning values of a @c tuning_policy.
+
+    \details Same as @c float_sort(first, last), called as @c float_sort<Tuning>(first, last),
+    but the tuning values are those of @c Tuning instead of @c current_tuning(),
+    so a call site can be tuned for the data it sorts without affecting the other sorts.
+    Falls back to @c boost::sort::pdqsort below @c Tuning::min_sort_size().
+
+    \tparam Tuning A @c tuning_policy.
+    \param[in] first Iterator pointer to first element.
+    \param[in] last Iterator pointing to one beyond the end of data.
+  */
+  template <class Tuning, class RandomAccessIter>
+  inline typename boost::enable_if_c< detail::is_tuning_policy<Tuning>::value,
+                                      void >::type
+  float_sort(RandomAccessIter first, RandomAccessIter last)
+  {
+    if (size_t(last - first) < Tuning::min_sort_size())
+      boost::sort::pdqsort(first, last);
+    else
+      detail::float_sort<Tuning>(first, last);
+  }
+
+  /*!
+    \brief Floating-point sort algorithm using random access iterators with just right-shift functor, with the compile-time tuning values of a @c tuning_policy.
+
+    \tparam Tuning A @c tuning_policy.
+    \param[in] first Iterator pointer to first element.
+    \param[in] last Iterator pointing to one beyond the end of data.
+    \param[in] rshift Functor that returns the result of shifting the value_type right a specified number of bits.
+  */
+  template <class Tuning, class RandomAccessIter, class Right_shift>
+  inline typename boost::enable_if_c< detail::is_tuning_policy<Tuning>::value,
+                                      void >::type
+  float_sort(RandomAccessIter first, RandomAccessIter last, Right_shift rshift)
+  {
+    if (size_t(last - first) < Tuning::min_sort_size())
+      boost::sort::pdqsort(first, last);
+    else
+      detail::float_sort<Tuning>(first, last, rshift(*first, 0), rshift);
+  }
+
+  /*!
+    \brief Float sort algorithm using random access iterators with both right-shift and user-defined comparison operator, with the compile-time tuning values of a @c tuning_policy.
+
+    \tparam Tuning A @c tuning_policy.
+    \param[in] first Iterator pointer to first element.
+    \param[in] last Iterator pointing to one beyond the end of data.
+    \param[in] rshift Functor that returns the result of shifting the value_type right a specified number of bits.
+    \param[in] comp A binary functor that returns whether the first element passed to it should go before the second in order.
+  */
+  template <class Tuning, class RandomAccessIter, class Right_shift,
+            class Compare>
+  inline typename boost::enable_if_c< detail::is_tuning_policy<Tuning>::value,
+                                      void >::type
+  float_sort(RandomAccessIter first, RandomAccessIter last, Right_shift rshift,
+             Compare comp)
+  {
+    if (size_t(last - first) < Tuning::min_sort_size())
+      boost::sort::pdqsort(first, last, comp);
+    else
+      detail::float_sort<Tuning>(first, last, rshift(*first, 0), rshift, comp);
+  }
 }
 }
 }
@@ -0,0 +1,122 @@
+//Templated Spreadsort-based implementation of integer_select
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort/ for library home page.
+
+#ifndef BOOST_INTEGER_SELECT_HPP
+#define BOOST_INTEGER_SELECT_HPP
+#include <algorithm>
+#include <boost/sort/spreadsort/detail/constants.hpp>
+#include <boost/sort/spreadsort/detail/radix_select.hpp>
+#include <boost/sort/pdqsort/pdqselect.hpp>
+
+namespace boost {
+namespace sort {
+namespace spreadsort {
+
+/*! \brief Integer selection algorithm using random access iterators.
+  (All variants fall back to @c boost::sort::nth_element if the data size is too small, < @c detail::min_sort_size).
+
+  \details @c integer_select rearranges the elements so that the element pointed by @c nth is the
+element that would be there if [@c first, @c last) were sorted, all the elements before it are not
+greater, and all the elements after it are not smaller.\n
+Ranges of at least @c detail::min_sample_size elements are first narrowed to the few percent of them
+around @c nth, with two pivots taken from a sample and one or two partitions.
+Each iteration then counts the elements of each bin of the @c integer_sort bins, and keeps only the bin
+which contains @c nth, moving the elements of the lower bins before it and those of the higher bins
+after it, so each iteration reads the elements twice and moves each element at most once.
+Bins smaller than @c detail::min_sort_size are finished with @c boost::sort::nth_element.\n
+On random data it runs within about 15% of @c boost::sort::nth_element, and faster at the median of 64-bit keys;
+its advantage is that the number of iterations is bounded by the key size, whatever the distribution.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] nth Iterator pointing to the element to select.
+   \param[in] last Iterator pointing to one beyond the end of data.
+
+   \pre [@c first, @c last) is a valid range, and @c nth is in it.
+   \pre @c RandomAccessIter @c value_type is mutable.
+   \pre @c RandomAccessIter @c value_type is <a href="http://en.cppreference.com/w/cpp/concept/LessThanComparable">LessThanComparable</a>
+   \pre @c RandomAccessIter @c value_type supports the @c operator>>,
+   which returns an integer-type right-shifted a specified number of bits.
+   \post @c *nth is the element of its position in sorted order, and [@c first, @c last) is partitioned around it.
+
+   \throws std::exception Propagates exceptions if any of the element comparisons, the element swaps (or moves),
+   the right shift, functors, or any operations on iterators throw.
+
+   \warning Throwing an exception may cause data loss.
+   \warning Invalid arguments cause undefined behaviour.
+
+   \remark <em> O(N * K/S) </em> operations worst-case, where:
+   \remark  *  N is @c last - @c first,
+   \remark  *  K is the log of the range in bits (32 for 32-bit integers using their full range),
+   \remark  *  S is a constant called max_splits, defaulting to 11.
+*/
+  template <class RandomAccessIter>
+  inline void integer_select(RandomAccessIter first, RandomAccessIter nth,
+                             RandomAccessIter last)
+  {
+    if (last - first < detail::min_sort_size)
+      boost::sort::nth_element(first, nth, last);
+    else
+      detail::integer_select(first, nth, last, *first >> 0);
+  }
+
+/*! \brief Integer selection algorithm using random access iterators with just right-shift functor.
+
+  \details Same as @c integer_select(first, nth, last), with the integer key returned by @c rshift.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] nth Iterator pointing to the element to select.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] rshift Functor that returns the result of shifting the value_type right a specified number of bits.
+
+   \pre [@c first, @c last) is a valid range, and @c nth is in it.
+   \pre @c RandomAccessIter @c value_type is <a href="http://en.cppreference.com/w/cpp/concept/LessThanComparable">LessThanComparable</a>
+   \post @c *nth is the element of its position in sorted order, and [@c first, @c last) is partitioned around it.
+*/
+  template <class RandomAccessIter, class Right_shift>
+  inline void integer_select(RandomAccessIter first, RandomAccessIter nth,
+                             RandomAccessIter last, Right_shift rshift)
+  {
+    typedef typename std::iterator_traits<RandomAccessIter>::value_type
+      Data_type;
+    if (last - first < detail::min_sort_size)
+      boost::sort::nth_element(first, nth, last);
+    else
+      detail::integer_select(first, nth, last, rshift(*first, 0), rshift,
+                             std::less<Data_type>());
+  }
+
+/*! \brief Integer selection algorithm using random access iterators with both right-shift and user-defined comparison operator.
+
+  \details Same as @c integer_select(first, nth, last), with the integer key returned by @c rshift.
+  The order of the keys must be the order of @c comp.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] nth Iterator pointing to the element to select.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] rshift Functor that returns the result of shifting the value_type right a specified number of bits.
+   \param[in] comp A binary functor that returns whether the first element passed to it should go before the second in order.
+
+   \pre [@c first, @c last) is a valid range, and @c nth is in it.
+   \post @c *nth is the element of its position in sorted order, and [@c first, @c last) is partitioned around it.
+*/
+  template <class RandomAccessIter, class Right_shift, class Compare>
+  inline void integer_select(RandomAccessIter first, RandomAccessIter nth,
+                             RandomAccessIter last, Right_shift rshift,
+                             Compare comp)
+  {
+    if (last - first < detail::min_sort_size)
+      boost::sort::nth_element(first, nth, last, comp);
+    else
+      detail::integer_select(first, nth, last, rshift(*first, 0), rshift,
+                             comp);
+  }
+}
+}
+}
+
+#endif
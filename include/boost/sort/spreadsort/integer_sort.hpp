@@ -23,6 +23,7 @@ Doxygen comments by Paul A. Bristow Jan 2015
 #include <limits>
 #include <boost/static_assert.hpp>
 #include <boost/sort/spreadsort/detail/constants.hpp>
+#include <boost/sort/spreadsort/tuning.hpp>
 #include <boost/sort/spreadsort/detail/integer_sort.hpp>
 #include <boost/range/begin.hpp>
 #include <boost/range/end.hpp>
@@ -34,7 +35,7 @@ namespace spreadsort {
 
 
 /*! \brief Integer sort algorithm using random access iterators.
-  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c detail::min_sort_size).
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
 
   \details @c integer_sort is a fast templated in-place hybrid radix/comparison algorithm,
 which in testing tends to be roughly 50% to 2X faster than @c std::sort for large tests (>=100kB).\n
@@ -76,14 +77,50 @@ Some performance plots of runtime vs. n and log(range) are provided:\n
   inline void integer_sort(RandomAccessIter first, RandomAccessIter last)
   {
     // Don't sort if it's too small to optimize.
-    if (last - first < detail::min_sort_size)
+    if (size_t(last - first) < current_tuning().min_sort_size)
       boost::sort::pdqsort(first, last);
     else
-      detail::integer_sort(first, last, *first >> 0);
+      detail::integer_sort<detail::int_tuning>(first, last, *first >> 0);
+  }
+
+/*! \brief Integer sort algorithm using random access iterators and a reusable @c spreadsort_context.
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
+
+  \details Same as @c integer_sort(first, last), but the bin positions are kept
+in @c context instead of in memory allocated by the call, so sorting many
+ranges with the same context doesn't allocate memory in each sort.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in,out] context Scratch space reused across calls.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable.
+   \pre @c RandomAccessIter @c value_type is <a href="http://en.cppreference.com/w/cpp/concept/LessThanComparable">LessThanComparable</a>
+   \pre @c RandomAccessIter @c value_type supports the @c operator>>,
+   which returns an integer-type right-shifted a specified number of bits.
+   \post The elements in the range [@c first, @c last) are sorted in ascending order.
+
+   \throws std::exception Propagates exceptions if any of the element comparisons, the element swaps (or moves),
+   the right shift, subtraction of right-shifted elements, functors, or any operations on iterators throw.
+
+   \warning Throwing an exception may cause data loss. This will also throw if the context grows and the allocation throws, in which case there will be no data loss.
+   \warning The context must not be used by another sort at the same time.
+*/
+  template <class RandomAccessIter>
+  inline void integer_sort(RandomAccessIter first, RandomAccessIter last,
+                           spreadsort_context<RandomAccessIter> &context)
+  {
+    // Don't sort if it's too small to optimize.
+    if (size_t(last - first) < current_tuning().min_sort_size)
+      boost::sort::pdqsort(first, last);
+    else
+      detail::integer_sort<detail::int_tuning>(first, last, *first >> 0,
+                                               &context);
   }
 
 /*! \brief Integer sort algorithm using range.
-  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c detail::min_sort_size).
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
 
   \details @c integer_sort is a fast templated in-place hybrid radix/comparison algorithm,
 which in testing tends to be roughly 50% to 2X faster than @c std::sort for large tests (>=100kB).\n
@@ -123,7 +160,7 @@ inline void integer_sort(Range& range)
 }
 
 /*! \brief Integer sort algorithm using random access iterators with both right-shift and user-defined comparison operator.
-  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c detail::min_sort_size).
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
 
   \details @c integer_sort is a fast templated in-place hybrid radix/comparison algorithm,
 which in testing tends to be roughly 50% to 2X faster than @c std::sort for large tests (>=100kB).\n
@@ -165,14 +202,49 @@ Some performance plots of runtime vs. n and log(range) are provided:\n
   template <class RandomAccessIter, class Right_shift, class Compare>
   inline void integer_sort(RandomAccessIter first, RandomAccessIter last,
                            Right_shift shift, Compare comp) {
-    if (last - first < detail::min_sort_size)
+    if (size_t(last - first) < current_tuning().min_sort_size)
       boost::sort::pdqsort(first, last, comp);
     else
-      detail::integer_sort(first, last, shift(*first, 0), shift, comp);
+      detail::integer_sort<detail::int_tuning>(first, last, shift(*first, 0),
+                                               shift, comp);
+  }
+
+/*! \brief Integer sort algorithm using random access iterators with both right-shift and user-defined comparison operator, and a reusable @c spreadsort_context.
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
+
+  \details Same as @c integer_sort(first, last, shift, comp), but the bin
+positions are kept in @c context instead of in memory allocated by the call.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] shift Functor that returns the result of shifting the value_type right a specified number of bits.
+   \param[in] comp A binary functor that returns whether the first element passed to it should go before the second in order.
+   \param[in,out] context Scratch space reused across calls.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable.
+   \post The elements in the range [@c first, @c last) are sorted in ascending order.
+
+   \throws std::exception Propagates exceptions if any of the element comparisons, the element swaps (or moves),
+   the right shift, subtraction of right-shifted elements, functors,
+   or any operations on iterators throw.
+
+   \warning Throwing an exception may cause data loss. This will also throw if the context grows and the allocation throws, in which case there will be no data loss.
+   \warning The context must not be used by another sort at the same time.
+*/
+  template <class RandomAccessIter, class Right_shift, class Compare>
+  inline void integer_sort(RandomAccessIter first, RandomAccessIter last,
+                           Right_shift shift, Compare comp,
+                           spreadsort_context<RandomAccessIter> &context) {
+    if (size_t(last - first) < current_tuning().min_sort_size)
+      boost::sort::pdqsort(first, last, comp);
+    else
+      detail::integer_sort<detail::int_tuning>(first, last, shift(*first, 0),
+                                               shift, comp, &context);
   }
 
 /*! \brief Integer sort algorithm using range with both right-shift and user-defined comparison operator.
-  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c detail::min_sort_size).
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
 
   \details @c integer_sort is a fast templated in-place hybrid radix/comparison algorithm,
 which in testing tends to be roughly 50% to 2X faster than @c std::sort for large tests (>=100kB).\n
@@ -216,7 +288,7 @@ inline void integer_sort(Range& range, Right_shift shift, Compare comp)
 }
 
 /*! \brief Integer sort algorithm using random access iterators with just right-shift functor.
-  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c detail::min_sort_size).
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
 
   \details @c integer_sort is a fast templated in-place hybrid radix/comparison algorithm,
 which in testing tends to be roughly 50% to 2X faster than @c std::sort for large tests (>=100kB).\n
@@ -258,15 +330,16 @@ Some performance plots of runtime vs. n and log(range) are provided:\n
   template <class RandomAccessIter, class Right_shift>
   inline void integer_sort(RandomAccessIter first, RandomAccessIter last,
                            Right_shift shift) {
-    if (last - first < detail::min_sort_size)
+    if (size_t(last - first) < current_tuning().min_sort_size)
       boost::sort::pdqsort(first, last);
     else
-      detail::integer_sort(first, last, shift(*first, 0), shift);
+      detail::integer_sort<detail::int_tuning>(first, last, shift(*first, 0),
+                                               shift);
   }
 
 
 /*! \brief Integer sort algorithm using range with just right-shift functor.
-  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c detail::min_sort_size).
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
 
   \details @c integer_sort is a fast templated in-place hybrid radix/comparison algorithm,
 which in testing tends to be roughly 50% to 2X faster than @c std::sort for large tests (>=100kB).\n
@@ -307,6 +380,223 @@ inline void integer_sort(Range& range, Right_shift shift)
 {
   integer_sort(boost::begin(range), boost::end(range), shift);
 }
+
+/*! \brief Integer sort algorithm using random access iterators, with the compile-time tuning values of a @c tuning_policy.
+  (Falls back to @c boost::sort::pdqsort if the data size is too small, < @c Tuning::min_sort_size()).
+
+  \details Same as @c integer_sort(first, last), called as @c integer_sort<Tuning>(first, last),
+but the tuning values are those of @c Tuning instead of @c current_tuning(),
+so a call site can be tuned for the data it sorts without affecting the other sorts.
+
+   \tparam Tuning A @c tuning_policy.
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable.
+   \pre @c RandomAccessIter @c value_type is <a href="http://en.cppreference.com/w/cpp/concept/LessThanComparable">LessThanComparable</a>
+   \pre @c RandomAccessIter @c value_type supports the @c operator>>,
+   which returns an integer-type right-shifted a specified number of bits.
+   \post The elements in the range [@c first, @c last) are sorted in ascending order.
+
+   \throws std::exception Propagates exceptions if any of the element comparisons, the element swaps (or moves),
+   the right shift, subtraction of right-shifted elements, functors, or any operations on iterators throw.
+
+   \warning Throwing an exception may cause data loss. This will also throw if a small vector resize throws, in which case there will be no data loss.
+*/
+  template <class Tuning, class RandomAccessIter>
+  inline typename boost::enable_if_c< detail::is_tuning_policy<Tuning>::value,
+                                      void >::type
+  integer_sort(RandomAccessIter first, RandomAccessIter last)
+  {
+    if (size_t(last - first) < Tuning::min_sort_size())
+      boost::sort::pdqsort(first, last);
+    else
+      detail::integer_sort<Tuning>(first, last, *first >> 0);
+  }
+
+/*! \brief Integer sort algorithm using random access iterators with both right-shift and user-defined comparison operator, with the compile-time tuning values of a @c tuning_policy.
+  (Falls back to @c boost::sort::pdqsort if the data size is too small, < @c Tuning::min_sort_size()).
+
+  \details Same as @c integer_sort(first, last, shift, comp), called as
+@c integer_sort<Tuning>(first, last, shift, comp), but the tuning values are those of @c Tuning.
+
+   \tparam Tuning A @c tuning_policy.
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] shift Functor that returns the result of shifting the value_type right a specified number of bits.
+   \param[in] comp A binary functor that returns whether the first element passed to it should go before the second in order.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable.
+   \post The elements in the range [@c first, @c last) are sorted in ascending order.
+
+   \throws std::exception Propagates exceptions if any of the element comparisons, the element swaps (or moves),
+   the right shift, subtraction of right-shifted elements, functors,
+   or any operations on iterators throw.
+
+   \warning Throwing an exception may cause data loss. This will also throw if a small vector resize throws, in which case there will be no data loss.
+*/
+  template <class Tuning, class RandomAccessIter, class Right_shift,
+            class Compare>
+  inline typename boost::enable_if_c< detail::is_tuning_policy<Tuning>::value,
+                                      void >::type
+  integer_sort(RandomAccessIter first, RandomAccessIter last,
+               Right_shift shift, Compare comp)
+  {
+    if (size_t(last - first) < Tuning::min_sort_size())
+      boost::sort::pdqsort(first, last, comp);
+    else
+      detail::integer_sort<Tuning>(first, last, shift(*first, 0), shift, comp);
+  }
+
+/*! \brief Integer sort algorithm using random access iterators with just right-shift functor, with the compile-time tuning values of a @c tuning_policy.
+  (Falls back to @c boost::sort::pdqsort if the data size is too small, < @c Tuning::min_sort_size()).
+
+  \details Same as @c integer_sort(first, last, shift), called as
+@c integer_sort<Tuning>(first, last, shift), but the tuning values are those of @c Tuning.
+
+   \tparam Tuning A @c tuning_policy.
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] shift Functor that returns the result of shifting the value_type right a specified number of bits.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable.
+   \pre @c RandomAccessIter @c value_type is <a href="http://en.cppreference.com/w/cpp/concept/LessThanComparable">LessThanComparable</a>
+   \post The elements in the range [@c first, @c last) are sorted in ascending order.
+
+   \throws std::exception Propagates exceptions if any of the element comparisons, the element swaps (or moves),
+   the right shift, subtraction of right-shifted elements, functors,
+   or any operations on iterators throw.
+
+   \warning Throwing an exception may cause data loss. This will also throw if a small vector resize throws, in which case there will be no data loss.
+*/
+  template <class Tuning, class RandomAccessIter, class Right_shift>
+  inline typename boost::enable_if_c< detail::is_tuning_policy<Tuning>::value,
+                                      void >::type
+  integer_sort(RandomAccessIter first, RandomAccessIter last,
+               Right_shift shift)
+  {
+    if (size_t(last - first) < Tuning::min_sort_size())
+      boost::sort::pdqsort(first, last);
+    else
+      detail::integer_sort<Tuning>(first, last, shift(*first, 0), shift);
+  }
+
+/*! \brief Out-of-place LSD radix sort for integers using random access iterators, a right-shift functor and a caller-provided buffer.
+
+  \details @c integer_sort_lsd does one least significant digit pass per digit of the key,
+moving the elements back and forth between [@c first, @c last) and the buffer.
+The digits are 8 bits, or 12 bits for keys wider than 4 bytes, so a 64-bit key takes 6 passes.
+The histograms of every digit are counted in a single pass over the data,
+and a pass is skipped when every key has the same value in that digit.
+It avoids the branchy in-place swap loop of @c integer_sort,
+which makes it faster on large inputs of fixed-width keys with a lot of random bits,
+at the cost of @c last - @c first elements of additional memory.\n
+The sort is stable.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] shift A functor that returns the result of shifting the value_type right a specified number of bits.
+   Only @c shift(x, 0) is used, and it must return an integer type.
+   \param[in] buffer Random access iterator to the first of @c last - @c first elements that can be assigned to.
+   Their content on return is unspecified.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable.
+   \post The elements in the range [@c first, @c last) are sorted in ascending order of @c shift(x, 0).
+
+   \throws std::exception Propagates exceptions if any of the element moves,
+   the right shift, functors, or any operations on iterators throw.
+
+   \warning Throwing an exception may cause data loss.
+   \warning Invalid arguments cause undefined behaviour.
+
+   \remark <em> O(N * K/D) </em> operations, where:
+   \remark  *  N is @c last - @c first,
+   \remark  *  K is the size of the key in bits,
+   \remark  *  D is the size of a digit in bits: 8, or 12 when K > 32.
+*/
+  template <class RandomAccessIter, class Right_shift, class Buffer_iter>
+  inline void integer_sort_lsd(RandomAccessIter first, RandomAccessIter last,
+                               Right_shift shift, Buffer_iter buffer)
+  {
+    if (last - first > 1)
+      detail::integer_sort_lsd(first, last, shift(*first, 0), shift, buffer);
+  }
+
+/*! \brief Out-of-place LSD radix sort for integers using random access iterators with just right-shift functor.
+
+  \details Same as @c integer_sort_lsd with a buffer, allocating
+@c last - @c first elements of @c value_type for the buffer.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] shift A functor that returns the result of shifting the value_type right a specified number of bits.
+   Only @c shift(x, 0) is used, and it must return an integer type.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable and default constructible.
+   \post The elements in the range [@c first, @c last) are sorted in ascending order of @c shift(x, 0).
+
+   \throws std::exception Propagates exceptions if any of the element moves,
+   the right shift, functors, or any operations on iterators throw,
+   and std::bad_alloc if the buffer can't be allocated.
+
+   \warning Throwing an exception may cause data loss.
+   \warning Invalid arguments cause undefined behaviour.
+*/
+  template <class RandomAccessIter, class Right_shift>
+  inline void integer_sort_lsd(RandomAccessIter first, RandomAccessIter last,
+                               Right_shift shift)
+  {
+    if (last - first < 2)
+      return;
+    std::vector<typename std::iterator_traits<RandomAccessIter>::value_type>
+      buffer(last - first);
+    detail::integer_sort_lsd(first, last, shift(*first, 0), shift,
+                             buffer.begin());
+  }
+
+/*! \brief Out-of-place LSD radix sort for integers using random access iterators.
+
+  \details Same as @c integer_sort_lsd with a buffer, using @c operator>> for the key
+and allocating @c last - @c first elements of @c value_type for the buffer.
+When @c value_type is an integer wider than 4 bytes, it calls @c integer_sort instead:
+the elements are their own keys, so the stability can't be observed,
+and the in-place MSD sort is faster than the 6 LSD passes over 64-bit keys.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable and default constructible.
+   \pre @c RandomAccessIter @c value_type supports the @c operator>>,
+   which returns an integer-type right-shifted a specified number of bits.
+   \post The elements in the range [@c first, @c last) are sorted in ascending order.
+
+   \throws std::exception Propagates exceptions if any of the element moves,
+   the right shift, or any operations on iterators throw,
+   and std::bad_alloc if the buffer can't be allocated.
+
+   \warning Throwing an exception may cause data loss.
+   \warning Invalid arguments cause undefined behaviour.
+*/
+  template <class RandomAccessIter>
+  inline void integer_sort_lsd(RandomAccessIter first, RandomAccessIter last)
+  {
+    typedef typename std::iterator_traits<RandomAccessIter>::value_type
+      Data_type;
+    if (boost::is_integral<Data_type>::value && sizeof(Data_type) > 4) {
+      integer_sort(first, last);
+      return;
+    }
+    if (last - first < 2)
+      return;
+    std::vector<Data_type> buffer(last - first);
+    detail::integer_sort_lsd(first, last, *first >> 0, buffer.begin());
+  }
 }
 }
 }
@@ -0,0 +1,58 @@
+//Templated Spreadsort-based implementation of integer_tag_sort
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort/ for library home page.
+
+#ifndef BOOST_INTEGER_TAG_SORT_HPP
+#define BOOST_INTEGER_TAG_SORT_HPP
+#include <boost/sort/spreadsort/detail/tag_sort.hpp>
+
+namespace boost {
+namespace sort {
+namespace spreadsort {
+
+/*! \brief Integer sort algorithm for large elements, which sorts tags with the keys of the elements and moves each element once.
+
+  \details @c integer_tag_sort copies the key returned by @c rshift(x, 0) of each element, with
+the position of the element, into an array of tags, sorts the tags with @c integer_sort, and then
+moves the elements to their sorted positions following the cycles of the permutation, so each
+element is moved once, plus one move per cycle.\n
+@c integer_sort with a right shift functor swaps the whole elements in each iteration, and sorting
+iterators to the elements, as @c indirect_sort does, dereferences them in each comparison.
+The tags are small and contiguous, so this is faster when the elements are much bigger than their
+keys, as records of hundreds of bytes with an integer key.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] rshift Functor that returns the result of shifting the value_type right a specified number of bits.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable and move constructible.
+   \post The elements in the range [@c first, @c last) are sorted in ascending order of their keys.
+
+   \throws std::exception Propagates exceptions if any of the element moves, the right shift,
+   or any operations on iterators throw, and if the tags can't be allocated.
+
+   \warning Throwing an exception while the elements are moved may cause data loss.
+   \warning Invalid arguments cause undefined behaviour.
+
+   \remark Needs @c last - @c first tags of additional memory, each one the size of a key plus
+   a 32-bit index (a @c size_t index with more than 2^32 elements).
+   \remark Not stable: elements with equal keys may be in any order.
+*/
+  template <class RandomAccessIter, class Right_shift>
+  inline void integer_tag_sort(RandomAccessIter first, RandomAccessIter last,
+                               Right_shift rshift)
+  {
+    if (last - first < 2)
+      return;
+    detail::integer_tag_sort(first, last, rshift(*first, 0), rshift);
+  }
+}
+}
+}
+
+#endif
@@ -0,0 +1,194 @@
+//Templated multithreaded Spreadsort-based implementation of integer_sort
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort/ for library home page.
+
+#ifndef BOOST_SORT_SPREADSORT_PARALLEL_INTEGER_SORT_HPP
+#define BOOST_SORT_SPREADSORT_PARALLEL_INTEGER_SORT_HPP
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <boost/sort/spreadsort/integer_sort.hpp>
+#include <boost/sort/spreadsort/detail/parallel_integer_sort.hpp>
+
+namespace boost {
+namespace sort {
+namespace spreadsort {
+
+/*! \brief Parallel integer sort algorithm using random access iterators.
+  (Falls back to @c integer_sort with fewer than @c detail::min_parallel_size elements per thread).
+
+  \details @c parallel_integer_sort splits the data into the first level of
+@c integer_sort bins using all the threads: each thread counts the bin sizes
+of its own part of the data, and a prefix sum over those counts gives each
+thread a private write position inside each bin, so the elements are scattered
+into a temporary buffer without locking.  The bins are then sorted in parallel
+with @c integer_sort; bins holding more than 1/nthread of the data are split
+again with all the threads.\n
+If the temporary buffer can't be allocated, the data is sorted in place with
+@c integer_sort.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] nthread Number of threads to use; defaults to the number of hardware threads.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable and move constructible.
+   \pre @c RandomAccessIter @c value_type is <a href="http://en.cppreference.com/w/cpp/concept/LessThanComparable">LessThanComparable</a>
+   \pre @c RandomAccessIter @c value_type supports the @c operator>>,
+   which returns an integer-type right-shifted a specified number of bits.
+   \post The elements in the range [@c first, @c last) are sorted in ascending order.
+
+   \throws std::exception Propagates exceptions if any of the element comparisons, the element swaps (or moves),
+   the right shift, subtraction of right-shifted elements, or any operations on iterators throw,
+   and if a thread can't be started.
+
+   \warning Throwing an exception may cause data loss.
+   \warning Invalid arguments cause undefined behaviour.
+
+   \remark Needs @c last - @c first elements of additional memory.
+*/
+  template <class RandomAccessIter>
+  inline void parallel_integer_sort(RandomAccessIter first,
+                                    RandomAccessIter last,
+                 unsigned nthread = std::thread::hardware_concurrency())
+  {
+    typedef typename std::iterator_traits<RandomAccessIter>::value_type
+      value_type;
+    if (size_t(last - first) < current_tuning().min_sort_size)
+      boost::sort::pdqsort(first, last);
+    else
+      detail::parallel_integer_sort(first, last, *first >> 0,
+        detail::default_right_shift(), std::less<value_type>(), nthread,
+        default_thread_pool());
+  }
+
+/*! \brief Parallel integer sort algorithm using random access iterators with just right-shift functor.
+  (Falls back to @c integer_sort with fewer than @c detail::min_parallel_size elements per thread).
+
+  \details See the plain @c parallel_integer_sort for the algorithm.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] shift A functor that returns the result of shifting the value_type right a specified number of bits.
+   \param[in] nthread Number of threads to use; defaults to the number of hardware threads.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable and move constructible.
+   \pre @c RandomAccessIter @c value_type is <a href="http://en.cppreference.com/w/cpp/concept/LessThanComparable">LessThanComparable</a>
+   \post The elements in the range [@c first, @c last) are sorted in ascending order.
+
+   \throws std::exception Propagates exceptions if any of the element comparisons, the element swaps (or moves),
+   the right shift, subtraction of right-shifted elements, functors, or any operations on iterators throw,
+   and if a thread can't be started.
+
+   \warning Throwing an exception may cause data loss.
+   \warning Invalid arguments cause undefined behaviour.
+
+   \remark Needs @c last - @c first elements of additional memory.
+*/
+  template <class RandomAccessIter, class Right_shift>
+  inline typename boost::disable_if_c< boost::is_integral<Right_shift>::value,
+                                       void >::type
+  parallel_integer_sort(RandomAccessIter first, RandomAccessIter last,
+                        Right_shift shift,
+                        unsigned nthread = std::thread::hardware_concurrency())
+  {
+    typedef typename std::iterator_traits<RandomAccessIter>::value_type
+      value_type;
+    if (size_t(last - first) < current_tuning().min_sort_size)
+      boost::sort::pdqsort(first, last);
+    else
+      detail::parallel_integer_sort(first, last, shift(*first, 0), shift,
+                                    std::less<value_type>(), nthread,
+                                    default_thread_pool());
+  }
+
+/*! \brief Parallel integer sort algorithm using random access iterators with both right-shift and user-defined comparison operator.
+  (Falls back to @c integer_sort with fewer than @c detail::min_parallel_size elements per thread).
+
+  \details See the plain @c parallel_integer_sort for the algorithm.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] shift Functor that returns the result of shifting the value_type right a specified number of bits.
+   \param[in] comp A binary functor that returns whether the first element passed to it should go before the second in order.
+   \param[in] nthread Number of threads to use; defaults to the number of hardware threads.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable and move constructible.
+   \post The elements in the range [@c first, @c last) are sorted in ascending order.
+
+   \throws std::exception Propagates exceptions if any of the element comparisons, the element swaps (or moves),
+   the right shift, subtraction of right-shifted elements, functors, or any operations on iterators throw,
+   and if a thread can't be started.
+
+   \warning Throwing an exception may cause data loss.
+   \warning Invalid arguments cause undefined behaviour.
+
+   \remark Needs @c last - @c first elements of additional memory.
+*/
+  template <class RandomAccessIter, class Right_shift, class Compare>
+  inline typename boost::disable_if_c< boost::is_integral<Compare>::value,
+                                       void >::type
+  parallel_integer_sort(RandomAccessIter first, RandomAccessIter last,
+                        Right_shift shift, Compare comp,
+                        unsigned nthread = std::thread::hardware_concurrency())
+  {
+    if (size_t(last - first) < current_tuning().min_sort_size)
+      boost::sort::pdqsort(first, last, comp);
+    else
+      detail::parallel_integer_sort(first, last, shift(*first, 0), shift,
+                                    comp, nthread, default_thread_pool());
+  }
+
+/*! \brief Parallel integer sort algorithm using random access iterators with both right-shift and user-defined comparison operator,
+  running on the threads of @c pool.
+  (Falls back to @c integer_sort with fewer than @c detail::min_parallel_size elements per thread).
+
+  \details See the plain @c parallel_integer_sort for the algorithm.
+The other overloads use @c default_thread_pool(); passing a pool lets the
+caller choose the threads, and share them with its own work.  The calling
+thread sorts too, and runs pending tasks of @c pool while it waits.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] shift Functor that returns the result of shifting the value_type right a specified number of bits.
+   \param[in] comp A binary functor that returns whether the first element passed to it should go before the second in order.
+   \param[in] nthread Number of threads to use, counting the calling thread.
+   \param[in] pool Thread pool that runs the other threads' work.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable and move constructible.
+   \post The elements in the range [@c first, @c last) are sorted in ascending order.
+
+   \throws std::exception Propagates exceptions if any of the element comparisons, the element swaps (or moves),
+   the right shift, subtraction of right-shifted elements, functors, or any operations on iterators throw.
+
+   \warning Throwing an exception may cause data loss.
+   \warning Invalid arguments cause undefined behaviour.
+
+   \remark Needs @c last - @c first elements of additional memory.
+*/
+  template <class RandomAccessIter, class Right_shift, class Compare>
+  inline void parallel_integer_sort(RandomAccessIter first,
+                                    RandomAccessIter last, Right_shift shift,
+                                    Compare comp, unsigned nthread,
+                                    thread_pool &pool)
+  {
+    if (size_t(last - first) < current_tuning().min_sort_size)
+      boost::sort::pdqsort(first, last, comp);
+    else
+      detail::parallel_integer_sort(first, last, shift(*first, 0), shift,
+                                    comp, nthread, pool);
+  }
+}
+}
+}
+
+#endif
@@ -0,0 +1,92 @@
+//Templated multithreaded Spreadsort-based implementation of integer_tag_sort
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort/ for library home page.
+
+#ifndef BOOST_SORT_SPREADSORT_PARALLEL_INTEGER_TAG_SORT_HPP
+#define BOOST_SORT_SPREADSORT_PARALLEL_INTEGER_TAG_SORT_HPP
+#include <thread>
+#include <boost/sort/spreadsort/integer_tag_sort.hpp>
+#include <boost/sort/spreadsort/detail/parallel_tag_sort.hpp>
+
+namespace boost {
+namespace sort {
+namespace spreadsort {
+
+/*! \brief Parallel integer sort algorithm for large elements, which sorts tags with the keys of the elements.
+  (Falls back to @c integer_tag_sort with fewer than @c detail::min_parallel_size elements per thread).
+
+  \details See @c integer_tag_sort for the algorithm. The tags are made by all the threads, each
+one in its own part of the data, and sorted with @c parallel_integer_sort. Then, instead of
+following the cycles of the permutation, each thread moves the elements of its part of the sorted
+order into a buffer, and back, so the threads don't depend on each other.  Without memory for
+the buffer, the permutation is applied by one thread.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] rshift Functor that returns the result of shifting the value_type right a specified number of bits.
+   \param[in] nthread Number of threads to use; defaults to the number of hardware threads.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable and move constructible.
+   \pre @c rshift can be called from several threads at the same time.
+   \post The elements in the range [@c first, @c last) are sorted in ascending order of their keys.
+
+   \throws std::exception Propagates exceptions if any of the element moves, the right shift,
+   or any operations on iterators throw, and if the tags can't be allocated or a thread can't be started.
+
+   \warning Throwing an exception while the elements are moved may cause data loss.
+   \warning Invalid arguments cause undefined behaviour.
+
+   \remark Needs @c last - @c first tags of additional memory for the tags, as much again
+   for the buffer of @c parallel_integer_sort, and @c last - @c first elements for the buffer of
+   the permutation.
+*/
+  template <class RandomAccessIter, class Right_shift>
+  inline void parallel_integer_tag_sort(RandomAccessIter first,
+                                        RandomAccessIter last,
+                                        Right_shift rshift,
+                 unsigned nthread = std::thread::hardware_concurrency())
+  {
+    if (last - first < 2)
+      return;
+    detail::parallel_integer_tag_sort(first, last, rshift(*first, 0), rshift,
+                                      nthread, default_thread_pool());
+  }
+
+/*! \brief Parallel integer sort algorithm for large elements, running on the threads of @c pool.
+  (Falls back to @c integer_tag_sort with fewer than @c detail::min_parallel_size elements per thread).
+
+  \details See @c integer_tag_sort for the algorithm. The calling thread works too, and runs
+pending tasks of @c pool while it waits.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] rshift Functor that returns the result of shifting the value_type right a specified number of bits.
+   \param[in] nthread Number of threads to use, counting the calling thread.
+   \param[in] pool Thread pool that runs the other threads' work.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable and move constructible.
+   \pre @c rshift can be called from several threads at the same time.
+   \post The elements in the range [@c first, @c last) are sorted in ascending order of their keys.
+*/
+  template <class RandomAccessIter, class Right_shift>
+  inline void parallel_integer_tag_sort(RandomAccessIter first,
+                                        RandomAccessIter last,
+                                        Right_shift rshift, unsigned nthread,
+                                        thread_pool &pool)
+  {
+    if (last - first < 2)
+      return;
+    detail::parallel_integer_tag_sort(first, last, rshift(*first, 0), rshift,
+                                      nthread, pool);
+  }
+}
+}
+}
+
+#endif
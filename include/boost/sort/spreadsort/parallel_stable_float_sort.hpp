@@ -0,0 +1,104 @@
+//Templated multithreaded radix-based implementation of stable_float_sort
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort/ for library home page.
+
+#ifndef BOOST_SORT_SPREADSORT_PARALLEL_STABLE_FLOAT_SORT_HPP
+#define BOOST_SORT_SPREADSORT_PARALLEL_STABLE_FLOAT_SORT_HPP
+#include <thread>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <boost/sort/spreadsort/stable_float_sort.hpp>
+#include <boost/sort/spreadsort/detail/parallel_stable_radix_sort.hpp>
+
+namespace boost {
+namespace sort {
+namespace spreadsort {
+
+  /*!
+    \brief Parallel stable floating-point sort algorithm using random access iterators, with casting to the appropriate size.
+    (Falls back to @c stable_float_sort with fewer than @c detail::min_parallel_size elements per thread).
+
+    \details The floats are cast to integers as in @c stable_float_sort, and sorted with the
+    byte passes of @c parallel_stable_integer_sort.
+
+    \param[in] first Iterator pointer to first element.
+    \param[in] last Iterator pointing to one beyond the end of data.
+    \param[in] nthread Number of threads to use; defaults to the number of hardware threads.
+
+    \pre [@c first, @c last) is a valid range.
+    \pre @c RandomAccessIter @c value_type is mutable and move constructible.
+    \post The elements in the range [@c first, @c last) are sorted in ascending order,
+    and the equal elements are in their original order.
+
+    \warning -0.0 is sorted before 0.0, and NaNs are sorted by their bits, as in @c stable_float_sort.
+
+    \remark Needs @c last - @c first elements of additional memory.
+  */
+  template <class RandomAccessIter>
+  inline void parallel_stable_float_sort(RandomAccessIter first,
+                                         RandomAccessIter last,
+                 unsigned nthread = std::thread::hardware_concurrency())
+  {
+    if (last - first < 2)
+      return;
+    detail::parallel_stable_float_sort(first, last, nthread,
+                                       default_thread_pool());
+  }
+
+  /*!
+    \brief Parallel stable floating-point sort algorithm using random access iterators with just right-shift functor.
+
+    \param[in] first Iterator pointer to first element.
+    \param[in] last Iterator pointing to one beyond the end of data.
+    \param[in] rshift Functor that returns the result of shifting the value_type right a specified number of bits.
+    Only @c rshift(x, 0) is used, and it must return the key of x cast to a signed integer of the same size.
+    \param[in] nthread Number of threads to use; defaults to the number of hardware threads.
+
+    \pre @c rshift can be called from several threads at the same time.
+  */
+  template <class RandomAccessIter, class Right_shift>
+  inline typename boost::disable_if_c< boost::is_integral<Right_shift>::value,
+                                       void >::type
+  parallel_stable_float_sort(RandomAccessIter first, RandomAccessIter last,
+                             Right_shift rshift,
+                        unsigned nthread = std::thread::hardware_concurrency())
+  {
+    if (last - first < 2)
+      return;
+    detail::parallel_stable_float_sort(first, last, rshift(*first, 0), rshift,
+                                       nthread, default_thread_pool());
+  }
+
+  /*!
+    \brief Parallel stable floating-point sort algorithm using random access iterators with just right-shift functor,
+    running on the threads of @c pool.
+
+    \param[in] first Iterator pointer to first element.
+    \param[in] last Iterator pointing to one beyond the end of data.
+    \param[in] rshift Functor that returns the result of shifting the value_type right a specified number of bits.
+    Only @c rshift(x, 0) is used, and it must return the key of x cast to a signed integer of the same size.
+    \param[in] nthread Number of threads to use, counting the calling thread.
+    \param[in] pool Thread pool that runs the other threads' work.
+
+    \pre @c rshift can be called from several threads at the same time.
+  */
+  template <class RandomAccessIter, class Right_shift>
+  inline void parallel_stable_float_sort(RandomAccessIter first,
+                                         RandomAccessIter last,
+                                         Right_shift rshift,
+                                         unsigned nthread, thread_pool &pool)
+  {
+    if (last - first < 2)
+      return;
+    detail::parallel_stable_float_sort(first, last, rshift(*first, 0), rshift,
+                                       nthread, pool);
+  }
+}
+}
+}
+
+#endif
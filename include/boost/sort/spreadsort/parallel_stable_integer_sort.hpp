@@ -0,0 +1,131 @@
+//Templated multithreaded radix-based implementation of stable_integer_sort
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort/ for library home page.
+
+#ifndef BOOST_SORT_SPREADSORT_PARALLEL_STABLE_INTEGER_SORT_HPP
+#define BOOST_SORT_SPREADSORT_PARALLEL_STABLE_INTEGER_SORT_HPP
+#include <thread>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <boost/sort/spreadsort/stable_integer_sort.hpp>
+#include <boost/sort/spreadsort/detail/parallel_stable_radix_sort.hpp>
+
+namespace boost {
+namespace sort {
+namespace spreadsort {
+
+/*! \brief Parallel stable integer sort algorithm using random access iterators.
+  (Falls back to @c stable_integer_sort with fewer than @c detail::min_parallel_size elements per thread).
+
+  \details See @c stable_integer_sort for the algorithm.  In each byte pass, each thread counts
+the bytes of the keys of its own part of the data, and a prefix sum over those counts, by byte
+value and then by thread, gives each thread a private write position inside each bin.  The threads
+scatter their parts in order without locking, and the parts are in order, so every pass keeps the
+order of the equal keys.\n
+If the temporary buffer can't be allocated, the data is sorted with @c stable_integer_sort.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] nthread Number of threads to use; defaults to the number of hardware threads.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable and move constructible.
+   \pre @c RandomAccessIter @c value_type supports the @c operator>>,
+   which returns an integer-type right-shifted a specified number of bits.
+   \post The elements in the range [@c first, @c last) are sorted in ascending order,
+   and the elements with equal keys are in their original order.
+
+   \throws std::exception Propagates exceptions if any of the element moves,
+   the right shift, or any operations on iterators throw, and if a thread can't be started.
+
+   \warning Throwing an exception may cause data loss.
+   \warning Invalid arguments cause undefined behaviour.
+
+   \remark Needs @c last - @c first elements of additional memory.
+*/
+  template <class RandomAccessIter>
+  inline void parallel_stable_integer_sort(RandomAccessIter first,
+                                           RandomAccessIter last,
+                 unsigned nthread = std::thread::hardware_concurrency())
+  {
+    if (last - first < 2)
+      return;
+    detail::parallel_stable_integer_sort(first, last, *first >> 0, nthread,
+                                         default_thread_pool());
+  }
+
+/*! \brief Parallel stable integer sort algorithm using random access iterators with just right-shift functor.
+  (Falls back to @c stable_integer_sort with fewer than @c detail::min_parallel_size elements per thread).
+
+  \details See the plain @c parallel_stable_integer_sort for the algorithm.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] shift A functor that returns the result of shifting the value_type right a specified number of bits.
+   Only @c shift(x, 0) is used, and it must return an integer type.
+   \param[in] nthread Number of threads to use; defaults to the number of hardware threads.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable and move constructible.
+   \pre @c shift can be called from several threads at the same time.
+   \post The elements in the range [@c first, @c last) are sorted in ascending order of @c shift(x, 0),
+   and the elements with equal keys are in their original order.
+
+   \remark Needs @c last - @c first elements of additional memory.
+*/
+  template <class RandomAccessIter, class Right_shift>
+  inline typename boost::disable_if_c< boost::is_integral<Right_shift>::value,
+                                       void >::type
+  parallel_stable_integer_sort(RandomAccessIter first, RandomAccessIter last,
+                               Right_shift shift,
+                        unsigned nthread = std::thread::hardware_concurrency())
+  {
+    if (last - first < 2)
+      return;
+    detail::parallel_stable_integer_sort(first, last, shift(*first, 0), shift,
+                                         nthread, default_thread_pool());
+  }
+
+/*! \brief Parallel stable integer sort algorithm using random access iterators with just right-shift functor,
+  running on the threads of @c pool.
+  (Falls back to @c stable_integer_sort with fewer than @c detail::min_parallel_size elements per thread).
+
+  \details See the plain @c parallel_stable_integer_sort for the algorithm.  The calling thread
+sorts too, and runs pending tasks of @c pool while it waits.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] shift A functor that returns the result of shifting the value_type right a specified number of bits.
+   Only @c shift(x, 0) is used, and it must return an integer type.
+   \param[in] nthread Number of threads to use, counting the calling thread.
+   \param[in] pool Thread pool that runs the other threads' work.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable and move constructible.
+   \pre @c shift can be called from several threads at the same time.
+   \post The elements in the range [@c first, @c last) are sorted in ascending order of @c shift(x, 0),
+   and the elements with equal keys are in their original order.
+
+   \remark Needs @c last - @c first elements of additional memory.
+*/
+  template <class RandomAccessIter, class Right_shift>
+  inline void parallel_stable_integer_sort(RandomAccessIter first,
+                                           RandomAccessIter last,
+                                           Right_shift shift,
+                                           unsigned nthread,
+                                           thread_pool &pool)
+  {
+    if (last - first < 2)
+      return;
+    detail::parallel_stable_integer_sort(first, last, shift(*first, 0), shift,
+                                         nthread, pool);
+  }
+}
+}
+}
+
+#endif
@@ -0,0 +1,100 @@
+//Templated multithreaded hybrid string_sort
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort/ for library home page.
+
+#ifndef BOOST_SORT_SPREADSORT_PARALLEL_STRING_SORT_HPP
+#define BOOST_SORT_SPREADSORT_PARALLEL_STRING_SORT_HPP
+#include <thread>
+#include <boost/sort/spreadsort/string_sort.hpp>
+#include <boost/sort/spreadsort/detail/parallel_string_sort.hpp>
+
+namespace boost {
+namespace sort {
+namespace spreadsort {
+
+/*! \brief Parallel string sort algorithm using random access iterators.
+  (Falls back to @c string_sort with fewer than @c detail::min_parallel_size elements per thread).
+
+  \details @c parallel_string_sort runs the same radix splits as @c string_sort,
+but the bins are sorted by a pool of threads: every bin produced by a split is
+pushed to a shared stack of tasks, bins still too large for a single thread
+are split again the same way, and the rest are sorted serially by the thread
+that pops them.  Each thread keeps its own bin cache, so the threads only
+share the task stack.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] nthread Number of threads to use; defaults to the number of hardware threads.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable.
+   \pre @c RandomAccessIter @c value_type is <a href="http://en.cppreference.com/w/cpp/concept/LessThanComparable">LessThanComparable</a>
+   \pre @c RandomAccessIter @c value_type supports the @c operator[], @c size() and @c data() like @c std::string,
+   with 1-byte characters.
+   \post The elements in the range [@c first, @c last) are sorted in ascending order.
+
+   \throws std::exception Propagates exceptions if any of the element comparisons, the element swaps (or moves),
+   or any operations on iterators throw, and if a thread can't be started.
+
+   \warning Throwing an exception may cause data loss.
+   \warning Invalid arguments cause undefined behaviour.
+*/
+  template <class RandomAccessIter>
+  inline void parallel_string_sort(RandomAccessIter first,
+                                   RandomAccessIter last,
+                 unsigned nthread = std::thread::hardware_concurrency())
+  {
+    unsigned char unused = '\0';
+    if (size_t(last - first) < current_tuning().min_sort_size)
+      boost::sort::pdqsort(first, last);
+    else
+      detail::parallel_string_sort(first, last, unused, nthread,
+                                   default_thread_pool());
+  }
+
+/*! \brief Parallel string sort algorithm using random access iterators, running on the threads of @c pool.
+  (Falls back to @c string_sort with fewer than @c detail::min_parallel_size elements per thread).
+
+  \details See the plain @c parallel_string_sort for the algorithm.
+The other overload uses @c default_thread_pool(); passing a pool lets the
+caller choose the threads, and share them with its own work.  The calling
+thread sorts too, and runs pending tasks of @c pool while it waits.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] nthread Number of threads to use, counting the calling thread.
+   \param[in] pool Thread pool that runs the other threads' work.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable.
+   \pre @c RandomAccessIter @c value_type is <a href="http://en.cppreference.com/w/cpp/concept/LessThanComparable">LessThanComparable</a>
+   \pre @c RandomAccessIter @c value_type supports the @c operator[], @c size() and @c data() like @c std::string,
+   with 1-byte characters.
+   \post The elements in the range [@c first, @c last) are sorted in ascending order.
+
+   \throws std::exception Propagates exceptions if any of the element comparisons, the element swaps (or moves),
+   or any operations on iterators throw.
+
+   \warning Throwing an exception may cause data loss.
+   \warning Invalid arguments cause undefined behaviour.
+*/
+  template <class RandomAccessIter>
+  inline void parallel_string_sort(RandomAccessIter first,
+                                   RandomAccessIter last, unsigned nthread,
+                                   thread_pool &pool)
+  {
+    unsigned char unused = '\0';
+    if (size_t(last - first) < current_tuning().min_sort_size)
+      boost::sort::pdqsort(first, last);
+    else
+      detail::parallel_string_sort(first, last, unused, nthread, pool);
+  }
+}
+}
+}
+
+#endif
@@ -27,6 +27,11 @@ Scott McMurray
 #include <boost/sort/spreadsort/integer_sort.hpp>
 #include <boost/sort/spreadsort/float_sort.hpp>
 #include <boost/sort/spreadsort/string_sort.hpp>
+#include <boost/sort/spreadsort/integer_select.hpp>
+#include <boost/sort/spreadsort/float_select.hpp>
+#include <boost/sort/spreadsort/integer_tag_sort.hpp>
+#include <boost/sort/spreadsort/stable_integer_sort.hpp>
+#include <boost/sort/spreadsort/stable_float_sort.hpp>
 #include <boost/range/begin.hpp>
 #include <boost/range/end.hpp>
 
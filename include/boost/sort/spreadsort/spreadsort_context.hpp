@@ -0,0 +1,60 @@
+// Scratch space of the Spreadsort algorithms, reusable across calls.
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort for library home page.
+
+#ifndef BOOST_SORT_SPREADSORT_CONTEXT_HPP
+#define BOOST_SORT_SPREADSORT_CONTEXT_HPP
+#include <cstddef>
+#include <vector>
+
+namespace boost {
+namespace sort {
+namespace spreadsort {
+
+/*! \brief Bin positions reused by @c integer_sort, @c float_sort and @c string_sort calls.
+
+  \details Every call to @c integer_sort, @c float_sort or @c string_sort
+keeps the position of each bin of the recursion in a vector, which is
+allocated, grown and zero-filled by the call and freed at its end.  When many
+small ranges are sorted, that is a noticeable part of the time.  The overloads
+taking a @c spreadsort_context use its vector instead, which keeps its
+capacity between calls, so after the first few calls no memory is allocated.\n
+The bin counts are kept on the stack, and need no allocation, unless
+@c set_tuning raised @c max_splits above its default.
+
+  \tparam RandomAccessIter Iterator type of the ranges sorted with this context.
+
+  \warning A context must not be used by two sorts at the same time; use one
+  context per thread.
+*/
+  template <class RandomAccessIter>
+  class spreadsort_context {
+  public:
+    //! Creates an empty context; the space is allocated by the first sorts.
+    spreadsort_context() {}
+
+    //! Reserves space for @c bin_count bin positions, to avoid allocating
+    //! memory even in the first sorts.
+    void reserve(size_t bin_count) { cache.reserve(bin_count); }
+
+    //! Frees the memory of the context.
+    void clear() { std::vector<RandomAccessIter>().swap(cache); }
+
+    //! Number of bin positions the context can hold without allocating.
+    size_t capacity() const { return cache.capacity(); }
+
+    //! Vector of bin positions used by the sorting algorithms.
+    std::vector<RandomAccessIter> &bin_cache() { return cache; }
+
+  private:
+    std::vector<RandomAccessIter> cache;
+  };
+}
+}
+}
+
+#endif
@@ -0,0 +1,79 @@
+//Templated radix-based implementation of stable_float_sort
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort/ for library home page.
+
+#ifndef BOOST_STABLE_FLOAT_SORT_HPP
+#define BOOST_STABLE_FLOAT_SORT_HPP
+#include <boost/sort/spreadsort/detail/stable_radix_sort.hpp>
+
+namespace boost {
+namespace sort {
+namespace spreadsort {
+
+  /*!
+    \brief Stable floating-point sort algorithm using random access iterators, with casting to the appropriate size.
+
+    \details @c stable_float_sort casts the floats to integers of the same size, as @c float_sort,
+    and sorts them with the stable LSD radix sort of @c stable_integer_sort: the bits of the
+    negative floats are inverted and the sign bit of the others is set, so the unsigned order
+    of the keys is the order of the floats.
+    Falls back to @c std::stable_sort if the data size is too small, < @c detail::min_sort_size,
+    or if the value type isn't an IEEE 754 float or double.
+
+    \param[in] first Iterator pointer to first element.
+    \param[in] last Iterator pointing to one beyond the end of data.
+
+    \pre [@c first, @c last) is a valid range.
+    \pre @c RandomAccessIter @c value_type is mutable and default constructible.
+    \post The elements in the range [@c first, @c last) are sorted in ascending order,
+    and the equal elements are in their original order.
+
+    \throws std::exception Propagates exceptions if any of the element moves,
+    or any operations on iterators throw, and std::bad_alloc if the buffer can't be allocated.
+
+    \warning -0.0 is sorted before 0.0, as their bits differ.
+    \warning NaNs are sorted by their bits, after the positive infinity if their sign bit
+    is clear, and before the negative infinity if it's set.
+
+    \remark Needs @c last - @c first elements of additional memory.
+  */
+  template <class RandomAccessIter>
+  inline void stable_float_sort(RandomAccessIter first, RandomAccessIter last)
+  {
+    if (last - first < 2)
+      return;
+    detail::stable_float_sort(first, last);
+  }
+
+  /*!
+    \brief Stable floating-point sort algorithm using random access iterators with just right-shift functor.
+
+    \details See the plain @c stable_float_sort for the algorithm.
+
+    \param[in] first Iterator pointer to first element.
+    \param[in] last Iterator pointing to one beyond the end of data.
+    \param[in] rshift Functor that returns the result of shifting the value_type right a specified number of bits.
+    Only @c rshift(x, 0) is used, and it must return the key of x cast to a signed integer of the same size.
+
+    \pre [@c first, @c last) is a valid range.
+    \pre @c RandomAccessIter @c value_type is mutable and default constructible.
+    \post The elements in the range [@c first, @c last) are sorted in ascending order of their keys,
+    and the elements with equal keys are in their original order.
+  */
+  template <class RandomAccessIter, class Right_shift>
+  inline void stable_float_sort(RandomAccessIter first, RandomAccessIter last,
+                                Right_shift rshift)
+  {
+    if (last - first < 2)
+      return;
+    detail::stable_float_sort(first, last, rshift(*first, 0), rshift);
+  }
+}
+}
+}
+
+#endif
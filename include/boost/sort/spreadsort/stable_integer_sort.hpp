@@ -0,0 +1,95 @@
+//Templated radix-based implementation of stable_integer_sort
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort/ for library home page.
+
+#ifndef BOOST_STABLE_INTEGER_SORT_HPP
+#define BOOST_STABLE_INTEGER_SORT_HPP
+#include <boost/sort/spreadsort/detail/stable_radix_sort.hpp>
+
+namespace boost {
+namespace sort {
+namespace spreadsort {
+
+/*! \brief Stable integer sort algorithm using random access iterators.
+
+  \details @c stable_integer_sort sorts the elements by their integer keys, keeping the order of
+the elements with equal keys, as needed by records of a key and a payload, like
+(timestamp, event) pairs.  It does one counting pass per byte of the key, from the least
+significant, scattering the elements to a buffer of @c last - @c first elements and back, as
+@c integer_sort_lsd; the histograms of all the bytes are counted in a single pass, and a pass
+is skipped when every key has the same value in that byte.\n
+Unlike @c integer_sort_lsd, it stays stable when it falls back to a comparison sort: ranges
+of fewer than @c detail::min_sort_size elements, and keys which aren't integers, are sorted
+with @c std::stable_sort by their keys.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable and default constructible.
+   \pre @c RandomAccessIter @c value_type supports the @c operator>>,
+   which returns an integer-type right-shifted a specified number of bits.
+   \post The elements in the range [@c first, @c last) are sorted in ascending order,
+   and the elements with equal keys are in their original order.
+
+   \throws std::exception Propagates exceptions if any of the element moves,
+   the right shift, or any operations on iterators throw,
+   and std::bad_alloc if the buffer can't be allocated.
+
+   \warning Throwing an exception may cause data loss.
+   \warning Invalid arguments cause undefined behaviour.
+
+   \remark <em> O(N * K/8) </em> operations, where:
+   \remark  *  N is @c last - @c first,
+   \remark  *  K is the size of the key in bits.
+   \remark Needs @c last - @c first elements of additional memory.
+*/
+  template <class RandomAccessIter>
+  inline void stable_integer_sort(RandomAccessIter first,
+                                  RandomAccessIter last)
+  {
+    if (last - first < 2)
+      return;
+    detail::stable_integer_sort(first, last, *first >> 0);
+  }
+
+/*! \brief Stable integer sort algorithm using random access iterators with just right-shift functor.
+
+  \details See the plain @c stable_integer_sort for the algorithm.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] shift A functor that returns the result of shifting the value_type right a specified number of bits.
+   Only @c shift(x, 0) is used, and it must return an integer type.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable and default constructible.
+   \post The elements in the range [@c first, @c last) are sorted in ascending order of @c shift(x, 0),
+   and the elements with equal keys are in their original order.
+
+   \throws std::exception Propagates exceptions if any of the element moves,
+   the right shift, functors, or any operations on iterators throw,
+   and std::bad_alloc if the buffer can't be allocated.
+
+   \warning Throwing an exception may cause data loss.
+   \warning Invalid arguments cause undefined behaviour.
+
+   \remark Needs @c last - @c first elements of additional memory.
+*/
+  template <class RandomAccessIter, class Right_shift>
+  inline void stable_integer_sort(RandomAccessIter first,
+                                  RandomAccessIter last, Right_shift shift)
+  {
+    if (last - first < 2)
+      return;
+    detail::stable_integer_sort(first, last, shift(*first, 0), shift);
+  }
+}
+}
+}
+
+#endif
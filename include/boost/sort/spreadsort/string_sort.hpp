@@ -20,6 +20,7 @@ Phil Endecott and Frank Gennari
 #include <limits>
 #include <boost/static_assert.hpp>
 #include <boost/sort/spreadsort/detail/constants.hpp>
+#include <boost/sort/spreadsort/tuning.hpp>
 #include <boost/sort/spreadsort/detail/string_sort.hpp>
 #include <boost/range/begin.hpp>
 #include <boost/range/end.hpp>
@@ -29,7 +30,7 @@ namespace sort {
 namespace spreadsort {
 
 /*! \brief String sort algorithm using random access iterators, allowing character-type overloads.\n
-  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c detail::min_sort_size).
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
 
   \details @c string_sort is a fast templated in-place hybrid radix/comparison algorithm,
 which in testing tends to be roughly 50% to 2X faster than @c std::sort for large tests (>=100kB).\n
@@ -75,14 +76,14 @@ Some performance plots of runtime vs. n and log(range) are provided:\n
                           Unsigned_char_type unused)
   {
     //Don't sort if it's too small to optimize
-    if (last - first < detail::min_sort_size)
+    if (size_t(last - first) < current_tuning().min_sort_size)
       boost::sort::pdqsort(first, last);
     else
       detail::string_sort(first, last, unused);
   }
 
 /*! \brief String sort algorithm using range, allowing character-type overloads.\n
-  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c detail::min_sort_size).
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
 
   \details @c string_sort is a fast templated in-place hybrid radix/comparison algorithm,
 which in testing tends to be roughly 50% to 2X faster than @c std::sort for large tests (>=100kB).\n
@@ -124,7 +125,7 @@ inline void string_sort(Range& range, Unsigned_char_type unused)
 }
 
 /*! \brief String sort algorithm using random access iterators, wraps using default of unsigned char.
-  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c detail::min_sort_size).
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
 
   \details @c string_sort is a fast templated in-place hybrid radix/comparison algorithm,
 which in testing tends to be roughly 50% to 2X faster than @c std::sort for large tests (>=100kB).\n
@@ -168,8 +169,44 @@ Some performance plots of runtime vs. n and log(range) are provided:\n
     string_sort(first, last, unused);
   }
 
+/*! \brief String sort algorithm using random access iterators and a reusable @c spreadsort_context, wraps using default of unsigned char.
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
+
+  \details Same as @c string_sort(first, last), but the bin positions are kept
+in @c context instead of in memory allocated by the call, so sorting many
+ranges with the same context doesn't allocate memory in each sort.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in,out] context Scratch space reused across calls.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable.
+   \pre @c RandomAccessIter @c value_type is <a href="http://en.cppreference.com/w/cpp/concept/LessThanComparable">LessThanComparable</a>
+   \post The elements in the range [@c first, @c last) are sorted in ascending order.
+
+   \throws std::exception Propagates exceptions if any of the element comparisons, the element swaps (or moves),
+   the right shift, subtraction of right-shifted elements, functors,
+   or any operations on iterators throw.
+
+   \warning Throwing an exception may cause data loss. This will also throw if the context grows and the allocation throws, in which case there will be no data loss.
+   \warning The context must not be used by another sort at the same time.
+*/
+  template <class RandomAccessIter>
+  inline void string_sort(RandomAccessIter first, RandomAccessIter last,
+                          spreadsort_context<RandomAccessIter> &context)
+  {
+    //Don't sort if it's too small to optimize
+    if (size_t(last - first) < current_tuning().min_sort_size)
+      boost::sort::pdqsort(first, last);
+    else {
+      unsigned char unused = '\0';
+      detail::string_sort(first, last, unused, &context);
+    }
+  }
+
 /*! \brief String sort algorithm using range, wraps using default of unsigned char.
-  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c detail::min_sort_size).
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
 
   \details @c string_sort is a fast templated in-place hybrid radix/comparison algorithm,
 which in testing tends to be roughly 50% to 2X faster than @c std::sort for large tests (>=100kB).\n
@@ -209,7 +246,7 @@ inline void string_sort(Range& range)
 
 /*! \brief String sort algorithm using random access iterators, allowing character-type overloads.
 
-  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < detail::min_sort_size).
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
 
   \details @c string_sort is a fast templated in-place hybrid radix/comparison algorithm,
 which in testing tends to be roughly 50% to 2X faster than @c std::sort for large tests (>=100kB).\n
@@ -259,7 +296,7 @@ Some performance plots of runtime vs. n and log(range) are provided:\n
                 RandomAccessIter last, Compare comp, Unsigned_char_type unused)
   {
     //Don't sort if it's too small to optimize.
-    if (last - first < detail::min_sort_size)
+    if (size_t(last - first) < current_tuning().min_sort_size)
       boost::sort::pdqsort(first, last, comp);
     else
       detail::reverse_string_sort(first, last, unused);
@@ -267,7 +304,7 @@ Some performance plots of runtime vs. n and log(range) are provided:\n
 
 /*! \brief String sort algorithm using range, allowing character-type overloads.
 
-  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < detail::min_sort_size).
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
 
   \details @c string_sort is a fast templated in-place hybrid radix/comparison algorithm,
 which in testing tends to be roughly 50% to 2X faster than @c std::sort for large tests (>=100kB).\n
@@ -314,7 +351,7 @@ inline void reverse_string_sort(Range& range, Compare comp, Unsigned_char_type u
 
 /*! \brief String sort algorithm using random access iterators,  wraps using default of @c unsigned char.
 
-  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c detail::min_sort_size).
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
 
   \details @c string_sort is a fast templated in-place hybrid radix/comparison algorithm,
 which in testing tends to be roughly 50% to 2X faster than @c std::sort for large tests (>=100kB).\n
@@ -363,7 +400,7 @@ Some performance plots of runtime vs. n and log(range) are provided:\n
 
 /*! \brief String sort algorithm using range, wraps using default of @c unsigned char.
 
-  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c detail::min_sort_size).
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
 
   \details @c string_sort is a fast templated in-place hybrid radix/comparison algorithm,
 which in testing tends to be roughly 50% to 2X faster than @c std::sort for large tests (>=100kB).\n
@@ -405,7 +442,7 @@ inline void reverse_string_sort(Range& range, Compare comp)
 
 /*! \brief String sort algorithm using random access iterators,  wraps using default of @c unsigned char.
 
-  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c detail::min_sort_size).
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
 
   \details @c string_sort is a fast templated in-place hybrid radix/comparison algorithm,
 which in testing tends to be roughly 50% to 2X faster than @c std::sort for large tests (>=100kB).\n
@@ -451,7 +488,7 @@ Some performance plots of runtime vs. n and log(range) are provided:\n
                           Get_char get_character, Get_length length)
   {
     //Don't sort if it's too small to optimize
-    if (last - first < detail::min_sort_size)
+    if (size_t(last - first) < current_tuning().min_sort_size)
       boost::sort::pdqsort(first, last);
     else {
       //skipping past empties, which allows us to get the character type
@@ -466,7 +503,7 @@ Some performance plots of runtime vs. n and log(range) are provided:\n
 
 /*! \brief String sort algorithm using range, wraps using default of @c unsigned char.
 
-  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c detail::min_sort_size).
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
 
   \details @c string_sort is a fast templated in-place hybrid radix/comparison algorithm,
 which in testing tends to be roughly 50% to 2X faster than @c std::sort for large tests (>=100kB).\n
@@ -511,7 +548,7 @@ inline void string_sort(Range& range, Get_char get_character, Get_length length)
 
 /*! \brief String sort algorithm using random access iterators,  wraps using default of @c unsigned char.
 
-  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c detail::min_sort_size).
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
 
   \details @c string_sort is a fast templated in-place hybrid radix/comparison algorithm,
 which in testing tends to be roughly 50% to 2X faster than @c std::sort for large tests (>=100kB).\n
@@ -559,7 +596,7 @@ Some performance plots of runtime vs. n and log(range) are provided:\n
                           Get_char get_character, Get_length length, Compare comp)
   {
     //Don't sort if it's too small to optimize
-    if (last - first < detail::min_sort_size)
+    if (size_t(last - first) < current_tuning().min_sort_size)
       boost::sort::pdqsort(first, last, comp);
     else {
       //skipping past empties, which allows us to get the character type
@@ -573,9 +610,56 @@ Some performance plots of runtime vs. n and log(range) are provided:\n
     }
   }
 
+/*! \brief String sort algorithm using random access iterators with functors and a reusable @c spreadsort_context.
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
+
+  \details Same as @c string_sort(first, last, get_character, length, comp),
+but the bin positions are kept in @c context instead of in memory allocated by
+the call.
+
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] get_character Bracket functor equivalent to @c operator[], taking a number corresponding to the character offset.
+   \param[in] length Functor to get the length of the string in characters.
+   \param[in] comp A binary functor that returns whether the first element passed to it should go before the second in order.
+   \param[in,out] context Scratch space reused across calls.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable.
+   \post The elements in the range [@c first, @c last) are sorted in ascending order.
+
+   \throws std::exception Propagates exceptions if any of the element comparisons, the element swaps (or moves),
+   the right shift, subtraction of right-shifted elements, functors,
+   or any operations on iterators throw.
+
+   \warning Throwing an exception may cause data loss. This will also throw if the context grows and the allocation throws, in which case there will be no data loss.
+   \warning The context must not be used by another sort at the same time.
+*/
+  template <class RandomAccessIter, class Get_char, class Get_length,
+            class Compare>
+  inline void string_sort(RandomAccessIter first, RandomAccessIter last,
+                          Get_char get_character, Get_length length,
+                          Compare comp,
+                          spreadsort_context<RandomAccessIter> &context)
+  {
+    //Don't sort if it's too small to optimize
+    if (size_t(last - first) < current_tuning().min_sort_size)
+      boost::sort::pdqsort(first, last, comp);
+    else {
+      //skipping past empties, which allows us to get the character type
+      //.empty() is not used so as not to require a user declaration of it
+      while (!length(*first)) {
+        if (++first == last)
+          return;
+      }
+      detail::string_sort(first, last, get_character, length, comp,
+                          get_character((*first), 0), &context);
+    }
+  }
+
 /*! \brief String sort algorithm using range, wraps using default of @c unsigned char.
 
-  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c detail::min_sort_size).
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
 
   \details @c string_sort is a fast templated in-place hybrid radix/comparison algorithm,
 which in testing tends to be roughly 50% to 2X faster than @c std::sort for large tests (>=100kB).\n
@@ -623,7 +707,7 @@ inline void string_sort(Range& range,
 
 /*! \brief Reverse String sort algorithm using random access iterators.
 
-  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c detail::min_sort_size).
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
 
  \details @c string_sort is a fast templated in-place hybrid radix/comparison algorithm,
 which in testing tends to be roughly 50% to 2X faster than @c std::sort for large tests (>=100kB).\n
@@ -671,7 +755,7 @@ Some performance plots of runtime vs. n and log(range) are provided:\n
     RandomAccessIter last, Get_char get_character, Get_length length, Compare comp)
   {
     //Don't sort if it's too small to optimize
-    if (last - first < detail::min_sort_size)
+    if (size_t(last - first) < current_tuning().min_sort_size)
       boost::sort::pdqsort(first, last, comp);
     else {
       //skipping past empties, which allows us to get the character type
@@ -689,7 +773,7 @@ Some performance plots of runtime vs. n and log(range) are provided:\n
 
 /*! \brief Reverse String sort algorithm using range.
 
-  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c detail::min_sort_size).
+  (All variants fall back to @c boost::sort::pdqsort if the data size is too small, < @c tuning::min_sort_size).
 
  \details @c string_sort is a fast templated in-place hybrid radix/comparison algorithm,
 which in testing tends to be roughly 50% to 2X faster than @c std::sort for large tests (>=100kB).\n
@@ -734,6 +818,127 @@ inline void reverse_string_sort(Range& range, Get_char get_character, Get_length
 {
     reverse_string_sort(boost::begin(range), boost::end(range), get_character, length, comp);
 }
+
+/*! \brief String sort algorithm using random access iterators, wraps using default of unsigned char, with the @c min_sort_size of a @c tuning_policy.
+  (Falls back to @c boost::sort::pdqsort if the data size is too small, < @c Tuning::min_sort_size()).
+
+  \details Same as @c string_sort(first, last), called as @c string_sort<Tuning>(first, last),
+but the size below which it falls back to @c pdqsort is that of @c Tuning instead of @c current_tuning().
+The bins of @c string_sort are set by the character size, so the other values of @c Tuning are unused.
+
+   \tparam Tuning A @c tuning_policy.
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable.
+   \pre @c RandomAccessIter @c value_type is <a href="http://en.cppreference.com/w/cpp/concept/LessThanComparable">LessThanComparable</a>
+   \post The elements in the range [@c first, @c last) are sorted in ascending order.
+
+   \throws std::exception Propagates exceptions if any of the element comparisons, the element swaps (or moves),
+   functors, or any operations on iterators throw.
+
+   \warning Throwing an exception may cause data loss. This will also throw if a small vector resize throws, in which case there will be no data loss.
+*/
+  template <class Tuning, class RandomAccessIter>
+  inline typename boost::enable_if_c< detail::is_tuning_policy<Tuning>::value,
+                                      void >::type
+  string_sort(RandomAccessIter first, RandomAccessIter last)
+  {
+    //Don't sort if it's too small to optimize
+    if (size_t(last - first) < Tuning::min_sort_size())
+      boost::sort::pdqsort(first, last);
+    else {
+      unsigned char unused = '\0';
+      detail::string_sort(first, last, unused);
+    }
+  }
+
+/*! \brief String sort algorithm using random access iterators with both character access and length functors, with the @c min_sort_size of a @c tuning_policy.
+  (Falls back to @c boost::sort::pdqsort if the data size is too small, < @c Tuning::min_sort_size()).
+
+  \details Same as @c string_sort(first, last, get_character, length), called as
+@c string_sort<Tuning>(first, last, get_character, length), but with the @c min_sort_size of @c Tuning.
+
+   \tparam Tuning A @c tuning_policy.
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] get_character Bracket functor equivalent to @c operator[], taking a number corresponding to the character offset.
+   \param[in] length Functor to get the length of the string in characters.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable.
+   \pre @c RandomAccessIter @c value_type is <a href="http://en.cppreference.com/w/cpp/concept/LessThanComparable">LessThanComparable</a>
+   \post The elements in the range [@c first, @c last) are sorted in ascending order.
+
+   \throws std::exception Propagates exceptions if any of the element comparisons, the element swaps (or moves),
+   functors, or any operations on iterators throw.
+
+   \warning Throwing an exception may cause data loss. This will also throw if a small vector resize throws, in which case there will be no data loss.
+*/
+  template <class Tuning, class RandomAccessIter, class Get_char,
+            class Get_length>
+  inline typename boost::enable_if_c< detail::is_tuning_policy<Tuning>::value,
+                                      void >::type
+  string_sort(RandomAccessIter first, RandomAccessIter last,
+              Get_char get_character, Get_length length)
+  {
+    //Don't sort if it's too small to optimize
+    if (size_t(last - first) < Tuning::min_sort_size())
+      boost::sort::pdqsort(first, last);
+    else {
+      //skipping past empties, which allows us to get the character type
+      while (!length(*first)) {
+        if (++first == last)
+          return;
+      }
+      detail::string_sort(first, last, get_character, length,
+                          get_character((*first), 0));
+    }
+  }
+
+/*! \brief String sort algorithm using random access iterators with character access, length and comparison functors, with the @c min_sort_size of a @c tuning_policy.
+  (Falls back to @c boost::sort::pdqsort if the data size is too small, < @c Tuning::min_sort_size()).
+
+  \details Same as @c string_sort(first, last, get_character, length, comp), called as
+@c string_sort<Tuning>(first, last, get_character, length, comp), but with the @c min_sort_size of @c Tuning.
+
+   \tparam Tuning A @c tuning_policy.
+   \param[in] first Iterator pointer to first element.
+   \param[in] last Iterator pointing to one beyond the end of data.
+   \param[in] get_character Bracket functor equivalent to @c operator[], taking a number corresponding to the character offset.
+   \param[in] length Functor to get the length of the string in characters.
+   \param[in] comp A binary functor that returns whether the first element passed to it should go before the second in order.
+
+   \pre [@c first, @c last) is a valid range.
+   \pre @c RandomAccessIter @c value_type is mutable.
+   \post The elements in the range [@c first, @c last) are sorted in ascending order.
+
+   \throws std::exception Propagates exceptions if any of the element comparisons, the element swaps (or moves),
+   functors, or any operations on iterators throw.
+
+   \warning Throwing an exception may cause data loss. This will also throw if a small vector resize throws, in which case there will be no data loss.
+*/
+  template <class Tuning, class RandomAccessIter, class Get_char,
+            class Get_length, class Compare>
+  inline typename boost::enable_if_c< detail::is_tuning_policy<Tuning>::value,
+                                      void >::type
+  string_sort(RandomAccessIter first, RandomAccessIter last,
+              Get_char get_character, Get_length length, Compare comp)
+  {
+    //Don't sort if it's too small to optimize
+    if (size_t(last - first) < Tuning::min_sort_size())
+      boost::sort::pdqsort(first, last, comp);
+    else {
+      //skipping past empties, which allows us to get the character type
+      while (!length(*first)) {
+        if (++first == last)
+          return;
+      }
+      detail::string_sort(first, last, get_character, length, comp,
+                          get_character((*first), 0));
+    }
+  }
 }
 }
 }
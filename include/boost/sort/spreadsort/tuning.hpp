@@ -0,0 +1,254 @@
+// Runtime tuning values of integer_sort, float_sort and string_sort.
+
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/sort for library home page.
+
+#ifndef BOOST_SORT_SPREADSORT_TUNING_HPP
+#define BOOST_SORT_SPREADSORT_TUNING_HPP
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <boost/static_assert.hpp>
+#include <boost/sort/spreadsort/detail/constants.hpp>
+
+namespace boost {
+namespace sort {
+namespace spreadsort {
+
+/*! \brief Tuning values of @c integer_sort, @c float_sort and @c string_sort.
+
+  \details The sorts read these values at runtime, so one binary can be tuned
+for each machine it runs on.  They default to the constants of
+@c detail/constants.hpp, and are replaced with @c set_tuning, or measured on
+the machine with @c calibrate (see @c calibrate.hpp).\n
+A profile saved by @c save_tuning is loaded on the first use of the sorts
+when the environment variable @c BOOST_SORT_TUNING_PROFILE names it.\n
+The fields have the meaning of the constants of the same name.
+*/
+  struct tuning {
+    //! Log of the maximum number of bins of a radix iteration
+    unsigned max_splits;
+    //! Log of the minimum number of elements per bin of @c integer_sort
+    unsigned int_log_mean_bin_size;
+    //! Log of the bin count below which @c integer_sort compares
+    unsigned int_log_min_split_count;
+    //! Log of the count which @c integer_sort finishes in one iteration
+    unsigned int_log_finishing_count;
+    //! Log of the minimum number of elements per bin of @c float_sort
+    unsigned float_log_mean_bin_size;
+    //! Log of the bin count below which @c float_sort compares
+    unsigned float_log_min_split_count;
+    //! Log of the count which @c float_sort finishes in one iteration
+    unsigned float_log_finishing_count;
+    //! Size below which the three sorts fall back to @c pdqsort
+    unsigned min_sort_size;
+  };
+
+  //! The tuning values of @c detail/constants.hpp.
+  inline tuning default_tuning()
+  {
+    BOOST_STATIC_ASSERT(detail::max_splits > 1 &&
+                        detail::max_splits <= detail::max_tuned_splits);
+    BOOST_STATIC_ASSERT(detail::max_finishing_splits == detail::max_splits + 1);
+    tuning values = { detail::max_splits, detail::int_log_mean_bin_size,
+      detail::int_log_min_split_count, detail::int_log_finishing_count,
+      detail::float_log_mean_bin_size, detail::float_log_min_split_count,
+      detail::float_log_finishing_count, detail::min_sort_size };
+    return values;
+  }
+
+  //! True if the sorts work with the tuning values.
+  inline bool valid_tuning(const tuning &values)
+  {
+    const unsigned size_bits = 8 * sizeof(size_t);
+    return values.max_splits > 1 &&
+      values.max_splits <= unsigned(detail::max_tuned_splits) &&
+      values.int_log_min_split_count > 0 &&
+      values.int_log_min_split_count <= values.max_splits &&
+      values.float_log_min_split_count > 0 &&
+      values.float_log_min_split_count <= values.max_splits &&
+      values.int_log_mean_bin_size < size_bits &&
+      values.float_log_mean_bin_size < size_bits &&
+      values.int_log_finishing_count < size_bits &&
+      values.float_log_finishing_count < size_bits &&
+      values.min_sort_size > 1;
+  }
+
+/*! \brief Compile-time tuning values of one call of @c integer_sort, @c float_sort or @c string_sort.
+
+  \details Passed as the first template argument, as in
+@c integer_sort<tuning_policy<9, 3> >(first, last), the policy replaces the
+runtime values of @c current_tuning() for that call only, so a hot call site
+can be tuned for the data it sorts (such as 16-bit keys, or many small sorts)
+without affecting the rest of the program.  The values are constants, so the
+thresholds of each iteration are computed at compile time.\n
+The defaults are those of @c integer_sort; @c float_sort defaults to
+@c tuning_policy<detail::max_splits, detail::float_log_mean_bin_size,
+detail::float_log_min_split_count, detail::float_log_finishing_count>.
+@c string_sort only uses @c MinSortSize.
+
+  \tparam MaxSplits Log of the maximum number of bins of a radix iteration.
+  \tparam LogMeanBinSize Log of the minimum number of elements per bin.
+  \tparam LogMinSplitCount Log of the bin count below which the sort compares.
+  \tparam LogFinishingCount Log of the count finished in one iteration.
+  \tparam MinSortSize Size below which the sort falls back to @c pdqsort.
+*/
+  template <unsigned MaxSplits = detail::max_splits,
+            unsigned LogMeanBinSize = detail::int_log_mean_bin_size,
+            unsigned LogMinSplitCount = detail::int_log_min_split_count,
+            unsigned LogFinishingCount = detail::int_log_finishing_count,
+            unsigned MinSortSize = detail::min_sort_size>
+  struct tuning_policy {
+    //The limits of valid_tuning
+    BOOST_STATIC_ASSERT(MaxSplits > 1 &&
+                        MaxSplits <= unsigned(detail::max_tuned_splits));
+    BOOST_STATIC_ASSERT(LogMinSplitCount > 0 && LogMinSplitCount <= MaxSplits);
+    BOOST_STATIC_ASSERT(LogMeanBinSize < 8 * sizeof(size_t) &&
+                        LogFinishingCount < 8 * sizeof(size_t));
+    BOOST_STATIC_ASSERT(MinSortSize > 1);
+
+    static unsigned max_splits() { return MaxSplits; }
+    static unsigned log_mean_bin_size() { return LogMeanBinSize; }
+    static unsigned log_min_split_count() { return LogMinSplitCount; }
+    static unsigned log_finishing_count() { return LogFinishingCount; }
+    static unsigned min_sort_size() { return MinSortSize; }
+  };
+
+  namespace detail {
+    //Selects the overloads of the sorts which take a tuning_policy
+    template <class Tuning>
+    struct is_tuning_policy { static const bool value = false; };
+
+    template <unsigned MaxSplits, unsigned LogMeanBinSize,
+              unsigned LogMinSplitCount, unsigned LogFinishingCount,
+              unsigned MinSortSize>
+    struct is_tuning_policy<tuning_policy<MaxSplits, LogMeanBinSize,
+      LogMinSplitCount, LogFinishingCount, MinSortSize> >
+    { static const bool value = true; };
+
+    //Name of each value in a profile
+    struct tuning_field {
+      const char *name;
+      unsigned tuning::*value;
+    };
+
+    inline const tuning_field *tuning_fields()
+    {
+      static const tuning_field fields[] = {
+        { "max_splits", &tuning::max_splits },
+        { "int_log_mean_bin_size", &tuning::int_log_mean_bin_size },
+        { "int_log_min_split_count", &tuning::int_log_min_split_count },
+        { "int_log_finishing_count", &tuning::int_log_finishing_count },
+        { "float_log_mean_bin_size", &tuning::float_log_mean_bin_size },
+        { "float_log_min_split_count", &tuning::float_log_min_split_count },
+        { "float_log_finishing_count", &tuning::float_log_finishing_count },
+        { "min_sort_size", &tuning::min_sort_size },
+        { 0, 0 } };
+      return fields;
+    }
+  }
+
+/*! \brief Reads a profile written by @c save_tuning.
+
+  \details The profile is a text file with a name and a value on each line;
+lines starting with @c # are comments.  Missing values keep their defaults.
+
+  \param[in] path Name of the profile.
+  \param[out] values The tuning values read; unchanged if the profile can't be used.
+  \return false if the file can't be read, or its values aren't valid.
+*/
+  inline bool load_tuning(const char *path, tuning &values)
+  {
+    std::FILE *file = std::fopen(path, "r");
+    if (!file)
+      return false;
+    tuning loaded = default_tuning();
+    char line[256];
+    bool good = true;
+    while (good && std::fgets(line, sizeof(line), file)) {
+      char name[64];
+      unsigned long value;
+      if (line[0] == '#' || std::sscanf(line, "%63s", name) != 1)
+        continue;
+      good = std::sscanf(line, "%63s %lu", name, &value) == 2;
+      const detail::tuning_field *field = detail::tuning_fields();
+      for (; good && field->name; ++field) {
+        if (!std::strcmp(field->name, name)) {
+          loaded.*(field->value) = unsigned(value);
+          break;
+        }
+      }
+    }
+    std::fclose(file);
+    if (!good || !valid_tuning(loaded))
+      return false;
+    values = loaded;
+    return true;
+  }
+
+/*! \brief Writes the tuning values to a profile, for @c load_tuning.
+
+  \param[in] path Name of the profile, which is overwritten.
+  \param[in] values The tuning values.
+  \return false if the file can't be written.
+*/
+  inline bool save_tuning(const char *path, const tuning &values)
+  {
+    std::FILE *file = std::fopen(path, "w");
+    if (!file)
+      return false;
+    bool good = std::fprintf(file, "# spreadsort tuning profile\n") > 0;
+    for (const detail::tuning_field *field = detail::tuning_fields();
+        good && field->name; ++field)
+      good = std::fprintf(file, "%s %u\n", field->name,
+                          values.*(field->value)) > 0;
+    return std::fclose(file) == 0 && good;
+  }
+
+  namespace detail {
+    //The defaults, or the profile named by BOOST_SORT_TUNING_PROFILE
+    inline tuning initial_tuning()
+    {
+      tuning values = default_tuning();
+      const char *profile = std::getenv("BOOST_SORT_TUNING_PROFILE");
+      if (profile && *profile)
+        load_tuning(profile, values);
+      return values;
+    }
+
+    inline tuning &tuning_state()
+    {
+      static tuning values = initial_tuning();
+      return values;
+    }
+  }
+
+  //! The tuning values used by the sorts.
+  inline const tuning &current_tuning()
+  {
+    return detail::tuning_state();
+  }
+
+/*! \brief Replaces the tuning values used by the sorts.
+
+  \param[in] values The new tuning values.
+  \return false, leaving the values unchanged, if they aren't valid.
+
+  \warning Not thread-safe: no sort may run while the values are replaced.
+*/
+  inline bool set_tuning(const tuning &values)
+  {
+    if (!valid_tuning(values))
+      return false;
+    detail::tuning_state() = values;
+    return true;
+  }
+}
+}
+}
+
+#endif
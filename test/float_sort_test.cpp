@@ -8,6 +8,7 @@
 //  See http://www.boost.org/libs/sort for library home page.
 
 #include <boost/sort/spreadsort/spreadsort.hpp>
+#include <boost/sort/spreadsort/stable_float_sort.hpp>
 // Include unit test framework
 #include <boost/test/included/test_exec_monitor.hpp>
 #include <boost/test/test_tools.hpp>
@@ -144,6 +145,146 @@ void corner_test() {
   BOOST_CHECK(test_vec[0] == test_value);
 }
 
+// Sorting ranges of many sizes with the same context.
+void context_test() {
+  spreadsort_context<vector<float>::iterator> context;
+  context.reserve(1024);
+  BOOST_CHECK(context.capacity() >= 1024);
+  for (unsigned count = 1; count <= 200000; count *= 3) {
+    vector<float> base_vec;
+    for (unsigned u = 0; u < count; ++u) {
+      float val = float(rand_32());
+      if (!(val < 0.0) && !(0.0 < val))
+        base_vec.push_back(0.0);
+      else
+        base_vec.push_back(val);
+    }
+    vector<float> sorted_vec = base_vec;
+    std::sort(sorted_vec.begin(), sorted_vec.end());
+    vector<float> test_vec = base_vec;
+    float_sort(test_vec.begin(), test_vec.end(), context);
+    BOOST_CHECK(test_vec == sorted_vec);
+    test_vec = base_vec;
+    float_sort(test_vec.begin(), test_vec.end(), rightshift(), less<float>(),
+               context);
+    BOOST_CHECK(test_vec == sorted_vec);
+  }
+}
+
+// Checks that *nth is in its sorted position, and the range is partitioned
+// around it.
+template <class FloatType>
+void check_selected(const vector<FloatType> &test_vec,
+                    const vector<FloatType> &sorted_vec, size_t pos)
+{
+  BOOST_CHECK(test_vec[pos] == sorted_vec[pos]);
+  for (size_t u = 0; u < pos; ++u)
+    BOOST_CHECK(!(test_vec[pos] < test_vec[u]));
+  for (size_t u = pos + 1; u < test_vec.size(); ++u)
+    BOOST_CHECK(!(test_vec[u] < test_vec[pos]));
+}
+
+template <class FloatType, class RightShift>
+void select_positions(const vector<FloatType> &base_vec, RightShift shifter)
+{
+  vector<FloatType> sorted_vec = base_vec;
+  std::sort(sorted_vec.begin(), sorted_vec.end());
+  size_t positions[] = { 0, base_vec.size() / 2, base_vec.size() - 1 };
+  for (unsigned u = 0; u < sizeof(positions) / sizeof(positions[0]); ++u) {
+    size_t pos = positions[u];
+    if (pos >= base_vec.size())
+      continue;
+    vector<FloatType> test_vec = base_vec;
+    float_select(test_vec.begin(), test_vec.begin() + pos, test_vec.end());
+    check_selected(test_vec, sorted_vec, pos);
+    test_vec = base_vec;
+    float_select(test_vec.begin(), test_vec.begin() + pos, test_vec.end(),
+                 shifter);
+    check_selected(test_vec, sorted_vec, pos);
+    test_vec = base_vec;
+    float_select(test_vec.begin(), test_vec.begin() + pos, test_vec.end(),
+                 shifter, less<FloatType>());
+    check_selected(test_vec, sorted_vec, pos);
+  }
+}
+
+// Selection of negative and positive floats and doubles, with few keys.
+void select_test() {
+  unsigned sizes[] = { 1, 999, 1000, 100000 };
+  for (unsigned s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    vector<float> float_vec, few_vec;
+    vector<double> double_vec;
+    for (unsigned u = 0; u < sizes[s]; ++u) {
+      float val = float(rand_32()) / 1000;
+      float_vec.push_back((!(val < 0.0) && !(0.0 < val)) ? 0.0f : val);
+      few_vec.push_back(float(rand() % 16) - 7.5f);
+      double dval = double(rand_32()) * double(rand_32());
+      double_vec.push_back((!(dval < 0.0) && !(0.0 < dval)) ? 0.0 : dval);
+    }
+    select_positions(float_vec, rightshift());
+    select_positions(few_vec, rightshift());
+    select_positions(double_vec, rightshift_64());
+  }
+}
+
+//Floats with the position they had before the sort
+struct float_record {
+  float key;
+  unsigned index;
+  bool operator==(const float_record &x) const
+  { return key == x.key && index == x.index; }
+};
+
+struct record_rightshift {
+  int operator()(const float_record &x, const unsigned offset) const {
+    return float_mem_cast<float, int>(x.key) >> offset;
+  }
+};
+
+struct record_key_less {
+  bool operator()(const float_record &x, const float_record &y) const
+  { return x.key < y.key; }
+};
+
+// Stable sort of records with few keys, and of negative and positive floats
+// and doubles, at the sizes sorted with std::stable_sort and with the radix
+// passes.
+void stable_test() {
+  unsigned sizes[] = { 2, 999, 1000, 100000 };
+  for (unsigned s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    vector<float_record> record_vec;
+    vector<float> float_vec;
+    vector<double> double_vec;
+    for (unsigned u = 0; u < sizes[s]; ++u) {
+      float_record record = { float(rand() % 16) - 7.5f, u };
+      record_vec.push_back(record);
+      float val = float(rand_32()) / 1000;
+      float_vec.push_back((!(val < 0.0) && !(0.0 < val)) ? 0.0f : val);
+      double dval = double(rand_32()) * double(rand_32());
+      double_vec.push_back((!(dval < 0.0) && !(0.0 < dval)) ? 0.0 : dval);
+    }
+    vector<float_record> record_sorted = record_vec;
+    std::stable_sort(record_sorted.begin(), record_sorted.end(),
+                     record_key_less());
+    stable_float_sort(record_vec.begin(), record_vec.end(),
+                      record_rightshift());
+    BOOST_CHECK(record_vec == record_sorted);
+
+    vector<float> float_sorted = float_vec;
+    std::sort(float_sorted.begin(), float_sorted.end());
+    vector<float> float_test = float_vec;
+    stable_float_sort(float_test.begin(), float_test.end());
+    BOOST_CHECK(float_test == float_sorted);
+    float_test = float_vec;
+    stable_float_sort(float_test.begin(), float_test.end(), rightshift());
+    BOOST_CHECK(float_test == float_sorted);
+    vector<double> double_sorted = double_vec;
+    std::sort(double_sorted.begin(), double_sorted.end());
+    stable_float_sort(double_vec.begin(), double_vec.end());
+    BOOST_CHECK(double_vec == double_sorted);
+  }
+}
+
 // test main 
 int test_main( int, char*[] )
 {
@@ -151,5 +292,8 @@ int test_main( int, char*[] )
   float_test();
   double_test();
   corner_test();
+  context_test();
+  select_test();
+  stable_test();
   return 0;
 }
@@ -9,10 +9,15 @@
 
 #include <boost/cstdint.hpp>
 #include <boost/sort/spreadsort/spreadsort.hpp>
+#include <boost/sort/spreadsort/stable_integer_sort.hpp>
 // Include unit test framework
 #include <boost/test/included/test_exec_monitor.hpp>
 #include <boost/test/test_tools.hpp>
+#include <algorithm>
+#include <functional>
+#include <limits>
 #include <vector>
+#include <utility>
 
 #include <iostream>
 
@@ -111,6 +116,209 @@ void int_test()
   BOOST_CHECK(long_test_vec == long_sorted_vec);
 }
 
+struct pair_rightshift {
+  boost::int64_t operator()(const pair<boost::int64_t, unsigned> &x,
+                            unsigned offset) const {
+    return x.first >> offset;
+  }
+};
+
+struct pair_key_less {
+  bool operator()(const pair<boost::int64_t, unsigned> &x,
+                  const pair<boost::int64_t, unsigned> &y) const {
+    return x.first < y.first;
+  }
+};
+
+//A key which isn't an integer, sorted with std::stable_sort
+struct double_pair_rightshift {
+  double operator()(const pair<double, unsigned> &x, unsigned) const {
+    return x.first;
+  }
+};
+
+struct double_pair_key_less {
+  bool operator()(const pair<double, unsigned> &x,
+                  const pair<double, unsigned> &y) const {
+    return x.first < y.first;
+  }
+};
+
+void lsd_test()
+{
+  vector<int> base_vec;
+  unsigned count = 100000;
+  srand(3);
+  for (unsigned u = 0; u < count; ++u)
+    base_vec.push_back(rand_32());
+  vector<int> sorted_vec = base_vec;
+  std::sort(sorted_vec.begin(), sorted_vec.end());
+  vector<int> test_vec = base_vec;
+  integer_sort_lsd(test_vec.begin(), test_vec.end());
+  BOOST_CHECK(test_vec == sorted_vec);
+  test_vec = base_vec;
+  integer_sort_lsd(test_vec.begin(), test_vec.end(), rightshift());
+  BOOST_CHECK(test_vec == sorted_vec);
+  //Caller-provided buffer
+  test_vec = base_vec;
+  vector<int> buffer(count);
+  integer_sort_lsd(test_vec.begin(), test_vec.end(), rightshift(),
+                   buffer.begin());
+  BOOST_CHECK(test_vec == sorted_vec);
+
+  //Only the low bytes differ, so most of the passes are skipped
+  vector<boost::uint64_t> small_vec;
+  for (unsigned u = 0; u < count; ++u)
+    small_vec.push_back(0x1234567800000000ULL + (rand() % 1000));
+  vector<boost::uint64_t> small_sorted = small_vec;
+  std::sort(small_sorted.begin(), small_sorted.end());
+  vector<boost::uint64_t> small_copy = small_vec;
+  integer_sort_lsd(small_vec.begin(), small_vec.end(), rightshift_max());
+  BOOST_CHECK(small_vec == small_sorted);
+  //64-bit integers without a functor are sorted with integer_sort
+  integer_sort_lsd(small_copy.begin(), small_copy.end());
+  BOOST_CHECK(small_copy == small_sorted);
+
+  //Negative 64-bit keys with a payload; equal keys must keep their order
+  vector<pair<boost::int64_t, unsigned> > pair_vec;
+  for (unsigned u = 0; u < count; ++u)
+    pair_vec.push_back(make_pair(
+        (boost::int64_t(rand_32()) << 24) * (rand() % 64), u));
+  vector<pair<boost::int64_t, unsigned> > pair_sorted = pair_vec;
+  std::stable_sort(pair_sorted.begin(), pair_sorted.end(), pair_key_less());
+  integer_sort_lsd(pair_vec.begin(), pair_vec.end(), pair_rightshift());
+  BOOST_CHECK(pair_vec == pair_sorted);
+
+  //Keys which aren't integers are still sorted stably by the key, with the
+  //payloads in decreasing order so that sorting the pairs would differ
+  vector<pair<double, unsigned> > double_vec;
+  for (unsigned u = 0; u < count; ++u)
+    double_vec.push_back(make_pair(double(rand() % 64) / 4, count - u));
+  vector<pair<double, unsigned> > double_sorted = double_vec;
+  std::stable_sort(double_sorted.begin(), double_sorted.end(),
+                   double_pair_key_less());
+  integer_sort_lsd(double_vec.begin(), double_vec.end(),
+                   double_pair_rightshift());
+  BOOST_CHECK(double_vec == double_sorted);
+
+  //Equal keys and tiny inputs
+  vector<int> equal_vec(1000, 7);
+  integer_sort_lsd(equal_vec.begin(), equal_vec.end());
+  BOOST_CHECK(equal_vec == vector<int>(1000, 7));
+  vector<int> tiny_vec;
+  integer_sort_lsd(tiny_vec.begin(), tiny_vec.end());
+  tiny_vec.push_back(-1);
+  integer_sort_lsd(tiny_vec.begin(), tiny_vec.end());
+  BOOST_CHECK(tiny_vec.size() == 1 && tiny_vec[0] == -1);
+}
+
+// Records with few distinct keys must keep the order of their payloads, at
+// the sizes sorted with std::stable_sort and with the radix passes.
+void stable_test()
+{
+  srand(6);
+  unsigned sizes[] = { 2, 999, 1000, 100000 };
+  for (unsigned s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    vector<pair<boost::int64_t, unsigned> > pair_vec;
+    for (unsigned u = 0; u < sizes[s]; ++u)
+      pair_vec.push_back(make_pair(
+          (boost::int64_t(rand() % 64) - 32) << 40, u));
+    vector<pair<boost::int64_t, unsigned> > pair_sorted = pair_vec;
+    std::stable_sort(pair_sorted.begin(), pair_sorted.end(), pair_key_less());
+    stable_integer_sort(pair_vec.begin(), pair_vec.end(), pair_rightshift());
+    BOOST_CHECK(pair_vec == pair_sorted);
+
+    vector<int> base_vec;
+    vector<unsigned char> char_vec;
+    for (unsigned u = 0; u < sizes[s]; ++u) {
+      base_vec.push_back(rand_32());
+      char_vec.push_back((unsigned char)(rand()));
+    }
+    vector<int> sorted_vec = base_vec;
+    std::sort(sorted_vec.begin(), sorted_vec.end());
+    vector<int> test_vec = base_vec;
+    stable_integer_sort(test_vec.begin(), test_vec.end());
+    BOOST_CHECK(test_vec == sorted_vec);
+    test_vec = base_vec;
+    stable_integer_sort(test_vec.begin(), test_vec.end(), rightshift());
+    BOOST_CHECK(test_vec == sorted_vec);
+    vector<unsigned char> char_sorted = char_vec;
+    std::sort(char_sorted.begin(), char_sorted.end());
+    stable_integer_sort(char_vec.begin(), char_vec.end());
+    BOOST_CHECK(char_vec == char_sorted);
+  }
+
+  //Equal keys and tiny inputs
+  vector<int> equal_vec(1000, 7);
+  stable_integer_sort(equal_vec.begin(), equal_vec.end());
+  BOOST_CHECK(equal_vec == vector<int>(1000, 7));
+  vector<int> tiny_vec;
+  stable_integer_sort(tiny_vec.begin(), tiny_vec.end());
+  tiny_vec.push_back(-1);
+  stable_integer_sort(tiny_vec.begin(), tiny_vec.end());
+  BOOST_CHECK(tiny_vec.size() == 1 && tiny_vec[0] == -1);
+}
+
+// Checks is_sorted_or_find_extremes, which has vector versions for 32 and
+// 64-bit integers, against a plain scan.
+template <class T>
+void check_extremes(const vector<T> &vec)
+{
+  vector<T> test_vec = vec;
+  typename vector<T>::iterator max, min;
+  bool sorted = boost::sort::spreadsort::detail::is_sorted_or_find_extremes(
+      test_vec.begin(), test_vec.end(), max, min);
+  BOOST_CHECK(sorted == (std::adjacent_find(vec.begin(), vec.end(),
+                                            greater<T>()) == vec.end()));
+  if (!sorted) {
+    BOOST_CHECK(*max == *std::max_element(vec.begin(), vec.end()));
+    BOOST_CHECK(*min == *std::min_element(vec.begin(), vec.end()));
+  }
+  //Pointers take the same path as vector iterators
+  T * pmax, * pmin;
+  BOOST_CHECK(sorted == boost::sort::spreadsort::detail::
+      is_sorted_or_find_extremes(&test_vec[0], &test_vec[0] + vec.size(),
+                                 pmax, pmin));
+  if (!sorted) {
+    BOOST_CHECK(*pmax == *max);
+    BOOST_CHECK(*pmin == *min);
+  }
+}
+
+template <class T>
+void extremes_test_type(T offset)
+{
+  const unsigned sizes[] = { 2, 3, 63, 64, 65, 67, 100, 1000, 4097 };
+  for (unsigned s = 0; s < sizeof(sizes)/sizeof(unsigned); ++s) {
+    vector<T> vec;
+    for (unsigned u = 0; u < sizes[s]; ++u)
+      vec.push_back(T(T(rand_32()) + offset));
+    check_extremes(vec);
+    std::sort(vec.begin(), vec.end());
+    check_extremes(vec);
+    //Only the last element or the last pair out of order
+    std::swap(vec[vec.size() - 1], vec[vec.size() - 2]);
+    check_extremes(vec);
+    std::swap(vec[vec.size() - 1], vec[vec.size() - 2]);
+    //The extremes in the tail that the vectors don't cover
+    vec[vec.size() - 1] = (std::numeric_limits<T>::min)();
+    check_extremes(vec);
+    vec[vec.size() - 1] = (std::numeric_limits<T>::max)();
+    vec[0] = (std::numeric_limits<T>::max)();
+    check_extremes(vec);
+  }
+}
+
+void extremes_test()
+{
+  srand(4);
+  extremes_test_type<boost::int32_t>(0);
+  //Unsigned values above the signed range
+  extremes_test_type<boost::uint32_t>(0x80000000u);
+  extremes_test_type<boost::int64_t>(boost::int64_t(1) << 40);
+  extremes_test_type<boost::uint64_t>(boost::uint64_t(1) << 63);
+}
+
 // Verify that 0 and 1 elements work correctly.
 void corner_test() {
   vector<int> test_vec;
@@ -122,10 +330,120 @@ void corner_test() {
   BOOST_CHECK(test_vec[0] == test_value);
 }
 
+// Sorting ranges of many sizes with the same context.
+void context_test()
+{
+  spreadsort_context<vector<int>::iterator> context;
+  BOOST_CHECK(context.capacity() == 0);
+  srand(1);
+  for (unsigned count = 1; count <= 200000; count *= 3) {
+    vector<int> base_vec;
+    for (unsigned u = 0; u < count; ++u)
+      base_vec.push_back(rand_32());
+    vector<int> sorted_vec = base_vec;
+    std::sort(sorted_vec.begin(), sorted_vec.end());
+    vector<int> test_vec = base_vec;
+    integer_sort(test_vec.begin(), test_vec.end(), context);
+    BOOST_CHECK(test_vec == sorted_vec);
+    test_vec = base_vec;
+    integer_sort(test_vec.begin(), test_vec.end(), rightshift(), less<int>(),
+                 context);
+    BOOST_CHECK(test_vec == sorted_vec);
+  }
+  BOOST_CHECK(context.capacity() != 0);
+  context.clear();
+  BOOST_CHECK(context.capacity() == 0);
+}
+
+// Checks that *nth is in its sorted position, and the range is partitioned
+// around it.
+template <class T, class Compare>
+void check_selected(const vector<T> &test_vec, const vector<T> &sorted_vec,
+                    size_t pos, Compare comp)
+{
+  BOOST_CHECK(test_vec[pos] == sorted_vec[pos]);
+  for (size_t u = 0; u < pos; ++u)
+    BOOST_CHECK(!comp(test_vec[pos], test_vec[u]));
+  for (size_t u = pos + 1; u < test_vec.size(); ++u)
+    BOOST_CHECK(!comp(test_vec[u], test_vec[pos]));
+}
+
+template <class T>
+void select_positions(const vector<T> &base_vec)
+{
+  vector<T> sorted_vec = base_vec;
+  std::sort(sorted_vec.begin(), sorted_vec.end());
+  size_t positions[] = { 0, 1, base_vec.size() / 3, base_vec.size() - 1 };
+  for (unsigned u = 0; u < sizeof(positions) / sizeof(positions[0]); ++u) {
+    size_t pos = positions[u];
+    if (pos >= base_vec.size())
+      continue;
+    vector<T> test_vec = base_vec;
+    integer_select(test_vec.begin(), test_vec.begin() + pos, test_vec.end());
+    check_selected(test_vec, sorted_vec, pos, less<T>());
+  }
+}
+
+// Selection with few and many keys, negative keys, and every key size.
+void select_test()
+{
+  srand(5);
+  unsigned sizes[] = { 1, 999, 1000, 100000 };
+  for (unsigned s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    unsigned count = sizes[s];
+    vector<int> rand_vec, few_vec, equal_vec(count, -3);
+    vector<boost::int64_t> wide_vec;
+    vector<boost::uint64_t> narrow_vec;
+    vector<signed char> char_vec;
+    for (unsigned u = 0; u < count; ++u) {
+      rand_vec.push_back(rand_32());
+      few_vec.push_back(rand() % 16 - 8);
+      wide_vec.push_back((boost::int64_t(rand_32()) << 24) * (rand() % 64));
+      narrow_vec.push_back(0x1234567800000000ULL + (rand() % 5000));
+      char_vec.push_back((signed char)(rand()));
+    }
+    select_positions(rand_vec);
+    select_positions(few_vec);
+    select_positions(equal_vec);
+    select_positions(wide_vec);
+    select_positions(narrow_vec);
+    select_positions(char_vec);
+  }
+  //Equal keys around nth in the sample, with a smaller key outside it
+  vector<int> outlier_vec(100000, 5);
+  outlier_vec[1] = 1;
+  select_positions(outlier_vec);
+
+  //Right_shift functors, with the order of their keys
+  vector<int> base_vec;
+  for (unsigned u = 0; u < 100000; ++u)
+    base_vec.push_back(rand_32());
+  vector<int> sorted_vec = base_vec;
+  std::sort(sorted_vec.begin(), sorted_vec.end());
+  vector<int> test_vec = base_vec;
+  integer_select(test_vec.begin(), test_vec.begin() + 777, test_vec.end(),
+                 rightshift());
+  check_selected(test_vec, sorted_vec, 777, less<int>());
+  test_vec = base_vec;
+  integer_select(test_vec.begin(), test_vec.begin() + 777, test_vec.end(),
+                 rightshift(), less<int>());
+  check_selected(test_vec, sorted_vec, 777, less<int>());
+  std::sort(sorted_vec.begin(), sorted_vec.end(), greater<int>());
+  test_vec = base_vec;
+  integer_select(test_vec.begin(), test_vec.begin() + 777, test_vec.end(),
+                 negrightshift(), greater<int>());
+  check_selected(test_vec, sorted_vec, 777, greater<int>());
+}
+
 // test main 
 int test_main( int, char*[] )
 {
   int_test();
+  lsd_test();
+  stable_test();
+  extremes_test();
   corner_test();    
+  context_test();
+  select_test();
   return 0;
 }
@@ -0,0 +1,152 @@
+//  Boost Sort library integer_tag_sort_test.cpp file  ----------------------//
+
+//  Use, modification and distribution is subject to the Boost Software
+//  License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/sort for library home page.
+
+#include <boost/cstdint.hpp>
+#include <boost/sort/spreadsort/integer_tag_sort.hpp>
+#include <boost/sort/spreadsort/parallel_integer_tag_sort.hpp>
+// Include unit test framework
+#include <boost/test/included/test_exec_monitor.hpp>
+#include <boost/test/test_tools.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+
+using namespace std;
+using namespace boost::sort::spreadsort;
+
+// A big record, with its key and the position it had before the sort
+struct record {
+  boost::int64_t key;
+  boost::uint32_t id;
+  char payload[244];
+};
+
+struct record_rightshift {
+  boost::int64_t operator()(const record &x, unsigned offset) const {
+    return x.key >> offset;
+  }
+};
+
+struct record_less {
+  bool operator()(const record &x, const record &y) const {
+    return x.key < y.key;
+  }
+};
+
+struct string_rightshift {
+  int operator()(const pair<int, string> &x, unsigned offset) const {
+    return x.first >> offset;
+  }
+};
+
+boost::int32_t
+rand_32(bool sign = true) {
+   boost::int32_t result = rand() | (rand()<< 16);
+   if (rand() % 2)
+     result |= 1 << 15;
+   //Adding the sign bit
+   if (sign && (rand() % 2))
+     result *= -1;
+   return result;
+}
+
+vector<record> make_records(unsigned count, unsigned key_mod)
+{
+  vector<record> vec(count);
+  for (unsigned u = 0; u < count; ++u) {
+    vec[u].key = key_mod ? rand() % key_mod :
+      (boost::int64_t(rand_32()) << 20) + rand_32(false);
+    vec[u].id = u;
+    for (unsigned b = 0; b < sizeof(vec[u].payload); ++b)
+      vec[u].payload[b] = char(u + b);
+  }
+  return vec;
+}
+
+// The keys are sorted, and each record is one of the input, unchanged
+void check_records(const vector<record> &base_vec,
+                   const vector<record> &test_vec)
+{
+  BOOST_CHECK(test_vec.size() == base_vec.size());
+  vector<char> seen(base_vec.size(), 0);
+  for (size_t u = 0; u < test_vec.size(); ++u) {
+    const record &rec = test_vec[u];
+    BOOST_CHECK(!u || !(rec.key < test_vec[u - 1].key));
+    BOOST_CHECK(rec.id < base_vec.size() && !seen[rec.id]);
+    seen[rec.id] = 1;
+    BOOST_CHECK(rec.key == base_vec[rec.id].key);
+    BOOST_CHECK(std::equal(rec.payload, rec.payload + sizeof(rec.payload),
+                           base_vec[rec.id].payload));
+  }
+}
+
+void tag_test()
+{
+  srand(1);
+  unsigned sizes[] = { 0, 1, 2, 999, 1000, 100000 };
+  unsigned key_mods[] = { 0, 10, 1 };
+  for (unsigned s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+    for (unsigned k = 0; k < sizeof(key_mods) / sizeof(key_mods[0]); ++k) {
+      vector<record> base_vec = make_records(sizes[s], key_mods[k]);
+      vector<record> test_vec = base_vec;
+      integer_tag_sort(test_vec.begin(), test_vec.end(), record_rightshift());
+      check_records(base_vec, test_vec);
+      //Already sorted input
+      integer_tag_sort(test_vec.begin(), test_vec.end(), record_rightshift());
+      check_records(base_vec, test_vec);
+    }
+  }
+
+  //Elements which own memory
+  vector<pair<int, string> > str_vec;
+  for (unsigned u = 0; u < 10000; ++u)
+    str_vec.push_back(make_pair(rand_32(), string(40, char('a' + u % 26))));
+  vector<pair<int, string> > sorted_vec = str_vec;
+  std::sort(sorted_vec.begin(), sorted_vec.end());
+  integer_tag_sort(str_vec.begin(), str_vec.end(), string_rightshift());
+  BOOST_CHECK(str_vec.size() == sorted_vec.size());
+  for (size_t u = 1; u < str_vec.size(); ++u)
+    BOOST_CHECK(!(str_vec[u].first < str_vec[u - 1].first));
+  std::sort(str_vec.begin(), str_vec.end());
+  BOOST_CHECK(str_vec == sorted_vec);
+}
+
+void parallel_tag_test()
+{
+  srand(2);
+  const unsigned thread_counts[] = { 1, 2, 3, 8 };
+  boost::sort::thread_pool pool(3);
+  unsigned key_mods[] = { 0, 1000 };
+  for (unsigned k = 0; k < sizeof(key_mods) / sizeof(key_mods[0]); ++k) {
+    vector<record> base_vec = make_records(1 << 18, key_mods[k]);
+    for (unsigned t = 0; t < sizeof(thread_counts)/sizeof(unsigned); ++t) {
+      vector<record> test_vec = base_vec;
+      parallel_integer_tag_sort(test_vec.begin(), test_vec.end(),
+                                record_rightshift(), thread_counts[t]);
+      check_records(base_vec, test_vec);
+      test_vec = base_vec;
+      parallel_integer_tag_sort(test_vec.begin(), test_vec.end(),
+                                record_rightshift(), thread_counts[t], pool);
+      check_records(base_vec, test_vec);
+    }
+  }
+  vector<record> small_vec = make_records(100, 0);
+  vector<record> test_vec = small_vec;
+  parallel_integer_tag_sort(test_vec.begin(), test_vec.end(),
+                            record_rightshift());
+  check_records(small_vec, test_vec);
+}
+
+// test main
+int test_main( int, char*[] )
+{
+  tag_test();
+  parallel_tag_test();
+  return 0;
+}
@@ -0,0 +1,197 @@
+//  Boost Sort library parallel_integer_sort_test.cpp file  -----------------//
+
+//  Use, modification and distribution is subject to the Boost Software
+//  License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/sort for library home page.
+
+#include <boost/cstdint.hpp>
+#include <boost/sort/spreadsort/parallel_integer_sort.hpp>
+#include <boost/sort/spreadsort/parallel_stable_integer_sort.hpp>
+#include <boost/sort/spreadsort/parallel_stable_float_sort.hpp>
+// Include unit test framework
+#include <boost/test/included/test_exec_monitor.hpp>
+#include <boost/test/test_tools.hpp>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+
+using namespace std;
+using namespace boost::sort::spreadsort;
+
+struct rightshift {
+  int operator()(int x, unsigned offset) const { return x >> offset; }
+};
+
+struct negrightshift {
+  int operator()(const int &x, const unsigned offset) const {
+    return -(x >> offset);
+  }
+};
+
+boost::int32_t
+rand_32(bool sign = true) {
+   boost::int32_t result = rand() | (rand()<< 16);
+   if (rand() % 2)
+     result |= 1 << 15;
+   //Adding the sign bit
+   if (sign && (rand() % 2))
+     result *= -1;
+   return result;
+}
+
+const unsigned thread_counts[] = { 1, 2, 3, 8 };
+
+void int_test()
+{
+  vector<int> base_vec;
+  unsigned count = 1 << 19;
+  srand(1);
+  for (unsigned u = 0; u < count; ++u)
+    base_vec.push_back(rand_32());
+  vector<int> sorted_vec = base_vec;
+  std::sort(sorted_vec.begin(), sorted_vec.end());
+  vector<int> reverse_vec = sorted_vec;
+  std::reverse(reverse_vec.begin(), reverse_vec.end());
+  for (unsigned t = 0; t < sizeof(thread_counts)/sizeof(unsigned); ++t) {
+    unsigned nthread = thread_counts[t];
+    vector<int> test_vec = base_vec;
+    parallel_integer_sort(test_vec.begin(), test_vec.end(), nthread);
+    BOOST_CHECK(test_vec == sorted_vec);
+    //One functor
+    test_vec = base_vec;
+    parallel_integer_sort(test_vec.begin(), test_vec.end(), rightshift(),
+                          nthread);
+    BOOST_CHECK(test_vec == sorted_vec);
+    //Both functors
+    test_vec = base_vec;
+    parallel_integer_sort(test_vec.begin(), test_vec.end(), rightshift(),
+                          less<int>(), nthread);
+    BOOST_CHECK(test_vec == sorted_vec);
+    //reverse order
+    test_vec = base_vec;
+    parallel_integer_sort(test_vec.begin(), test_vec.end(), negrightshift(),
+                          greater<int>(), nthread);
+    BOOST_CHECK(test_vec == reverse_vec);
+    //Already sorted and reverse sorted input
+    test_vec = sorted_vec;
+    parallel_integer_sort(test_vec.begin(), test_vec.end(), nthread);
+    BOOST_CHECK(test_vec == sorted_vec);
+    test_vec = reverse_vec;
+    parallel_integer_sort(test_vec.begin(), test_vec.end(), nthread);
+    BOOST_CHECK(test_vec == sorted_vec);
+  }
+  //Default number of threads
+  vector<int> test_vec = base_vec;
+  parallel_integer_sort(test_vec.begin(), test_vec.end());
+  BOOST_CHECK(test_vec == sorted_vec);
+}
+
+// Most of the data in one bin, to exercise the parallel split of large bins.
+void skew_test()
+{
+  vector<boost::uint64_t> base_vec;
+  unsigned count = 1 << 19;
+  srand(2);
+  for (unsigned u = 0; u < count; ++u) {
+    if (u % 64)
+      base_vec.push_back(rand() % 100000);
+    else
+      base_vec.push_back((boost::uint64_t(rand_32(false)) << 31) + rand());
+  }
+  vector<boost::uint64_t> sorted_vec = base_vec;
+  std::sort(sorted_vec.begin(), sorted_vec.end());
+  for (unsigned t = 0; t < sizeof(thread_counts)/sizeof(unsigned); ++t) {
+    vector<boost::uint64_t> test_vec = base_vec;
+    parallel_integer_sort(test_vec.begin(), test_vec.end(), thread_counts[t]);
+    BOOST_CHECK(test_vec == sorted_vec);
+  }
+  //All keys equal
+  vector<boost::uint64_t> equal_vec(count, 42);
+  parallel_integer_sort(equal_vec.begin(), equal_vec.end(), 4);
+  BOOST_CHECK(equal_vec == vector<boost::uint64_t>(count, 42));
+}
+
+struct pair_rightshift {
+  boost::int64_t operator()(const pair<boost::int64_t, unsigned> &x,
+                            unsigned offset) const {
+    return x.first >> offset;
+  }
+};
+
+struct pair_key_less {
+  bool operator()(const pair<boost::int64_t, unsigned> &x,
+                  const pair<boost::int64_t, unsigned> &y) const {
+    return x.first < y.first;
+  }
+};
+
+// The threads scatter their parts in order: records with few keys must keep
+// the order of their payloads with any number of threads.
+void stable_test()
+{
+  vector<pair<boost::int64_t, unsigned> > pair_vec;
+  vector<int> base_vec;
+  vector<double> double_vec;
+  unsigned count = 1 << 19;
+  srand(3);
+  for (unsigned u = 0; u < count; ++u) {
+    pair_vec.push_back(make_pair((boost::int64_t(rand() % 64) - 32) << 40, u));
+    base_vec.push_back(rand_32());
+    double_vec.push_back(double(rand_32()) / 7);
+  }
+  vector<pair<boost::int64_t, unsigned> > pair_sorted = pair_vec;
+  std::stable_sort(pair_sorted.begin(), pair_sorted.end(), pair_key_less());
+  vector<int> sorted_vec = base_vec;
+  std::sort(sorted_vec.begin(), sorted_vec.end());
+  vector<double> double_sorted = double_vec;
+  std::sort(double_sorted.begin(), double_sorted.end());
+  for (unsigned t = 0; t < sizeof(thread_counts)/sizeof(unsigned); ++t) {
+    vector<pair<boost::int64_t, unsigned> > pair_test = pair_vec;
+    parallel_stable_integer_sort(pair_test.begin(), pair_test.end(),
+                                 pair_rightshift(), thread_counts[t]);
+    BOOST_CHECK(pair_test == pair_sorted);
+    vector<int> test_vec = base_vec;
+    parallel_stable_integer_sort(test_vec.begin(), test_vec.end(),
+                                 thread_counts[t]);
+    BOOST_CHECK(test_vec == sorted_vec);
+    vector<double> double_test = double_vec;
+    parallel_stable_float_sort(double_test.begin(), double_test.end(),
+                               thread_counts[t]);
+    BOOST_CHECK(double_test == double_sorted);
+  }
+  //With a pool of its own
+  boost::sort::thread_pool pool(3);
+  vector<pair<boost::int64_t, unsigned> > pair_test = pair_vec;
+  parallel_stable_integer_sort(pair_test.begin(), pair_test.end(),
+                               pair_rightshift(), 4, pool);
+  BOOST_CHECK(pair_test == pair_sorted);
+  //All keys equal
+  vector<boost::uint64_t> equal_vec(count, 42);
+  parallel_stable_integer_sort(equal_vec.begin(), equal_vec.end(), 4);
+  BOOST_CHECK(equal_vec == vector<boost::uint64_t>(count, 42));
+}
+
+// Verify that 0 and 1 elements work correctly.
+void corner_test() {
+  vector<int> test_vec;
+  parallel_integer_sort(test_vec.begin(), test_vec.end(), 4);
+  const int test_value = 42;
+  test_vec.push_back(test_value);
+  parallel_integer_sort(test_vec.begin(), test_vec.end(), 4);
+  BOOST_CHECK(test_vec.size() == 1);
+  BOOST_CHECK(test_vec[0] == test_value);
+}
+
+// test main
+int test_main( int, char*[] )
+{
+  int_test();
+  skew_test();
+  stable_test();
+  corner_test();
+  return 0;
+}
@@ -0,0 +1,93 @@
+//  Boost Sort library parallel_string_sort_test.cpp file  ------------------//
+
+//  Use, modification and distribution is subject to the Boost Software
+//  License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/sort for library home page.
+
+#include <boost/sort/spreadsort/parallel_string_sort.hpp>
+// Include unit test framework
+#include <boost/test/included/test_exec_monitor.hpp>
+#include <boost/test/test_tools.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+using namespace std;
+using namespace boost::sort::spreadsort;
+
+static const unsigned input_count = 300000;
+const unsigned thread_counts[] = { 1, 2, 3, 8 };
+
+void check_sort(const vector<string> &base_vec)
+{
+  vector<string> sorted_vec = base_vec;
+  std::sort(sorted_vec.begin(), sorted_vec.end());
+  for (unsigned t = 0; t < sizeof(thread_counts)/sizeof(unsigned); ++t) {
+    vector<string> test_vec = base_vec;
+    parallel_string_sort(test_vec.begin(), test_vec.end(), thread_counts[t]);
+    BOOST_CHECK(test_vec == sorted_vec);
+  }
+}
+
+// Random strings of random length, including empties.
+void random_test()
+{
+  vector<string> base_vec;
+  srand(1);
+  for (unsigned u = 0; u < input_count; ++u) {
+    unsigned length = rand() % 12;
+    string result;
+    for (unsigned v = 0; v < length; ++v)
+      result.push_back(rand() % 256);
+    base_vec.push_back(result);
+  }
+  check_sort(base_vec);
+  //Default number of threads
+  vector<string> sorted_vec = base_vec;
+  std::sort(sorted_vec.begin(), sorted_vec.end());
+  parallel_string_sort(base_vec.begin(), base_vec.end());
+  BOOST_CHECK(base_vec == sorted_vec);
+}
+
+// Log-like lines: long shared prefixes, and a few keys holding most lines,
+// so large bins keep being split after the first characters.
+void log_test()
+{
+  vector<string> base_vec;
+  srand(2);
+  const char *levels[] = { "INFO", "WARN", "ERROR" };
+  for (unsigned u = 0; u < input_count; ++u) {
+    char line[96];
+    sprintf(line, "2017-03-%02d %02d:%02d:%02d %s worker-%d request %d",
+            1 + rand() % 2, rand() % 24, rand() % 60, rand() % 60,
+            levels[(rand() % 16) ? 0 : 1 + rand() % 2], rand() % 4,
+            rand() % 100000);
+    base_vec.push_back(line);
+  }
+  check_sort(base_vec);
+}
+
+// Identical and empty strings.
+void corner_test()
+{
+  check_sort(vector<string>(input_count, string("same")));
+  check_sort(vector<string>(input_count));
+  vector<string> test_vec;
+  parallel_string_sort(test_vec.begin(), test_vec.end(), 4);
+  test_vec.push_back("one");
+  parallel_string_sort(test_vec.begin(), test_vec.end(), 4);
+  BOOST_CHECK(test_vec.size() == 1 && test_vec[0] == "one");
+}
+
+// test main
+int test_main( int, char*[] )
+{
+  random_test();
+  log_test();
+  corner_test();
+  return 0;
+}
@@ -13,10 +13,17 @@
 #include <boost/sort/spreadsort/detail/float_sort.hpp>
 #include <boost/sort/spreadsort/detail/string_sort.hpp>
 #include <boost/sort/spreadsort/float_sort.hpp>
+#include <boost/sort/spreadsort/integer_sort.hpp>
+#include <boost/sort/spreadsort/string_sort.hpp>
+#include <boost/sort/spreadsort/calibrate.hpp>
 // Include unit test framework
 #include <boost/test/included/test_exec_monitor.hpp>
 #include <boost/test/test_tools.hpp>
 #include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
 
 #include <iostream>
 
@@ -64,22 +71,24 @@ void roughlog2_test()
 
 // Test the worst-case performance handling, and assure that is using the
 // correct formula for the worst-case number of radix iterations.
-template<unsigned log_mean_bin_size, unsigned log_min_split_count,
-         unsigned log_finishing_count>
+template<class Tuning>
 void get_min_count_test()
 {
-  const unsigned min_log_size = log_mean_bin_size + log_min_split_count;
-  size_t prev_min_count = absolute_min_count;
+  const int max_splits = Tuning::max_splits();
+  const int log_mean_bin_size = Tuning::log_mean_bin_size();
+  const int log_min_split_count = Tuning::log_min_split_count();
+  const int min_log_size = log_mean_bin_size + log_min_split_count;
+  size_t prev_min_count = size_t(1) <<
+    (std::min)((int)Tuning::log_finishing_count(), min_log_size);
   for (int log_range = 0; log_range <= max_int_bits; ++log_range) {
-    size_t min_count = get_min_count<log_mean_bin_size, log_min_split_count, 
-                                     log_finishing_count>(log_range);
+    size_t min_count = get_min_count<Tuning>(log_range);
     BOOST_CHECK(min_count >= prev_min_count);
     prev_min_count = min_count;
     // When the range is really small, the radix sort will complete in one
     // iteration and worst-case handling doesn't apply.  The code below 
     // guarantees the worst-case number of radix sorting iteration.
     if (log_range > min_log_size) {
-      BOOST_CHECK(min_count >= (1 << min_log_size));
+      BOOST_CHECK(min_count >= (size_t(1) << min_log_size));
       int iterations = rough_log_2_size(min_count) - min_log_size;
       BOOST_CHECK(iterations >= 1);
       int base_iterations = max_splits - log_min_split_count;
@@ -110,7 +119,7 @@ void get_log_divisor_test()
       size_t count = (one << log_count) - 1;
       BOOST_CHECK(rough_log_2_size(count) == (unsigned)log_count);
       int log_divisor =
-        get_log_divisor<int_log_mean_bin_size>(count, log_range);
+        get_log_divisor<int_tuning>(count, log_range);
       // Only process counts >= int_log_finishing_count in this function.
       if (count >= absolute_min_count)
         BOOST_CHECK(log_divisor <= log_range);
@@ -276,19 +285,207 @@ void swap_loop_test() {
   BOOST_CHECK(next_float_bin_start == floats.begin() + bin_sizes[0]);
 }
 
+// Sort with the given tuning values, and compare with std::sort.
+void tuned_sort_check(const tuning &values) {
+  BOOST_CHECK(set_tuning(values));
+  BOOST_CHECK(current_tuning().max_splits == values.max_splits);
+  std::vector<int> ints, int_copy;
+  std::vector<float> floats, float_copy;
+  std::vector<string> strings, string_copy;
+  for (int i = 0; i < 100000; ++i) {
+    int value = (rand() << 16) ^ rand();
+    ints.push_back(value >> (i % 24));
+    floats.push_back(float(value >> (i % 24)) / 1024.0f);
+    if (i < 10000)
+      strings.push_back(std::string(1 + i % 7, char('a' + value % 26)) +
+                        std::string(1, char('a' + (value >> 8) % 26)));
+  }
+  int_copy = ints;
+  float_copy = floats;
+  string_copy = strings;
+  boost::sort::spreadsort::integer_sort(ints.begin(), ints.end());
+  boost::sort::spreadsort::float_sort(floats.begin(), floats.end());
+  boost::sort::spreadsort::string_sort(strings.begin(), strings.end());
+  std::sort(int_copy.begin(), int_copy.end());
+  std::sort(float_copy.begin(), float_copy.end());
+  std::sort(string_copy.begin(), string_copy.end());
+  BOOST_CHECK(ints == int_copy);
+  BOOST_CHECK(floats == float_copy);
+  BOOST_CHECK(strings == string_copy);
+}
+
+struct throwing_sorter {
+  void operator()(std::vector<boost::uint32_t> &) const
+  { throw std::runtime_error("throwing_sorter"); }
+};
+
+// Check the runtime tuning values, their profile, and calibrate.
+void tuning_test() {
+  const tuning defaults = default_tuning();
+  BOOST_CHECK(valid_tuning(defaults));
+  BOOST_CHECK(current_tuning().max_splits == defaults.max_splits);
+  tuning values = defaults;
+  values.max_splits = 1;
+  BOOST_CHECK(!set_tuning(values));
+  values = defaults;
+  values.int_log_min_split_count = values.max_splits + 1;
+  BOOST_CHECK(!set_tuning(values));
+  values.min_sort_size = 1;
+  BOOST_CHECK(!set_tuning(values));
+  BOOST_CHECK(current_tuning().max_splits == defaults.max_splits);
+
+  // Fewer splits than the default, and more, with the bin sizes on the heap
+  const unsigned splits[] = { 5, max_finishing_splits + 2 };
+  for (unsigned u = 0; u < sizeof(splits) / sizeof(splits[0]); ++u) {
+    values = defaults;
+    values.max_splits = splits[u];
+    values.int_log_min_split_count =
+      (std::min)(values.int_log_min_split_count, splits[u]);
+    values.float_log_min_split_count =
+      (std::min)(values.float_log_min_split_count, splits[u]);
+    values.min_sort_size = 2;
+    tuned_sort_check(values);
+  }
+
+  // A profile gives back the values saved
+  const char *profile = "sort_detail_test.profile";
+  values = defaults;
+  values.max_splits = 13;
+  values.float_log_mean_bin_size = 3;
+  values.min_sort_size = 500;
+  BOOST_CHECK(save_tuning(profile, values));
+  tuning loaded = defaults;
+  BOOST_CHECK(load_tuning(profile, loaded));
+  BOOST_CHECK(loaded.max_splits == 13 && loaded.float_log_mean_bin_size == 3 &&
+              loaded.min_sort_size == 500 &&
+              loaded.int_log_min_split_count == values.int_log_min_split_count);
+  std::FILE *file = std::fopen(profile, "w");
+  BOOST_CHECK(file && std::fputs("max_splits 1\n", file) >= 0);
+  if (file)
+    std::fclose(file);
+  BOOST_CHECK(!load_tuning(profile, loaded));
+  BOOST_CHECK(loaded.max_splits == 13);
+  std::remove(profile);
+
+  // measure_tuning passes the values tried to its own sorts only, and
+  // restores the previous ones after an exception
+  values = defaults;
+  values.max_splits = 9;
+  BOOST_CHECK(set_tuning(values));
+  BOOST_CHECK(valid_tuning(boost::sort::spreadsort::measure_tuning(4096)));
+  BOOST_CHECK(current_tuning().max_splits == 9);
+  BOOST_CHECK(trial_tuning() == 0);
+  std::vector<std::vector<boost::uint32_t> > samples(1,
+    std::vector<boost::uint32_t>(10, 1));
+  tuning_measure<boost::uint32_t, throwing_sorter> throwing_measure =
+    { &samples };
+  BOOST_CHECK_THROW(throwing_measure(defaults), std::runtime_error);
+  BOOST_CHECK(trial_tuning() == 0);
+  BOOST_CHECK(current_tuning().max_splits == 9);
+  set_tuning(defaults);
+
+  // calibrate measures the values, saves them, and loads them again
+  tuning measured = calibrate(profile, 4096);
+  BOOST_CHECK(valid_tuning(measured));
+  BOOST_CHECK(load_tuning(profile, loaded));
+  BOOST_CHECK(loaded.max_splits == measured.max_splits &&
+              loaded.min_sort_size == measured.min_sort_size);
+  BOOST_CHECK(calibrate(profile).max_splits == measured.max_splits);
+  tuned_sort_check(current_tuning());
+  std::remove(profile);
+  set_tuning(defaults);
+}
+
+struct policy_shift {
+  int operator()(const int &x, unsigned offset) const { return x >> offset; }
+};
+
+struct policy_float_shift {
+  int operator()(const float &x, unsigned offset) const {
+    return float_mem_cast<float, int>(x) >> offset;
+  }
+};
+
+// Sort with the values of a tuning_policy, and compare with std::sort.
+template<class Tuning>
+void policy_sort_check() {
+  std::vector<int> ints, int_copy, shorts, short_copy;
+  std::vector<float> floats, float_copy;
+  std::vector<string> strings, string_copy;
+  for (int i = 0; i < 100000; ++i) {
+    int value = (rand() << 16) ^ rand();
+    ints.push_back(value >> (i % 24));
+    shorts.push_back(value & 0xffff);
+    floats.push_back(float(value >> (i % 24)) / 1024.0f);
+    if (i < 10000)
+      strings.push_back(std::string(1 + i % 7, char('a' + value % 26)) +
+                        std::string(1, char('a' + (value >> 8) % 26)));
+  }
+  int_copy = ints;
+  short_copy = shorts;
+  float_copy = floats;
+  string_copy = strings;
+  std::sort(int_copy.begin(), int_copy.end());
+  std::sort(short_copy.begin(), short_copy.end());
+  std::sort(float_copy.begin(), float_copy.end());
+  std::sort(string_copy.begin(), string_copy.end());
+  std::vector<int> data = ints;
+  boost::sort::spreadsort::integer_sort<Tuning>(data.begin(), data.end());
+  BOOST_CHECK(data == int_copy);
+  data = ints;
+  boost::sort::spreadsort::integer_sort<Tuning>(data.begin(), data.end(),
+                                                policy_shift());
+  BOOST_CHECK(data == int_copy);
+  data = shorts;
+  boost::sort::spreadsort::integer_sort<Tuning>(data.begin(), data.end(),
+                                                policy_shift(), std::less<int>());
+  BOOST_CHECK(data == short_copy);
+  std::vector<float> float_data = floats;
+  boost::sort::spreadsort::float_sort<Tuning>(float_data.begin(),
+                                              float_data.end());
+  BOOST_CHECK(float_data == float_copy);
+  float_data = floats;
+  boost::sort::spreadsort::float_sort<Tuning>(float_data.begin(),
+    float_data.end(), policy_float_shift(), std::less<float>());
+  BOOST_CHECK(float_data == float_copy);
+  std::vector<string> string_data = strings;
+  boost::sort::spreadsort::string_sort<Tuning>(string_data.begin(),
+                                               string_data.end());
+  BOOST_CHECK(string_data == string_copy);
+}
+
+// Check that a tuning_policy is used for its call only.
+void tuning_policy_test() {
+  typedef tuning_policy<> default_policy;
+  BOOST_CHECK(default_policy::max_splits() == unsigned(max_splits));
+  BOOST_CHECK(default_policy::min_sort_size() == unsigned(min_sort_size));
+  get_min_count_test<tuning_policy<9, 3> >();
+  get_min_count_test<tuning_policy<max_finishing_splits + 2, 1, 4, 1> >();
+  // A huge runtime min_sort_size would only use pdqsort
+  tuning values = default_tuning();
+  values.min_sort_size = 1 << 30;
+  BOOST_CHECK(set_tuning(values));
+  policy_sort_check<default_policy>();
+  policy_sort_check<tuning_policy<5, 1, 3, 1, 2> >();
+  policy_sort_check<tuning_policy<max_finishing_splits + 2, 2, 9, 1, 64> >();
+  BOOST_CHECK(current_tuning().min_sort_size == values.min_sort_size);
+  BOOST_CHECK(current_tuning().max_splits == values.max_splits);
+  set_tuning(default_tuning());
+}
+
 } // end anonymous namespace
 
 // test main 
 int test_main( int, char*[] )
 {
   roughlog2_test();
-  get_min_count_test<int_log_mean_bin_size, int_log_min_split_count,
-                    int_log_finishing_count>();
-  get_min_count_test<float_log_mean_bin_size, float_log_min_split_count,
-                    float_log_finishing_count>();
+  get_min_count_test<int_tuning>();
+  get_min_count_test<float_tuning>();
   get_log_divisor_test();
   is_sorted_or_find_extremes_test();
   size_bins_test();
   swap_loop_test();
+  tuning_test();
+  tuning_policy_test();
   return 0;
 }
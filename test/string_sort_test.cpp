@@ -151,6 +151,31 @@ void corner_test() {
   }
 }
 
+// Sorting ranges of many sizes with the same context.
+void context_test() {
+  spreadsort_context<vector<string>::iterator> context;
+  srand(1);
+  for (unsigned count = 1; count <= input_count; count *= 3) {
+    vector<string> base_vec;
+    for (unsigned u = 0; u < count; ++u) {
+      unsigned length = rand() % 32;
+      string result;
+      for (unsigned v = 0; v < length; ++v)
+        result.push_back(rand() % 256);
+      base_vec.push_back(result);
+    }
+    vector<string> sorted_vec = base_vec;
+    std::sort(sorted_vec.begin(), sorted_vec.end());
+    vector<string> test_vec = base_vec;
+    string_sort(test_vec.begin(), test_vec.end(), context);
+    BOOST_CHECK(test_vec == sorted_vec);
+    test_vec = base_vec;
+    string_sort(test_vec.begin(), test_vec.end(), bracket(), get_size(),
+                less<string>(), context);
+    BOOST_CHECK(test_vec == sorted_vec);
+  }
+}
+
 // test main 
 int test_main( int, char*[] )
 {
@@ -158,5 +183,6 @@ int test_main( int, char*[] )
   offset_comparison_test();
   string_test();
   corner_test();
+  context_test();
   return 0;
 }
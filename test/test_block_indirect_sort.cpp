@@ -11,7 +11,11 @@
 /// @remarks
 //-----------------------------------------------------------------------------
 #include <algorithm>
+#include <atomic>
+#include <new>
 #include <random>
+#include <memory>
+#include <string>
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
@@ -31,6 +35,47 @@ using bsc::range;
 std::vector< uint64_t > Vrandom;
 const uint64_t NELEM = 2000000;
 
+// ---------------- counter of the allocations of the program ----------------
+// The memory is obtained with malloc, as in the default operator new, and
+// it is returned with free by the default operator delete
+std::atomic< uint64_t > nalloc (0);
+
+void *operator new (size_t size)
+{
+    ++nalloc;
+    void *ptr = malloc (size == 0 ? 1 : size);
+    if (ptr == nullptr) throw std::bad_alloc ( );
+    return ptr;
+};
+
+// ------- allocator which takes the memory from a buffer, reused in each sort --
+alignas (64) char arena[ 1 << 22 ];
+std::atomic< size_t > arena_used (0);
+
+template< class T >
+struct arena_allocator
+{
+    typedef T value_type;
+
+    arena_allocator (void) { };
+    template< class U >
+    arena_allocator (const arena_allocator< U > &) { };
+
+    T *allocate (size_t n)
+    {
+        size_t size = (n * sizeof (T) + 63) & ~size_t (63);
+        size_t pos = arena_used.fetch_add (size);
+        if (pos + size > sizeof (arena)) throw std::bad_alloc ( );
+        return reinterpret_cast< T * > (arena + pos);
+    };
+    void deallocate (T *, size_t) { };
+
+    template< class U >
+    bool operator== (const arena_allocator< U > &) const { return true; };
+    template< class U >
+    bool operator!= (const arena_allocator< U > &) const { return false; };
+};
+
 void test1 (void)
 {
     const uint32_t NElem = 500000;
@@ -172,6 +217,135 @@ void test3 (void)
     test_int_array<int_array<8> >(1u << 17);
 }
 
+// The buffers of the threads are taken from the memory of the caller, of
+// the exact size required, reused in many sorts. When the memory is too
+// small, it is obtained inside the algorithm
+void test4 (void)
+{
+    typedef std::vector<std::string>::iterator iter_t;
+    const uint32_t NELEM2 = 200000, NTHREAD = 4;
+    std::vector<std::string> A, B;
+    for (uint32_t i = 0; i < NELEM2; ++i)
+        A.push_back (std::to_string (Vrandom[i] % 100000));
+    B = A;
+    std::sort (B.begin ( ), B.end ( ));
+
+    size_t nbuf = bsp::block_indirect_sort_buffer_size<iter_t> (NELEM2,
+                                                                NTHREAD);
+    BOOST_CHECK (nbuf != 0);
+    BOOST_CHECK (bsp::block_indirect_sort_buffer_size<iter_t> (100,
+                                                               NTHREAD) == 0);
+    std::allocator<std::string> alloc;
+    std::string *ptr = alloc.allocate (nbuf);
+    for (uint32_t k = 0; k < 3; ++k)
+    {
+        std::vector<std::string> V (A);
+        block_indirect_sort (V.begin ( ), V.end ( ), std::less<std::string> ( ),
+                             NTHREAD, range<std::string *> (ptr, ptr + nbuf));
+        BOOST_CHECK (V == B);
+    };
+    std::vector<std::string> V (A);
+    block_indirect_sort (V.begin ( ), V.end ( ), std::less<std::string> ( ),
+                         NTHREAD, range<std::string *> (ptr, ptr + nbuf - 1));
+    BOOST_CHECK (V == B);
+    alloc.deallocate (ptr, nbuf);
+};
+
+// Sort of the iterators of parallel_indirect_sort
+struct block_indirect_method
+{
+    template<class Iter_t, class Compare>
+    void operator() (Iter_t first, Iter_t last, Compare comp) const
+    {   block_indirect_sort (first, last, comp, 4);
+    };
+};
+
+// The permutation of the indirect sort is applied with several threads, and
+// by one thread when they are less than 2 or the elements are few
+void test5 (void)
+{
+    const uint32_t NELEM2 = 100000;
+    std::vector<std::string> A, B;
+    for (uint32_t i = 0; i < NELEM2; ++i)
+        A.push_back (std::to_string (Vrandom[i] % 100000));
+    B = A;
+    std::sort (B.begin ( ), B.end ( ));
+
+    bsc::thread_pool pool (3);
+    const uint32_t nthreads[] = { 1, 2, 4 };
+    for (uint32_t nthread : nthreads)
+    {
+        std::vector<std::string> V (A);
+        bsc::parallel_indirect_sort (block_indirect_method ( ), V.begin ( ),
+                                     V.end ( ), std::less<std::string> ( ),
+                                     nthread, pool);
+        BOOST_CHECK (V == B);
+
+        V = A;
+        bsc::parallel_indirect_sort (block_indirect_method ( ), V.begin ( ),
+                                     V.end ( ), std::less<std::string> ( ),
+                                     nthread);
+        BOOST_CHECK (V == B);
+
+        V.assign (A.begin ( ), A.begin ( ) + 1000);
+        std::vector<std::string> C (V);
+        std::sort (C.begin ( ), C.end ( ));
+        bsc::parallel_indirect_sort (block_indirect_method ( ), V.begin ( ),
+                                     V.end ( ), std::less<std::string> ( ),
+                                     nthread, pool);
+        BOOST_CHECK (V == C);
+    };
+
+    // the index is the reverse of the data
+    std::vector<uint64_t> V (Vrandom.begin ( ), Vrandom.begin ( ) + NELEM2);
+    std::vector<uint64_t> R (V.rbegin ( ), V.rend ( ));
+    std::vector<std::vector<uint64_t>::iterator> index;
+    for (uint32_t i = NELEM2; i > 0; --i) index.push_back (V.begin ( ) + i - 1);
+    bsc::parallel_sort_index (V.begin ( ), index, 4, pool);
+    BOOST_CHECK (V == R);
+};
+
+// With the buffers of the threads and the internal data structures taken
+// from the memory of the caller, a second sort doesn't use the heap. With 4
+// threads the data are sorted only with parallel_sort, with 8 threads are
+// also merged and moved by blocks
+void test6 (void)
+{
+    typedef std::vector< uint64_t >::iterator iter_t;
+    bsc::thread_pool pool (7);
+    const uint32_t nthreads[] = { 4, 8 };
+    const uint64_t nelems[] = { NELEM / 2, NELEM };
+
+    for (uint32_t k = 0; k < 2; ++k)
+    {
+        std::vector< uint64_t > A (Vrandom.begin ( ),
+                                   Vrandom.begin ( ) + nelems[ k ]);
+        for (uint64_t &x : A) x = (x << 32) ^ (x * 0x9E3779B97F4A7C15ULL);
+        std::vector< uint64_t > B (A);
+        std::sort (B.begin ( ), B.end ( ));
+
+        size_t nbuf = bsp::block_indirect_sort_buffer_size< iter_t > (
+                        A.size ( ), nthreads[ k ]);
+        BOOST_CHECK (nbuf != 0);
+        std::vector< uint64_t > buf (nbuf);
+        range< uint64_t * > rbuf (buf.data ( ), buf.data ( ) + nbuf);
+
+        std::vector< uint64_t > V (A);
+        for (uint32_t i = 0; i < 2; ++i)
+        {
+            V = A;
+            arena_used = 0;
+            uint64_t nalloc_ini = nalloc;
+            block_indirect_sort (V.begin ( ), V.end ( ),
+                                 std::less< uint64_t > ( ), nthreads[ k ],
+                                 rbuf, pool, arena_allocator< uint64_t > ( ));
+            uint64_t nalloc_sort = nalloc - nalloc_ini;
+            BOOST_CHECK (V == B);
+            if (i == 1) BOOST_CHECK (nalloc_sort == 0);
+        };
+    };
+};
+
 int test_main (int, char *[])
 {   
     std::mt19937 my_rand (0);
@@ -181,6 +355,9 @@ int test_main (int, char *[])
     test1  ( );
     test2  ( );
     test3  ( );
+    test4  ( );
+    test5  ( );
+    test6  ( );
 
     return 0;
 };
@@ -0,0 +1,169 @@
+//----------------------------------------------------------------------------
+/// @file test_external_sort.cpp
+/// @brief Test program of the external_sort algorithm
+///
+///         Distributed under the Boost Software License, Version 1.0.\n
+///         ( See accompanying file LICENSE_1_0.txt or copy at
+///           http://www.boost.org/LICENSE_1_0.txt  )
+/// @version 0.1
+///
+/// @remarks
+//-----------------------------------------------------------------------------
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <ios>
+#include <random>
+#include <string>
+#include <vector>
+#include <ciso646>
+#include <boost/test/included/test_exec_monitor.hpp>
+#include <boost/test/test_tools.hpp>
+#include <boost/sort/external_sort/external_sort.hpp>
+#include <boost/sort/common/file_vector.hpp>
+
+namespace bsc = boost::sort::common;
+using boost::sort::external_sort;
+using boost::sort::external_sort_config;
+
+const std::string input_name = "test_external_sort_input.bin";
+const std::string output_name = "test_external_sort_output.bin";
+
+struct record
+{
+    uint32_t key;
+    uint32_t data[3];
+};
+
+struct greater_record
+{
+    bool operator( ) (const record &r1, const record &r2) const
+    {
+        return r1.key > r2.key;
+    };
+};
+
+template< class T >
+void write_vector (const std::vector< T > &V, const std::string &filename)
+{
+    std::ofstream ofile (filename, std::ios_base::out | std::ios_base::binary |
+                                   std::ios_base::trunc);
+    ofile.write ((const char *) V.data ( ), V.size ( ) * sizeof (T));
+};
+
+template< class T >
+std::vector< T > read_vector (const std::string &filename)
+{
+    std::ifstream input (filename, std::ios_base::in | std::ios_base::binary |
+                                   std::ios_base::ate);
+    std::vector< T > V (size_t (input.tellg ( )) / sizeof (T));
+    input.seekg (0);
+    input.read ((char *) V.data ( ), V.size ( ) * sizeof (T));
+    return V;
+};
+
+//---------------------------------------------------------------------------
+// Numbers of 64 bits, with one pass of merge, with several passes, and in
+// memory, with one and several threads
+//---------------------------------------------------------------------------
+void test1 (void)
+{
+    const uint32_t NELEM = 300000;
+    bsc::generate_file (input_name, NELEM);
+    std::vector< uint64_t > A, B;
+    bsc::fill_vector_uint64 (input_name, A, NELEM);
+    std::sort (A.begin ( ), A.end ( ));
+
+    external_sort_config config;
+    config.io_block = 8192;
+    size_t memory[] = {size_t (1) << 18, size_t (1) << 16, size_t (1) << 24};
+    for (uint32_t nthread = 1; nthread < 4; nthread += 2)
+    {
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            config.memory = memory[i];
+            config.nthread = nthread;
+            external_sort< uint64_t > (input_name, output_name, config);
+            bsc::fill_vector_uint64 (output_name, B, NELEM);
+            BOOST_CHECK (A == B);
+        };
+    };
+
+    // the output can be the input
+    config.memory = size_t (1) << 16;
+    external_sort< uint64_t > (input_name, input_name, config);
+    bsc::fill_vector_uint64 (input_name, B, NELEM);
+    BOOST_CHECK (A == B);
+};
+
+//---------------------------------------------------------------------------
+// Records with a comparison object, and many repeated keys
+//---------------------------------------------------------------------------
+void test2 (void)
+{
+    std::mt19937 my_rand (0);
+    std::vector< record > A (100000);
+    for (uint32_t i = 0; i < A.size ( ); ++i)
+    {
+        A[i].key = my_rand ( ) % 1000;
+        A[i].data[0] = A[i].data[1] = A[i].data[2] = A[i].key * 3;
+    };
+    write_vector (A, input_name);
+
+    external_sort_config config;
+    config.memory = size_t (1) << 16;
+    config.io_block = 4096;
+    config.nthread = 2;
+    external_sort< record > (input_name, output_name, greater_record ( ),
+                             config);
+
+    std::vector< record > B = read_vector< record > (output_name);
+    BOOST_CHECK (B.size ( ) == A.size ( ));
+    bool sorted = true;
+    for (uint32_t i = 0; i < B.size ( ); ++i)
+    {
+        if (B[i].data[0] != B[i].key * 3) sorted = false;
+        if (i != 0 and B[i - 1].key < B[i].key) sorted = false;
+    };
+    BOOST_CHECK (sorted);
+};
+
+//---------------------------------------------------------------------------
+// Empty file, file with incorrect length, and errors in the files
+//---------------------------------------------------------------------------
+void test3 (void)
+{
+    std::vector< uint64_t > V;
+    write_vector (V, input_name);
+    external_sort< uint64_t > (input_name, output_name);
+    BOOST_CHECK (read_vector< uint64_t > (output_name).empty ( ));
+
+    std::vector< uint32_t > V3 (3, 7);
+    write_vector (V3, input_name);
+    BOOST_CHECK_THROW (external_sort< uint64_t > (input_name, output_name),
+                       std::ios_base::failure);
+
+    BOOST_CHECK_THROW (external_sort< uint64_t > ("nonexistent_file.bin",
+                                                  output_name),
+                       std::ios_base::failure);
+
+    bsc::generate_file (input_name, 100000);
+    external_sort_config config;
+    config.memory = size_t (1) << 16;
+    config.io_block = 8192;
+    config.temp_dir = "nonexistent_directory";
+    BOOST_CHECK_THROW (external_sort< uint64_t > (input_name, output_name,
+                                                  config),
+                       std::ios_base::failure);
+};
+
+int test_main (int, char *[])
+{
+    test1 ( );
+    test2 ( );
+    test3 ( );
+    std::remove (input_name.c_str ( ));
+    std::remove (output_name.c_str ( ));
+    return 0;
+};
@@ -24,6 +24,7 @@ using namespace boost::sort;
 void test1 ( );
 void test2 ( );
 void test3 ( );
+void test4 ( );
 
 //---------------- stability test -----------------------------------
 struct xk
@@ -131,10 +132,52 @@ void test3 (void)
     {   BOOST_CHECK ( V[i].num == (i / 10) and V[i].tail == (i %10) );
     };
 }
+//---------------- natural runs test -------------------------------
+// a few ascending and descending runs of random size, with repeated keys,
+// and some of the runs left in random order
+void test4 (void)
+{
+    typedef typename std::vector< xk >::iterator iter_t;
+    typedef std::less< xk > compare_t;
+    std::mt19937_64 my_rand (0);
+    const uint32_t NELEM = 400000;
+    const uint32_t nruns[] = { 2, 5, 17, 100 };
+
+    for (uint32_t nrun : nruns)
+    {
+        std::vector< uint32_t > cut (1, 0);
+        for (uint32_t i = 1; i < nrun; ++i) cut.push_back (my_rand ( ) % NELEM);
+        cut.push_back (NELEM);
+        std::sort (cut.begin ( ), cut.end ( ));
+
+        std::vector< xk > V1, V2;
+        V1.reserve (NELEM);
+        for (uint32_t k = 0; k < NELEM; ++k)
+            V1.emplace_back (uint32_t (my_rand ( ) % 5000), k % 16);
+        for (uint32_t i = 0; i < nrun; ++i)
+        {
+            if (i % 3 == 1)
+                std::stable_sort (V1.begin ( ) + cut[ i ], V1.begin ( ) + cut[ i + 1 ],
+                                  [](xk A, xk B) { return B < A; });
+            else if (i % 3 == 0)
+                std::stable_sort (V1.begin ( ) + cut[ i ], V1.begin ( ) + cut[ i + 1 ]);
+        };
+        V2 = V1;
+        flat_stable_sort< iter_t, compare_t > (V1.begin ( ), V1.end ( ), compare_t ( ));
+        std::stable_sort (V2.begin ( ), V2.end ( ));
+
+        BOOST_CHECK (V1.size ( ) == V2.size ( ));
+        for (uint32_t i = 0; i < V1.size ( ); ++i) {
+            BOOST_CHECK (V1[ i ].num == V2[ i ].num and
+                         V1[ i ].tail == V2[ i ].tail);
+        };
+    };
+};
 int test_main (int, char *[])
 {
     test1 ( );
     test2 ( );
     test3 ( );
+    test4 ( );
     return 0;
 };
@@ -12,10 +12,15 @@
 //-----------------------------------------------------------------------------
 #include <ciso646>
 #include <iostream>
+#include <limits>
+#include <string>
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
 #include <vector>
+#include <algorithm>
+#include <functional>
+#include <random>
 #include <boost/sort/insert_sort/insert_sort.hpp>
 #include <boost/test/included/test_exec_monitor.hpp>
 #include <boost/test/test_tools.hpp>
@@ -24,6 +29,7 @@
 using namespace boost::sort;
 using namespace std;
 using boost::sort::common::util::insert_sorted;
+namespace bsc = boost::sort::common;
 
 void test01 (void)
 {
@@ -154,10 +160,79 @@ void test03 ( void)
 
 
 }
+// By the 0-1 principle, the network sorts any data when it sorts all the
+// sequences of 0 and 1
+template <size_t N>
+void test_network01 (void)
+{
+    for (uint32_t mask = 0; mask < (1u << N); ++mask)
+    {
+        int A[ N + 1 ];
+        for (uint32_t i = 0; i < N; ++i) A[ i ] = (mask >> i) & 1;
+        bsc::sort_network<N> (A, std::less<int> ( ));
+        BOOST_CHECK (std::is_sorted (A, A + N));
+    };
+};
+
+// The integers are padded with the greatest value, which is also in the data
+template <class T, class Compare>
+void test_network_sort (Compare comp)
+{
+    std::mt19937 my_rand (0);
+    const T highest = (std::numeric_limits<T>::max) ( );
+    const T lowest = (std::numeric_limits<T>::min) ( );
+    for (uint32_t nelem = 0; nelem <= 40; ++nelem)
+    {
+        for (uint32_t k = 0; k < 100; ++k)
+        {
+            std::vector<T> V, W;
+            for (uint32_t i = 0; i < nelem; ++i)
+            {
+                uint32_t x = my_rand ( );
+                V.push_back ((x % 7 == 0) ? highest
+                             : (x % 7 == 1) ? lowest : T (x >> 8));
+            };
+            W = V;
+            std::sort (W.begin ( ), W.end ( ), comp);
+            if (nelem <= bsc::sort_network_max)
+            {
+                std::vector<T> U (V);
+                bsc::network_sort (U.begin ( ), U.end ( ), comp);
+                BOOST_CHECK (U == W);
+            };
+            insert_sort (V.begin ( ), V.end ( ), comp);
+            BOOST_CHECK (V == W);
+        };
+    };
+};
+
+void test04 (void)
+{
+    typedef std::vector<int>::iterator iter_t;
+    BOOST_CHECK ((bsc::use_sort_network<iter_t, std::less<int> >::value));
+    BOOST_CHECK ((bsc::use_sort_network<iter_t, std::greater<int> >::value));
+    BOOST_CHECK ((not bsc::use_sort_network<double *,
+                                            std::less<double> >::value));
+    BOOST_CHECK ((not bsc::use_sort_network<std::string *,
+                                            std::less<std::string> >::value));
+
+    test_network01<2> ( );
+    test_network01<3> ( );
+    test_network01<4> ( );
+    test_network01<8> ( );
+    test_network01<16> ( );
+
+    test_network_sort<int> (std::less<int> ( ));
+    test_network_sort<int> (std::greater<int> ( ));
+    test_network_sort<int8_t> (std::less<int8_t> ( ));
+    test_network_sort<uint64_t> (std::greater<uint64_t> ( ));
+};
+
 int test_main (int, char *[])
 {
     test01 ( );
     test02 ( );
     test03 ( );
+    test04 ( );
     return 0;
 }
@@ -0,0 +1,135 @@
+//----------------------------------------------------------------------------
+/// @file test_mapped_file.cpp
+/// @brief Test program of the class mapped_file, sorting files in place with
+///        several algorithms
+///
+///         Distributed under the Boost Software License, Version 1.0.\n
+///         ( See accompanying file LICENSE_1_0.txt or copy at
+///           http://www.boost.org/LICENSE_1_0.txt  )
+/// @version 0.1
+///
+/// @remarks
+//-----------------------------------------------------------------------------
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <ios>
+#include <random>
+#include <string>
+#include <vector>
+#include <ciso646>
+#include <boost/test/included/test_exec_monitor.hpp>
+#include <boost/test/test_tools.hpp>
+#include <boost/sort/sort.hpp>
+#include <boost/sort/common/mapped_file.hpp>
+
+namespace bsc = boost::sort::common;
+namespace bss = boost::sort;
+using bsc::mapped_file;
+
+const std::string filename = "test_mapped_file.bin";
+
+void write_vector (const std::vector< uint64_t > &V)
+{
+    std::ofstream ofile (filename, std::ios_base::out | std::ios_base::binary |
+                                   std::ios_base::trunc);
+    ofile.write ((const char *) V.data ( ), V.size ( ) * sizeof (uint64_t));
+};
+
+std::vector< uint64_t > read_vector (void)
+{
+    std::ifstream input (filename, std::ios_base::in | std::ios_base::binary |
+                                   std::ios_base::ate);
+    std::vector< uint64_t > V (size_t (input.tellg ( )) / sizeof (uint64_t));
+    input.seekg (0);
+    input.read ((char *) V.data ( ), V.size ( ) * sizeof (uint64_t));
+    return V;
+};
+
+//---------------------------------------------------------------------------
+// The same file sorted in place with several algorithms
+//---------------------------------------------------------------------------
+void test1 (void)
+{
+    std::mt19937_64 my_rand (0);
+    std::vector< uint64_t > A (500000), B;
+    for (uint32_t i = 0; i < A.size ( ); ++i) A[i] = my_rand ( );
+    B = A;
+    std::sort (B.begin ( ), B.end ( ));
+
+    for (uint32_t alg = 0; alg < 4; ++alg)
+    {
+        write_vector (A);
+        {
+            mapped_file< uint64_t > file (filename);
+            BOOST_CHECK (file.size ( ) == A.size ( ));
+            BOOST_CHECK (file[7] == A[7]);
+            file.advise (file.sequential);
+            switch (alg)
+            {
+            case 0:
+                bss::spreadsort::integer_sort (file.begin ( ), file.end ( ));
+                break;
+            case 1:
+                bss::pdqsort (file.begin ( ), file.end ( ));
+                break;
+            case 2:
+                bss::flat_stable_sort (file.begin ( ), file.end ( ));
+                break;
+            default:
+                file.advise (file.random);
+                bss::block_indirect_sort (file.begin ( ), file.end ( ),
+                                          std::less< uint64_t > ( ), 4);
+            };
+            file.sync ( );
+        };
+        BOOST_CHECK (read_vector ( ) == B);
+    };
+
+    // read only
+    {
+        mapped_file< uint64_t > file (filename, true);
+        BOOST_CHECK (std::is_sorted (file.begin ( ), file.end ( )));
+        BOOST_CHECK (file.get_range ( ).size ( ) == B.size ( ));
+    };
+
+    // a read only file is sorted in memory, and the file is not modified
+    write_vector (A);
+    {
+        mapped_file< uint64_t > file (filename, true);
+        bss::spreadsort::integer_sort (file.begin ( ), file.end ( ));
+        BOOST_CHECK (std::equal (file.begin ( ), file.end ( ), B.begin ( )));
+        file.sync ( );
+    };
+    BOOST_CHECK (read_vector ( ) == A);
+};
+
+//---------------------------------------------------------------------------
+// Empty file, and files which can't be mapped
+//---------------------------------------------------------------------------
+void test2 (void)
+{
+    write_vector (std::vector< uint64_t > ( ));
+    {
+        mapped_file< uint64_t > file (filename);
+        BOOST_CHECK (file.empty ( ));
+        BOOST_CHECK (file.begin ( ) == file.end ( ));
+        file.advise (file.willneed);
+        bss::pdqsort (file.begin ( ), file.end ( ));
+    };
+
+    std::ofstream (filename, std::ios_base::binary) << "12345";
+    BOOST_CHECK_THROW (mapped_file< uint64_t > file (filename),
+                       std::ios_base::failure);
+    BOOST_CHECK_THROW (mapped_file< uint64_t > file ("nonexistent_file.bin"),
+                       std::ios_base::failure);
+};
+
+int test_main (int, char *[])
+{
+    test1 ( );
+    test2 ( );
+    std::remove (filename.c_str ( ));
+    return 0;
+};
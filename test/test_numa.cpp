@@ -0,0 +1,168 @@
+//----------------------------------------------------------------------------
+/// @file test_numa.cpp
+/// @brief Test program of the NUMA support of the parallel algorithms
+///
+///         Distributed under the Boost Software License, Version 1.0.\n
+///         ( See accompanying file LICENSE_1_0.txt or copy at
+///           http://www.boost.org/LICENSE_1_0.txt  )
+/// @version 0.1
+///
+/// @remarks
+//-----------------------------------------------------------------------------
+#define BOOST_SORT_USE_NUMA
+#define BOOST_SORT_NUMA_SYSFS_PATH "numa_test_machine"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include <ciso646>
+#include <boost/test/included/test_exec_monitor.hpp>
+#include <boost/test/test_tools.hpp>
+#include <boost/sort/sort.hpp>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace bss = boost::sort;
+using bss::common::numa_topology;
+using bss::common::numa_bind;
+
+#ifdef __linux__
+//---------------------------------------------------------------------------
+// Copy of /sys/devices/system/node with two nodes with the first cpu allowed
+// to the thread, and a node without cpus
+//---------------------------------------------------------------------------
+const char *nodes[] = {"node0", "node1", "node2"};
+
+uint32_t first_cpu (void)
+{
+    cpu_set_t cpu_set;
+    pthread_getaffinity_np (pthread_self ( ), sizeof (cpu_set), &cpu_set);
+    uint32_t cpu = 0;
+    while (not CPU_ISSET (cpu, &cpu_set)) ++cpu;
+    return cpu;
+};
+
+void create_machine (const std::string &dir)
+{
+    std::string cpulist[] = {std::to_string (first_cpu ( )),
+                             std::to_string (first_cpu ( )), ""};
+    mkdir (dir.c_str ( ), 0700);
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        mkdir ((dir + "/" + nodes[i]).c_str ( ), 0700);
+        std::ofstream (dir + "/" + nodes[i] + "/cpulist") << cpulist[i] << "\n";
+    };
+};
+
+void remove_machine (const std::string &dir)
+{
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        std::remove ((dir + "/" + nodes[i] + "/cpulist").c_str ( ));
+        rmdir ((dir + "/" + nodes[i]).c_str ( ));
+    };
+    rmdir (dir.c_str ( ));
+};
+#endif
+
+//---------------------------------------------------------------------------
+// Lists of cpus in the format of sysfs
+//---------------------------------------------------------------------------
+void test1 (void)
+{
+    std::vector< uint32_t > V = numa_topology::parse_cpulist ("0-3,8,10-11\n");
+    uint32_t A[] = {0, 1, 2, 3, 8, 10, 11};
+    BOOST_CHECK (V == std::vector< uint32_t > (A, A + 7));
+    BOOST_CHECK (numa_topology::parse_cpulist ("5") ==
+                 std::vector< uint32_t > (1, 5));
+    BOOST_CHECK (numa_topology::parse_cpulist ("\n").empty ( ));
+
+    // A directory without nodes is a single node
+    numa_topology T ("/nonexistent");
+    BOOST_CHECK (T.nnodes ( ) == 1);
+    BOOST_CHECK (T.node_of (5, 8) == 0);
+};
+
+//---------------------------------------------------------------------------
+// Topology read from the copy of /sys/devices/system/node, and binding to
+// its nodes
+//---------------------------------------------------------------------------
+void test2 (void)
+{
+#ifdef __linux__
+    cpu_set_t old_set;
+    BOOST_CHECK (pthread_getaffinity_np (pthread_self ( ), sizeof (old_set),
+                                         &old_set) == 0);
+    uint32_t cpu = first_cpu ( );
+
+    numa_topology T (BOOST_SORT_NUMA_SYSFS_PATH);
+    BOOST_CHECK (T.nnodes ( ) == 2);
+    BOOST_CHECK (T.cpus (1) == std::vector< uint32_t > (1, cpu));
+    BOOST_CHECK (T.node_of (0, 8) == 0);
+    BOOST_CHECK (T.node_of (3, 8) == 0);
+    BOOST_CHECK (T.node_of (4, 8) == 1);
+    BOOST_CHECK (T.node_of (7, 8) == 1);
+    {
+        numa_bind nb (T, 1);
+        BOOST_CHECK (nb.is_bound ( ));
+        cpu_set_t new_set;
+        pthread_getaffinity_np (pthread_self ( ), sizeof (new_set), &new_set);
+        BOOST_CHECK (CPU_COUNT (&new_set) == 1 and CPU_ISSET (cpu, &new_set));
+    };
+    cpu_set_t restored;
+    pthread_getaffinity_np (pthread_self ( ), sizeof (restored), &restored);
+    BOOST_CHECK (CPU_EQUAL (&restored, &old_set));
+#endif
+};
+
+//---------------------------------------------------------------------------
+// The parallel algorithms in a machine with two nodes
+//---------------------------------------------------------------------------
+void test3 (void)
+{
+#ifdef __linux__
+    BOOST_CHECK (bss::common::numa_machine ( ).nnodes ( ) == 2);
+#endif
+    typedef std::less< uint64_t > compare;
+    std::mt19937_64 my_rand (0);
+    const uint32_t NELEM = 500000;
+    std::vector< uint64_t > A, B;
+    A.reserve (NELEM);
+    for (uint32_t i = 0; i < NELEM; ++i) A.push_back (my_rand ( ));
+    B = A;
+    std::sort (B.begin ( ), B.end ( ));
+
+    std::vector< uint64_t > V (A);
+    bss::block_indirect_sort (V.begin ( ), V.end ( ), compare ( ), 4);
+    BOOST_CHECK (V == B);
+
+    V = A;
+    bss::sample_sort (V.begin ( ), V.end ( ), compare ( ), 4);
+    BOOST_CHECK (V == B);
+
+    V = A;
+    bss::parallel_stable_sort (V.begin ( ), V.end ( ), compare ( ), 4);
+    BOOST_CHECK (V == B);
+};
+
+int test_main (int, char *[])
+{
+#ifdef __linux__
+    create_machine (BOOST_SORT_NUMA_SYSFS_PATH);
+#endif
+    test1 ( );
+    test2 ( );
+    test3 ( );
+#ifdef __linux__
+    remove_machine (BOOST_SORT_NUMA_SYSFS_PATH);
+#endif
+    return 0;
+};
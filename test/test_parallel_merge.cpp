@@ -0,0 +1,199 @@
+//----------------------------------------------------------------------------
+/// @file test_parallel_merge.cpp
+/// @brief Test program of the loser_tree class and of the parallel_merge
+///        algorithm
+///
+///         Distributed under the Boost Software License, Version 1.0.\n
+///         ( See accompanying file LICENSE_1_0.txt or copy at
+///           http://www.boost.org/LICENSE_1_0.txt  )
+/// @version 0.1
+///
+/// @remarks
+//-----------------------------------------------------------------------------
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <ciso646>
+#include <boost/test/included/test_exec_monitor.hpp>
+#include <boost/test/test_tools.hpp>
+#include <boost/sort/parallel_merge/parallel_merge.hpp>
+
+namespace bsc = boost::sort::common;
+using boost::sort::parallel_merge;
+using bsc::range;
+using bsc::loser_tree;
+
+// element with a key and the number of its range, for to check stability
+typedef std::pair< uint32_t, uint32_t > xk;
+typedef std::vector< xk >::iterator xk_iter;
+
+struct less_key
+{
+    bool operator( ) (const xk &a, const xk &b) const
+    {
+        return a.first < b.first;
+    };
+};
+
+//---------------------------------------------------------------------------
+// Fill V with nrange sorted ranges of random sizes, some of them empty, and
+// store the ranges in vr. Sorted is the stable merge of the ranges
+//---------------------------------------------------------------------------
+void create_ranges (std::vector< xk > &V, std::vector< range< xk_iter > > &vr,
+                    std::vector< xk > &sorted, uint32_t nrange,
+                    uint32_t max_size, uint32_t max_key)
+{
+    std::mt19937 my_rand (nrange);
+    std::vector< size_t > vsize;
+    V.clear ( );
+    for (uint32_t i = 0; i < nrange; ++i)
+    {
+        size_t n = (i % 5 == 3) ? 0 : my_rand ( ) % max_size;
+        for (size_t j = 0; j < n; ++j)
+            V.emplace_back (my_rand ( ) % max_key, i);
+        std::stable_sort (V.end ( ) - n, V.end ( ), less_key ( ));
+        vsize.push_back (n);
+    };
+    vr.clear ( );
+    xk_iter it = V.begin ( );
+    for (uint32_t i = 0; i < nrange; ++i)
+    {
+        vr.emplace_back (it, it + vsize[i]);
+        it += vsize[i];
+    };
+    sorted = V;
+    std::stable_sort (sorted.begin ( ), sorted.end ( ), less_key ( ));
+};
+
+//---------------------------------------------------------------------------
+// loser_tree with 0, 1, and several ranges
+//---------------------------------------------------------------------------
+void test1 (void)
+{
+    std::vector< xk > V, sorted;
+    std::vector< range< xk_iter > > vr;
+    uint32_t nranges[] = {0, 1, 2, 3, 37};
+    for (uint32_t k : nranges)
+    {
+        create_ranges (V, vr, sorted, k, 1000, 100);
+        std::vector< xk > out (V.size ( ));
+        loser_tree< xk_iter, less_key > tree (vr, less_key ( ));
+        BOOST_CHECK (tree.size ( ) == V.size ( ));
+        BOOST_CHECK (tree.merge (out.begin ( )) == out.end ( ));
+        BOOST_CHECK (tree.empty ( ));
+        BOOST_CHECK (out == sorted);
+
+        // copy, which doesn't modify the ranges
+        std::vector< xk > input (V);
+        std::vector< xk > out2 (V.size ( ));
+        loser_tree< xk_iter, less_key > tree2 (vr, less_key ( ));
+        BOOST_CHECK (tree2.copy (out2.begin ( )) == out2.end ( ));
+        BOOST_CHECK (tree2.empty ( ));
+        BOOST_CHECK (out2 == sorted);
+        BOOST_CHECK (V == input);
+    };
+
+    // uninitialized output
+    create_ranges (V, vr, sorted, 7, 1000, 100);
+    std::vector< xk > out (V.size ( ));
+    loser_tree< xk_iter, less_key > tree (vr, less_key ( ));
+    BOOST_CHECK (tree.merge_construct (out.data ( )) == out.data ( ) + out.size ( ));
+    BOOST_CHECK (out == sorted);
+};
+
+//---------------------------------------------------------------------------
+// parallel_merge with many repeated keys, with unique keys, with several
+// numbers of threads, and in a pool
+//---------------------------------------------------------------------------
+void test2 (void)
+{
+    std::vector< xk > V, sorted;
+    std::vector< range< xk_iter > > vr;
+    uint32_t nranges[] = {1, 2, 5, 48};
+    uint32_t max_keys[] = {10, 1000000000};
+    boost::sort::thread_pool pool (2);
+    for (uint32_t k : nranges)
+    {
+        for (uint32_t max_key : max_keys)
+        {
+            create_ranges (V, vr, sorted, k, 400000 / k + 1000, max_key);
+            std::vector< xk > input (V);
+            for (uint32_t nthread = 1; nthread < 8; nthread += 3)
+            {
+                std::vector< xk > out (V.size ( ));
+                BOOST_CHECK (parallel_merge (vr, out.begin ( ), less_key ( ),
+                                             nthread) == out.end ( ));
+                BOOST_CHECK (out == sorted);
+                BOOST_CHECK (V == input);
+            };
+            std::vector< xk > out (V.size ( ));
+            parallel_merge (vr, out.begin ( ), less_key ( ), 3, pool);
+            BOOST_CHECK (out == sorted);
+            BOOST_CHECK (V == input);
+        };
+    };
+
+    // all the elements equal
+    V.assign (200000, xk (5, 0));
+    for (uint32_t i = 0; i < V.size ( ); ++i) V[i].second = i;
+    vr.clear ( );
+    for (uint32_t i = 0; i < 4; ++i)
+        vr.emplace_back (V.begin ( ) + i * 50000, V.begin ( ) + (i + 1) * 50000);
+    std::vector< xk > input (V);
+    std::vector< xk > out (V.size ( ));
+    parallel_merge (vr, out.begin ( ), less_key ( ), 4);
+    BOOST_CHECK (out == V);
+    BOOST_CHECK (V == input);
+};
+
+//---------------------------------------------------------------------------
+// strings, with the default comparison
+//---------------------------------------------------------------------------
+void test3 (void)
+{
+    std::mt19937 my_rand (0);
+    std::vector< std::string > V, sorted;
+    typedef std::vector< std::string >::iterator str_iter;
+    std::vector< range< str_iter > > vr;
+    for (uint32_t i = 0; i < 100000; ++i)
+        V.push_back (std::to_string (my_rand ( )));
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        std::sort (V.begin ( ) + i * 10000, V.begin ( ) + (i + 1) * 10000);
+        vr.emplace_back (V.begin ( ) + i * 10000, V.begin ( ) + (i + 1) * 10000);
+    };
+    sorted = V;
+    std::sort (sorted.begin ( ), sorted.end ( ));
+    std::vector< std::string > input (V);
+    std::vector< std::string > out (V.size ( ));
+    parallel_merge (vr, out.begin ( ));
+    BOOST_CHECK (out == sorted);
+    BOOST_CHECK (V == input);
+
+    // two shards merged with 2 threads, which must keep their strings
+    V.clear ( );
+    for (uint32_t i = 0; i < 200000; ++i)
+        V.push_back (std::to_string (my_rand ( )));
+    std::sort (V.begin ( ), V.begin ( ) + 100000);
+    std::sort (V.begin ( ) + 100000, V.end ( ));
+    vr.clear ( );
+    vr.emplace_back (V.begin ( ), V.begin ( ) + 100000);
+    vr.emplace_back (V.begin ( ) + 100000, V.end ( ));
+    sorted = input = V;
+    std::sort (sorted.begin ( ), sorted.end ( ));
+    out.assign (V.size ( ), std::string ( ));
+    parallel_merge (vr, out.begin ( ), std::less< std::string > ( ), 2);
+    BOOST_CHECK (out == sorted);
+    BOOST_CHECK (V == input);
+};
+
+int test_main (int, char *[])
+{
+    test1 ( );
+    test2 ( );
+    test3 ( );
+    return 0;
+};
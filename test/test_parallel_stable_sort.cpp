@@ -14,6 +14,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
+#include <memory>
 #include <vector>
 #include <random>
 #include <algorithm>
@@ -170,6 +171,34 @@ void test5 (void)
     };
 }
 
+// The auxiliary memory is taken from the memory of the caller, of the exact
+// size required, reused in many sorts, with 1 and many threads
+void test6 (void)
+{
+    typedef typename std::vector<xk>::iterator iter_t;
+    typedef std::less<xk> compare;
+    std::mt19937 my_rand (0);
+    std::vector<xk> A, B;
+    const uint32_t NELEM = 300000;
+    for (uint32_t i = 0; i < NELEM; ++i) A.emplace_back (my_rand ( ) % 1000, i);
+    B = A;
+    std::stable_sort (B.begin ( ), B.end ( ));
+
+    size_t nbuf = bss::parallel_stable_sort_buffer_size<iter_t> (NELEM, 4);
+    BOOST_CHECK (nbuf == (NELEM + 1) / 2);
+    std::allocator<xk> alloc;
+    xk *ptr = alloc.allocate (nbuf);
+    bss::common::range<xk *> rbuf (ptr, ptr + nbuf);
+    for (uint32_t nthread = 1; nthread < 5; nthread += 3)
+    {
+        std::vector<xk> V (A);
+        bss::parallel_stable_sort (V.begin ( ), V.end ( ), compare ( ),
+                                   nthread, rbuf);
+        for (uint32_t i = 0; i < NELEM; ++i)
+            BOOST_CHECK (V[i].num == B[i].num and V[i].tail == B[i].tail);
+    };
+    alloc.deallocate (ptr, nbuf);
+}
 
 int test_main(int, char *[])
 {
@@ -178,6 +207,7 @@ int test_main(int, char *[])
     test3();
     test4();
     test5();
+    test6();
     return 0;
 };
 
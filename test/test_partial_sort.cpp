@@ -0,0 +1,150 @@
+//----------------------------------------------------------------------------
+/// @file test_partial_sort.cpp
+/// @brief Test program of nth_element, partial_sort and parallel_partial_sort
+///
+///         Distributed under the Boost Software License, Version 1.0.\n
+///         ( See accompanying file LICENSE_1_0.txt or copy at
+///           http://www.boost.org/LICENSE_1_0.txt  )
+/// @version 0.1
+///
+/// @remarks
+//-----------------------------------------------------------------------------
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include <ciso646>
+#include <boost/test/included/test_exec_monitor.hpp>
+#include <boost/test/test_tools.hpp>
+#include <boost/sort/pdqsort/pdqselect.hpp>
+#include <boost/sort/parallel_partial_sort/parallel_partial_sort.hpp>
+
+namespace bss = boost::sort;
+
+//---------------------------------------------------------------------------
+// Vectors with several distributions, which produce bad partitions or many
+// equal elements
+//---------------------------------------------------------------------------
+std::vector< std::vector< uint32_t > > create_distributions (size_t size)
+{
+    std::mt19937_64 my_rand (size);
+    std::vector< std::vector< uint32_t > > vv (6);
+    for (uint32_t i = 0; i < size; ++i)
+    {
+        vv[0].push_back (uint32_t (my_rand ( )));
+        vv[1].push_back (uint32_t (my_rand ( ) % 16));
+        vv[2].push_back (0);
+        vv[3].push_back (i);
+        vv[4].push_back (uint32_t (size - i));
+        vv[5].push_back ((i < size / 2) ? i : uint32_t (size - i));
+    };
+    return vv;
+};
+
+//---------------------------------------------------------------------------
+// nth_element and partial_sort with several sizes and positions
+//---------------------------------------------------------------------------
+void test1 (void)
+{
+    size_t sizes[] = {1, 10, 100, 1000, 100000};
+    for (size_t size : sizes)
+    {
+        for (const std::vector< uint32_t > &A : create_distributions (size))
+        {
+            std::vector< uint32_t > sorted (A);
+            std::sort (sorted.begin ( ), sorted.end ( ));
+            size_t positions[] = {0, 1, size / 3, size / 2, size - 1};
+            for (size_t pos : positions)
+            {
+                if (pos >= size) continue;
+                std::vector< uint32_t > V (A);
+                bss::nth_element (V.begin ( ), V.begin ( ) + pos, V.end ( ));
+                BOOST_CHECK (V[pos] == sorted[pos]);
+                BOOST_CHECK (std::all_of (V.begin ( ), V.begin ( ) + pos,
+                             [&](uint32_t x) { return x <= V[pos]; }));
+                BOOST_CHECK (std::all_of (V.begin ( ) + pos, V.end ( ),
+                             [&](uint32_t x) { return x >= V[pos]; }));
+
+                V = A;
+                bss::partial_sort (V.begin ( ), V.begin ( ) + pos + 1,
+                                   V.end ( ));
+                BOOST_CHECK (std::equal (V.begin ( ), V.begin ( ) + pos + 1,
+                                         sorted.begin ( )));
+                std::sort (V.begin ( ) + pos + 1, V.end ( ));
+                BOOST_CHECK (std::equal (V.begin ( ) + pos + 1, V.end ( ),
+                                         sorted.begin ( ) + pos + 1));
+            };
+        };
+    };
+};
+
+//---------------------------------------------------------------------------
+// strings, with std::greater
+//---------------------------------------------------------------------------
+void test2 (void)
+{
+    std::mt19937 my_rand (0);
+    std::vector< std::string > A, V, sorted;
+    for (uint32_t i = 0; i < 10000; ++i)
+        A.push_back (std::to_string (my_rand ( ) % 5000));
+    sorted = A;
+    std::sort (sorted.begin ( ), sorted.end ( ), std::greater< std::string > ( ));
+
+    V = A;
+    bss::nth_element (V.begin ( ), V.begin ( ) + 777, V.end ( ),
+                      std::greater< std::string > ( ));
+    BOOST_CHECK (V[777] == sorted[777]);
+
+    V = A;
+    bss::partial_sort (V.begin ( ), V.begin ( ) + 1000, V.end ( ),
+                       std::greater< std::string > ( ));
+    BOOST_CHECK (std::equal (V.begin ( ), V.begin ( ) + 1000, sorted.begin ( )));
+
+    V = A;
+    bss::parallel_partial_sort (V.begin ( ), V.begin ( ) + 10, V.end ( ),
+                                std::greater< std::string > ( ), 4);
+    BOOST_CHECK (std::equal (V.begin ( ), V.begin ( ) + 10, sorted.begin ( )));
+};
+
+//---------------------------------------------------------------------------
+// parallel_partial_sort, with several numbers of threads and elements to sort
+//---------------------------------------------------------------------------
+void test3 (void)
+{
+    const size_t NELEM = 1000000;
+    bss::thread_pool pool (3);
+    for (const std::vector< uint32_t > &A : create_distributions (NELEM))
+    {
+        std::vector< uint32_t > sorted (A);
+        std::sort (sorted.begin ( ), sorted.end ( ));
+        size_t nsels[] = {1, 1000, 100000, NELEM};
+        for (size_t nsel : nsels)
+        {
+            for (uint32_t nthread = 1; nthread < 10; nthread += 4)
+            {
+                std::vector< uint32_t > V (A);
+                bss::parallel_partial_sort (V.begin ( ), V.begin ( ) + nsel,
+                                            V.end ( ), nthread);
+                BOOST_CHECK (std::equal (V.begin ( ), V.begin ( ) + nsel,
+                                         sorted.begin ( )));
+                std::sort (V.begin ( ) + nsel, V.end ( ));
+                BOOST_CHECK (V == sorted);
+            };
+            std::vector< uint32_t > V (A);
+            bss::parallel_partial_sort (V.begin ( ), V.begin ( ) + nsel,
+                                        V.end ( ), std::less< uint32_t > ( ),
+                                        4, pool);
+            BOOST_CHECK (std::equal (V.begin ( ), V.begin ( ) + nsel,
+                                     sorted.begin ( )));
+        };
+    };
+};
+
+int test_main (int, char *[])
+{
+    test1 ( );
+    test2 ( );
+    test3 ( );
+    return 0;
+};
@@ -8,6 +8,7 @@
 //  See http://www.boost.org/libs/sort for library home page.
 
 
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <random>
@@ -145,6 +146,38 @@ void execute_test(DistrF distr, std::string distr_name, int repeats) {
 }
 
 
+// The primitive types compared with std::less or std::greater may be partitioned with vectors,
+// with the elements which don't fill a vector partitioned one by one.
+template<class T, class Compare>
+void execute_primitive_test(const std::string& type_name, Compare comp) {
+    std::mt19937_64 rng; rng.seed(0);
+
+    for (size_t sz = 1; sz <= 10000; sz = sz * 3 + 1) {
+        for (int distr = 0; distr < 4; ++distr) {
+            std::vector<T> v; v.reserve(sz);
+            for (size_t i = 0; i < sz; ++i) {
+                uint64_t r = rng();
+                if (distr == 0) v.push_back(T(r));
+                else if (distr == 1) v.push_back(T(r % 16));
+                else if (distr == 2) v.push_back(T(int64_t(r) >> 20) / T(3));
+                else v.push_back(T(i % 2 ? r % 1000 : i));
+            }
+
+            std::vector<T> expected = v;
+            std::sort(expected.begin(), expected.end(), comp);
+            std::vector<T> by_iter = v;
+            boost::sort::pdqsort(by_iter.begin(), by_iter.end(), comp);
+            std::vector<T> by_ptr = v;
+            boost::sort::pdqsort(&by_ptr[0], &by_ptr[0] + sz, comp);
+
+            BOOST_CHECK_MESSAGE(by_iter == expected && by_ptr == expected,
+                "pdqsort<" + type_name + "> distribution " + std::to_string(distr) +
+                " failed with size " + std::to_string(sz));
+        }
+    }
+}
+
+
 // test main 
 int test_main(int argc, char** argv) {
     // No unused warning.
@@ -159,5 +192,14 @@ int test_main(int argc, char** argv) {
     execute_test(push_front, "push_front", 1);
     execute_test(push_middle, "push_middle", 1);
 
+    execute_primitive_test<int32_t>("int32_t, std::less", std::less<int32_t>());
+    execute_primitive_test<int32_t>("int32_t, std::greater", std::greater<int32_t>());
+    execute_primitive_test<uint32_t>("uint32_t, std::less", std::less<uint32_t>());
+    execute_primitive_test<int64_t>("int64_t, std::less", std::less<int64_t>());
+    execute_primitive_test<uint64_t>("uint64_t, std::greater", std::greater<uint64_t>());
+    execute_primitive_test<float>("float, std::less", std::less<float>());
+    execute_primitive_test<double>("double, std::less", std::less<double>());
+    execute_primitive_test<double>("double, std::greater", std::greater<double>());
+
     return 0;
 }
@@ -163,10 +163,17 @@ void test5 (void)
         iter_t last = first + NELEM ;
         std::shuffle( first, last, my_rand);
     };
+    std::vector<xk> V2 (V);
     bss::sample_sort( V.begin() , V.end());
     for ( uint32_t i =0 ; i < ( NELEM * 10); ++i)
     {   BOOST_CHECK ( V[i].num == (i / 10) and V[i].tail == (i %10) );
     };
+
+    // --------------- many threads, merged with a loser tree ---------------
+    bss::sample_sort( V2.begin() , V2.end(), 32);
+    for ( uint32_t i =0 ; i < ( NELEM * 10); ++i)
+    {   BOOST_CHECK ( V2[i].num == (i / 10) and V2[i].tail == (i %10) );
+    };
 }
 
 
@@ -0,0 +1,154 @@
+//----------------------------------------------------------------------------
+/// @file test_scheduler_ws.cpp
+/// @brief Test program of the deque_ws and scheduler_ws classes
+///
+///         Distributed under the Boost Software License, Version 1.0.\n
+///         ( See accompanying file LICENSE_1_0.txt or copy at
+///           http://www.boost.org/LICENSE_1_0.txt  )
+/// @version 0.1
+///
+/// @remarks
+//-----------------------------------------------------------------------------
+#include <atomic>
+#include <functional>
+#include <future>
+#include <thread>
+#include <vector>
+#include <ciso646>
+#include <boost/test/included/test_exec_monitor.hpp>
+#include <boost/test/test_tools.hpp>
+#include <boost/sort/common/deque_ws.hpp>
+#include <boost/sort/common/scheduler_ws.hpp>
+
+namespace bsc = boost::sort::common;
+using bsc::deque_ws;
+using bsc::scheduler_ws;
+
+//---------------------------------------------------------------------------
+// The owner takes the last inserted and the thieves the first, growing the
+// deque over its initial size
+//---------------------------------------------------------------------------
+void test1 (void)
+{
+    std::vector< int > V (100);
+    deque_ws< int > D (4);
+    BOOST_CHECK (D.empty ( ));
+    BOOST_CHECK (D.pop ( ) == nullptr);
+    BOOST_CHECK (D.steal ( ) == nullptr);
+
+    for (int i = 0; i < 100; ++i) D.push (&V[i]);
+    BOOST_CHECK (D.pop ( ) == &V[99]);
+    BOOST_CHECK (D.steal ( ) == &V[0]);
+    BOOST_CHECK (D.steal ( ) == &V[1]);
+    for (int i = 98; i > 1; --i) BOOST_CHECK (D.pop ( ) == &V[i]);
+    BOOST_CHECK (D.pop ( ) == nullptr);
+    BOOST_CHECK (D.empty ( ));
+};
+
+//---------------------------------------------------------------------------
+// Every element is taken once, by the owner or by one of the thieves
+//---------------------------------------------------------------------------
+void test2 (void)
+{
+    const int NElem = 200000, NThief = 3;
+    std::vector< int > V (NElem, 0);
+    std::vector< std::atomic< int > > Taken (NElem);
+    for (int i = 0; i < NElem; ++i) Taken[i] = 0;
+    deque_ws< int > D;
+    std::atomic< bool > done (false);
+
+    std::vector< std::future< void > > F;
+    for (int t = 0; t < NThief; ++t)
+    {
+        F.push_back (std::async (std::launch::async, [&]( )
+        {
+            while (not done)
+            {
+                int *P = D.steal ( );
+                if (P != nullptr) Taken[P - &V[0]]++;
+            };
+        }));
+    };
+    for (int i = 0; i < NElem; ++i)
+    {
+        D.push (&V[i]);
+        if (i % 3 == 0)
+        {
+            int *P = D.pop ( );
+            if (P != nullptr) Taken[P - &V[0]]++;
+        };
+    };
+    int *P;
+    while ((P = D.pop ( )) != nullptr) Taken[P - &V[0]]++;
+    done = true;
+    for (int t = 0; t < NThief; ++t) F[t].get ( );
+
+    bool once = true;
+    for (int i = 0; i < NElem; ++i) once = once and (Taken[i] == 1);
+    BOOST_CHECK (once);
+};
+
+//---------------------------------------------------------------------------
+// Recursive splitting of works, as in block_indirect_sort, with the first
+// work inserted from a thread which is not a worker
+//---------------------------------------------------------------------------
+typedef std::function< void(void) > function_t;
+
+void split (scheduler_ws< function_t > &S, std::atomic< uint32_t > &counter,
+            std::atomic< uint64_t > &sum, uint64_t first, uint64_t last)
+{
+    if (last - first < 64)
+    {
+        uint64_t total = 0;
+        for (uint64_t i = first; i < last; ++i) total += i;
+        sum += total;
+        counter--;
+        return;
+    };
+    uint64_t mid = (first + last) >> 1;
+    counter++;
+    S.emplace_back ([&S, &counter, &sum, mid, last]( )
+    {
+        split (S, counter, sum, mid, last);
+    });
+    split (S, counter, sum, first, mid);
+};
+
+void test3 (void)
+{
+    const uint32_t NThread = 4;
+    const uint64_t NElem = 1 << 20;
+    scheduler_ws< function_t > S (NThread);
+    std::atomic< uint32_t > counter (1);
+    std::atomic< uint64_t > sum (0);
+    S.emplace_back ([&]( ) { split (S, counter, sum, 0, NElem); });
+
+    std::vector< std::future< void > > F;
+    for (uint32_t t = 0; t < NThread; ++t)
+    {
+        F.push_back (std::async (std::launch::async, [&]( )
+        {
+            scheduler_ws< function_t >::worker wk (S);
+            function_t func;
+            while (counter != 0)
+            {
+                if (S.pop_move_back (func)) func ( );
+                else std::this_thread::yield ( );
+            };
+        }));
+    };
+    for (uint32_t t = 0; t < NThread; ++t) F[t].get ( );
+    BOOST_CHECK (sum == NElem * (NElem - 1) / 2);
+
+    // works not executed are deleted with the scheduler
+    scheduler_ws< function_t > S2 (2);
+    S2.emplace_back ([]( ) { });
+};
+
+int test_main (int, char *[])
+{
+    test1 ( );
+    test2 ( );
+    test3 ( );
+    return 0;
+};
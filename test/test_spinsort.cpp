@@ -12,6 +12,7 @@
 //-----------------------------------------------------------------------------
 #include <ciso646>
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <cstdio>
 #include <cstdlib>
@@ -32,6 +33,21 @@ void test1 ( );
 void test2 ( );
 void test3 ( );
 void test4 ( );
+void test5 ( );
+void test6 ( );
+
+// ---------------- counter of the allocations of the program ----------------
+// The memory is obtained with malloc, as in the default operator new, and
+// it is returned with free by the default operator delete
+std::atomic< uint64_t > nalloc (0);
+
+void *operator new (size_t size)
+{
+    ++nalloc;
+    void *ptr = malloc (size == 0 ? 1 : size);
+    if (ptr == nullptr) throw std::bad_alloc ( );
+    return ptr;
+};
 
 //---------------- stability test -----------------------------------
 struct xk
@@ -170,11 +186,83 @@ void test4 (void)
     {   BOOST_CHECK ( V[i].num == (i / 10) and V[i].tail == (i %10) );
     };
 }
+//---------------- natural runs test -------------------------------
+// a few ascending and descending runs of random size, with repeated keys,
+// and some of the runs left in random order
+void test5 (void)
+{
+    typedef std::less< xk > compare_t;
+    std::mt19937_64 my_rand (0);
+    const uint32_t NELEM = 400000;
+    const uint32_t nruns[] = { 2, 5, 17, 100 };
+
+    for (uint32_t nrun : nruns)
+    {
+        std::vector< uint32_t > cut (1, 0);
+        for (uint32_t i = 1; i < nrun; ++i) cut.push_back (my_rand ( ) % NELEM);
+        cut.push_back (NELEM);
+        std::sort (cut.begin ( ), cut.end ( ));
+
+        std::vector< xk > V1, V2;
+        V1.reserve (NELEM);
+        for (uint32_t k = 0; k < NELEM; ++k)
+            V1.emplace_back (uint32_t (my_rand ( ) % 5000), k % 16);
+        for (uint32_t i = 0; i < nrun; ++i)
+        {
+            if (i % 3 == 1)
+                std::stable_sort (V1.begin ( ) + cut[ i ], V1.begin ( ) + cut[ i + 1 ],
+                                  [](xk A, xk B) { return B < A; });
+            else if (i % 3 == 0)
+                std::stable_sort (V1.begin ( ) + cut[ i ], V1.begin ( ) + cut[ i + 1 ]);
+        };
+        V2 = V1;
+        spinsort (V1.begin ( ), V1.end ( ), compare_t ( ));
+        std::stable_sort (V2.begin ( ), V2.end ( ));
+
+        BOOST_CHECK (V1.size ( ) == V2.size ( ));
+        for (uint32_t i = 0; i < V1.size ( ); ++i) {
+            BOOST_CHECK (V1[ i ].num == V2[ i ].num and
+                         V1[ i ].tail == V2[ i ].tail);
+        };
+    };
+};
+//---------------- allocations and many runs test -------------------
+// with the auxiliary memory provided, the random data are sorted without
+// allocations, and the data with more runs than the local array of
+// find_natural_runs are merged
+void test6 (void)
+{
+    typedef std::less< uint64_t > compare_t;
+    typedef spin_detail::spinsort< std::vector< uint64_t >::iterator,
+                                   compare_t > spinsort_t;
+    std::mt19937_64 my_rand (0);
+    const uint32_t NELEM = 100000;
+
+    std::vector< uint64_t > V1, V2, Vaux (NELEM);
+    for (uint32_t i = 0; i < NELEM; ++i) V1.push_back (my_rand ( ));
+    V2 = V1;
+    range< uint64_t * > range_aux (Vaux.data ( ), Vaux.data ( ) + NELEM);
+
+    uint64_t nalloc_ini = nalloc;
+    spinsort_t (V1.begin ( ), V1.end ( ), compare_t ( ), range_aux);
+    BOOST_CHECK (nalloc == nalloc_ini);
+    std::sort (V2.begin ( ), V2.end ( ));
+    BOOST_CHECK (V1 == V2);
+
+    // 200 ascending runs of 500 elements
+    std::shuffle (V1.begin ( ), V1.end ( ), my_rand);
+    for (uint32_t i = 0; i < NELEM; i += 500)
+        std::sort (V1.begin ( ) + i, V1.begin ( ) + i + 500);
+    spinsort_t (V1.begin ( ), V1.end ( ), compare_t ( ), range_aux);
+    BOOST_CHECK (V1 == V2);
+};
 int test_main (int, char *[])
 {
     test1 ( );
     test2 ( );
     test3 ( );
     test4 ( );
+    test5 ( );
+    test6 ( );
     return 0;
 };
@@ -0,0 +1,153 @@
+//----------------------------------------------------------------------------
+/// @file test_thread_pool.cpp
+/// @brief Test program of the thread_pool class, and of the parallel
+///        algorithms running in a thread pool provided by the caller
+///
+///         Distributed under the Boost Software License, Version 1.0.\n
+///         ( See accompanying file LICENSE_1_0.txt or copy at
+///           http://www.boost.org/LICENSE_1_0.txt  )
+/// @version 0.1
+///
+/// @remarks
+//-----------------------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <ciso646>
+#include <boost/test/included/test_exec_monitor.hpp>
+#include <boost/test/test_tools.hpp>
+#include <boost/sort/sort.hpp>
+
+namespace bss = boost::sort;
+using bss::thread_pool;
+
+//---------------------------------------------------------------------------
+// Results and exceptions are returned through the futures
+//---------------------------------------------------------------------------
+void test1 (void)
+{
+    thread_pool pool (2);
+    BOOST_CHECK (pool.size ( ) == 2);
+
+    std::future< int > F1 = pool.async ([]( ) { return 42; });
+    std::future< void > F2 =
+        pool.async ([]( ) { throw std::runtime_error ("test1"); });
+    pool.wait (F1);
+    BOOST_CHECK (F1.get ( ) == 42);
+    pool.wait (F2);
+    BOOST_CHECK_THROW (F2.get ( ), std::runtime_error);
+
+    std::atomic< uint32_t > count (0);
+    pool.run (10, [&](uint32_t i) { count += i; });
+    BOOST_CHECK (count == 45);
+    BOOST_CHECK_THROW (pool.run (4, [](uint32_t i)
+    {
+        if (i == 3) throw std::runtime_error ("test1");
+    }), std::runtime_error);
+};
+
+//---------------------------------------------------------------------------
+// A pool without threads progress because the waiting thread executes the
+// works, and the works can wait other works of the same pool
+//---------------------------------------------------------------------------
+uint64_t fibo (thread_pool &pool, uint32_t n)
+{
+    if (n < 2) return n;
+    std::future< uint64_t > F =
+        pool.async ([&pool, n]( ) { return fibo (pool, n - 1); });
+    uint64_t N2 = fibo (pool, n - 2);
+    pool.wait (F);
+    return F.get ( ) + N2;
+};
+
+void test2 (void)
+{
+    thread_pool pool0 (0);
+    BOOST_CHECK (fibo (pool0, 15) == 610);
+
+    thread_pool pool1 (1);
+    BOOST_CHECK (fibo (pool1, 18) == 2584);
+};
+
+//---------------------------------------------------------------------------
+// The same pool is used by many sorts, with more threads than the pool has,
+// and from works of the pool
+//---------------------------------------------------------------------------
+void test3 (void)
+{
+    typedef std::less< uint64_t > compare;
+    std::mt19937_64 my_rand (0);
+    const uint32_t NELEM = 300000;
+    std::vector< uint64_t > A, B;
+    A.reserve (NELEM);
+    for (uint32_t i = 0; i < NELEM; ++i) A.push_back (my_rand ( ) % 10000);
+    B = A;
+    std::sort (B.begin ( ), B.end ( ));
+
+    thread_pool pool (1);
+    for (uint32_t k = 0; k < 3; ++k)
+    {
+        std::vector< uint64_t > V (A);
+        bss::block_indirect_sort (V.begin ( ), V.end ( ), compare ( ), 4, pool);
+        BOOST_CHECK (V == B);
+
+        V = A;
+        bss::sample_sort (V.begin ( ), V.end ( ), compare ( ), 4, pool);
+        BOOST_CHECK (V == B);
+
+        V = A;
+        bss::parallel_stable_sort (V.begin ( ), V.end ( ), compare ( ), 4,
+                                   pool);
+        BOOST_CHECK (V == B);
+
+        V = A;
+        bss::spreadsort::parallel_integer_sort (
+            V.begin ( ), V.end ( ), bss::spreadsort::detail::default_right_shift ( ),
+            compare ( ), 4, pool);
+        BOOST_CHECK (V == B);
+    };
+
+    std::vector< std::string > S, S2;
+    for (uint32_t i = 0; i < 100000; ++i)
+        S.push_back (std::to_string (my_rand ( ) % 1000000));
+    S2 = S;
+    std::sort (S2.begin ( ), S2.end ( ));
+    bss::spreadsort::parallel_string_sort (S.begin ( ), S.end ( ), 4, pool);
+    BOOST_CHECK (S == S2);
+
+    // two sorts running at the same time inside works of the pool
+    std::vector< uint64_t > V1 (A), V2 (A);
+    std::future< void > F1 = pool.async ([&]( )
+    {
+        bss::block_indirect_sort (V1.begin ( ), V1.end ( ), compare ( ), 3,
+                                  pool);
+    });
+    std::future< void > F2 = pool.async ([&]( )
+    {
+        bss::sample_sort (V2.begin ( ), V2.end ( ), compare ( ), 3, pool);
+    });
+    pool.wait (F1);
+    pool.wait (F2);
+    F1.get ( );
+    F2.get ( );
+    BOOST_CHECK (V1 == B);
+    BOOST_CHECK (V2 == B);
+
+    // the algorithms without pool use the default pool
+    std::vector< uint64_t > V (A);
+    bss::block_indirect_sort (V.begin ( ), V.end ( ));
+    BOOST_CHECK (V == B);
+};
+
+int test_main (int, char *[])
+{
+    test1 ( );
+    test2 ( );
+    test3 ( );
+    return 0;
+};